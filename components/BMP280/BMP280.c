@@ -266,9 +266,9 @@ esp_err_t bmp280_read_raw(bmp280_dev_t *dev, int32_t *raw_temp, int32_t *raw_pre
 }
 
 /**
- * @brief Compensate temperature (from BMP280 datasheet)
+ * @brief Compensate temperature (from BMP280 datasheet), in 0.01 °C
  */
-static float bmp280_compensate_temperature(bmp280_dev_t *dev, int32_t adc_T)
+static int32_t bmp280_compensate_temperature(bmp280_dev_t *dev, int32_t adc_T)
 {
     int32_t var1, var2;
 
@@ -281,14 +281,13 @@ static float bmp280_compensate_temperature(bmp280_dev_t *dev, int32_t adc_T)
 
     dev->t_fine = var1 + var2;
 
-    float T = (dev->t_fine * 5 + 128) >> 8;
-    return T / 100.0f;
+    return (dev->t_fine * 5 + 128) >> 8;
 }
 
 /**
- * @brief Compensate pressure (from BMP280 datasheet)
+ * @brief Compensate pressure (from BMP280 datasheet), in Pa as Q24.8 (1/256 Pa)
  */
-static float bmp280_compensate_pressure(bmp280_dev_t *dev, int32_t adc_P)
+static uint32_t bmp280_compensate_pressure(bmp280_dev_t *dev, int32_t adc_P)
 {
     int64_t var1, var2, p;
 
@@ -311,7 +310,7 @@ static float bmp280_compensate_pressure(bmp280_dev_t *dev, int32_t adc_P)
 
     p = ((p + var1 + var2) >> 8) + (((int64_t)dev->calib.dig_P7) << 4);
 
-    return (float)p / 256.0f / 100.0f; // Convert to hPa
+    return (uint32_t)p;
 }
 
 esp_err_t bmp280_read_temperature(bmp280_dev_t *dev, float *temperature)
@@ -326,7 +325,7 @@ esp_err_t bmp280_read_temperature(bmp280_dev_t *dev, float *temperature)
         return ret;
     }
 
-    *temperature = bmp280_compensate_temperature(dev, raw_temp);
+    *temperature = bmp280_compensate_temperature(dev, raw_temp) / 100.0f;
     return ESP_OK;
 }
 
@@ -344,7 +343,7 @@ esp_err_t bmp280_read_pressure(bmp280_dev_t *dev, float *pressure)
 
     // Must read temperature first to calculate t_fine
     bmp280_compensate_temperature(dev, raw_temp);
-    *pressure = bmp280_compensate_pressure(dev, raw_press);
+    *pressure = bmp280_compensate_pressure(dev, raw_press) / 256.0f / 100.0f; // Convert to hPa
 
     return ESP_OK;
 }
@@ -361,8 +360,26 @@ esp_err_t bmp280_read_data(bmp280_dev_t *dev, float *temperature, float *pressur
         return ret;
     }
 
+    *temperature = bmp280_compensate_temperature(dev, raw_temp) / 100.0f;
+    *pressure = bmp280_compensate_pressure(dev, raw_press) / 256.0f / 100.0f; // Convert to hPa
+
+    return ESP_OK;
+}
+
+esp_err_t bmp280_read_data_fixed(bmp280_dev_t *dev, int32_t *temperature, int32_t *pressure)
+{
+    if (dev == NULL || temperature == NULL || pressure == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int32_t raw_temp, raw_press;
+    esp_err_t ret = bmp280_read_raw(dev, &raw_temp, &raw_press);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
     *temperature = bmp280_compensate_temperature(dev, raw_temp);
-    *pressure = bmp280_compensate_pressure(dev, raw_press);
+    *pressure = (int32_t)((bmp280_compensate_pressure(dev, raw_press) + 128) >> 8); // Round to Pa
 
     return ESP_OK;
 }
@@ -153,6 +153,16 @@ esp_err_t bmp280_read_pressure(bmp280_dev_t *dev, float *pressure);
  */
 esp_err_t bmp280_read_data(bmp280_dev_t *dev, float *temperature, float *pressure);
 
+/**
+ * @brief Read both temperature and pressure as fixed-point integers, without floating point math
+ *
+ * @param dev Pointer to BMP280 device structure
+ * @param temperature Pointer to store temperature in 0.01 °C (2550 = 25.50 °C)
+ * @param pressure Pointer to store pressure in Pa, i.e. 0.01 hPa (101325 = 1013.25 hPa)
+ * @return esp_err_t ESP_OK on success
+ */
+esp_err_t bmp280_read_data_fixed(bmp280_dev_t *dev, int32_t *temperature, int32_t *pressure);
+
 /**
  * @brief Calculate altitude based on pressure
  *
@@ -1444,6 +1444,7 @@ namespace lgfx
 
     inline ILight* light(void) const { return _panel ? panel()->light() : nullptr; }
     inline void setBrightness(uint8_t brightness) { _brightness = brightness; if (_panel) { _panel->setBrightness(brightness); } }
+    inline void setBrightnessFade(uint8_t brightness, uint32_t time_ms) { _brightness = brightness; auto l = light(); if (l) { l->setBrightnessFade(brightness, time_ms); } }
     inline uint8_t getBrightness(void) const { return _brightness; }
 
     inline ITouch* touch(void) const { return _panel ? panel()->touch() : nullptr; }
@@ -31,6 +31,10 @@ namespace lgfx
 
     virtual bool init(uint8_t brightness) = 0;
     virtual void setBrightness(uint8_t brightness) = 0;
+
+    /// Change the brightness gradually within time_ms.
+    /// Lights without hardware fading change it at once.
+    virtual void setBrightnessFade(uint8_t brightness, uint32_t time_ms) { (void)time_ms; setBrightness(brightness); }
   };
 /*
   struct Light_NULL : public ILight
@@ -34,6 +34,10 @@ Contributors:
 #include <esp_heap_caps.h>
 #include <esp_log.h>
 
+#if defined ( LGFX_SPI_DMA_JOB_QUEUE )
+ #include <soc/periph_defs.h>
+#endif
+
 #if __has_include (<esp_private/periph_ctrl.h>)
  #include <esp_private/periph_ctrl.h>
 #else
@@ -197,6 +201,27 @@ namespace lgfx
   {
 //ESP_LOGI("LGFX","Bus_SPI::release");
     if (!_inited) return;
+    _wait_dma_jobs();
+#if defined ( LGFX_SPI_DMA_JOB_QUEUE )
+    if (_dma_job_intr)
+    {
+      *reg(SPI_DMA_INT_ENA_REG(_spi_port)) &= ~SPI_OUT_TOTAL_EOF_INT_ENA;
+      esp_intr_free(_dma_job_intr);
+      _dma_job_intr = nullptr;
+    }
+    if (_dma_job_task_handle)
+    {
+      vTaskDelete(_dma_job_task_handle);
+      _dma_job_task_handle = nullptr;
+    }
+    for (auto& slot : _dma_jobs)
+    {
+      if (slot.desc) { heap_free(slot.desc); }
+      slot.desc = nullptr;
+      slot.desc_size = 0;
+      slot.desc_data = nullptr;
+    }
+#endif
     _inited = false;
     spi::release(_cfg.spi_host);
     gpio_reset(_cfg.pin_dc  );
@@ -257,6 +282,7 @@ namespace lgfx
 
   void Bus_SPI::endTransaction(void)
   {
+    _wait_dma_jobs();
     dc_control(true);
 #if defined ( LGFX_SPIDMA_WORKAROUND )
     if (_dma_ch) { spicommon_dmaworkaround_idle(_dma_ch); }
@@ -269,13 +295,14 @@ namespace lgfx
 
   void Bus_SPI::wait(void)
   {
+    _wait_dma_jobs();
     auto spi_cmd_reg = _spi_cmd_reg;
     while (*spi_cmd_reg & SPI_USR);
   }
 
   bool Bus_SPI::busy(void) const
   {
-    return (*_spi_cmd_reg & SPI_USR);
+    return _dma_job_count || (*_spi_cmd_reg & SPI_USR);
   }
 
   bool Bus_SPI::writeCommand(uint32_t data, uint_fast8_t bit_length)
@@ -818,6 +845,208 @@ label_start:
 #endif
   }
 
+  bool Bus_SPI::queueDMAJob(const dma_job_t& job, bool kick)
+  {
+    if (job.length == 0 || job.cmd_count > dma_job_t::cmd_max) { return false; }
+
+#if defined ( LGFX_SPI_DMA_JOB_QUEUE )
+    if (_cfg.dma_channel)
+    {
+      // The interrupt moves the head and lowers the count together, so read them together.
+      // head + count (the slot after the queued jobs) doesn't change until this job is added.
+      portENTER_CRITICAL(&_dma_job_mux);
+      uint32_t count = _dma_job_count;
+      uint32_t tail = (_dma_job_head + count) % dma_job_queue_size;
+      portEXIT_CRITICAL(&_dma_job_mux);
+      if (count >= dma_job_queue_size) { return false; }
+
+      // The commands of the next job are written by busy-waiting on the SPI registers. It's done in a task
+      // with interrupts enabled, not in the interrupt itself.
+      if (_dma_job_task_handle == nullptr)
+      {
+        if (pdPASS != xTaskCreate(_dma_job_task, "lgfx_spi_dma", 2048, this, configMAX_PRIORITIES - 1, &_dma_job_task_handle))
+        {
+          ESP_LOGW("LGFX", "Failed to create the SPI DMA job task. ");
+          _dma_job_task_handle = nullptr;
+          return false;
+        }
+      }
+      if (_dma_job_intr == nullptr)
+      {
+        int source = (_spi_port == 3) ? ETS_SPI3_DMA_INTR_SOURCE : ETS_SPI2_DMA_INTR_SOURCE;
+        if (ESP_OK != esp_intr_alloc(source, ESP_INTR_FLAG_LOWMED | ESP_INTR_FLAG_IRAM, _dma_job_isr, this, &_dma_job_intr))
+        {
+          ESP_LOGW("LGFX", "Failed to allocate the SPI DMA interrupt. ");
+          _dma_job_intr = nullptr;
+          return false;
+        }
+      }
+
+      // The slot after the queued jobs is not used by the interrupt
+      auto slot = &_dma_jobs[tail];
+      if (slot->desc_data != job.data || slot->desc_length != job.length)
+      {
+        uint32_t desc_size = (job.length - 1) / SPI_MAX_DMA_LEN + 1;
+        if (slot->desc_size < desc_size)
+        {
+          if (slot->desc) { heap_free(slot->desc); }
+          slot->desc = (lldesc_t*)heap_caps_malloc(sizeof(lldesc_t) * desc_size, MALLOC_CAP_DMA);
+          slot->desc_size = slot->desc ? desc_size : 0;
+          slot->desc_data = nullptr;
+          if (slot->desc == nullptr) { return false; }
+        }
+
+        auto data = job.data;
+        uint32_t len = job.length;
+        lldesc_t *dmadesc = slot->desc;
+        while (len > SPI_MAX_DMA_LEN)
+        {
+          len -= SPI_MAX_DMA_LEN;
+          dmadesc->buf = (uint8_t *)data;
+          data += SPI_MAX_DMA_LEN;
+          *(uint32_t*)dmadesc = SPI_MAX_DMA_LEN | SPI_MAX_DMA_LEN << 12 | 0x80000000;
+          dmadesc->qe.stqe_next = dmadesc + 1;
+          dmadesc++;
+        }
+        *(uint32_t*)dmadesc = ((len + 3) & ( ~3 )) | len << 12 | 0xC0000000;
+        dmadesc->buf = (uint8_t *)data;
+        dmadesc->qe.stqe_next = nullptr;
+        slot->desc_data = job.data;
+        slot->desc_length = job.length;
+      }
+      slot->job = job;
+
+      portENTER_CRITICAL(&_dma_job_mux);
+      _dma_job_count = _dma_job_count + 1;
+      portEXIT_CRITICAL(&_dma_job_mux);
+
+      if (kick) { kickDMAJobs(); }
+      return true;
+    }
+#endif
+
+    // Without the interrupt the job is sent now
+    (void)kick;
+    for (size_t i = 0; i < job.cmd_count; ++i)
+    {
+      writeCommand(job.cmd[i], 8);
+      if (job.param_bits[i]) { writeData(job.param[i], job.param_bits[i]); }
+    }
+    writeBytes(job.data, job.length, true, true);
+    wait();
+    if (job.done_cb) { job.done_cb(job.user_data); }
+    return true;
+  }
+
+  void Bus_SPI::kickDMAJobs(void)
+  {
+#if defined ( LGFX_SPI_DMA_JOB_QUEUE )
+    portENTER_CRITICAL(&_dma_job_mux);
+    bool start = !_dma_job_running && _dma_job_count;
+    if (start)
+    {
+      _dma_job_running = true;
+      *reg(SPI_DMA_INT_ENA_REG(_spi_port)) |= SPI_OUT_TOTAL_EOF_INT_ENA;
+    }
+    portEXIT_CRITICAL(&_dma_job_mux);
+
+    // Only the one who set _dma_job_running writes the bus, so the mux is not held meanwhile
+    if (start) { _dma_job_start(); }
+#endif
+  }
+
+  void Bus_SPI::_wait_dma_jobs(void)
+  {
+    if (_dma_job_count == 0) { return; }
+    kickDMAJobs();
+    while (_dma_job_count) {}
+  }
+
+#if defined ( LGFX_SPI_DMA_JOB_QUEUE )
+
+  void Bus_SPI::_dma_job_start(void)
+  {
+    auto slot = &_dma_jobs[_dma_job_head];
+    auto& job = slot->job;
+
+    // The D/C line is a GPIO, so the commands are written from the registers before the DMA is started
+    for (size_t i = 0; i < job.cmd_count; ++i)
+    {
+      writeCommand(job.cmd[i], 8);
+      if (job.param_bits[i]) { writeData(job.param[i], job.param_bits[i]); }
+    }
+
+    auto spi_dma_out_link_reg = _spi_dma_out_link_reg;
+    wait_spi();
+    *spi_dma_out_link_reg = 0;
+
+    auto dma_conf_reg = reg(SPI_DMA_CONF_REG(_spi_port));
+    auto dma_conf = *dma_conf_reg & ~(SPI_OUT_DATA_BURST_EN | SPI_AHBM_RST | SPI_AHBM_FIFO_RST | SPI_OUT_RST);
+    *dma_conf_reg = dma_conf | SPI_AHBM_RST | SPI_AHBM_FIFO_RST | SPI_OUT_RST;
+    // Use the burst mode only if the length is a multiple of 4 (see writeBytes)
+    dma_conf |= (job.length & 3) ? (SPI_OUTDSCR_BURST_EN) : (SPI_OUTDSCR_BURST_EN | SPI_OUT_DATA_BURST_EN);
+    *dma_conf_reg = dma_conf;
+
+    *reg(SPI_DMA_INT_CLR_REG(_spi_port)) = SPI_OUT_TOTAL_EOF_INT_CLR;
+    *spi_dma_out_link_reg = SPI_OUTLINK_START | ((int)(&slot->desc[0]) & 0xFFFFF);
+    set_write_len(job.length << 3);
+    *_gpio_reg_dc[1] = _mask_reg_dc;
+
+#if defined (SPI_DMA_OUTFIFO_EMPTY)
+    while (*_spi_dma_outstatus_reg & SPI_DMA_OUTFIFO_EMPTY ) {}
+#elif defined ( LGFX_SPIDMA_WORKAROUND )
+    if (_dma_ch) { spicommon_dmaworkaround_transfer_active(_dma_ch); }
+#endif
+    exec_spi();
+  }
+
+  // Only wakes up the job task. It's in IRAM to run during flash operations too.
+  void IRAM_ATTR Bus_SPI::_dma_job_isr(void* arg)
+  {
+    auto me = (Bus_SPI*)arg;
+    auto spi_port = me->_spi_port;
+    if (0 == (*reg(SPI_DMA_INT_ST_REG(spi_port)) & SPI_OUT_TOTAL_EOF_INT_ST)) { return; }
+    *reg(SPI_DMA_INT_CLR_REG(spi_port)) = SPI_OUT_TOTAL_EOF_INT_CLR;
+    if (!me->_dma_job_running) { return; } // e.g. the end of writeBytes
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(me->_dma_job_task_handle, &woken);
+    if (woken) { portYIELD_FROM_ISR(); }
+  }
+
+  void Bus_SPI::_dma_job_task(void* arg)
+  {
+    auto me = (Bus_SPI*)arg;
+    for (;;)
+    {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+      // All the data is read by the DMA but the last bytes are still in the FIFO
+      me->wait_spi();
+
+      auto& job = me->_dma_jobs[me->_dma_job_head].job;
+      auto done_cb = job.done_cb;
+      auto user_data = job.user_data;
+
+      portENTER_CRITICAL(&me->_dma_job_mux);
+      me->_dma_job_head = (me->_dma_job_head + 1) % dma_job_queue_size;
+      me->_dma_job_count = me->_dma_job_count - 1;
+      bool next = me->_dma_job_count != 0;
+      if (!next)
+      {
+        me->_dma_job_running = false;
+        *reg(SPI_DMA_INT_ENA_REG(me->_spi_port)) &= ~SPI_OUT_TOTAL_EOF_INT_ENA;
+      }
+      portEXIT_CRITICAL(&me->_dma_job_mux);
+
+      // The next job is already being sent while the callback runs
+      if (next) { me->_dma_job_start(); }
+      if (done_cb) { done_cb(user_data); }
+    }
+  }
+
+#endif
+
   void Bus_SPI::beginRead(uint_fast8_t dummy_bits)
   {
     beginRead();
@@ -53,6 +53,14 @@ Contributors:
 #define LGFX_ESP32_SPI_DMA_CH 0
 #endif
 
+// DMA jobs are sent in the background on ESP32. Other targets send them immediately.
+#if !defined ( SOC_GDMA_SUPPORTED ) && ( defined ( CONFIG_IDF_TARGET_ESP32 ) || !defined ( CONFIG_IDF_TARGET ) )
+ #define LGFX_SPI_DMA_JOB_QUEUE
+ #include <esp_intr_alloc.h>
+ #include <freertos/FreeRTOS.h>
+ #include <freertos/task.h>
+#endif
+
 #include "../../Bus.hpp"
 #include "../common.hpp"
 
@@ -92,6 +100,25 @@ namespace lgfx
 #endif
     };
 
+    /// Called from the job task of the bus when the data of a job is sent.
+    typedef void (*dma_job_cb_t)(void* user_data);
+
+    /// A transfer sent in the background: a few commands with parameters (e.g. the address window)
+    /// and then the data with DMA (e.g. the pixels of a strip).
+    struct dma_job_t
+    {
+      static constexpr size_t cmd_max = 3;
+      uint8_t cmd[cmd_max] = {};          // commands sent with D/C low, e.g. CASET, RASET, RAMWR
+      uint8_t param_bits[cmd_max] = {};   // bit length of the parameter of each command (0: no parameter)
+      uint32_t param[cmd_max] = {};       // parameters, sent from the lowest byte like writeData()
+      uint8_t cmd_count = 0;
+      const uint8_t* data = nullptr;      // DMA capable memory, kept until done_cb is called
+      uint32_t length = 0;                // bytes of data, at least 1
+      dma_job_cb_t done_cb = nullptr;
+      void* user_data = nullptr;
+    };
+    static constexpr size_t dma_job_queue_size = 4;
+
     constexpr Bus_SPI(void) = default;
 
     const config_t& config(void) const { return _cfg; }
@@ -124,6 +151,20 @@ namespace lgfx
     void execDMAQueue(void) override;
     uint8_t* getDMABuffer(uint32_t length) override { return _flip_buffer.getBuffer(length); }
 
+    /// Queue a job to send it in the background. The DMA interrupt of a job only wakes up a high priority
+    /// task, which starts the next job and calls the callback, so the CPU is free while the queued jobs are sent.
+    /// Keep the transaction open (startWrite) while there are jobs, and don't write the bus in other ways.
+    /// endWrite() waits until all the jobs are sent.
+    /// @param kick true: start sending if it's not sending already; false: only queue it for kickDMAJobs()
+    /// @return false if the queue is full or the descriptors couldn't be allocated
+    bool queueDMAJob(const dma_job_t& job, bool kick = true);
+
+    /// Start sending the queued jobs.
+    void kickDMAJobs(void);
+
+    /// Number of jobs which are queued or being sent.
+    uint32_t getDMAJobCount(void) const { return _dma_job_count; }
+
     void beginRead(uint_fast8_t dummy_bits) override;
     void beginRead(void) override;
     void endRead(void) override;
@@ -171,6 +212,30 @@ namespace lgfx
     void _alloc_dmadesc(size_t len);
     void _spi_dma_reset(void);
     void _setup_dma_desc_links(const uint8_t *data, int32_t len);
+    void _wait_dma_jobs(void);
+
+#if defined ( LGFX_SPI_DMA_JOB_QUEUE )
+    struct dma_job_slot_t
+    {
+      dma_job_t job;
+      lldesc_t* desc = nullptr;       // kept for the next jobs, reallocated only for longer data
+      uint32_t desc_size = 0;
+      const uint8_t* desc_data = nullptr;
+      uint32_t desc_length = 0;
+    };
+
+    static void _dma_job_isr(void* arg);
+    static void _dma_job_task(void* arg);
+    void _dma_job_start(void);
+
+    dma_job_slot_t _dma_jobs[dma_job_queue_size];
+    intr_handle_t _dma_job_intr = nullptr;
+    TaskHandle_t _dma_job_task_handle = nullptr;
+    portMUX_TYPE _dma_job_mux = portMUX_INITIALIZER_UNLOCKED;
+    volatile uint8_t _dma_job_head = 0;
+    volatile bool _dma_job_running = false;   // true while a job is sent: only its starter writes the bus
+#endif
+    volatile uint8_t _dma_job_count = 0;
 
     config_t _cfg;
     FlipBuffer _flip_buffer;
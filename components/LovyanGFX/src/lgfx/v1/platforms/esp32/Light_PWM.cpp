@@ -87,6 +87,10 @@ namespace lgfx
     };
     ledc_timer_config(&ledc_timer);
 
+    // The fade service may be installed already by the application.
+    auto err = ledc_fade_func_install(0);
+    _fade_installed = (err == ESP_OK || err == ESP_ERR_INVALID_STATE);
+
     setBrightness(brightness);
 
 #endif
@@ -94,7 +98,7 @@ namespace lgfx
     return true;
   }
 
-  void Light_PWM::setBrightness(uint8_t brightness)
+  uint32_t Light_PWM::_calc_duty(uint8_t brightness) const
   {
     uint32_t duty = 0;
     if (brightness)
@@ -107,6 +111,12 @@ namespace lgfx
       duty >>= 16 - PWM_BITS;
     }
     if (_cfg.invert) duty = (1 << PWM_BITS) - duty;
+    return duty;
+  }
+
+  void Light_PWM::setBrightness(uint8_t brightness)
+  {
+    uint32_t duty = _calc_duty(brightness);
 
 #if defined ( ARDUINO )
 #if defined LEDC_USE_IDF_V5
@@ -114,12 +124,41 @@ namespace lgfx
 #else
       ledcWrite(_cfg.pwm_channel, duty);
 #endif
-#elif SOC_LEDC_SUPPORT_HS_MODE
-      ledc_set_duty(LEDC_HIGH_SPEED_MODE, (ledc_channel_t)_cfg.pwm_channel, duty);
-      ledc_update_duty(LEDC_HIGH_SPEED_MODE, (ledc_channel_t)_cfg.pwm_channel);
 #else
-      ledc_set_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)_cfg.pwm_channel, duty);
-      ledc_update_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)_cfg.pwm_channel);
+#if SOC_LEDC_SUPPORT_HS_MODE
+      static constexpr ledc_mode_t mode = LEDC_HIGH_SPEED_MODE;
+#else
+      static constexpr ledc_mode_t mode = LEDC_LOW_SPEED_MODE;
+#endif
+      if (_fade_installed)
+      { // Safe with the fade functions. The ESP32 can't stop a fade, so it waits for a running one.
+        ledc_set_duty_and_update(mode, (ledc_channel_t)_cfg.pwm_channel, duty, 0);
+      }
+      else
+      {
+        ledc_set_duty(mode, (ledc_channel_t)_cfg.pwm_channel, duty);
+        ledc_update_duty(mode, (ledc_channel_t)_cfg.pwm_channel);
+      }
+#endif
+  }
+
+  void Light_PWM::setBrightnessFade(uint8_t brightness, uint32_t time_ms)
+  {
+#if defined ( ARDUINO )
+    (void)time_ms;
+    setBrightness(brightness);
+#else
+    if (!_fade_installed || time_ms == 0)
+    {
+      setBrightness(brightness);
+      return;
+    }
+#if SOC_LEDC_SUPPORT_HS_MODE
+    static constexpr ledc_mode_t mode = LEDC_HIGH_SPEED_MODE;
+#else
+    static constexpr ledc_mode_t mode = LEDC_LOW_SPEED_MODE;
+#endif
+    ledc_set_fade_time_and_start(mode, (ledc_channel_t)_cfg.pwm_channel, _calc_duty(brightness), time_ms, LEDC_FADE_NO_WAIT);
 #endif
   }
 
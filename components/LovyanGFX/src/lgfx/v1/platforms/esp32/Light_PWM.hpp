@@ -45,8 +45,15 @@ namespace lgfx
     bool init(uint8_t brightness) override;
     void setBrightness(uint8_t brightness) override;
 
+    /// Fade with the LEDC hardware: the CPU is interrupted only at the end of the fade.
+    /// On the ESP32 a brightness change during the fade waits until it's finished.
+    void setBrightnessFade(uint8_t brightness, uint32_t time_ms) override;
+
   private:
     config_t _cfg;
+    bool _fade_installed = false;
+
+    uint32_t _calc_duty(uint8_t brightness) const;
   };
 
 //----------------------------------------------------------------------------
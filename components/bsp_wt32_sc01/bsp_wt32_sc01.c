@@ -4,41 +4,143 @@
 #include "esp_lcd_panel_vendor.h"
 #include "esp_lcd_panel_ops.h"
 #include "driver/gpio.h"
+#include "driver/ledc.h"
 #include "driver/i2c.h"
 #include "esp_timer.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
 
 static const char *TAG = "BSP_WT32_SC01";
 
-// LVGL display buffer
-#define LVGL_BUFFER_SIZE (LCD_H_RES * 40)
+// LVGL display buffer: LCD_DRAW_BUF_LINES lines of the landscape display.
+// The i80 bus's max_transfer_bytes is the size of one buffer, so a band is sent in one DMA transfer.
+#define LVGL_BUFFER_SIZE (LCD_V_RES * LCD_DRAW_BUF_LINES)
+
+// Backlight PWM. The LEDC hardware fades it without interrupting the CPU at every step.
+#define LCD_BK_LIGHT_LEDC_MODE      LEDC_LOW_SPEED_MODE
+#define LCD_BK_LIGHT_LEDC_TIMER     LEDC_TIMER_0
+#define LCD_BK_LIGHT_LEDC_CHANNEL   LEDC_CHANNEL_0
+#define LCD_BK_LIGHT_LEDC_BITS      10
+#define LCD_BK_LIGHT_FREQ_HZ        5000
+
+// ST7796 sleep in/out timing: 5 ms before the next command, 120 ms before the next sleep in/out
+#define LCD_SLEEP_CMD_DELAY_MS      5
+#define LCD_SLEEP_TOGGLE_DELAY_MS   120
+
+static bool backlight_ready = false;
+static int64_t sleep_toggle_time_us = 0; // Time of the last sleep in/out command
 
 static lv_disp_draw_buf_t disp_buf;
 static lv_disp_drv_t disp_drv;
 static lv_color_t *buf1 = NULL;
 static lv_color_t *buf2 = NULL;
 
+static esp_lcd_i80_bus_handle_t i80_bus = NULL;
+static esp_lcd_panel_io_handle_t io_handle = NULL;
 static esp_lcd_panel_handle_t panel_handle = NULL;
 
+// ST7796 initialization (the same as LovyanGFX's Panel_ST7796).
+// Sleep out is the last command; the display is turned on after the orientation is set.
+typedef struct {
+    uint8_t cmd;
+    uint8_t data[14];
+    uint8_t data_bytes;
+    uint8_t delay_ms;
+} lcd_init_cmd_t;
+
+static const lcd_init_cmd_t st7796_init_cmds[] = {
+    {0xF0, {0xC3}, 1, 0},                   // CSCON: enable extension command 2 part I
+    {0xF0, {0x96}, 1, 0},                   // CSCON: enable extension command 2 part II
+    {0x3A, {0x55}, 1, 0},                   // COLMOD: 16 bit/pixel
+    {0xB4, {0x01}, 1, 0},                   // INVCTR: 1-dot inversion
+    {0xB6, {0x80, 0x22, 0x3B}, 3, 0},       // DFUNCTR: bypass, S1->S960, G1->G480, 480 lines
+    {0xE8, {0x40, 0x8A, 0x00, 0x00, 0x29, 0x19, 0xA5, 0x33}, 8, 0}, // DOCA: display output timing
+    {0xC1, {0x06}, 1, 0},                   // PWCTR2: VAP/VAN = +-3.85 V + VCOM
+    {0xC2, {0xA7}, 1, 0},                   // PWCTR3: low source, high gamma driving current
+    {0xC5, {0x18}, 1, 120},                 // VMCTR: VCOM = 0.9 V
+    {0xE0, {0xF0, 0x09, 0x0B, 0x06, 0x04, 0x15, 0x2F, 0x54, 0x42, 0x3C, 0x17, 0x14, 0x18, 0x1B}, 14, 0}, // Positive gamma
+    {0xE1, {0xE0, 0x09, 0x0B, 0x06, 0x04, 0x03, 0x2B, 0x43, 0x42, 0x3B, 0x16, 0x14, 0x17, 0x1B}, 14, 120}, // Negative gamma
+    {0xF0, {0x3C}, 1, 0},                   // CSCON: disable extension command 2 part I
+    {0xF0, {0x69}, 1, 0},                   // CSCON: disable extension command 2 part II
+    {0x11, {0}, 0, 130},                    // SLPOUT
+    {0x38, {0}, 0, 0},                      // IDMOFF
+};
+
 // Forward declarations
 static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
+static bool lvgl_flush_ready_cb(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx);
 static void lvgl_port_update_callback(lv_disp_drv_t *drv);
 static void increase_lvgl_tick(void *arg);
+static esp_err_t lcd_draw_bufs_alloc(void);
+static esp_err_t lcd_panel_create(esp_lcd_panel_io_color_trans_done_cb_t trans_done_cb, void *user_ctx);
+static void lcd_panel_delete(void);
+static esp_err_t backlight_init(void);
+
+static esp_err_t backlight_init(void)
+{
+    ledc_timer_config_t timer_config = {
+        .speed_mode = LCD_BK_LIGHT_LEDC_MODE,
+        .duty_resolution = LCD_BK_LIGHT_LEDC_BITS,
+        .timer_num = LCD_BK_LIGHT_LEDC_TIMER,
+        .freq_hz = LCD_BK_LIGHT_FREQ_HZ,
+        .clk_cfg = LEDC_AUTO_CLK,
+    };
+    esp_err_t ret = ledc_timer_config(&timer_config);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    ledc_channel_config_t channel_config = {
+        .gpio_num = LCD_BK_LIGHT_PIN,
+        .speed_mode = LCD_BK_LIGHT_LEDC_MODE,
+        .channel = LCD_BK_LIGHT_LEDC_CHANNEL,
+        .intr_type = LEDC_INTR_DISABLE,
+        .timer_sel = LCD_BK_LIGHT_LEDC_TIMER,
+        .duty = 0,
+        .hpoint = 0,
+    };
+    ret = ledc_channel_config(&channel_config);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // The fade service may be installed already, e.g. by LovyanGFX's Light_PWM
+    ret = ledc_fade_func_install(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        return ret;
+    }
+
+    backlight_ready = true;
+    return ESP_OK;
+}
 
 esp_err_t bsp_display_brightness_set(int brightness_percent)
 {
+    return bsp_display_brightness_fade(brightness_percent, 0);
+}
+
+esp_err_t bsp_display_brightness_fade(int brightness_percent, uint32_t fade_ms)
+{
+    if (!backlight_ready) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
     if (brightness_percent > 100) {
         brightness_percent = 100;
     } else if (brightness_percent < 0) {
         brightness_percent = 0;
     }
+    uint32_t duty = ((1 << LCD_BK_LIGHT_LEDC_BITS) - 1) * brightness_percent / 100;
 
-    // Simple on/off control (you can implement PWM for gradual brightness)
-    gpio_set_level(LCD_BK_LIGHT_PIN, brightness_percent > 0 ? 1 : 0);
-    
-    return ESP_OK;
+    if (fade_ms == 0) {
+        // Safe with the fade functions. The ESP32 can't stop a fade, so it waits for a running one.
+        return ledc_set_duty_and_update(LCD_BK_LIGHT_LEDC_MODE, LCD_BK_LIGHT_LEDC_CHANNEL, duty, 0);
+    }
+    return ledc_set_fade_time_and_start(LCD_BK_LIGHT_LEDC_MODE, LCD_BK_LIGHT_LEDC_CHANNEL, duty, fade_ms,
+                                        LEDC_FADE_NO_WAIT);
 }
 
 static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
@@ -48,11 +150,16 @@ static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t
     int offsetx2 = area->x2;
     int offsety1 = area->y1;
     int offsety2 = area->y2;
-    
-    // Copy a buffer's content to a specific area of the display
+
+    // Queue the buffer for DMA. lvgl_flush_ready_cb() tells LVGL when it can be rendered again.
     esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
-    
-    lv_disp_flush_ready(drv);
+}
+
+static bool lvgl_flush_ready_cb(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+    // Called from the DMA interrupt when the color data of a flush is sent
+    lv_disp_flush_ready((lv_disp_drv_t *) user_ctx);
+    return false;
 }
 
 static void lvgl_port_update_callback(lv_disp_drv_t *drv)
@@ -84,18 +191,25 @@ static void increase_lvgl_tick(void *arg)
     lv_tick_inc(2);
 }
 
-esp_err_t bsp_display_init(lv_disp_t **lv_disp)
+static esp_err_t lcd_draw_bufs_alloc(void)
 {
-    // Initialize backlight GPIO
-    gpio_config_t bk_gpio_config = {
-        .mode = GPIO_MODE_OUTPUT,
-        .pin_bit_mask = 1ULL << LCD_BK_LIGHT_PIN
-    };
-    ESP_ERROR_CHECK(gpio_config(&bk_gpio_config));
-    gpio_set_level(LCD_BK_LIGHT_PIN, 1);
+    // Allocate the draw buffers using DMA-capable memory, they are kept for the lifetime of the application
+    if (buf1 == NULL) {
+        buf1 = heap_caps_malloc(LVGL_BUFFER_SIZE * sizeof(lv_color_t), MALLOC_CAP_DMA);
+    }
+    if (buf2 == NULL) {
+        buf2 = heap_caps_malloc(LVGL_BUFFER_SIZE * sizeof(lv_color_t), MALLOC_CAP_DMA);
+    }
+    if (buf1 == NULL || buf2 == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate the DMA draw buffers");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
 
+static esp_err_t lcd_panel_create(esp_lcd_panel_io_color_trans_done_cb_t trans_done_cb, void *user_ctx)
+{
     ESP_LOGI(TAG, "Initialize Intel 8080 bus");
-    esp_lcd_i80_bus_handle_t i80_bus = NULL;
     esp_lcd_i80_bus_config_t bus_config = {
         .clk_src = LCD_CLK_SRC_DEFAULT,
         .dc_gpio_num = LCD_DC_PIN,
@@ -111,43 +225,64 @@ esp_err_t bsp_display_init(lv_disp_t **lv_disp)
             LCD_D7_PIN,
         },
         .bus_width = 8,
-        .max_transfer_bytes = LVGL_BUFFER_SIZE * sizeof(uint16_t),
+        .max_transfer_bytes = LVGL_BUFFER_SIZE * sizeof(lv_color_t),
         .psram_trans_align = 64,
         .sram_trans_align = 4,
     };
-    ESP_ERROR_CHECK(esp_lcd_new_i80_bus(&bus_config, &i80_bus));
+    esp_err_t ret = esp_lcd_new_i80_bus(&bus_config, &i80_bus);
+    if (ret != ESP_OK) {
+        return ret;
+    }
 
-    ESP_LOGI(TAG, "Install LCD driver (using ST7789 for compatibility)");
-    esp_lcd_panel_io_handle_t io_handle = NULL;
+    ESP_LOGI(TAG, "Install LCD panel IO (%d Hz)", LCD_PIXEL_CLK_HZ);
     esp_lcd_panel_io_i80_config_t io_config = {
         .cs_gpio_num = LCD_CS_PIN,
         .pclk_hz = LCD_PIXEL_CLK_HZ,
+        // Two buffers are in flight at most, the rest is for the CASET/RASET/RAMWR of the flushes
         .trans_queue_depth = 10,
+        .on_color_trans_done = trans_done_cb,
+        .user_ctx = user_ctx,
         .dc_levels = {
             .dc_idle_level = 0,
             .dc_cmd_level = 0,
             .dc_dummy_level = 0,
             .dc_data_level = 1,
         },
+        .flags = {
+            // The panel expects the high byte first. Let the DMA swap if LVGL doesn't render swapped.
+            .swap_color_bytes = !LV_COLOR_16_SWAP,
+        },
         .lcd_cmd_bits = 8,
         .lcd_param_bits = 8,
     };
-    ESP_ERROR_CHECK(esp_lcd_new_panel_io_i80(i80_bus, &io_config, &io_handle));
+    ret = esp_lcd_new_panel_io_i80(i80_bus, &io_config, &io_handle);
+    if (ret != ESP_OK) {
+        lcd_panel_delete();
+        return ret;
+    }
 
-    // Use ST7789 driver instead of ST7796 (they are very similar and compatible)
+    // The ST7789 driver is used only for the MIPI DCS commands which are the same on the ST7796
+    // (reset, MADCTL, CASET/RASET/RAMWR, INVON, DISPON). The panel is initialized with its own sequence.
     esp_lcd_panel_dev_config_t panel_config = {
         .reset_gpio_num = LCD_RST_PIN,
         .rgb_endian = LCD_RGB_ENDIAN_BGR,
         .bits_per_pixel = 16,
     };
-    
-    // ST7789 driver is compatible with ST7796 displays
-    ESP_LOGI(TAG, "Creating panel with ST7789 driver (compatible with ST7796)");
-    ESP_ERROR_CHECK(esp_lcd_new_panel_st7789(io_handle, &panel_config, &panel_handle));
+    ret = esp_lcd_new_panel_st7789(io_handle, &panel_config, &panel_handle);
+    if (ret != ESP_OK) {
+        lcd_panel_delete();
+        return ret;
+    }
 
-    ESP_LOGI(TAG, "Reset and initialize LCD panel");
+    ESP_LOGI(TAG, "Reset and initialize ST7796");
     esp_lcd_panel_reset(panel_handle);
-    esp_lcd_panel_init(panel_handle);
+    for (size_t i = 0; i < sizeof(st7796_init_cmds) / sizeof(st7796_init_cmds[0]); i++) {
+        const lcd_init_cmd_t *cmd = &st7796_init_cmds[i];
+        esp_lcd_panel_io_tx_param(io_handle, cmd->cmd, cmd->data_bytes ? cmd->data : NULL, cmd->data_bytes);
+        if (cmd->delay_ms) {
+            vTaskDelay(pdMS_TO_TICKS(cmd->delay_ms));
+        }
+    }
     esp_lcd_panel_invert_color(panel_handle, true);
 
     // Set orientation - adjust these if display is rotated/mirrored incorrectly
@@ -158,21 +293,123 @@ esp_err_t bsp_display_init(lv_disp_t **lv_disp)
     // Some displays need this, WT32-SC01 typically doesn't but you can adjust if needed
     // esp_lcd_panel_set_gap(panel_handle, 0, 0);
 
+    esp_lcd_panel_disp_on_off(panel_handle, true);
+    return ESP_OK;
+}
+
+static void lcd_panel_delete(void)
+{
+    if (panel_handle) {
+        esp_lcd_panel_del(panel_handle);
+        panel_handle = NULL;
+    }
+    if (io_handle) {
+        esp_lcd_panel_io_del(io_handle);
+        io_handle = NULL;
+    }
+    if (i80_bus) {
+        esp_lcd_del_i80_bus(i80_bus);
+        i80_bus = NULL;
+    }
+}
+
+esp_err_t bsp_display_sleep(bool sleep)
+{
+    if (io_handle == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // The panel ignores a sleep in/out sent within 120 ms after the previous one
+    int64_t elapsed_ms = (esp_timer_get_time() - sleep_toggle_time_us) / 1000;
+    if (elapsed_ms < LCD_SLEEP_TOGGLE_DELAY_MS) {
+        vTaskDelay(pdMS_TO_TICKS(LCD_SLEEP_TOGGLE_DELAY_MS - elapsed_ms) + 1);
+    }
+
+    // A command is sent when the queued color transfers are done
+    esp_err_t ret = esp_lcd_panel_io_tx_param(io_handle, sleep ? 0x10 : 0x11, NULL, 0); // SLPIN / SLPOUT
+    sleep_toggle_time_us = esp_timer_get_time();
+    // The panel needs 5 ms after sleep in/out before the next command
+    vTaskDelay(pdMS_TO_TICKS(LCD_SLEEP_CMD_DELAY_MS));
+    return ret;
+}
+
+static bool benchmark_trans_done_cb(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR((SemaphoreHandle_t) user_ctx, &woken);
+    return woken == pdTRUE;
+}
+
+esp_err_t bsp_display_benchmark(uint32_t frames, bsp_display_benchmark_t *result)
+{
+    if (panel_handle != NULL) {
+        ESP_LOGE(TAG, "Run the benchmark before bsp_display_init()");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Counts the free draw buffers like LVGL does with its flushing flags
+    SemaphoreHandle_t free_bufs = xSemaphoreCreateCounting(2, 2);
+    if (free_bufs == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t ret = lcd_draw_bufs_alloc();
+    if (ret == ESP_OK) {
+        ret = lcd_panel_create(benchmark_trans_done_cb, free_bufs);
+    }
+
+    if (ret == ESP_OK) {
+        // Two colors to see the bands on the panel
+        lv_color_t *bufs[2] = {buf1, buf2};
+        lv_color_fill(buf1, lv_color_make(0x00, 0x40, 0xC0), LVGL_BUFFER_SIZE);
+        lv_color_fill(buf2, lv_color_make(0xC0, 0x40, 0x00), LVGL_BUFFER_SIZE);
+
+        uint32_t buf_idx = 0;
+        int64_t start = esp_timer_get_time();
+        for (uint32_t f = 0; f < frames && ret == ESP_OK; f++) {
+            for (int y = 0; y < LCD_H_RES && ret == ESP_OK; y += LCD_DRAW_BUF_LINES) {
+                int y2 = y + LCD_DRAW_BUF_LINES < LCD_H_RES ? y + LCD_DRAW_BUF_LINES : LCD_H_RES;
+                xSemaphoreTake(free_bufs, portMAX_DELAY);
+                ret = esp_lcd_panel_draw_bitmap(panel_handle, 0, y, LCD_V_RES, y2, bufs[buf_idx]);
+                buf_idx ^= 1;
+            }
+        }
+        // Wait until both buffers are sent
+        if (ret == ESP_OK) {
+            xSemaphoreTake(free_bufs, portMAX_DELAY);
+            xSemaphoreTake(free_bufs, portMAX_DELAY);
+        }
+
+        result->frames = frames;
+        result->bytes = frames * LCD_H_RES * LCD_V_RES * sizeof(lv_color_t);
+        result->time_us = (uint32_t)(esp_timer_get_time() - start);
+        result->pixel_clk_hz = LCD_PIXEL_CLK_HZ;
+    }
+
+    lcd_panel_delete();
+    vSemaphoreDelete(free_bufs);
+    return ret;
+}
+
+esp_err_t bsp_display_init(lv_disp_t **lv_disp)
+{
+    // Initialize backlight PWM
+    ESP_ERROR_CHECK(backlight_init());
+    bsp_display_brightness_set(100);
+
+    ESP_ERROR_CHECK(lcd_draw_bufs_alloc());
+    ESP_ERROR_CHECK(lcd_panel_create(lvgl_flush_ready_cb, &disp_drv));
+
     ESP_LOGI(TAG, "Initialize LVGL library");
     lv_init();
 
-    // Allocate draw buffers using DMA-capable memory
-    buf1 = heap_caps_malloc(LVGL_BUFFER_SIZE * sizeof(lv_color_t), MALLOC_CAP_DMA);
-    assert(buf1);
-    buf2 = heap_caps_malloc(LVGL_BUFFER_SIZE * sizeof(lv_color_t), MALLOC_CAP_DMA);
-    assert(buf2);
-
     lv_disp_draw_buf_init(&disp_buf, buf1, buf2, LVGL_BUFFER_SIZE);
 
     ESP_LOGI(TAG, "Register display driver to LVGL");
     lv_disp_drv_init(&disp_drv);
-    disp_drv.hor_res = LCD_H_RES;
-    disp_drv.ver_res = LCD_V_RES;
+    // The panel is turned to landscape by lcd_panel_create()
+    disp_drv.hor_res = LCD_V_RES;
+    disp_drv.ver_res = LCD_H_RES;
     disp_drv.flush_cb = lvgl_flush_cb;
     disp_drv.drv_update_cb = lvgl_port_update_callback;
     disp_drv.draw_buf = &disp_buf;
@@ -191,12 +428,3 @@ esp_err_t bsp_display_init(lv_disp_t **lv_disp)
     ESP_LOGI(TAG, "Display initialization complete");
     return ESP_OK;
 }
-
-esp_err_t bsp_touch_init(lv_indev_t **lv_indev)
-{
-    // Touch implementation would go here
-    // For now, we'll leave it as a placeholder
-    ESP_LOGW(TAG, "Touch not implemented yet");
-    *lv_indev = NULL;
-    return ESP_OK;
-}
@@ -38,7 +38,14 @@ extern "C" {
 // Display specifications
 #define LCD_H_RES           320
 #define LCD_V_RES           480
-#define LCD_PIXEL_CLK_HZ    (10 * 1000 * 1000)  // 10MHz for stability
+#ifndef LCD_PIXEL_CLK_HZ
+#define LCD_PIXEL_CLK_HZ    (16 * 1000 * 1000)  // 16MHz like LovyanGFX's Bus_Parallel8, lower it if a board revision shows noise
+#endif
+
+// Lines of a DMA draw buffer. Each buffer is exactly one i80 transfer (max_transfer_bytes).
+#ifndef LCD_DRAW_BUF_LINES
+#define LCD_DRAW_BUF_LINES  20
+#endif
 
 // Touch I2C configuration (FT6336)
 #define TOUCH_I2C_SDA       18  // Shared with LCD_D6
@@ -48,8 +55,22 @@ extern "C" {
 #define TOUCH_I2C_NUM       I2C_NUM_0
 #define TOUCH_I2C_ADDR      0x38  // FT6336 I2C address
 
+/**
+ * @brief Result of bsp_display_benchmark()
+ */
+typedef struct {
+    uint32_t frames;        // Number of full frames sent
+    uint32_t bytes;         // Number of pixel bytes sent
+    uint32_t time_us;       // Time of sending them, including the wait for the last transfer
+    uint32_t pixel_clk_hz;  // Pixel clock of the i80 bus
+} bsp_display_benchmark_t;
+
 /**
  * @brief Initialize WT32-SC01 display
+ *
+ * Initializes LVGL, registers a landscape display and flushes it with the i80 DMA.
+ * A band is reported ready to LVGL only when its transfer is done, so LVGL renders
+ * into the other one of the two DMA buffers meanwhile.
  * 
  * @param lv_disp Pointer to store LVGL display object
  * @return esp_err_t ESP_OK on success
@@ -57,20 +78,49 @@ extern "C" {
 esp_err_t bsp_display_init(lv_disp_t **lv_disp);
 
 /**
- * @brief Initialize touch controller
+ * @brief Set LCD backlight brightness
  * 
- * @param lv_indev Pointer to store LVGL input device object
+ * @param brightness_percent Brightness percentage (0-100)
  * @return esp_err_t ESP_OK on success
  */
-esp_err_t bsp_touch_init(lv_indev_t **lv_indev);
+esp_err_t bsp_display_brightness_set(int brightness_percent);
 
 /**
- * @brief Set LCD backlight brightness
- * 
+ * @brief Change the LCD backlight brightness gradually with the LEDC hardware fade
+ *
+ * Returns at once; the CPU is interrupted only at the end of the fade.
+ * On the ESP32 a brightness change during a fade waits until it's finished.
+ *
  * @param brightness_percent Brightness percentage (0-100)
+ * @param fade_ms Time of the fade, 0 to set the brightness at once
  * @return esp_err_t ESP_OK on success
  */
-esp_err_t bsp_display_brightness_set(int brightness_percent);
+esp_err_t bsp_display_brightness_fade(int brightness_percent, uint32_t fade_ms);
+
+/**
+ * @brief Put the LCD panel to sleep mode or wake it up
+ *
+ * The panel keeps the content of its frame memory while sleeping, so only the areas
+ * invalidated meanwhile need to be flushed after waking up.
+ * It waits until the queued transfers are sent and keeps the panel's timing: 120 ms after the
+ * previous sleep in/out and 5 ms after this one. Turn off the backlight before sleeping.
+ *
+ * @param sleep true: sleep in; false: sleep out
+ * @return esp_err_t ESP_OK on success
+ */
+esp_err_t bsp_display_sleep(bool sleep);
+
+/**
+ * @brief Measure the throughput of the i80 bus
+ *
+ * Sends full frames with the same double DMA buffers as the LVGL flush and waits for the last one.
+ * It creates and deletes its own bus, so call it before bsp_display_init().
+ *
+ * @param frames Number of frames to send
+ * @param result Store the result here
+ * @return esp_err_t ESP_OK on success
+ */
+esp_err_t bsp_display_benchmark(uint32_t frames, bsp_display_benchmark_t *result);
 
 #ifdef __cplusplus
 }
@@ -58,6 +58,8 @@ typedef struct {
     uint32_t time_sum_opa;
     uint32_t refr_cnt_normal;
     uint32_t refr_cnt_opa;
+    uint32_t event_sum_normal;  /*Events sent in the frames*/
+    uint32_t event_sum_opa;
     uint32_t fps_normal;
     uint32_t fps_opa;
     uint8_t weight;
@@ -758,13 +760,21 @@ static void monitor_cb(lv_disp_drv_t * drv, uint32_t time, uint32_t px)
 {
     LV_UNUSED(drv);
     LV_UNUSED(px);
+
+    /*The events sent since the previous frame*/
+    lv_event_stat_t event_stat;
+    lv_event_get_stat(&event_stat);
+    lv_event_reset_stat();
+
     if(opa_mode) {
         scenes[scene_act].refr_cnt_opa ++;
         scenes[scene_act].time_sum_opa += time;
+        scenes[scene_act].event_sum_opa += event_stat.sent;
     }
     else {
         scenes[scene_act].refr_cnt_normal ++;
         scenes[scene_act].time_sum_normal += time;
+        scenes[scene_act].event_sum_normal += event_stat.sent;
     }
 
     //    lv_obj_invalidate(lv_scr_act());
@@ -956,8 +966,9 @@ static void report_cb(lv_timer_t * timer)
 
         lv_label_set_text_fmt(subtitle, "Result : %"LV_PRId32" FPS",
                               scenes[scene_act].fps_opa);
-        LV_LOG("Result of \"%s + opa\": %"LV_PRId32" FPS", scenes[scene_act].name,
-               scenes[scene_act].fps_opa);
+        LV_LOG("Result of \"%s + opa\": %"LV_PRId32" FPS, %"LV_PRIu32" events/frame", scenes[scene_act].name,
+               scenes[scene_act].fps_opa,
+               scenes[scene_act].event_sum_opa / LV_MAX(scenes[scene_act].refr_cnt_opa, 1));
     }
     else {
         if(scenes[scene_act].time_sum_normal == 0) scenes[scene_act].time_sum_normal = 1;
@@ -965,8 +976,9 @@ static void report_cb(lv_timer_t * timer)
 
         lv_label_set_text_fmt(subtitle, "Result : %"LV_PRId32" FPS",
                               scenes[scene_act].fps_normal);
-        LV_LOG("Result of \"%s\": %"LV_PRId32" FPS", scenes[scene_act].name,
-               scenes[scene_act].fps_normal);
+        LV_LOG("Result of \"%s\": %"LV_PRId32" FPS, %"LV_PRIu32" events/frame", scenes[scene_act].name,
+               scenes[scene_act].fps_normal,
+               scenes[scene_act].event_sum_normal / LV_MAX(scenes[scene_act].refr_cnt_normal, 1));
     }
 }
 
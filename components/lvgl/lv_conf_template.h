@@ -98,6 +98,30 @@
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #define LV_DPI_DEF 130     /*[px/inch]*/
 
+/*Maximum number of draw buffers which can be passed to `lv_disp_draw_buf_init_ring()`.
+ *With more than 2 buffers several rendered bands can wait for flushing (e.g. by a task on an other CPU core)
+ *while LVGL renders the next band. 0: disable the draw buffer ring*/
+#define LV_DISP_DRAW_BUF_RING_MAX 0
+
+/*Width of the tiles (in pixels) used to find the parts of the bands which are the same as on the display.
+ *With `lv_disp_drv_t.damage_track = 1` the hash of every tile row is kept and the bands are cropped
+ *to the changed tiles before flushing. 0: disable damage tracking*/
+#define LV_DISP_DAMAGE_TILE_W 0
+
+/*Run the animations right before the refreshing of the default display instead of with their own timer.
+ *This way every frame shows the animations updated together and nothing is animated while it's not refreshed*/
+#define LV_ANIM_SYNC_REFR 0
+#if LV_ANIM_SYNC_REFR
+    /*Update the animations less frequently (down to every 4th refresh period) while LVGL's idle time
+     *is below this percentage. 0: always update them in every refresh*/
+    #define LV_ANIM_THROTTLE_IDLE 10
+#endif
+
+/*Maximum number of opaque objects collected front to back for every refreshed area.
+ *Objects (or the rows/columns of them) which are fully under these are not drawn.
+ *0: disable occlusion culling*/
+#define LV_REFR_OCCLUSION_CULL 0
+
 /*=======================
  * FEATURE CONFIGURATION
  *=======================*/
@@ -123,6 +147,13 @@
     #define LV_CIRCLE_CACHE_SIZE 4
 #endif /*LV_DRAW_COMPLEX*/
 
+/*Size of the arc coverage cache in bytes. 0: to disable the cache
+ *The anti-aliased coverage of arcs drawn again with the same radius, width, angles and opacity is saved
+ *and blended without evaluating the angle and radius masks again. The least recently used arcs are freed if the cache is full.
+ *The memory is allocated when the first arc is drawn.
+ *Requires `LV_DRAW_COMPLEX 1`*/
+#define LV_ARC_CACHE_SIZE 0
+
 /**
  * "Simple layers" are used when a widget has `style_opa < 255` to buffer the widget into a layer
  * and blend it as an image with the given opacity.
@@ -139,6 +170,12 @@
 #define LV_LAYER_SIMPLE_BUF_SIZE          (24 * 1024)
 #define LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE (3 * 1024)
 
+/*Size of the layer cache in bytes. 0: to disable the layer cache
+ *Objects with `LV_OBJ_FLAG_LAYER_CACHE` are rendered into a layer (with their children) which is kept
+ *and only its changed parts are rendered again. The least recently used layers are freed if the cache is full.
+ *Requires `LV_COLOR_SCREEN_TRANSP 1`*/
+#define LV_LAYER_CACHE_SIZE 0
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -306,6 +343,12 @@
 
 #define LV_USE_USER_DATA 1
 
+/*Number of light objects allocated together in a slab (max. 32). 0: to disable light objects
+ *The objects created after `lv_obj_enable_light_create(true)` can't be clicked, scrolled or focused
+ *and are allocated from slabs of same sized objects. The slab also stores their extra draw size,
+ *so e.g. labels need no special attributes. Meant for many decorative labels, lines and images.*/
+#define LV_OBJ_LIGHT_SLAB_CNT 0
+
 /*Garbage Collector settings
  *Used if lvgl is bound to higher level language and the memory is managed by that language*/
 #define LV_ENABLE_GC 0
@@ -491,6 +534,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LINE_CACHE 0     /*Store the line breaks and line widths in labels to measure and draw the text only once*/
 #endif
 
 #define LV_USE_LINE       1
@@ -602,6 +646,10 @@
 /*A layout similar to Grid in CSS.*/
 #define LV_USE_GRID 1
 
+/*1: Skip calculating the layout of an object again if the size, flags and position of its children haven't changed
+ *since the last layout calculation. Adds 4 bytes to the special attributes of the objects.*/
+#define LV_USE_LAYOUT_CACHE 0
+
 /*---------------------
  * 3rd party libraries
  *--------------------*/
@@ -658,6 +706,11 @@
 
 /*GIF decoder library*/
 #define LV_USE_GIF 0
+#if LV_USE_GIF
+    /*Memory for the changed areas of the frames of an endlessly looping GIF [bytes].
+     *After the first repeat the loop is played from this cache without decoding. (0: disable)*/
+    #define LV_GIF_CACHE_SIZE 0
+#endif
 
 /*QR code library*/
 #define LV_USE_QRCODE 0
@@ -707,6 +760,9 @@
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
 
+/*1: Enable recording and replaying input devices with latency and frame time statistics*/
+#define LV_USE_REPLAY 0
+
 /*1: Enable grid navigation*/
 #define LV_USE_GRIDNAV 0
 
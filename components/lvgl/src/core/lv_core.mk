@@ -5,6 +5,8 @@ CSRCS += lv_indev_scroll.c
 CSRCS += lv_obj.c
 CSRCS += lv_obj_class.c
 CSRCS += lv_obj_draw.c
+CSRCS += lv_obj_layer_cache.c
+CSRCS += lv_obj_light.c
 CSRCS += lv_obj_pos.c
 CSRCS += lv_obj_scroll.c
 CSRCS += lv_obj_style.c
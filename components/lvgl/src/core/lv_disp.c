@@ -450,6 +450,48 @@ bool lv_disp_is_invalidation_enabled(lv_disp_t * disp)
     return (disp->inv_en_cnt > 0);
 }
 
+/**
+ * Pause and resume the refreshing of a display, e.g. while its backlight is off.
+ * @param disp pointer to a display (NULL to use the default display)
+ * @param en true: pause the refreshing; false: resume it and refresh as soon as possible
+ */
+void lv_disp_set_refr_paused(lv_disp_t * disp, bool en)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) {
+        LV_LOG_WARN("no display registered");
+        return;
+    }
+
+    disp->refr_paused = en ? 1 : 0;
+    if(disp->refr_timer == NULL) return;
+
+    if(en) {
+        lv_timer_pause(disp->refr_timer);
+    }
+    else {
+        /*Draw what was invalidated in the meantime and let the animations catch up*/
+        lv_timer_resume(disp->refr_timer);
+        lv_timer_ready(disp->refr_timer);
+    }
+}
+
+/**
+ * Get whether the refreshing of a display is paused.
+ * @param disp pointer to a display (NULL to use the default display)
+ * @return true if the refreshing is paused
+ */
+bool lv_disp_is_refr_paused(lv_disp_t * disp)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) {
+        LV_LOG_WARN("no display registered");
+        return false;
+    }
+
+    return disp->refr_paused;
+}
+
 /**
  * Get a pointer to the screen refresher timer to
  * modify its parameters with `lv_timer_...` functions.
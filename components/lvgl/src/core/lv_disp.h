@@ -162,6 +162,22 @@ void lv_disp_enable_invalidation(lv_disp_t * disp, bool en);
  */
 bool lv_disp_is_invalidation_enabled(lv_disp_t * disp);
 
+/**
+ * Pause and resume the refreshing of a display, e.g. while its backlight is off.
+ * The invalidated areas are still collected and they are redrawn when the refreshing is resumed.
+ * With `LV_ANIM_SYNC_REFR` the animations are also stopped on the default display while it's paused.
+ * @param disp pointer to a display (NULL to use the default display)
+ * @param en true: pause the refreshing; false: resume it and refresh as soon as possible
+ */
+void lv_disp_set_refr_paused(lv_disp_t * disp, bool en);
+
+/**
+ * Get whether the refreshing of a display is paused.
+ * @param disp pointer to a display (NULL to use the default display)
+ * @return true if the refreshing is paused
+ */
+bool lv_disp_is_refr_paused(lv_disp_t * disp);
+
 /**
  * Get a pointer to the screen refresher timer to
  * modify its parameters with `lv_timer_...` functions.
@@ -29,11 +29,15 @@ typedef struct _lv_event_dsc_t {
 static lv_event_dsc_t * lv_obj_get_event_dsc(const lv_obj_t * obj, uint32_t id);
 static lv_res_t event_send_core(lv_event_t * e);
 static bool event_is_bubbled(lv_event_t * e);
+static bool draw_event_is_observed(const lv_obj_t * obj, lv_event_code_t event_code);
+static uint8_t get_draw_event_bits(uint8_t filter);
+static void update_draw_observed(lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static lv_event_t * event_head;
+static lv_event_stat_t event_stat;
 
 /**********************
  *      MACROS
@@ -54,6 +58,16 @@ lv_res_t lv_event_send(lv_obj_t * obj, lv_event_code_t event_code, void * param)
 
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*Most objects draw themselves only in LV_EVENT_DRAW_MAIN and LV_EVENT_DRAW_POST.
+     *Don't dispatch the other draw events if there is nobody to handle them*/
+    if(event_code >= LV_EVENT_DRAW_MAIN_BEGIN && event_code <= LV_EVENT_DRAW_PART_END &&
+       !draw_event_is_observed(obj, event_code)) {
+        event_stat.draw_skipped++;
+        return LV_RES_OK;
+    }
+
+    event_stat.sent++;
+
     lv_event_t e;
     e.target = obj;
     e.current_target = obj;
@@ -144,6 +158,16 @@ uint32_t lv_event_register_id(void)
     return last_id;
 }
 
+void lv_event_get_stat(lv_event_stat_t * stat)
+{
+    *stat = event_stat;
+}
+
+void lv_event_reset_stat(void)
+{
+    lv_memset_00(&event_stat, sizeof(event_stat));
+}
+
 void _lv_event_mark_deleted(lv_obj_t * obj)
 {
     lv_event_t * e = event_head;
@@ -168,6 +192,7 @@ struct _lv_event_dsc_t * lv_obj_add_event_cb(lv_obj_t * obj, lv_event_cb_t event
     obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1].cb = event_cb;
     obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1].filter = filter;
     obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1].user_data = user_data;
+    obj->spec_attr->event_draw_observed |= get_draw_event_bits(filter);
 
     return &obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1];
 }
@@ -188,6 +213,7 @@ bool lv_obj_remove_event_cb(lv_obj_t * obj, lv_event_cb_t event_cb)
             obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
                                                        obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
             LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
+            update_draw_observed(obj);
             return true;
         }
     }
@@ -213,6 +239,7 @@ bool lv_obj_remove_event_cb_with_user_data(lv_obj_t * obj, lv_event_cb_t event_c
             obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
                                                        obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
             LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
+            update_draw_observed(obj);
             return true;
         }
     }
@@ -237,6 +264,7 @@ bool lv_obj_remove_event_dsc(lv_obj_t * obj, struct _lv_event_dsc_t * event_dsc)
             obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
                                                        obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
             LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
+            update_draw_observed(obj);
             return true;
         }
     }
@@ -519,3 +547,34 @@ static bool event_is_bubbled(lv_event_t * e)
             return true;
     }
 }
+
+static bool draw_event_is_observed(const lv_obj_t * obj, lv_event_code_t event_code)
+{
+    /*The feedback callback of the input device gets every event*/
+    lv_indev_t * indev_act = lv_indev_get_act();
+    if(indev_act && indev_act->driver->feedback_cb) return true;
+
+    uint8_t bit = LV_OBJ_CLASS_DRAW_EVENT(event_code);
+    if(obj->spec_attr && (obj->spec_attr->event_draw_observed & bit)) return true;
+
+    /*Draw events are not bubbled so only the class of the object needs to be checked*/
+    return (_lv_obj_class_get_draw_events(obj->class_p) & bit) ? true : false;
+}
+
+static uint8_t get_draw_event_bits(uint8_t filter)
+{
+    uint8_t code = filter & ~LV_EVENT_PREPROCESS;
+    if(code == LV_EVENT_ALL) return LV_OBJ_CLASS_DRAW_EVENT_ALL;
+    if(code >= LV_EVENT_DRAW_MAIN_BEGIN && code <= LV_EVENT_DRAW_PART_END) return LV_OBJ_CLASS_DRAW_EVENT(code);
+    return 0;
+}
+
+static void update_draw_observed(lv_obj_t * obj)
+{
+    obj->spec_attr->event_draw_observed = 0;
+
+    uint32_t i;
+    for(i = 0; i < obj->spec_attr->event_dsc_cnt; i++) {
+        obj->spec_attr->event_draw_observed |= get_draw_event_bits(obj->spec_attr->event_dsc[i].filter);
+    }
+}
@@ -131,6 +131,15 @@ typedef struct {
     const lv_area_t * area;
 } lv_cover_check_info_t;
 
+/**
+ * Event counters to see the cost of the event dispatching
+ */
+typedef struct {
+    uint32_t sent;              /**< Number of events sent to the event functions of the objects*/
+    uint32_t draw_skipped;      /**< Number of draw events not sent as neither the class nor the callbacks
+                                     of the object handle them*/
+} lv_event_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -215,6 +224,17 @@ void lv_event_stop_processing(lv_event_t * e);
  */
 uint32_t lv_event_register_id(void);
 
+/**
+ * Get the number of sent and skipped events since the last `lv_event_reset_stat()`
+ * @param stat      store the counters here
+ */
+void lv_event_get_stat(lv_event_stat_t * stat);
+
+/**
+ * Reset the counters of `lv_event_get_stat()`, e.g. in every refresh to count the events of a frame
+ */
+void lv_event_reset_stat(void);
+
 /**
  * Nested events can be called and one of them might belong to an object that is being deleted.
  * Mark this object's `event_temp_data` deleted to know that its `lv_event_send` should return `LV_RES_INV`
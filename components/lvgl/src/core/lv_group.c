@@ -112,6 +112,11 @@ void lv_group_add_obj(lv_group_t * group, lv_obj_t * obj)
 {
     if(group == NULL) return;
 
+    if(lv_obj_is_light(obj)) {
+        LV_LOG_WARN("Light objects can't be added to a group");
+        return;
+    }
+
     LV_LOG_TRACE("begin");
 
     /*Be sure the object is removed from its current group*/
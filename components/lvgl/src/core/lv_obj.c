@@ -65,6 +65,7 @@ static void draw_scrollbar(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static lv_res_t scrollbar_init_draw_dsc(lv_obj_t * obj, lv_draw_rect_dsc_t * dsc);
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find);
 static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state);
+static bool anim_var_is_visible(void * var);
 
 /**********************
  *  STATIC VARIABLES
@@ -74,6 +75,7 @@ const lv_obj_class_t lv_obj_class = {
     .constructor_cb = lv_obj_constructor,
     .destructor_cb = lv_obj_destructor,
     .event_cb = lv_obj_event,
+    .draw_events = LV_OBJ_CLASS_DRAW_EVENTS_DEF,
     .width_def = LV_DPI_DEF,
     .height_def = LV_DPI_DEF,
     .editable = LV_OBJ_CLASS_EDITABLE_FALSE,
@@ -113,6 +115,7 @@ void lv_init(void)
     _lv_fs_init();
 
     _lv_anim_core_init();
+    _lv_anim_set_var_visible_cb(anim_var_is_visible);
 
     _lv_group_init();
 
@@ -144,6 +147,14 @@ void lv_init(void)
     /*Initialize the screen refresh system*/
     _lv_refr_init();
 
+#if LV_LAYER_CACHE_SIZE
+    _lv_obj_layer_cache_init();
+#endif
+
+#if LV_OBJ_LIGHT_SLAB_CNT
+    _lv_obj_light_init();
+#endif
+
     _lv_img_decoder_init();
 #if LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
@@ -230,6 +241,11 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_LIGHT_SLAB_CNT
+    /*Light objects are only decorations*/
+    if(obj->light) f &= ~_LV_OBJ_LIGHT_INPUT_FLAGS;
+#endif
+
     bool was_on_layout = lv_obj_is_layout_positioned(obj);
 
     /* We must invalidate the area occupied by the object before we hide it as calls to invalidate hidden objects are ignored */
@@ -277,6 +293,10 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags &= (~f);
 
+#if LV_LAYER_CACHE_SIZE
+    if(f & LV_OBJ_FLAG_LAYER_CACHE) _lv_obj_layer_cache_drop(obj);
+#endif
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
         if(lv_obj_is_layout_positioned(obj)) {
@@ -370,6 +390,10 @@ void lv_obj_allocate_spec_attr(lv_obj_t * obj)
 
         obj->spec_attr->scroll_dir = LV_DIR_ALL;
         obj->spec_attr->scrollbar_mode = LV_SCROLLBAR_MODE_AUTO;
+#if LV_OBJ_LIGHT_SLAB_CNT
+        /*Light objects kept it in the slab so far*/
+        if(obj->light) obj->spec_attr->ext_draw_size = *_lv_obj_light_ext_draw_size(obj);
+#endif
     }
 }
 
@@ -465,6 +489,11 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
 
+#if LV_LAYER_CACHE_SIZE
+    /*Free the cached layer*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_LAYER_CACHE)) _lv_obj_layer_cache_drop(obj);
+#endif
+
     if(obj->spec_attr) {
         if(obj->spec_attr->children) {
             lv_mem_free(obj->spec_attr->children);
@@ -749,7 +778,7 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
         uint32_t child_cnt = lv_obj_get_child_cnt(obj);
         for(uint32_t i = 0; i < child_cnt; i++) {
             lv_obj_t * child = obj->spec_attr->children[i];
-            lv_obj_mark_layout_as_dirty(child);
+            _lv_obj_mark_layout_as_dirty_keep_cache(child);
         }
     }
     else if(code == LV_EVENT_KEY) {
@@ -842,14 +871,14 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
         lv_coord_t align = lv_obj_get_style_align(obj, LV_PART_MAIN);
         uint16_t layout = lv_obj_get_style_layout(obj, LV_PART_MAIN);
         if(layout || align) {
-            lv_obj_mark_layout_as_dirty(obj);
+            _lv_obj_mark_layout_as_dirty_keep_cache(obj);
         }
 
         uint32_t i;
         uint32_t child_cnt = lv_obj_get_child_cnt(obj);
         for(i = 0; i < child_cnt; i++) {
             lv_obj_t * child = obj->spec_attr->children[i];
-            lv_obj_mark_layout_as_dirty(child);
+            _lv_obj_mark_layout_as_dirty_keep_cache(child);
         }
     }
     else if(code == LV_EVENT_CHILD_CHANGED) {
@@ -858,7 +887,7 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
         lv_coord_t align = lv_obj_get_style_align(obj, LV_PART_MAIN);
         uint16_t layout = lv_obj_get_style_layout(obj, LV_PART_MAIN);
         if(layout || align || w == LV_SIZE_CONTENT || h == LV_SIZE_CONTENT) {
-            lv_obj_mark_layout_as_dirty(obj);
+            _lv_obj_mark_layout_as_dirty_keep_cache(obj);
         }
     }
     else if(code == LV_EVENT_CHILD_DELETED) {
@@ -973,3 +1002,12 @@ static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_fin
     }
     return false;
 }
+
+static bool anim_var_is_visible(void * var)
+{
+    lv_obj_t * obj = var;
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp && disp->refr_paused) return false;
+
+    return lv_obj_is_visible(obj);
+}
@@ -108,6 +108,7 @@ enum {
     LV_OBJ_FLAG_IGNORE_LAYOUT   = (1L << 17), /**< Make the object position-able by the layouts*/
     LV_OBJ_FLAG_FLOATING        = (1L << 18), /**< Do not scroll the object when the parent scrolls and ignore layout*/
     LV_OBJ_FLAG_OVERFLOW_VISIBLE = (1L << 19), /**< Do not clip the children's content to the parent's boundary*/
+    LV_OBJ_FLAG_LAYER_CACHE     = (1L << 20), /**< Keep the rendered object and its children in a layer and re-render only the changed parts. Requires `LV_LAYER_CACHE_SIZE > 0`*/
 
     LV_OBJ_FLAG_LAYOUT_1        = (1L << 23), /**< Custom flag, free to use by layouts*/
     LV_OBJ_FLAG_LAYOUT_2        = (1L << 24), /**< Custom flag, free to use by layouts*/
@@ -138,6 +139,8 @@ typedef enum {
 #include "lv_obj_scroll.h"
 #include "lv_obj_style.h"
 #include "lv_obj_draw.h"
+#include "lv_obj_layer_cache.h"
+#include "lv_obj_light.h"
 #include "lv_obj_class.h"
 #include "lv_event.h"
 #include "lv_group.h"
@@ -168,6 +171,10 @@ typedef struct {
     lv_dir_t scroll_dir : 4;                /**< The allowed scroll direction(s)*/
     uint8_t event_dsc_cnt : 6;              /**< Number of event callbacks stored in `event_dsc` array*/
     uint8_t layer_type : 2;    /**< Cache the layer type here. Element of @lv_intermediate_layer_type_t */
+    uint8_t event_draw_observed;            /**< Draw events with a callback in `event_dsc` (`LV_OBJ_CLASS_DRAW_EVENT()` bits)*/
+#if LV_USE_LAYOUT_CACHE
+    uint32_t layout_key;                /**< Hash of the inputs and result of the last layout update. 0: not cached*/
+#endif
 } _lv_obj_spec_attr_t;
 
 #define STYLE_COUNT_BITS 6
@@ -187,11 +194,15 @@ typedef struct _lv_obj_t {
     uint16_t layout_inv : 1;
     uint16_t readjust_scroll_after_layout : 1;
     uint16_t scr_layout_inv : 1;
+    uint16_t child_layout_inv : 1;
     uint16_t skip_trans : 1;
     uint16_t style_cnt  : STYLE_COUNT_BITS;
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t being_deleted   : 1;
+#if LV_OBJ_LIGHT_SLAB_CNT
+    uint16_t light           : 1;
+#endif
 } lv_obj_t;
 
 /**********************
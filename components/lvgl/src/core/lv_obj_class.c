@@ -44,9 +44,18 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
     uint32_t s = get_instance_size(class_p);
-    lv_obj_t * obj = lv_mem_alloc(s);
+    lv_obj_t * obj = NULL;
+#if LV_OBJ_LIGHT_SLAB_CNT
+    /*Screens are never light*/
+    if(parent) obj = _lv_obj_light_alloc(s);
+    bool light = obj ? true : false;
+#endif
+    if(obj == NULL) obj = lv_mem_alloc(s);
     if(obj == NULL) return NULL;
     lv_memset_00(obj, s);
+#if LV_OBJ_LIGHT_SLAB_CNT
+    obj->light = light;
+#endif
     obj->class_p = class_p;
     obj->parent = parent;
 
@@ -109,13 +118,18 @@ void lv_obj_class_init_obj(lv_obj_t * obj)
     lv_theme_apply(obj);
     lv_obj_construct(obj);
 
+    if(lv_obj_is_light(obj)) {
+        /*Light objects are only decorations*/
+        lv_obj_clear_flag(obj, _LV_OBJ_LIGHT_INPUT_FLAGS);
+    }
+
     lv_obj_enable_style_refresh(true);
     lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY);
 
     lv_obj_refresh_self_size(obj);
 
     lv_group_t * def_group = lv_group_get_default();
-    if(def_group && lv_obj_is_group_def(obj)) {
+    if(def_group && lv_obj_is_group_def(obj) && !lv_obj_is_light(obj)) {
         lv_group_add_obj(def_group, obj);
     }
 
@@ -168,6 +182,21 @@ bool lv_obj_is_group_def(lv_obj_t * obj)
     return class_p->group_def == LV_OBJ_CLASS_GROUP_DEF_TRUE ? true : false;
 }
 
+uint8_t _lv_obj_class_get_draw_events(const lv_obj_class_t * class_p)
+{
+    uint8_t draw_events = 0;
+    while(class_p) {
+        if(class_p->event_cb) {
+            /*Unknown, the class can use any draw event*/
+            if(class_p->draw_events == 0) return LV_OBJ_CLASS_DRAW_EVENT_ALL;
+            draw_events |= class_p->draw_events;
+        }
+        class_p = class_p->base_class;
+    }
+
+    return draw_events;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -20,6 +20,14 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Bit of a draw event (::LV_EVENT_DRAW_MAIN_BEGIN ... ::LV_EVENT_DRAW_PART_END) in a draw event mask*/
+#define LV_OBJ_CLASS_DRAW_EVENT(code)   (1 << ((code) - LV_EVENT_DRAW_MAIN_BEGIN))
+#define LV_OBJ_CLASS_DRAW_EVENT_ALL     0xFF
+
+/** Draw events handled by the event function of `lv_obj_class`*/
+#define LV_OBJ_CLASS_DRAW_EVENTS_DEF    (LV_OBJ_CLASS_DRAW_EVENT(LV_EVENT_DRAW_MAIN) | \
+                                         LV_OBJ_CLASS_DRAW_EVENT(LV_EVENT_DRAW_POST))
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -59,6 +67,8 @@ typedef struct _lv_obj_class_t {
     uint32_t editable : 2;             /**< Value from ::lv_obj_class_editable_t*/
     uint32_t group_def : 2;            /**< Value from ::lv_obj_class_group_def_t*/
     uint32_t instance_size : 16;
+    uint32_t draw_events : 8;          /**< Draw events handled by `event_cb` (`LV_OBJ_CLASS_DRAW_EVENT()` bits).
+                                        *   0: unknown, let `event_cb` get all draw events*/
 } lv_obj_class_t;
 
 /**********************
@@ -81,6 +91,13 @@ bool lv_obj_is_editable(struct _lv_obj_t * obj);
 
 bool lv_obj_is_group_def(struct _lv_obj_t * obj);
 
+/**
+ * Get the draw events handled by the event functions of a class and its base classes
+ * @param class_p   pointer to a class
+ * @return          `LV_OBJ_CLASS_DRAW_EVENT()` bits of the handled draw events
+ */
+uint8_t _lv_obj_class_get_draw_events(const lv_obj_class_t * class_p);
+
 /**********************
  *      MACROS
  **********************/
@@ -370,6 +370,12 @@ void lv_obj_refresh_ext_draw_size(lv_obj_t * obj)
     if(obj->spec_attr) {
         obj->spec_attr->ext_draw_size = s_new;
     }
+#if LV_OBJ_LIGHT_SLAB_CNT
+    /*Light objects have room for it in their slab*/
+    else if(obj->light) {
+        *_lv_obj_light_ext_draw_size(obj) = s_new;
+    }
+#endif
     /*Allocate spec. attrs. only if the result is not zero.
      *Zero is the default value if the spec. attr. are not defined.*/
     else if(s_new != 0) {
@@ -383,6 +389,9 @@ void lv_obj_refresh_ext_draw_size(lv_obj_t * obj)
 lv_coord_t _lv_obj_get_ext_draw_size(const lv_obj_t * obj)
 {
     if(obj->spec_attr) return obj->spec_attr->ext_draw_size;
+#if LV_OBJ_LIGHT_SLAB_CNT
+    else if(obj->light) return *_lv_obj_light_ext_draw_size(obj);
+#endif
     else return 0;
 }
 
@@ -0,0 +1,284 @@
+/**
+ * @file lv_obj_layer_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_layer_cache.h"
+#if LV_LAYER_CACHE_SIZE
+
+#include "lv_obj.h"
+#include "lv_refr.h"
+#include "../misc/lv_gc.h"
+
+#if LV_COLOR_SCREEN_TRANSP == 0
+    #error "LV_LAYER_CACHE_SIZE requires LV_COLOR_SCREEN_TRANSP 1 to render the layers with alpha channel"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define layer_ll LV_GC_ROOT(_lv_layer_cache_ll)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const lv_obj_t * obj;
+    uint8_t * buf;          /*ARGB pixels of `area`*/
+    uint32_t buf_size;
+    uint32_t refr_cnt;      /*Value of `refr_cnt` when the layer was used last time*/
+    lv_area_t area;         /*Absolute coordinates of the layer*/
+    lv_area_t dirty_area;   /*The part of the layer to render again*/
+    uint8_t dirty : 1;
+} layer_cache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static layer_cache_entry_t * entry_find(const lv_obj_t * obj);
+static layer_cache_entry_t * entry_create(const lv_obj_t * obj, const lv_area_t * area);
+static void entry_free(layer_cache_entry_t * entry);
+static void layer_render(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, layer_cache_entry_t * entry);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t used_size;
+static uint32_t refr_cnt;
+static uint32_t hit_cnt;
+static uint32_t update_cnt;
+static uint32_t miss_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_obj_layer_cache_init(void)
+{
+    _lv_ll_init(&layer_ll, sizeof(layer_cache_entry_t));
+    used_size = 0;
+    refr_cnt = 0;
+    hit_cnt = 0;
+    update_cnt = 0;
+    miss_cnt = 0;
+}
+
+void _lv_obj_layer_cache_refr_start(void)
+{
+    refr_cnt++;
+}
+
+lv_res_t _lv_obj_layer_cache_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+
+    /*Not a real display (e.g. snapshot) or already rendering into a layer with alpha channel
+     *(e.g. the layer of a cached parent)*/
+    if(disp->driver->draw_buf == NULL || disp->driver->screen_transp) return LV_RES_INV;
+
+    /*The children can be drawn out of the layer*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return LV_RES_INV;
+
+    lv_area_t area;
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &area);
+    lv_area_increase(&area, ext_draw_size, ext_draw_size);
+    if(!lv_obj_area_is_visible(obj, &area)) return LV_RES_OK;
+
+    lv_area_t clip_area;
+    if(!_lv_area_intersect(&clip_area, draw_ctx->clip_area, &area)) return LV_RES_OK;
+
+    /*If the object was moved or resized the layer needs to be rendered again*/
+    layer_cache_entry_t * entry = entry_find(obj);
+    if(entry && !_lv_area_is_equal(&entry->area, &area)) {
+        entry_free(entry);
+        entry = NULL;
+    }
+
+    if(entry == NULL) {
+        entry = entry_create(obj, &area);
+        if(entry == NULL) return LV_RES_INV;
+        miss_cnt++;
+    }
+    else if(entry->dirty) {
+        update_cnt++;
+    }
+    else {
+        hit_cnt++;
+    }
+
+    /*Move to the head to be the most recently used*/
+    _lv_ll_move_before(&layer_ll, entry, _lv_ll_get_head(&layer_ll));
+    entry->refr_cnt = refr_cnt;
+
+    if(entry->dirty) {
+        entry->dirty = 0;
+        layer_render(draw_ctx, obj, entry);
+    }
+
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip_area;
+    lv_draw_img_decoded(draw_ctx, &draw_dsc, &entry->area, entry->buf, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    draw_ctx->clip_area = clip_area_ori;
+
+    return LV_RES_OK;
+}
+
+void _lv_obj_layer_cache_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
+{
+    /*Fast path if no layers are cached at all*/
+    if(_lv_ll_get_head(&layer_ll) == NULL) return;
+
+    while(obj) {
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_LAYER_CACHE)) {
+            layer_cache_entry_t * entry = entry_find(obj);
+            lv_area_t dirty_area;
+            if(entry && _lv_area_intersect(&dirty_area, area, &entry->area)) {
+                if(entry->dirty) _lv_area_join(&entry->dirty_area, &entry->dirty_area, &dirty_area);
+                else entry->dirty_area = dirty_area;
+                entry->dirty = 1;
+            }
+        }
+        obj = lv_obj_get_parent(obj);
+    }
+}
+
+void _lv_obj_layer_cache_drop(const lv_obj_t * obj)
+{
+    layer_cache_entry_t * entry = entry_find(obj);
+    if(entry) entry_free(entry);
+}
+
+void lv_obj_layer_cache_clean(void)
+{
+    layer_cache_entry_t * entry = _lv_ll_get_head(&layer_ll);
+    while(entry) {
+        entry_free(entry);
+        entry = _lv_ll_get_head(&layer_ll);
+    }
+}
+
+void lv_obj_layer_cache_monitor(lv_layer_cache_monitor_t * mon_p)
+{
+    LV_ASSERT_NULL(mon_p);
+
+    mon_p->entry_cnt = _lv_ll_get_len(&layer_ll);
+    mon_p->used_size = used_size;
+    mon_p->hit_cnt = hit_cnt;
+    mon_p->update_cnt = update_cnt;
+    mon_p->miss_cnt = miss_cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static layer_cache_entry_t * entry_find(const lv_obj_t * obj)
+{
+    layer_cache_entry_t * entry;
+    _LV_LL_READ(&layer_ll, entry) {
+        if(entry->obj == obj) return entry;
+    }
+
+    return NULL;
+}
+
+static layer_cache_entry_t * entry_create(const lv_obj_t * obj, const lv_area_t * area)
+{
+    uint32_t buf_size = lv_area_get_size(area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    if(buf_size > LV_LAYER_CACHE_SIZE) {
+        LV_LOG_INFO("the layer (%"LV_PRIu32" bytes) is larger than LV_LAYER_CACHE_SIZE", buf_size);
+        return NULL;
+    }
+
+    /*Evict the least recently used layers but keep the ones used in this refresh cycle.
+     *Evicting them would only make the other layers to be rendered again in every refresh cycle.*/
+    while(used_size + buf_size > LV_LAYER_CACHE_SIZE) {
+        layer_cache_entry_t * lru = _lv_ll_get_tail(&layer_ll);
+        if(lru == NULL || lru->refr_cnt == refr_cnt) return NULL;
+        entry_free(lru);
+    }
+
+    uint8_t * buf = lv_mem_alloc(buf_size);
+    if(buf == NULL) {
+        LV_LOG_WARN("couldn't allocate %"LV_PRIu32" bytes for a cached layer", buf_size);
+        return NULL;
+    }
+
+    layer_cache_entry_t * entry = _lv_ll_ins_head(&layer_ll);
+    LV_ASSERT_MALLOC(entry);
+    if(entry == NULL) {
+        lv_mem_free(buf);
+        return NULL;
+    }
+
+    entry->obj = obj;
+    entry->buf = buf;
+    entry->buf_size = buf_size;
+    entry->area = *area;
+    entry->dirty_area = *area;
+    entry->dirty = 1;
+    used_size += buf_size;
+
+    return entry;
+}
+
+static void entry_free(layer_cache_entry_t * entry)
+{
+    used_size -= entry->buf_size;
+    lv_mem_free(entry->buf);
+    _lv_ll_remove(&layer_ll, entry);
+    lv_mem_free(entry);
+}
+
+/**
+ * Render the dirty area of a layer into its buffer
+ */
+static void layer_render(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, layer_cache_entry_t * entry)
+{
+    /*Copy it because the object might be invalidated again during rendering*/
+    lv_area_t dirty_area_copy = entry->dirty_area;
+    const lv_area_t * dirty_area = &dirty_area_copy;
+
+    /*Clear the area to fully transparent as it will be rendered with alpha channel*/
+    uint32_t stride = lv_area_get_width(&entry->area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint32_t row_size = lv_area_get_width(dirty_area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint8_t * row = entry->buf + (dirty_area->y1 - entry->area.y1) * stride;
+    row += (dirty_area->x1 - entry->area.x1) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_coord_t y;
+    for(y = dirty_area->y1; y <= dirty_area->y2; y++) {
+        lv_memset_00(row, row_size);
+        row += stride;
+    }
+
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    void * buf_ori = draw_ctx->buf;
+    lv_area_t * buf_area_ori = draw_ctx->buf_area;
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    uint32_t screen_transp_ori = disp->driver->screen_transp;
+
+    draw_ctx->buf = entry->buf;
+    draw_ctx->buf_area = &entry->area;
+    draw_ctx->clip_area = dirty_area;
+    disp->driver->screen_transp = 1;
+
+    lv_obj_redraw(draw_ctx, obj);
+    lv_draw_wait_for_finish(draw_ctx);
+
+    draw_ctx->buf = buf_ori;
+    draw_ctx->buf_area = buf_area_ori;
+    draw_ctx->clip_area = clip_area_ori;
+    disp->driver->screen_transp = screen_transp_ori;
+}
+
+#endif /*LV_LAYER_CACHE_SIZE*/
@@ -0,0 +1,100 @@
+/**
+ * @file lv_obj_layer_cache.h
+ *
+ */
+
+#ifndef LV_OBJ_LAYER_CACHE_H
+#define LV_OBJ_LAYER_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_types.h"
+#include "../misc/lv_area.h"
+
+#if LV_LAYER_CACHE_SIZE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_t;
+struct _lv_draw_ctx_t;
+
+typedef struct {
+    uint32_t entry_cnt;     /**< Number of cached layers*/
+    uint32_t used_size;     /**< Size of the cached layers in bytes*/
+    uint32_t hit_cnt;       /**< Number of times a layer was blended from the cache*/
+    uint32_t update_cnt;    /**< Number of times a changed part of a cached layer was rendered again*/
+    uint32_t miss_cnt;      /**< Number of times a layer was rendered completely*/
+} lv_layer_cache_monitor_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the layer cache
+ */
+void _lv_obj_layer_cache_init(void);
+
+/**
+ * Tell the layer cache that a new refresh cycle starts.
+ * The layers used in the current refresh cycle are not evicted to make place for other layers.
+ */
+void _lv_obj_layer_cache_refr_start(void);
+
+/**
+ * Draw an object having `LV_OBJ_FLAG_LAYER_CACHE` from its cached layer.
+ * The changed parts of the layer are rendered again before blending it.
+ * @param draw_ctx  pointer to the current draw context
+ * @param obj       pointer to an object
+ * @return          LV_RES_OK: the object is drawn; LV_RES_INV: it can't be cached, draw it normally
+ */
+lv_res_t _lv_obj_layer_cache_draw(struct _lv_draw_ctx_t * draw_ctx, struct _lv_obj_t * obj);
+
+/**
+ * Mark an area as changed in the cached layers of the object and its parents.
+ * Called when an area of an object is invalidated.
+ * @param obj       pointer to an object
+ * @param area      the changed area in absolute coordinates
+ */
+void _lv_obj_layer_cache_invalidate_area(const struct _lv_obj_t * obj, const lv_area_t * area);
+
+/**
+ * Free the cached layer of an object
+ * @param obj       pointer to an object
+ */
+void _lv_obj_layer_cache_drop(const struct _lv_obj_t * obj);
+
+/**
+ * Free all cached layers
+ */
+void lv_obj_layer_cache_clean(void);
+
+/**
+ * Get the usage statistics of the layer cache
+ * @param mon_p     pointer to a `lv_layer_cache_monitor_t` variable to store the result
+ */
+void lv_obj_layer_cache_monitor(lv_layer_cache_monitor_t * mon_p);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_LAYER_CACHE_SIZE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_LAYER_CACHE_H*/
@@ -0,0 +1,171 @@
+/**
+ * @file lv_obj_light.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_light.h"
+#include "lv_obj.h"
+#include "../misc/lv_gc.h"
+
+#if LV_OBJ_LIGHT_SLAB_CNT > 32
+    #error "LV_OBJ_LIGHT_SLAB_CNT can be max. 32"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_OBJ_LIGHT_SLAB_CNT
+#define slab_head LV_GC_ROOT(_lv_obj_light_slab_head)
+
+/*Align the objects for any member type*/
+#define LIGHT_ALIGN(x)      (((x) + 7) & ~7)
+#define SLAB_HEADER_SIZE    LIGHT_ALIGN(sizeof(light_slab_t))
+#define OBJ_HEADER_SIZE     LIGHT_ALIGN(sizeof(light_obj_header_t))
+#define SLAB_FULL_MAP       ((uint32_t)(((uint64_t)1 << LV_OBJ_LIGHT_SLAB_CNT) - 1))
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_OBJ_LIGHT_SLAB_CNT
+/*A slab is allocated at once with `LV_OBJ_LIGHT_SLAB_CNT` slots of the same size after this header.
+ *A slot is a `light_obj_header_t` and the object.*/
+typedef struct _light_slab_t {
+    struct _light_slab_t * next;
+    uint32_t slot_size;
+    uint32_t used_map;          /*Bit `n` is set if the n-th slot of the slab is used*/
+} light_slab_t;
+
+typedef struct {
+    lv_coord_t ext_draw_size;   /*Used while the object has no `spec_attr`*/
+} light_obj_header_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_OBJ_LIGHT_SLAB_CNT
+    static bool light_create;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool lv_obj_is_light(const lv_obj_t * obj)
+{
+#if LV_OBJ_LIGHT_SLAB_CNT
+    return obj->light ? true : false;
+#else
+    LV_UNUSED(obj);
+    return false;
+#endif
+}
+
+#if LV_OBJ_LIGHT_SLAB_CNT
+
+void _lv_obj_light_init(void)
+{
+    slab_head = NULL;
+    light_create = false;
+}
+
+void lv_obj_enable_light_create(bool en)
+{
+    light_create = en;
+}
+
+lv_obj_t * _lv_obj_light_alloc(uint32_t size)
+{
+    if(!light_create) return NULL;
+
+    uint32_t slot_size = OBJ_HEADER_SIZE + LIGHT_ALIGN(size);
+
+    light_slab_t * slab = slab_head;
+    while(slab) {
+        if(slab->slot_size == slot_size && slab->used_map != SLAB_FULL_MAP) break;
+        slab = slab->next;
+    }
+
+    if(slab == NULL) {
+        slab = lv_mem_alloc(SLAB_HEADER_SIZE + slot_size * LV_OBJ_LIGHT_SLAB_CNT);
+        LV_ASSERT_MALLOC(slab);
+        if(slab == NULL) return NULL;
+
+        slab->slot_size = slot_size;
+        slab->used_map = 0;
+        slab->next = slab_head;
+        slab_head = slab;
+    }
+
+    uint32_t i = 0;
+    while(slab->used_map & ((uint32_t)1 << i)) i++;
+    slab->used_map |= (uint32_t)1 << i;
+
+    uint8_t * slot = (uint8_t *)slab + SLAB_HEADER_SIZE + i * slot_size;
+    lv_memset_00(slot, OBJ_HEADER_SIZE);
+    return (lv_obj_t *)(slot + OBJ_HEADER_SIZE);
+}
+
+void _lv_obj_light_free(lv_obj_t * obj)
+{
+    light_slab_t * prev = NULL;
+    light_slab_t * slab = slab_head;
+    while(slab) {
+        uint8_t * slots = (uint8_t *)slab + SLAB_HEADER_SIZE;
+        if((uint8_t *)obj > slots && (uint8_t *)obj < slots + slab->slot_size * LV_OBJ_LIGHT_SLAB_CNT) break;
+        prev = slab;
+        slab = slab->next;
+    }
+
+    LV_ASSERT_MSG(slab != NULL, "The light object is not in any slab");
+    if(slab == NULL) return;
+
+    uint32_t i = (uint32_t)((uint8_t *)obj - ((uint8_t *)slab + SLAB_HEADER_SIZE)) / slab->slot_size;
+    slab->used_map &= ~((uint32_t)1 << i);
+    if(slab->used_map) return;
+
+    /*The slab is empty*/
+    if(prev) prev->next = slab->next;
+    else slab_head = slab->next;
+    lv_mem_free(slab);
+}
+
+lv_coord_t * _lv_obj_light_ext_draw_size(const lv_obj_t * obj)
+{
+    light_obj_header_t * header = (light_obj_header_t *)((uint8_t *)obj - OBJ_HEADER_SIZE);
+    return &header->ext_draw_size;
+}
+
+void lv_obj_light_monitor(lv_obj_light_monitor_t * mon_p)
+{
+    lv_memset_00(mon_p, sizeof(lv_obj_light_monitor_t));
+
+    light_slab_t * slab = slab_head;
+    while(slab) {
+        mon_p->slab_cnt++;
+        mon_p->slab_size += SLAB_HEADER_SIZE + slab->slot_size * LV_OBJ_LIGHT_SLAB_CNT;
+        uint32_t i;
+        for(i = 0; i < LV_OBJ_LIGHT_SLAB_CNT; i++) {
+            if(slab->used_map & ((uint32_t)1 << i)) mon_p->obj_cnt++;
+        }
+        slab = slab->next;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /*LV_OBJ_LIGHT_SLAB_CNT*/
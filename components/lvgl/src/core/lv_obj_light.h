@@ -0,0 +1,109 @@
+/**
+ * @file lv_obj_light.h
+ *
+ */
+
+#ifndef LV_OBJ_LIGHT_H
+#define LV_OBJ_LIGHT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_types.h"
+#include "../misc/lv_area.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Flags light objects never have*/
+#define _LV_OBJ_LIGHT_INPUT_FLAGS   (LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_CLICK_FOCUSABLE | LV_OBJ_FLAG_CHECKABLE | \
+                                     LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_SCROLL_ELASTIC | LV_OBJ_FLAG_SCROLL_MOMENTUM | \
+                                     LV_OBJ_FLAG_SCROLL_CHAIN | LV_OBJ_FLAG_SCROLL_ON_FOCUS | LV_OBJ_FLAG_PRESS_LOCK)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_t;
+
+typedef struct {
+    uint32_t obj_cnt;           /**< Number of light objects*/
+    uint32_t slab_cnt;          /**< Number of slabs the light objects are allocated from*/
+    uint32_t slab_size;         /**< Size of the slabs in bytes*/
+} lv_obj_light_monitor_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Tell if an object is a light object
+ * @param obj       pointer to an object
+ * @return          true: `obj` was created as a light object
+ */
+bool lv_obj_is_light(const struct _lv_obj_t * obj);
+
+#if LV_OBJ_LIGHT_SLAB_CNT
+
+/**
+ * Initialize the slabs of the light objects
+ */
+void _lv_obj_light_init(void);
+
+/**
+ * Create the next objects as light objects or normal objects.
+ * Light objects are meant for decorations (labels, lines, images) shown in large numbers:
+ * - they are allocated from slabs of objects with the same size
+ * - their extra draw size is stored in the slab, so they don't need special attributes for it
+ * - they can't be clicked, scrolled or added to a group. `lv_obj_add_flag()` ignores these flags.
+ * Screens are never light. Children can be added to light objects but they don't scroll.
+ * @param en        true: create light objects; false: create normal objects
+ */
+void lv_obj_enable_light_create(bool en);
+
+/**
+ * Allocate memory for a light object from a slab if light objects are created now
+ * @param size      size of the object in bytes
+ * @return          pointer to the allocated memory or NULL if a normal object should be allocated
+ */
+struct _lv_obj_t * _lv_obj_light_alloc(uint32_t size);
+
+/**
+ * Free the memory of a light object. The slab is freed if it has no more objects.
+ * @param obj       pointer to a light object
+ */
+void _lv_obj_light_free(struct _lv_obj_t * obj);
+
+/**
+ * Get where the extra draw size of a light object is stored while it has no special attributes
+ * @param obj       pointer to a light object
+ * @return          pointer to the extra draw size in the slab
+ */
+lv_coord_t * _lv_obj_light_ext_draw_size(const struct _lv_obj_t * obj);
+
+/**
+ * Get the memory usage of the light objects
+ * @param mon_p     pointer to a `lv_obj_light_monitor_t` variable to store the result
+ */
+void lv_obj_light_monitor(lv_obj_light_monitor_t * mon_p);
+
+#endif /*LV_OBJ_LIGHT_SLAB_CNT*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_LIGHT_H*/
@@ -26,12 +26,17 @@
 static lv_coord_t calc_content_width(lv_obj_t * obj);
 static lv_coord_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static void layout_calc(lv_obj_t * obj, uint32_t layout_id);
+#if LV_USE_LAYOUT_CACHE
+    static uint32_t layout_key_calc(lv_obj_t * obj, uint32_t layout_id);
+#endif
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t layout_cnt;
+static lv_layout_monitor_t layout_mon;
 
 /**********************
  *      MACROS
@@ -200,7 +205,13 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     /*Invalidate the new area*/
     lv_obj_invalidate(obj);
 
+    /*Readjust the scroll position on the next layout update. Mark the parents to find this object.*/
     obj->readjust_scroll_after_layout = 1;
+    while(parent) {
+        parent->child_layout_inv = 1;
+        parent = parent->parent;
+    }
+    parent = lv_obj_get_parent(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -286,16 +297,32 @@ bool lv_obj_is_layout_positioned(const lv_obj_t * obj)
 }
 
 void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
+{
+#if LV_USE_LAYOUT_CACHE
+    /*Something might have changed which is not checked by the layout cache (e.g. a style property)*/
+    if(obj->spec_attr) obj->spec_attr->layout_key = 0;
+#endif
+
+    _lv_obj_mark_layout_as_dirty_keep_cache(obj);
+}
+
+void _lv_obj_mark_layout_as_dirty_keep_cache(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
 
+    /*Mark the parents too to visit only the changed branches of the object tree on layout update*/
+    lv_obj_t * scr = obj;
+    while(scr->parent) {
+        scr = scr->parent;
+        scr->child_layout_inv = 1;
+    }
+
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
-    lv_obj_t * scr = lv_obj_get_screen(obj);
     scr->scr_layout_inv = 1;
 
     /*Make the display refreshing*/
     lv_disp_t * disp = lv_obj_get_disp(scr);
-    if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+    if(disp->refr_timer && !disp->refr_paused) lv_timer_resume(disp->refr_timer);
 }
 
 void lv_obj_update_layout(const lv_obj_t * obj)
@@ -331,6 +358,13 @@ uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data)
     return layout_cnt;  /*No -1 to skip 0th index*/
 }
 
+void lv_obj_layout_monitor(lv_layout_monitor_t * mon_p)
+{
+    LV_ASSERT_NULL(mon_p);
+
+    *mon_p = layout_mon;
+}
+
 void lv_obj_set_align(lv_obj_t * obj, lv_align_t align)
 {
     lv_obj_set_style_align(obj, align, 0);
@@ -621,7 +655,7 @@ bool lv_obj_refresh_self_size(lv_obj_t * obj)
     lv_coord_t h_set = lv_obj_get_style_height(obj, LV_PART_MAIN);
     if(w_set != LV_SIZE_CONTENT && h_set != LV_SIZE_CONTENT) return false;
 
-    lv_obj_mark_layout_as_dirty(obj);
+    _lv_obj_mark_layout_as_dirty_keep_cache(obj);
     return true;
 }
 
@@ -835,6 +869,11 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_LAYER_CACHE_SIZE
+    /*Update the cached layers even if the area is not visible now or invalidation is disabled*/
+    _lv_obj_layer_cache_invalidate_area(obj, area);
+#endif
+
     lv_disp_t * disp   = lv_obj_get_disp(obj);
     if(!lv_disp_is_invalidation_enabled(disp)) return;
 
@@ -1125,21 +1164,26 @@ static void layout_update_core(lv_obj_t * obj)
 {
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_cnt(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+
+    /*Skip the branches where nothing has changed*/
+    if(obj->child_layout_inv) {
+        obj->child_layout_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            layout_update_core(child);
+        }
     }
 
     if(obj->layout_inv) {
         obj->layout_inv = 0;
+        layout_mon.obj_cnt++;
         lv_obj_refr_size(obj);
         lv_obj_refr_pos(obj);
 
         if(child_cnt > 0) {
             uint32_t layout_id = lv_obj_get_style_layout(obj, LV_PART_MAIN);
             if(layout_id > 0 && layout_id <= layout_cnt) {
-                void  * user_data = LV_GC_ROOT(_lv_layout_list)[layout_id - 1].user_data;
-                LV_GC_ROOT(_lv_layout_list)[layout_id - 1].cb(obj, user_data);
+                layout_calc(obj, layout_id);
             }
         }
     }
@@ -1150,6 +1194,71 @@ static void layout_update_core(lv_obj_t * obj)
     }
 }
 
+/**
+ * Call the layout's update callback on an object unless the cached result is up to date
+ * @param obj           pointer to an object having children
+ * @param layout_id     the layout of the object
+ */
+static void layout_calc(lv_obj_t * obj, uint32_t layout_id)
+{
+#if LV_USE_LAYOUT_CACHE
+    /*If the key is the same the children are already where the layout would put them*/
+    if(obj->spec_attr->layout_key != 0 && obj->spec_attr->layout_key == layout_key_calc(obj, layout_id)) {
+        layout_mon.skip_cnt++;
+        return;
+    }
+#endif
+
+    layout_mon.calc_cnt++;
+    void  * user_data = LV_GC_ROOT(_lv_layout_list)[layout_id - 1].user_data;
+    LV_GC_ROOT(_lv_layout_list)[layout_id - 1].cb(obj, user_data);
+
+#if LV_USE_LAYOUT_CACHE
+    /*The callback might delete the children*/
+    if(obj->spec_attr) obj->spec_attr->layout_key = layout_key_calc(obj, layout_id);
+#endif
+}
+
+#if LV_USE_LAYOUT_CACHE
+/**
+ * Hash everything which is used by the layouts but not covered by `lv_obj_mark_layout_as_dirty()`
+ * on style changes: the size of the object and the flags, size and relative position of the children.
+ * @param obj           pointer to an object having children
+ * @param layout_id     the layout of the object
+ * @return              the key of the current state, never 0
+ */
+static uint32_t layout_key_calc(lv_obj_t * obj, uint32_t layout_id)
+{
+    /*FNV-1a on 32 bit values*/
+#define LAYOUT_KEY_ADD(v) key = (key ^ (uint32_t)(v)) * 16777619
+
+    uint32_t key = 2166136261;
+    LAYOUT_KEY_ADD(layout_id);
+    LAYOUT_KEY_ADD(lv_obj_get_width(obj));
+    LAYOUT_KEY_ADD(lv_obj_get_height(obj));
+    LAYOUT_KEY_ADD(lv_obj_get_style_base_dir(obj, LV_PART_MAIN));
+
+    lv_coord_t x = obj->coords.x1 - lv_obj_get_scroll_x(obj);
+    lv_coord_t y = obj->coords.y1 - lv_obj_get_scroll_y(obj);
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        LAYOUT_KEY_ADD((lv_uintptr_t)child);
+        LAYOUT_KEY_ADD(child->flags);
+        LAYOUT_KEY_ADD(child->coords.x1 - x);
+        LAYOUT_KEY_ADD(child->coords.y1 - y);
+        LAYOUT_KEY_ADD(child->coords.x2 - x);
+        LAYOUT_KEY_ADD(child->coords.y2 - y);
+        LAYOUT_KEY_ADD(child->w_layout | (child->h_layout << 1));
+    }
+
+#undef LAYOUT_KEY_ADD
+
+    return key == 0 ? 1 : key;
+}
+#endif
+
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv)
 {
     int16_t angle = lv_obj_get_style_transform_angle(obj, 0);
@@ -30,6 +30,12 @@ typedef struct {
     void * user_data;
 } lv_layout_dsc_t;
 
+typedef struct {
+    uint32_t obj_cnt;       /**< Number of times the size and position of an object was refreshed*/
+    uint32_t calc_cnt;      /**< Number of times a layout (e.g. flex or grid) was calculated*/
+    uint32_t skip_cnt;      /**< Number of layout calculations skipped because nothing has changed since the last one*/
+} lv_layout_monitor_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -142,10 +148,19 @@ bool lv_obj_is_layout_positioned(const struct _lv_obj_t * obj);
 
 /**
  * Mark the object for layout update.
+ * The layout of the object will be calculated again even if its cached result seems up to date.
  * @param obj      pointer to an object whose children needs to be updated
  */
 void lv_obj_mark_layout_as_dirty(struct _lv_obj_t * obj);
 
+/**
+ * Mark the object for layout update but keep its cached layout.
+ * Use it if only the size or position of the object or its children might have changed
+ * as these are checked by the layout cache anyway.
+ * @param obj      pointer to an object whose children needs to be updated
+ */
+void _lv_obj_mark_layout_as_dirty_keep_cache(struct _lv_obj_t * obj);
+
 /**
  * Update the layout of an object.
  * @param obj      pointer to an object whose children needs to be updated
@@ -160,6 +175,12 @@ void lv_obj_update_layout(const struct _lv_obj_t * obj);
  */
 uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data);
 
+/**
+ * Get the statistics of the layout updates
+ * @param mon_p     pointer to a `lv_layout_monitor_t` variable to store the result
+ */
+void lv_obj_layout_monitor(lv_layout_monitor_t * mon_p);
+
 /**
  * Change the alignment of an object.
  * @param obj       pointer to an object to align
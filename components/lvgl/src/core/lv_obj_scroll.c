@@ -57,6 +57,9 @@ void lv_obj_set_scrollbar_mode(lv_obj_t * obj, lv_scrollbar_mode_t mode)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*Light objects can't scroll*/
+    if(lv_obj_is_light(obj)) return;
+
     lv_obj_allocate_spec_attr(obj);
 
     if(obj->spec_attr->scrollbar_mode == mode) return;
@@ -66,6 +69,8 @@ void lv_obj_set_scrollbar_mode(lv_obj_t * obj, lv_scrollbar_mode_t mode)
 
 void lv_obj_set_scroll_dir(lv_obj_t * obj, lv_dir_t dir)
 {
+    if(lv_obj_is_light(obj)) return;
+
     lv_obj_allocate_spec_attr(obj);
 
     if(dir != obj->spec_attr->scroll_dir) {
@@ -75,12 +80,16 @@ void lv_obj_set_scroll_dir(lv_obj_t * obj, lv_dir_t dir)
 
 void lv_obj_set_scroll_snap_x(lv_obj_t * obj, lv_scroll_snap_t align)
 {
+    if(lv_obj_is_light(obj)) return;
+
     lv_obj_allocate_spec_attr(obj);
     obj->spec_attr->scroll_snap_x = align;
 }
 
 void lv_obj_set_scroll_snap_y(lv_obj_t * obj, lv_scroll_snap_t align)
 {
+    if(lv_obj_is_light(obj)) return;
+
     lv_obj_allocate_spec_attr(obj);
     obj->spec_attr->scroll_snap_y = align;
 }
@@ -411,6 +420,7 @@ void lv_obj_scroll_to_view_recursive(lv_obj_t * obj, lv_anim_enable_t anim_en)
 lv_res_t _lv_obj_scroll_by_raw(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
 {
     if(x == 0 && y == 0) return LV_RES_OK;
+    if(lv_obj_is_light(obj)) return LV_RES_OK;
 
     lv_obj_allocate_spec_attr(obj);
 
@@ -413,6 +413,12 @@ static void obj_del_core(lv_obj_t * obj)
     }
 
     /*Free the object itself*/
+#if LV_OBJ_LIGHT_SLAB_CNT
+    if(lv_obj_is_light(obj)) {
+        _lv_obj_light_free(obj);
+        return;
+    }
+#endif
     lv_mem_free(obj);
 }
 
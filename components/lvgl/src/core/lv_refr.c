@@ -36,6 +36,7 @@ typedef struct {
     uint32_t    frame_cnt;
     uint32_t    fps_sum_cnt;
     uint32_t    fps_sum_all;
+    uint32_t    layout_calc_cnt;
 #if LV_USE_LABEL
     lv_obj_t  * perf_label;
 #endif
@@ -48,6 +49,16 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+#if LV_REFR_OCCLUSION_CULL
+typedef struct {
+    const lv_area_t * buf_area;                 /*Cull only while drawing into this buffer*/
+    lv_obj_t * objs[LV_REFR_OCCLUSION_CULL];    /*Opaque objects front to back*/
+    lv_area_t areas[LV_REFR_OCCLUSION_CULL];    /*The areas they cover*/
+    uint32_t cnt;                               /*Number of opaque objects not drawn yet*/
+    uint32_t layer_depth;                       /*Drawing into an intermediate layer*/
+} occlusion_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -62,6 +73,19 @@ static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
 static void draw_buf_flush(lv_disp_t * disp);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static inline uint32_t draw_buf_ring_cnt(lv_disp_draw_buf_t * draw_buf);
+static void draw_buf_ring_wait(lv_disp_t * disp, uint32_t max_pending);
+#if LV_DISP_DAMAGE_TILE_W
+    static inline bool damage_track_enabled(lv_disp_t * disp);
+    static uint32_t damage_hash(const lv_color_t * color_p, lv_coord_t px_cnt);
+    static bool damage_crop(lv_disp_t * disp, lv_area_t * area, lv_color_t ** color_p);
+#endif
+#if LV_REFR_OCCLUSION_CULL
+    static void occlusion_collect_area(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr);
+    static bool occlusion_collect(lv_obj_t * obj, const lv_area_t * clip_area, lv_obj_t * stop_obj);
+    static bool occlusion_trim(lv_draw_ctx_t * draw_ctx, lv_area_t * area);
+    static void occlusion_drawn(lv_obj_t * obj);
+#endif
 
 #if LV_USE_PERF_MONITOR
     static void perf_monitor_init(perf_monitor_t * perf_monitor);
@@ -84,6 +108,11 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
     static mem_monitor_t    mem_monitor;
 #endif
 
+#if LV_REFR_OCCLUSION_CULL
+    static occlusion_t occlusion;
+    static lv_refr_occlusion_stat_t occlusion_stat;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -141,23 +170,34 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     /*If the object is visible on the current clip area OR has overflow visible draw it.
      *With overflow visible drawing should happen to apply the masks which might affect children */
     bool should_draw = com_clip_res || lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    bool draw_main = false;
     if(should_draw) {
+#if LV_REFR_OCCLUSION_CULL
+        /*Leave out the parts which will be covered by opaque objects drawn later*/
+        lv_area_t clip_coords_for_main = clip_coords_for_obj;
+        draw_main = !com_clip_res || occlusion_trim(draw_ctx, &clip_coords_for_main);
+        draw_ctx->clip_area = &clip_coords_for_main;
+#else
+        draw_main = true;
         draw_ctx->clip_area = &clip_coords_for_obj;
+#endif
 
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, draw_ctx);
+        if(draw_main) {
+            lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
+            lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
+            lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, draw_ctx);
 #if LV_USE_REFR_DEBUG
-        lv_color_t debug_color = lv_color_make(lv_rand(0, 0xFF), lv_rand(0, 0xFF), lv_rand(0, 0xFF));
-        lv_draw_rect_dsc_t draw_dsc;
-        lv_draw_rect_dsc_init(&draw_dsc);
-        draw_dsc.bg_color.full = debug_color.full;
-        draw_dsc.bg_opa = LV_OPA_20;
-        draw_dsc.border_width = 1;
-        draw_dsc.border_opa = LV_OPA_30;
-        draw_dsc.border_color = debug_color;
-        lv_draw_rect(draw_ctx, &draw_dsc, &obj_coords_ext);
+            lv_color_t debug_color = lv_color_make(lv_rand(0, 0xFF), lv_rand(0, 0xFF), lv_rand(0, 0xFF));
+            lv_draw_rect_dsc_t draw_dsc;
+            lv_draw_rect_dsc_init(&draw_dsc);
+            draw_dsc.bg_color.full = debug_color.full;
+            draw_dsc.bg_opa = LV_OPA_20;
+            draw_dsc.border_width = 1;
+            draw_dsc.border_opa = LV_OPA_30;
+            draw_dsc.border_color = debug_color;
+            lv_draw_rect(draw_ctx, &draw_dsc, &obj_coords_ext);
 #endif
+        }
     }
 
     /*With overflow visible keep the previous clip area to let the children visible out of this object too
@@ -183,8 +223,9 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
         }
     }
 
-    /*If the object was visible on the clip area call the post draw events too*/
-    if(should_draw) {
+    /*If the object was visible on the clip area call the post draw events too.
+     *A culled object is covered by later objects, so it gets none of the draw events.*/
+    if(draw_main) {
         draw_ctx->clip_area = &clip_coords_for_obj;
 
         /*If all the children are redrawn make 'post draw' draw*/
@@ -235,10 +276,19 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(disp->driver->full_refresh) {
         disp->inv_areas[0] = scr_area;
         disp->inv_p = 1;
-        if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+        if(disp->refr_timer && !disp->refr_paused) lv_timer_resume(disp->refr_timer);
         return;
     }
 
+#if LV_DISP_DAMAGE_TILE_W
+    /*Invalidate whole tiles to compare whole tiles with the display's content on flush*/
+    if(damage_track_enabled(disp)) {
+        com_area.x1 -= com_area.x1 % LV_DISP_DAMAGE_TILE_W;
+        com_area.x2 += LV_DISP_DAMAGE_TILE_W - 1 - com_area.x2 % LV_DISP_DAMAGE_TILE_W;
+        if(com_area.x2 > scr_area.x2) com_area.x2 = scr_area.x2;
+    }
+#endif
+
     if(disp->driver->rounder_cb) disp->driver->rounder_cb(disp->driver, &com_area);
 
     /*Save only if this area is not in one of the saved areas*/
@@ -256,7 +306,7 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
         lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
     }
     disp->inv_p++;
-    if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+    if(disp->refr_timer && !disp->refr_paused) lv_timer_resume(disp->refr_timer);
 }
 
 /**
@@ -304,6 +354,14 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr = lv_disp_get_default();
     }
 
+#if LV_ANIM_SYNC_REFR
+    /*Update the animations right before drawing so that all of them are shown in the same frame.
+     *Keep refreshing while there are animations even if this step hasn't changed anything.*/
+    if(tmr && disp_refr == lv_disp_get_default()) {
+        if(_lv_anim_refr_frame()) lv_timer_resume(tmr);
+    }
+#endif
+
     /*Refresh the screen's layout if required*/
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
@@ -383,6 +441,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         }
     }
     else {
+        uint32_t perf_elaps = lv_tick_elaps(perf_monitor.perf_last_time);
         perf_monitor.perf_last_time = lv_tick_get();
         uint32_t fps_limit;
         uint32_t fps;
@@ -412,7 +471,14 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         perf_monitor.fps_sum_all += fps;
         perf_monitor.fps_sum_cnt ++;
         uint32_t cpu = 100 - lv_timer_get_idle();
-        lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU", fps, cpu);
+
+        /*Number of layout calculations per second*/
+        lv_layout_monitor_t layout_mon;
+        lv_obj_layout_monitor(&layout_mon);
+        uint32_t layouts = (1000 * (layout_mon.calc_cnt - perf_monitor.layout_calc_cnt)) / perf_elaps;
+        perf_monitor.layout_calc_cnt = layout_mon.calc_cnt;
+
+        lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU\n%"LV_PRIu32" layout/s", fps, cpu, layouts);
     }
 #endif
 
@@ -466,6 +532,18 @@ uint32_t lv_refr_get_fps_avg(void)
 }
 #endif
 
+#if LV_REFR_OCCLUSION_CULL
+void lv_refr_get_occlusion_stat(lv_refr_occlusion_stat_t * stat)
+{
+    *stat = occlusion_stat;
+}
+
+void lv_refr_reset_occlusion_stat(void)
+{
+    lv_memset_00(&occlusion_stat, sizeof(occlusion_stat));
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -607,6 +685,10 @@ static void refr_invalid_areas(void)
     disp_refr->driver->draw_buf->last_part = 0;
     disp_refr->rendering_in_progress = true;
 
+#if LV_LAYER_CACHE_SIZE
+    _lv_obj_layer_cache_refr_start();
+#endif
+
     for(i = 0; i < disp_refr->inv_p; i++) {
         /*Refresh the unjoined areas*/
         if(disp_refr->inv_area_joined[i] == 0) {
@@ -619,6 +701,9 @@ static void refr_invalid_areas(void)
         }
     }
 
+    /*With a draw buffer ring all bands of this refresh cycle have to be flushed before it ends*/
+    draw_buf_ring_wait(disp_refr, 0);
+
     disp_refr->rendering_in_progress = false;
 }
 
@@ -702,12 +787,20 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
 
     /* Below the `area_p` area will be redrawn into the draw buffer.
      * In single buffered mode wait here until the buffer is freed.
-     * In full double buffered mode wait here while the buffers are swapped and a buffer becomes available*/
+     * In full double buffered mode wait here while the buffers are swapped and a buffer becomes available
+     * With a draw buffer ring wait until the band rendered earlier into the current buffer is flushed*/
+    uint32_t ring_cnt = draw_buf_ring_cnt(draw_buf);
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
-    if((draw_buf->buf1 && !draw_buf->buf2) ||
+    if(ring_cnt ||
+       (draw_buf->buf1 && !draw_buf->buf2) ||
        (draw_buf->buf1 && draw_buf->buf2 && full_sized)) {
-        while(draw_buf->flushing) {
-            if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
+        if(ring_cnt) {
+            draw_buf_ring_wait(disp_refr, ring_cnt - 1);
+        }
+        else {
+            while(draw_buf->flushing) {
+                if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
+            }
         }
 
         /*If the screen is transparent initialize it when the flushing is ready*/
@@ -768,6 +861,10 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
         }
     }
 
+#if LV_REFR_OCCLUSION_CULL
+    occlusion_collect_area(draw_ctx, top_act_scr);
+#endif
+
     if(disp_refr->draw_prev_over_act) {
         if(top_act_scr == NULL) top_act_scr = disp_refr->act_scr;
         refr_obj_and_children(draw_ctx, top_act_scr);
@@ -793,6 +890,10 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
 
+#if LV_REFR_OCCLUSION_CULL
+    occlusion.buf_area = NULL;
+#endif
+
     draw_buf_flush(disp_refr);
 }
 
@@ -965,8 +1066,16 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 {
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+#if LV_REFR_OCCLUSION_CULL
+    occlusion_drawn(obj);
+#endif
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
+#if LV_LAYER_CACHE_SIZE
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_LAYER_CACHE)) {
+            if(_lv_obj_layer_cache_draw(draw_ctx, obj) == LV_RES_OK) return;
+        }
+#endif
         lv_obj_redraw(draw_ctx, obj);
     }
     else {
@@ -1023,6 +1132,9 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
             if(layer_ctx->area_act.y2 > layer_ctx->area_full.y2) layer_ctx->area_act.y2 = layer_ctx->area_full.y2;
         }
 
+#if LV_REFR_OCCLUSION_CULL
+        occlusion.layer_depth++;
+#endif
         while(layer_ctx->area_act.y1 <= layer_area_full.y2) {
             if(flags & LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE) {
                 layer_alpha_test(obj, draw_ctx, layer_ctx, flags);
@@ -1042,6 +1154,9 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
             layer_ctx->area_act.y2 = layer_ctx->area_act.y1 + layer_ctx->max_row_with_no_alpha - 1;
         }
 
+#if LV_REFR_OCCLUSION_CULL
+        occlusion.layer_depth--;
+#endif
         lv_draw_layer_destroy(draw_ctx, layer_ctx);
     }
 }
@@ -1272,10 +1387,33 @@ static void draw_buf_flush(lv_disp_t * disp)
     lv_draw_ctx_t * draw_ctx = disp->driver->draw_ctx;
     if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
 
+    lv_area_t * flush_area = draw_ctx->buf_area;
+    lv_color_t * flush_buf = draw_ctx->buf;
+
+#if LV_DISP_DAMAGE_TILE_W
+    /*Flush only the changed part of the band. If nothing changed keep rendering into the same buffer
+     *as it's not passed to `flush_cb`*/
+    lv_area_t damage_area;
+    if(damage_track_enabled(disp)) {
+        damage_area = *flush_area;
+        flush_area = &damage_area;
+        if(damage_crop(disp, flush_area, &flush_buf) == false) {
+            if(!(draw_buf->last_area && draw_buf->last_part)) return;
+
+            /*The driver still needs to know that the frame is finished (`lv_disp_flush_is_last`),
+             *so flush the first pixel of the last band. It's the same as the display's content.*/
+            damage_area.x2 = damage_area.x1;
+            damage_area.y2 = damage_area.y1;
+        }
+    }
+#endif
+
     /* In partial double buffered mode wait until the other buffer is freed
-     * and driver is ready to receive the new buffer */
+     * and driver is ready to receive the new buffer.
+     * With a draw buffer ring it was already checked before rendering this band.*/
+    uint32_t ring_cnt = draw_buf_ring_cnt(draw_buf);
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
-    if(draw_buf->buf1 && draw_buf->buf2 && !full_sized) {
+    if(ring_cnt == 0 && draw_buf->buf1 && draw_buf->buf2 && !full_sized) {
         while(draw_buf->flushing) {
             if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
         }
@@ -1291,13 +1429,25 @@ static void draw_buf_flush(lv_disp_t * disp)
     if(disp->driver->flush_cb) {
         /*Rotate the buffer to the display's native orientation if necessary*/
         if(disp->driver->rotated != LV_DISP_ROT_NONE && disp->driver->sw_rotate) {
-            draw_buf_rotate(draw_ctx->buf_area, draw_ctx->buf);
+            /*Rotation flushes the chunks serially so let the other bands of the ring be flushed first*/
+            draw_buf_ring_wait(disp, 0);
+            draw_buf_rotate(flush_area, flush_buf);
         }
         else {
-            call_flush_cb(disp->driver, draw_ctx->buf_area, draw_ctx->buf);
+            call_flush_cb(disp->driver, flush_area, flush_buf);
         }
     }
 
+#if LV_DISP_DRAW_BUF_RING_MAX
+    /*Render the next band into the next buffer of the ring*/
+    if(ring_cnt) {
+        draw_buf->ring_idx++;
+        if(draw_buf->ring_idx >= ring_cnt) draw_buf->ring_idx = 0;
+        draw_buf->buf_act = draw_buf->ring_bufs[draw_buf->ring_idx];
+        return;
+    }
+#endif
+
     /*If there are 2 buffers swap them. With direct mode swap only on the last area*/
     if(draw_buf->buf1 && draw_buf->buf2 && (!disp->driver->direct_mode || flushing_last)) {
         if(draw_buf->buf_act == draw_buf->buf1)
@@ -1319,9 +1469,322 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
         .y2 = area->y2 + drv->offset_y
     };
 
+#if LV_DISP_DRAW_BUF_RING_MAX
+    /*Count it before calling `flush_cb` as `lv_disp_flush_ready()` might be called before `flush_cb` returns*/
+    if(drv->draw_buf->ring_cnt) {
+        drv->draw_buf->ring_flush_req++;
+        if(drv->draw_buf->flushing_last) drv->draw_buf->ring_flush_last_req = drv->draw_buf->ring_flush_req;
+    }
+#endif
+
     drv->flush_cb(drv, &offset_area, color_p);
 }
 
+static inline uint32_t draw_buf_ring_cnt(lv_disp_draw_buf_t * draw_buf)
+{
+#if LV_DISP_DRAW_BUF_RING_MAX
+    return draw_buf->ring_cnt;
+#else
+    LV_UNUSED(draw_buf);
+    return 0;
+#endif
+}
+
+/**
+ * Wait until at most `max_pending` bands of the draw buffer ring are waiting for flushing.
+ * Does nothing if the draw buffer ring is not used.
+ * @param disp          pointer to a display
+ * @param max_pending   0: wait until all the bands are flushed
+ */
+static void draw_buf_ring_wait(lv_disp_t * disp, uint32_t max_pending)
+{
+#if LV_DISP_DRAW_BUF_RING_MAX
+    lv_disp_draw_buf_t * draw_buf = disp->driver->draw_buf;
+    if(draw_buf->ring_cnt == 0) return;
+
+    /*The counters are written from different sides so the difference is correct even on overflow*/
+    while(draw_buf->ring_flush_req - draw_buf->ring_flush_done > max_pending) {
+        if(disp->driver->wait_cb) disp->driver->wait_cb(disp->driver);
+    }
+#else
+    LV_UNUSED(disp);
+    LV_UNUSED(max_pending);
+#endif
+}
+
+#if LV_DISP_DAMAGE_TILE_W
+static inline bool damage_track_enabled(lv_disp_t * disp)
+{
+    lv_disp_drv_t * drv = disp->driver;
+    return drv->damage_track && !drv->full_refresh && !drv->direct_mode && !drv->screen_transp && !drv->set_px_cb;
+}
+
+static uint32_t damage_hash(const lv_color_t * color_p, lv_coord_t px_cnt)
+{
+    /*FNV-1a on the pixels*/
+    uint32_t hash = 2166136261UL;
+    lv_coord_t i;
+    for(i = 0; i < px_cnt; i++) {
+        hash ^= (uint32_t)color_p[i].full;
+        hash *= 16777619UL;
+    }
+
+    /*0 is reserved for unknown tiles*/
+    return hash ? hash : 1;
+}
+
+/**
+ * Compare the tile rows of a rendered band with the hashes of the last flushed content
+ * and crop the band to the changed tiles. The cropped band is moved to the beginning of the buffer.
+ * @param disp      pointer to the display
+ * @param area      area of the band. Cropped to the changed part.
+ * @param color_p   pointer to the rendered pixels of the band. Set to the cropped band.
+ * @return          false: nothing changed, the band doesn't need to be flushed
+ */
+static bool damage_crop(lv_disp_t * disp, lv_area_t * area, lv_color_t ** color_p)
+{
+    lv_coord_t hor_res = lv_disp_get_hor_res(disp);
+    lv_coord_t ver_res = lv_disp_get_ver_res(disp);
+    uint32_t tile_cnt_hor = (hor_res + LV_DISP_DAMAGE_TILE_W - 1) / LV_DISP_DAMAGE_TILE_W;
+    if(area->x1 < 0 || area->y1 < 0 || area->x2 >= hor_res || area->y2 >= ver_res) return true;
+
+    if(disp->damage_hashes == NULL) {
+        disp->damage_hashes = lv_mem_alloc(tile_cnt_hor * ver_res * sizeof(uint32_t));
+        if(disp->damage_hashes == NULL) {
+            LV_LOG_WARN("couldn't allocate the tile hashes, flushing the bands without cropping");
+            return true;
+        }
+        lv_memset_00(disp->damage_hashes, tile_cnt_hor * ver_res * sizeof(uint32_t));
+    }
+
+    lv_coord_t w = lv_area_get_width(area);
+    lv_area_t changed;
+    changed.x1 = LV_COORD_MAX;
+    changed.y1 = LV_COORD_MAX;
+    changed.x2 = LV_COORD_MIN;
+    changed.y2 = LV_COORD_MIN;
+
+    const lv_color_t * row_p = *color_p;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        uint32_t * hashes = &disp->damage_hashes[y * tile_cnt_hor];
+        lv_coord_t x = area->x1;
+        while(x <= area->x2) {
+            uint32_t tile_id = x / LV_DISP_DAMAGE_TILE_W;
+            lv_coord_t tile_x1 = tile_id * LV_DISP_DAMAGE_TILE_W;
+            lv_coord_t tile_x2 = LV_MIN(tile_x1 + LV_DISP_DAMAGE_TILE_W - 1, hor_res - 1);
+            lv_coord_t seg_x2 = LV_MIN(tile_x2, area->x2);
+
+            /*Only whole tiles can be compared. The hash of a partially flushed tile is unknown.*/
+            uint32_t hash = 0;
+            if(x == tile_x1 && seg_x2 == tile_x2) hash = damage_hash(&row_p[x - area->x1], seg_x2 - x + 1);
+
+            if(hash == 0 || hash != hashes[tile_id]) {
+                changed.x1 = LV_MIN(changed.x1, x);
+                changed.x2 = LV_MAX(changed.x2, seg_x2);
+                changed.y1 = LV_MIN(changed.y1, y);
+                changed.y2 = y;
+            }
+
+            hashes[tile_id] = hash;
+            x = seg_x2 + 1;
+        }
+        row_p += w;
+    }
+
+    disp->damage_px_rendered += lv_area_get_size(area);
+    if(changed.x1 > changed.x2) return false;
+    disp->damage_px_flushed += lv_area_get_size(&changed);
+
+    /*Move the changed part to the beginning of the buffer row by row*/
+    lv_coord_t changed_w = lv_area_get_width(&changed);
+    lv_color_t * src = *color_p + (changed.y1 - area->y1) * w + (changed.x1 - area->x1);
+    if(changed_w == w) {
+        /*Only the rows are cropped, the remaining rows are continuous*/
+        *color_p = src;
+    }
+    else {
+        /*The destination is never after the source so it can be copied forward*/
+        lv_color_t * dest = *color_p;
+        for(y = changed.y1; y <= changed.y2; y++) {
+            lv_coord_t i;
+            for(i = 0; i < changed_w; i++) dest[i] = src[i];
+            dest += changed_w;
+            src += w;
+        }
+    }
+
+    *area = changed;
+    return true;
+}
+#endif
+
+#if LV_REFR_OCCLUSION_CULL
+/**
+ * Collect the opaque objects of the area being refreshed front to back
+ * @param draw_ctx      the draw context with the area being refreshed
+ * @param top_act_scr   the object from which the active screen is drawn (NULL: the whole screen)
+ */
+static void occlusion_collect_area(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr)
+{
+    occlusion.cnt = 0;
+    occlusion.layer_depth = 0;
+    occlusion.buf_area = draw_ctx->buf_area;
+    occlusion_stat.area_px += lv_area_get_size(draw_ctx->clip_area);
+
+    /*During screen load animations the previous screen is also drawn. Keep it simple and don't cull then.*/
+    if(disp_refr->prev_scr) return;
+
+    /*Go in the opposite order of the drawing*/
+    if(occlusion_collect(lv_disp_get_layer_sys(disp_refr), draw_ctx->clip_area, NULL)) return;
+    if(occlusion_collect(lv_disp_get_layer_top(disp_refr), draw_ctx->clip_area, NULL)) return;
+
+    /*If the first drawn object wasn't found the objects before it might have been collected*/
+    bool reached = occlusion_collect(lv_disp_get_scr_act(disp_refr), draw_ctx->clip_area, top_act_scr);
+    if(!reached && top_act_scr) occlusion.cnt = 0;
+}
+
+/**
+ * Collect the opaque objects from an object and its children, front to back.
+ * @param obj           the object to check
+ * @param clip_area     the object is visible only here
+ * @param stop_obj      the drawing starts with this object. Stop when reached.
+ * @return              true: `stop_obj` was reached or there is no more space; don't continue.
+ */
+static bool occlusion_collect(lv_obj_t * obj, const lv_area_t * clip_area, lv_obj_t * stop_obj)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
+
+    /*Layers are drawn separately (and maybe transformed) so don't look into them*/
+    if(_lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return false;
+
+    lv_area_t obj_area;
+    bool visible = _lv_area_intersect(&obj_area, clip_area, &obj->coords);
+
+    /*With rounded corners only a band can be covered. Use the full height band of wide objects
+     *and the full width band of tall ones.*/
+    lv_area_t cover_area = obj->coords;
+    lv_coord_t r = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    if(r > 0) {
+        lv_coord_t w = lv_obj_get_width(obj);
+        lv_coord_t h = lv_obj_get_height(obj);
+        r = LV_MIN(r, LV_MIN(w, h)) + 1;
+        if(w > h) lv_area_increase(&cover_area, -r, 0);
+        else lv_area_increase(&cover_area, 0, -r);
+    }
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_NOT_COVER;
+    if(visible) {
+        info.res = LV_COVER_RES_COVER;
+        info.area = &cover_area;
+        /*Also tells if the children are masked, e.g. clipped to the rounded corners*/
+        if(!_lv_area_intersect(&cover_area, &cover_area, &obj_area)) info.area = &obj_area;
+        lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+        if(info.res == LV_COVER_RES_MASKED) return false;
+    }
+
+    const lv_area_t * clip_area_children;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) clip_area_children = clip_area;
+    else if(visible) clip_area_children = &obj_area;
+    else return false;
+
+    int32_t child_cnt = lv_obj_get_child_cnt(obj);
+#if LV_LAYER_CACHE_SIZE
+    /*The children of a cached layer are not drawn one by one if the cache is valid,
+     *unless the drawing starts inside it*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_LAYER_CACHE)) {
+        lv_obj_t * stop_parent = stop_obj;
+        while(stop_parent && stop_parent != obj) stop_parent = lv_obj_get_parent(stop_parent);
+        if(stop_parent == NULL) child_cnt = 0;
+    }
+#endif
+
+    int32_t i;
+    for(i = child_cnt - 1; i >= 0; i--) {
+        if(occlusion_collect(obj->spec_attr->children[i], clip_area_children, stop_obj)) return true;
+    }
+
+    /*Nothing is drawn before `stop_obj` so it can't cover anything*/
+    if(obj == stop_obj) return true;
+
+    if(info.res == LV_COVER_RES_COVER) {
+        occlusion.objs[occlusion.cnt] = obj;
+        occlusion.areas[occlusion.cnt] = *info.area;
+        occlusion.cnt++;
+        occlusion_stat.occluder_cnt++;
+        if(occlusion.cnt >= LV_REFR_OCCLUSION_CULL) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Remove the parts of an area which will be covered by the opaque objects drawn later.
+ * Only whole rows or columns are removed to keep the area a rectangle.
+ * @param draw_ctx      the current draw context
+ * @param area          the area to draw an object on. Updated with the remaining part.
+ * @return              false: the area is fully covered, nothing needs to be drawn
+ */
+static bool occlusion_trim(lv_draw_ctx_t * draw_ctx, lv_area_t * area)
+{
+    if(draw_ctx->buf_area != occlusion.buf_area || occlusion.layer_depth) return true;
+
+    uint32_t size_ori = lv_area_get_size(area);
+    bool trimmed;
+    do {
+        trimmed = false;
+        uint32_t i;
+        for(i = 0; i < occlusion.cnt; i++) {
+            const lv_area_t * occ = &occlusion.areas[i];
+            if(_lv_area_is_on(area, occ) == false) continue;
+
+            bool cover_x = occ->x1 <= area->x1 && occ->x2 >= area->x2;
+            bool cover_y = occ->y1 <= area->y1 && occ->y2 >= area->y2;
+            if(cover_x && cover_y) {
+                occlusion_stat.culled_px += size_ori;
+                occlusion_stat.culled_cnt++;
+                return false;
+            }
+
+            if(cover_x) {
+                if(occ->y1 <= area->y1) area->y1 = occ->y2 + 1;
+                else if(occ->y2 >= area->y2) area->y2 = occ->y1 - 1;
+                else continue;
+                trimmed = true;
+            }
+            else if(cover_y) {
+                if(occ->x1 <= area->x1) area->x1 = occ->x2 + 1;
+                else if(occ->x2 >= area->x2) area->x2 = occ->x1 - 1;
+                else continue;
+                trimmed = true;
+            }
+        }
+    } while(trimmed);
+
+    uint32_t size = lv_area_get_size(area);
+    occlusion_stat.culled_px += size_ori - size;
+    occlusion_stat.drawn_px += size;
+    return true;
+}
+
+/**
+ * Called when an object is being drawn. The opaque objects behind it
+ * (and itself) can't cover the objects drawn from now.
+ * @param obj           the object being drawn
+ */
+static void occlusion_drawn(lv_obj_t * obj)
+{
+    uint32_t i;
+    for(i = 0; i < occlusion.cnt; i++) {
+        if(occlusion.objs[i] == obj) {
+            occlusion.cnt = i;
+            break;
+        }
+    }
+}
+#endif
+
 #if LV_USE_PERF_MONITOR
 static void perf_monitor_init(perf_monitor_t * _perf_monitor)
 {
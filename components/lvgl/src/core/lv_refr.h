@@ -26,6 +26,17 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_REFR_OCCLUSION_CULL
+/** Counters of the occlusion culling*/
+typedef struct {
+    uint32_t area_px;             /**< Pixels of the refreshed areas*/
+    uint32_t drawn_px;            /**< Pixels where objects were drawn. `drawn_px / area_px` is the overdraw*/
+    uint32_t culled_px;           /**< Pixels not drawn because opaque objects were drawn there later*/
+    uint32_t culled_cnt;          /**< Objects not drawn at all because they were fully covered*/
+    uint32_t occluder_cnt;        /**< Opaque objects found in front of the others*/
+} lv_refr_occlusion_stat_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -98,6 +109,19 @@ void lv_refr_reset_fps_counter(void);
 uint32_t lv_refr_get_fps_avg(void);
 #endif
 
+#if LV_REFR_OCCLUSION_CULL
+/**
+ * Get the counters of the occlusion culling since the last `lv_refr_reset_occlusion_stat()`
+ * @param stat      store the counters here
+ */
+void lv_refr_get_occlusion_stat(lv_refr_occlusion_stat_t * stat);
+
+/**
+ * Reset the counters of the occlusion culling
+ */
+void lv_refr_reset_occlusion_stat(void);
+#endif
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
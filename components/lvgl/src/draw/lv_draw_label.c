@@ -34,6 +34,10 @@ typedef uint8_t cmd_state_t;
  *  STATIC PROTOTYPES
  **********************/
 
+static uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const char * txt, uint32_t line_id,
+                             uint32_t line_start, lv_coord_t max_w);
+static lv_coord_t get_line_width(const lv_draw_label_dsc_t * dsc, const char * txt, uint32_t line_id,
+                                 uint32_t line_start, uint32_t line_end);
 static uint8_t hex_char_to_num(char hex);
 
 /**********************
@@ -106,7 +110,10 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
     lv_bidi_calculate_align(&align, &base_dir, txt);
 
-    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
+    /*The hint is not required if the lines are already known*/
+    if(dsc->lines) hint = NULL;
+
+    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0 || dsc->lines) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
@@ -151,13 +158,15 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+    uint32_t line_id = 0;
+    uint32_t line_end = get_line_end(dsc, txt, line_id, line_start, w);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_id++;
+        line_end = get_line_end(dsc, txt, line_id, line_start, w);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -172,14 +181,14 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(dsc, txt, line_id, line_start, line_end);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(dsc, txt, line_id, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
     uint32_t sel_start = dsc->sel_start;
@@ -334,21 +343,20 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_id++;
+        line_end = get_line_end(dsc, txt, line_id, line_start, w);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, txt, line_id, line_start, line_end);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, txt, line_id, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -371,6 +379,43 @@ void lv_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the end of a line from the lines measured in advance or by measuring it now
+ * @param dsc           pointer to the draw descriptor
+ * @param txt           the text to draw
+ * @param line_id       index of the line
+ * @param line_start    byte index of the first character of the line
+ * @param max_w         max width of the lines
+ * @return              byte index of the first character of the next line
+ */
+static uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const char * txt, uint32_t line_id,
+                             uint32_t line_start, lv_coord_t max_w)
+{
+    if(dsc->lines) {
+        /*After the last line `line_start` is already at the end of the text*/
+        return line_id < dsc->line_cnt ? dsc->lines[line_id].end : line_start;
+    }
+
+    return line_start + _lv_txt_get_next_line(&txt[line_start], dsc->font, dsc->letter_space, max_w, NULL, dsc->flag);
+}
+
+/**
+ * Get the width of a line from the lines measured in advance or by measuring it now
+ * @param dsc           pointer to the draw descriptor
+ * @param txt           the text to draw
+ * @param line_id       index of the line
+ * @param line_start    byte index of the first character of the line
+ * @param line_end      byte index of the first character of the next line
+ * @return              width of the line
+ */
+static lv_coord_t get_line_width(const lv_draw_label_dsc_t * dsc, const char * txt, uint32_t line_id,
+                                 uint32_t line_start, uint32_t line_end)
+{
+    if(dsc->lines) return line_id < dsc->line_cnt ? dsc->lines[line_id].width : 0;
+
+    return lv_txt_get_width(&txt[line_start], line_end - line_start, dsc->font, dsc->letter_space, dsc->flag);
+}
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
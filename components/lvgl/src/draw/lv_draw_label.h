@@ -27,8 +27,17 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** The end and width of a line of a text measured in advance*/
+typedef struct {
+    uint32_t end;           /**< Byte index of the first character of the next line*/
+    lv_coord_t width;       /**< Width of the line in pixels*/
+} lv_draw_label_line_t;
+
 typedef struct {
     const lv_font_t * font;
+    const lv_draw_label_line_t * lines; /**< The lines of the text measured with the same width, font and flags.
+                                             NULL: measure the lines while drawing*/
+    uint32_t line_cnt;
     uint32_t sel_start;
     uint32_t sel_end;
     lv_color_t color;
@@ -58,6 +58,8 @@ static void circ_next(lv_point_t * c, lv_coord_t * tmp);
 static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radius);
 static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t y, lv_coord_t * len,
                                 lv_coord_t * x_start);
+static lv_draw_mask_res_t get_radius_span(const lv_draw_mask_radius_param_t * p, lv_coord_t abs_y,
+                                          lv_draw_mask_span_t * span);
 static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
 
 /**********************
@@ -163,6 +165,65 @@ lv_draw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_apply_ids(lv_opa_t * mask_
     return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
 }
 
+/**
+ * Get which part of a line is transparent, fully covered or partially covered by the added masks.
+ * The fully covered part can be blended without mask, `lv_draw_mask_apply` is required only on the partial parts.
+ * Masks which can't tell their coverage (all except the not inverted radius masks) make the visible part partial.
+ * @param abs_x absolute X coordinate where the line to check start
+ * @param abs_y absolute Y coordinate of the line
+ * @param len length of the line to check (in pixel count)
+ * @param span store the coverage here. Its coordinates are limited to the given line.
+ * @return One of these values:
+ * - `LV_DRAW_MASK_RES_FULL_TRANSP`: the whole line is transparent. `span` is not set
+ * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully covered
+ * - `LV_DRAW_MASK_RES_CHANGED`: `span` tells which part of the line needs a mask
+ */
+lv_draw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_get_span(lv_coord_t abs_x, lv_coord_t abs_y,
+                                                               lv_coord_t len, lv_draw_mask_span_t * span)
+{
+    span->x1 = abs_x;
+    span->x2 = abs_x + len - 1;
+    span->opa_x1 = span->x1;
+    span->opa_x2 = span->x2;
+
+    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+
+    /*The pixels are transparent if any mask makes them transparent
+     *and fully covered only if all masks cover them, so intersect the spans of the masks*/
+    while(m->param) {
+        _lv_draw_mask_common_dsc_t * dsc = m->param;
+        lv_draw_mask_span_t mask_span;
+        lv_draw_mask_res_t res = LV_DRAW_MASK_RES_UNKNOWN;
+        if(dsc->type == LV_DRAW_MASK_TYPE_RADIUS) res = get_radius_span(m->param, abs_y, &mask_span);
+
+        if(res == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
+        else if(res == LV_DRAW_MASK_RES_CHANGED) {
+            span->x1 = LV_MAX(span->x1, mask_span.x1);
+            span->x2 = LV_MIN(span->x2, mask_span.x2);
+            span->opa_x1 = LV_MAX(span->opa_x1, mask_span.opa_x1);
+            span->opa_x2 = LV_MIN(span->opa_x2, mask_span.opa_x2);
+        }
+        else if(res == LV_DRAW_MASK_RES_UNKNOWN) {
+            span->opa_x1 = LV_COORD_MAX;
+            span->opa_x2 = LV_COORD_MIN;
+        }
+
+        m++;
+    }
+
+    if(span->x1 > span->x2) return LV_DRAW_MASK_RES_TRANSP;
+
+    span->opa_x1 = LV_MAX(span->opa_x1, span->x1);
+    span->opa_x2 = LV_MIN(span->opa_x2, span->x2);
+    if(span->opa_x1 > span->opa_x2) {
+        span->opa_x1 = span->x2 + 1;
+        span->opa_x2 = span->x2;
+    }
+
+    if(span->opa_x1 == abs_x && span->opa_x2 == abs_x + len - 1) return LV_DRAW_MASK_RES_FULL_COVER;
+    else return LV_DRAW_MASK_RES_CHANGED;
+}
+
 /**
  * Remove a mask with a given ID
  * @param id the ID of the mask.  Returned by `lv_draw_mask_add`
@@ -1165,6 +1226,45 @@ static lv_draw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_radius(lv_opa_t * m
     return LV_DRAW_MASK_RES_CHANGED;
 }
 
+/**
+ * Get the coverage of a radius mask on a line from the same circle data `lv_draw_mask_radius` uses.
+ * @return `LV_DRAW_MASK_RES_TRANSP`, `LV_DRAW_MASK_RES_CHANGED` with the set `span`
+ *         or `LV_DRAW_MASK_RES_UNKNOWN` for inverted masks
+ */
+static lv_draw_mask_res_t get_radius_span(const lv_draw_mask_radius_param_t * p, lv_coord_t abs_y,
+                                          lv_draw_mask_span_t * span)
+{
+    /*The not covered middle of an inverted mask can't be described with one span*/
+    if(p->cfg.outer) return LV_DRAW_MASK_RES_UNKNOWN;
+
+    const lv_area_t * rect = &p->cfg.rect;
+    if(abs_y < rect->y1 || abs_y > rect->y2) return LV_DRAW_MASK_RES_TRANSP;
+
+    int32_t radius = p->cfg.radius;
+    if(abs_y >= rect->y1 + radius && abs_y <= rect->y2 - radius) {
+        span->x1 = rect->x1;
+        span->x2 = rect->x2;
+        span->opa_x1 = rect->x1;
+        span->opa_x2 = rect->x2;
+        return LV_DRAW_MASK_RES_CHANGED;
+    }
+
+    int32_t y = abs_y - rect->y1;
+    lv_coord_t cir_y;
+    if(y < radius) cir_y = radius - y - 1;
+    else cir_y = y - (lv_area_get_height(rect) - radius);
+
+    /*The anti-aliased pixels are right before and after the fully covered part*/
+    lv_coord_t aa_len;
+    lv_coord_t x_start;
+    get_next_line(p->circle, cir_y, &aa_len, &x_start);
+    span->opa_x1 = rect->x1 + radius - x_start;
+    span->opa_x2 = rect->x2 - radius + x_start;
+    span->x1 = span->opa_x1 - aa_len;
+    span->x2 = span->opa_x2 + aa_len;
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+
 static lv_draw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_fade(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                   lv_coord_t abs_y, lv_coord_t len,
                                                                   lv_draw_mask_fade_param_t * p)
@@ -210,6 +210,18 @@ typedef struct {
     } cfg;
 } lv_draw_mask_polygon_param_t;
 
+/**
+ * Coverage of the added masks on a line.
+ * The pixels out of `[x1, x2]` are transparent, the pixels in `[opa_x1, opa_x2]` are fully covered
+ * and only the pixels in `[x1, opa_x1 - 1]` and `[opa_x2 + 1, x2]` need the per-pixel mask.
+ */
+typedef struct {
+    lv_coord_t x1;          /*First visible pixel*/
+    lv_coord_t x2;          /*Last visible pixel*/
+    lv_coord_t opa_x1;      /*First fully covered pixel. `opa_x1 == x2 + 1` if there is no such pixel*/
+    lv_coord_t opa_x2;      /*Last fully covered pixel. `opa_x2 == x2` if there is no such pixel*/
+} lv_draw_mask_span_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -255,6 +267,22 @@ lv_draw_mask_res_t /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_mask_apply_ids(lv_opa_t *
                                                                       lv_coord_t abs_y, lv_coord_t len,
                                                                       const int16_t * ids, int16_t ids_count);
 
+/**
+ * Get which part of a line is transparent, fully covered or partially covered by the added masks.
+ * The fully covered part can be blended without mask, `lv_draw_mask_apply` is required only on the partial parts.
+ * Masks which can't tell their coverage (all except the not inverted radius masks) make the visible part partial.
+ * @param abs_x absolute X coordinate where the line to check start
+ * @param abs_y absolute Y coordinate of the line
+ * @param len length of the line to check (in pixel count)
+ * @param span store the coverage here. Its coordinates are limited to the given line.
+ * @return One of these values:
+ * - `LV_DRAW_MASK_RES_FULL_TRANSP`: the whole line is transparent. `span` is not set
+ * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully covered
+ * - `LV_DRAW_MASK_RES_CHANGED`: `span` tells which part of the line needs a mask
+ */
+lv_draw_mask_res_t /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_mask_get_span(lv_coord_t abs_x, lv_coord_t abs_y,
+                                                                     lv_coord_t len, lv_draw_mask_span_t * span);
+
 //! @endcond
 
 /**
@@ -43,6 +43,17 @@ typedef struct {
     uint32_t has_alpha : 1;
 } lv_draw_sw_layer_ctx_t;
 
+/** Counters of the arc coverage cache*/
+typedef struct {
+    uint32_t hit_cnt;             /**< The arc was blended from the cached coverage*/
+    uint32_t miss_cnt;            /**< The arc was not in the cache yet or its coverage was computed now*/
+    uint32_t evict_cnt;           /**< An arc was removed from the cache to make space for a new one*/
+    uint32_t not_cached_cnt;      /**< The arc couldn't be cached (e.g. other masks were active or it was too large)*/
+    uint32_t item_cnt;            /**< Number of arcs in the cache now*/
+    size_t   used_size;           /**< Bytes used in the cache now*/
+    size_t   cache_size;          /**< Size of the cache in bytes*/
+} lv_draw_sw_arc_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -55,6 +66,22 @@ void lv_draw_sw_wait_for_finish(lv_draw_ctx_t * draw_ctx);
 void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center, uint16_t radius,
                     uint16_t start_angle, uint16_t end_angle);
 
+/**
+ * Get the counters of the arc coverage cache. All zero if `LV_ARC_CACHE_SIZE` is 0.
+ * @param stat store the counters here
+ */
+void lv_draw_sw_arc_get_cache_stat(lv_draw_sw_arc_cache_stat_t * stat);
+
+/**
+ * Reset the hit, miss, evict and not cached counters of the arc coverage cache.
+ */
+void lv_draw_sw_arc_reset_cache_stat(void);
+
+/**
+ * Free all the arcs saved in the arc coverage cache.
+ */
+void lv_draw_sw_arc_free_cache(void);
+
 void lv_draw_sw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 
 void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
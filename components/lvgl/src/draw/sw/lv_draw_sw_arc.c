@@ -10,6 +10,7 @@
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_log.h"
 #include "../../misc/lv_mem.h"
+#include "../../misc/lv_gc.h"
 #include "../lv_draw.h"
 
 /*********************
@@ -18,6 +19,22 @@
 #define SPLIT_RADIUS_LIMIT 10  /*With radius greater than this the arc will drawn in quarters. A quarter is drawn only if there is arc in it*/
 #define SPLIT_ANGLE_GAP_LIMIT 60  /*With small gaps in the arc don't bother with splitting because there is nothing to skip.*/
 
+#if LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE
+#define arc_cache_mem LV_GC_ROOT(_lv_arc_cache_mem)
+
+#if defined(LV_ARCH_64)
+    #define ALIGN(X)    (((X) + 7) & ~7)
+#else
+    #define ALIGN(X)    (((X) + 3) & ~3)
+#endif
+
+#define ARC_CACHE_PART_CNT      3       /*The arc and its two rounded ends*/
+#define ARC_CACHE_AREA_MAX      8       /*The arc is drawn in max. 2 areas per quarter*/
+#define ARC_CACHE_COVER_MIN     16      /*Shorter fully covered runs are stored as coverage bytes*/
+#define ARC_CACHE_COVER_FLAG    0x8000  /*The segment is fully covered, no coverage bytes follow it*/
+#define ARC_CACHE_ROW_END       0xFFFF
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -32,8 +49,49 @@ typedef struct {
     lv_draw_rect_dsc_t * draw_dsc;
     const lv_area_t * draw_area;
     lv_draw_ctx_t * draw_ctx;
+#if LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE
+    lv_area_t * areas;          /*If not NULL only collect the areas to draw instead of drawing*/
+    uint32_t area_cnt;
+#endif
 } quarter_draw_dsc_t;
 
+#if LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE
+typedef enum {
+    ARC_CACHE_STATE_SEEN,       /*Drawn once, the coverage is not computed yet*/
+    ARC_CACHE_STATE_READY,      /*The coverage is in `parts`*/
+    ARC_CACHE_STATE_SKIP,       /*Can't be cached, draw it without the cache*/
+} arc_cache_state_t;
+
+typedef struct {
+    uint16_t radius;
+    uint16_t width;
+    uint16_t start_angle;
+    uint16_t end_angle;
+    lv_opa_t opa;
+    uint8_t rounded;
+} arc_cache_key_t;
+
+/**
+ * The coverage of an area in rows. The data starts with the offset of each row (`uint32_t`) followed by the rows.
+ * A row is a list of `uint16_t` segments: X offset, length (with `ARC_CACHE_COVER_FLAG` for fully covered segments)
+ * and the coverage bytes padded to 2 bytes. `ARC_CACHE_ROW_END` closes the row.
+ */
+typedef struct {
+    lv_area_t area;             /*Relative to the center of the arc*/
+    uint32_t ofs;               /*Offset of the data from the start of the entry*/
+    uint32_t size;
+} arc_cache_part_t;
+
+/*The entries are stored after each other in the cache memory, each followed by the data of its parts*/
+typedef struct {
+    arc_cache_key_t key;
+    arc_cache_state_t state;
+    uint32_t life;              /*The value of `arc_cache_tick` when the entry was used the last time*/
+    uint32_t size;              /*Size of the entry with its data*/
+    arc_cache_part_t parts[ARC_CACHE_PART_CNT];
+} arc_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -42,12 +100,35 @@ typedef struct {
     static void draw_quarter_1(quarter_draw_dsc_t * q);
     static void draw_quarter_2(quarter_draw_dsc_t * q);
     static void draw_quarter_3(quarter_draw_dsc_t * q);
+    static void draw_quarter_area(quarter_draw_dsc_t * q, lv_area_t * quarter_area, const lv_area_t * clip_area_ori);
     static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area);
 #endif /*LV_DRAW_COMPLEX*/
 
+#if LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE
+    static lv_res_t arc_cache_draw(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                                   uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+    static arc_cache_entry_t * arc_cache_next(arc_cache_entry_t * entry);
+    static arc_cache_entry_t * arc_cache_find(const arc_cache_key_t * key);
+    static arc_cache_entry_t * arc_cache_add(const arc_cache_key_t * key, arc_cache_state_t state, uint32_t size);
+    static void arc_cache_remove(arc_cache_entry_t * entry);
+    static lv_res_t arc_cache_generate(lv_draw_ctx_t * draw_ctx, const arc_cache_key_t * key, const lv_point_t * center,
+                                       arc_cache_part_t * parts, uint8_t ** data);
+    static lv_res_t part_generate(arc_cache_part_t * part, uint8_t ** data, const lv_area_t * area,
+                                  const lv_area_t * regions, uint32_t region_cnt, const lv_point_t * center, const int16_t * ids, int16_t id_cnt,
+                                  lv_opa_t opa);
+    static uint32_t row_encode(uint8_t * dest, const lv_opa_t * mask_buf, lv_coord_t len);
+    static void part_draw(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc, const arc_cache_part_t * part,
+                          const uint8_t * data, const lv_point_t * center);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE
+    static uint8_t * arc_cache_end;
+    static uint32_t arc_cache_tick;
+    static lv_draw_sw_arc_cache_stat_t arc_cache_stat;
+#endif
 
 /**********************
  *      MACROS
@@ -94,6 +175,12 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
     area_in.x2 -= dsc->width;
     area_in.y2 -= dsc->width;
 
+#if LV_ARC_CACHE_SIZE
+    if(dsc->img_src == NULL && start_angle + 360 != end_angle && start_angle != end_angle + 360) {
+        if(arc_cache_draw(draw_ctx, dsc, center, radius, start_angle, end_angle) == LV_RES_OK) return;
+    }
+#endif
+
     /*Create inner the mask*/
     int16_t mask_in_id = LV_MASK_ID_INV;
     lv_draw_mask_radius_param_t mask_in_param;
@@ -154,6 +241,9 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
         q_dsc.draw_dsc = &cir_dsc;
         q_dsc.draw_area = &area_out;
         q_dsc.draw_ctx = draw_ctx;
+#if LV_ARC_CACHE_SIZE
+        q_dsc.areas = NULL;
+#endif
 
         draw_quarter_0(&q_dsc);
         draw_quarter_1(&q_dsc);
@@ -222,6 +312,38 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
 #endif /*LV_DRAW_COMPLEX*/
 }
 
+void lv_draw_sw_arc_get_cache_stat(lv_draw_sw_arc_cache_stat_t * stat)
+{
+#if LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE
+    *stat = arc_cache_stat;
+    stat->item_cnt = 0;
+    arc_cache_entry_t * entry = arc_cache_next(NULL);
+    while(entry) {
+        stat->item_cnt++;
+        entry = arc_cache_next(entry);
+    }
+    stat->used_size = arc_cache_mem ? (size_t)(arc_cache_end - arc_cache_mem) : 0;
+    stat->cache_size = LV_ARC_CACHE_SIZE;
+#else
+    lv_memset_00(stat, sizeof(lv_draw_sw_arc_cache_stat_t));
+#endif
+}
+
+void lv_draw_sw_arc_reset_cache_stat(void)
+{
+#if LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE
+    lv_memset_00(&arc_cache_stat, sizeof(arc_cache_stat));
+#endif
+}
+
+void lv_draw_sw_arc_free_cache(void)
+{
+#if LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE
+    lv_mem_free(arc_cache_mem);
+    arc_cache_mem = arc_cache_end = NULL;
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -240,11 +362,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
         quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->end_angle) * q->radius) >> LV_TRIGO_SHIFT);
         quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
+        draw_quarter_area(q, &quarter_area, clip_area_ori);
     }
     else if(q->start_quarter == 0 || q->end_quarter == 0) {
         /*Start and/or end arcs here*/
@@ -255,11 +373,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
             quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
             quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
+            draw_quarter_area(q, &quarter_area, clip_area_ori);
         }
         if(q->end_quarter == 0) {
             quarter_area.x2 = q->center->x + q->radius;
@@ -268,11 +382,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
             quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->end_angle) * q->radius) >> LV_TRIGO_SHIFT);
             quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
+            draw_quarter_area(q, &quarter_area, clip_area_ori);
         }
     }
     else if((q->start_quarter == q->end_quarter && q->start_quarter != 0 && q->end_angle < q->start_angle) ||
@@ -285,11 +395,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
         quarter_area.x2 = q->center->x + q->radius;
         quarter_area.y2 = q->center->y + q->radius;
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
+        draw_quarter_area(q, &quarter_area, clip_area_ori);
     }
     q->draw_ctx->clip_area = clip_area_ori;
 }
@@ -307,11 +413,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
         quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
         quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
+        draw_quarter_area(q, &quarter_area, clip_area_ori);
     }
     else if(q->start_quarter == 1 || q->end_quarter == 1) {
         /*Start and/or end arcs here*/
@@ -322,11 +424,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
             quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
             quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
+            draw_quarter_area(q, &quarter_area, clip_area_ori);
         }
         if(q->end_quarter == 1) {
             quarter_area.x2 = q->center->x - 1;
@@ -335,11 +433,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
             quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
             quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
+            draw_quarter_area(q, &quarter_area, clip_area_ori);
         }
     }
     else if((q->start_quarter == q->end_quarter && q->start_quarter != 1 && q->end_angle < q->start_angle) ||
@@ -352,11 +446,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
         quarter_area.x2 = q->center->x - 1;
         quarter_area.y2 = q->center->y + q->radius;
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
+        draw_quarter_area(q, &quarter_area, clip_area_ori);
     }
     q->draw_ctx->clip_area = clip_area_ori;
 }
@@ -374,11 +464,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
         quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->end_angle) * q->radius) >> LV_TRIGO_SHIFT);
         quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
+        draw_quarter_area(q, &quarter_area, clip_area_ori);
     }
     else if(q->start_quarter == 2 || q->end_quarter == 2) {
         /*Start and/or end arcs here*/
@@ -389,11 +475,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
             quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
             quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
+            draw_quarter_area(q, &quarter_area, clip_area_ori);
         }
         if(q->end_quarter == 2) {
             quarter_area.x1 = q->center->x - q->radius;
@@ -402,11 +484,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
             quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
             quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->end_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
+            draw_quarter_area(q, &quarter_area, clip_area_ori);
         }
     }
     else if((q->start_quarter == q->end_quarter && q->start_quarter != 2 && q->end_angle < q->start_angle) ||
@@ -419,11 +497,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
         quarter_area.x2 = q->center->x - 1;
         quarter_area.y2 = q->center->y - 1;
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
+        draw_quarter_area(q, &quarter_area, clip_area_ori);
     }
     q->draw_ctx->clip_area = clip_area_ori;
 }
@@ -441,11 +515,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
         quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
         quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
+        draw_quarter_area(q, &quarter_area, clip_area_ori);
     }
     else if(q->start_quarter == 3 || q->end_quarter == 3) {
         /*Start and/or end arcs here*/
@@ -456,11 +526,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
             quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
             quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
+            draw_quarter_area(q, &quarter_area, clip_area_ori);
         }
         if(q->end_quarter == 3) {
             quarter_area.x1 = q->center->x;
@@ -469,11 +535,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
             quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
             quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
+            draw_quarter_area(q, &quarter_area, clip_area_ori);
         }
     }
     else if((q->start_quarter == q->end_quarter && q->start_quarter != 3 && q->end_angle < q->start_angle) ||
@@ -486,16 +548,32 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
         quarter_area.x2 = q->center->x + q->radius;
         quarter_area.y2 = q->center->y - 1;
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
+        draw_quarter_area(q, &quarter_area, clip_area_ori);
     }
 
     q->draw_ctx->clip_area = clip_area_ori;
 }
 
+/**
+ * Draw the arc in an area of a quarter.
+ * If the areas are collected for the arc cache only save the area.
+ */
+static void draw_quarter_area(quarter_draw_dsc_t * q, lv_area_t * quarter_area, const lv_area_t * clip_area_ori)
+{
+#if LV_ARC_CACHE_SIZE
+    if(q->areas) {
+        if(_lv_area_intersect(&q->areas[q->area_cnt], quarter_area, q->draw_area)) q->area_cnt++;
+        return;
+    }
+#endif
+
+    bool ok = _lv_area_intersect(quarter_area, quarter_area, clip_area_ori);
+    if(ok) {
+        q->draw_ctx->clip_area = quarter_area;
+        lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+    }
+}
+
 static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area)
 {
     const uint8_t ps = 8;
@@ -535,3 +613,498 @@ static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness
 }
 
 #endif /*LV_DRAW_COMPLEX*/
+
+#if LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE
+/**
+ * Blend an arc from its cached coverage.
+ * The coverage is computed when the arc is drawn the second time with the same geometry.
+ * @return LV_RES_OK: the arc is drawn; LV_RES_INV: draw the arc without the cache
+ */
+static lv_res_t arc_cache_draw(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                               uint16_t radius, uint16_t start_angle, uint16_t end_angle)
+{
+    /*Other masks would be baked into the coverage and the segment lengths are stored on 15 bits*/
+    lv_area_t area_out;
+    area_out.x1 = center->x - radius;
+    area_out.y1 = center->y - radius;
+    area_out.x2 = center->x + radius - 1;
+    area_out.y2 = center->y + radius - 1;
+    if(lv_draw_mask_is_any(&area_out) || lv_area_get_width(&area_out) >= ARC_CACHE_COVER_FLAG) {
+        arc_cache_stat.not_cached_cnt++;
+        return LV_RES_INV;
+    }
+
+    /*The memory is allocated when the first arc is drawn and kept until `lv_draw_sw_arc_free_cache()`*/
+    if(arc_cache_mem == NULL) {
+        arc_cache_mem = lv_mem_alloc(LV_ARC_CACHE_SIZE);
+        LV_ASSERT_MALLOC(arc_cache_mem);
+        if(arc_cache_mem == NULL) return LV_RES_INV;
+        arc_cache_end = arc_cache_mem;
+    }
+
+    while(start_angle >= 360) start_angle -= 360;
+    while(end_angle >= 360) end_angle -= 360;
+
+    arc_cache_key_t key;
+    lv_memset_00(&key, sizeof(key));
+    key.radius = radius;
+    key.width = dsc->width;
+    key.start_angle = start_angle;
+    key.end_angle = end_angle;
+    key.opa = dsc->opa >= LV_OPA_MAX ? LV_OPA_COVER : dsc->opa;
+    key.rounded = dsc->rounded;
+
+    arc_cache_entry_t * entry = arc_cache_find(&key);
+    if(entry == NULL) {
+        /*Compute the coverage only if the arc is drawn again with the same geometry.
+         *E.g. the indicator of a changing value would fill the cache with arcs never drawn again.*/
+        arc_cache_stat.miss_cnt++;
+        arc_cache_add(&key, ARC_CACHE_STATE_SEEN, 0);
+        return LV_RES_INV;
+    }
+
+    entry->life = ++arc_cache_tick;
+
+    if(entry->state == ARC_CACHE_STATE_SKIP) {
+        arc_cache_stat.not_cached_cnt++;
+        return LV_RES_INV;
+    }
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.color = dsc->color;
+    blend_dsc.blend_mode = dsc->blend_mode;
+    blend_dsc.opa = LV_OPA_COVER;   /*The opacity is in the coverage*/
+
+    uint32_t i;
+    if(entry->state == ARC_CACHE_STATE_READY) {
+        arc_cache_stat.hit_cnt++;
+
+        /*Same order as without the cache: the rounded ends are blended on the arc*/
+        for(i = 0; i < ARC_CACHE_PART_CNT; i++) {
+            part_draw(draw_ctx, &blend_dsc, &entry->parts[i], (uint8_t *)entry + entry->parts[i].ofs, center);
+        }
+        return LV_RES_OK;
+    }
+
+    /*Seen before: compute the coverage and replace the entry with one having the data too*/
+    arc_cache_remove(entry);
+
+    arc_cache_part_t parts[ARC_CACHE_PART_CNT];
+    uint8_t * data[ARC_CACHE_PART_CNT];
+    if(arc_cache_generate(draw_ctx, &key, center, parts, data) != LV_RES_OK) {
+        arc_cache_add(&key, ARC_CACHE_STATE_SKIP, 0);
+        arc_cache_stat.not_cached_cnt++;
+        return LV_RES_INV;
+    }
+
+    uint32_t size = 0;
+    for(i = 0; i < ARC_CACHE_PART_CNT; i++) size += ALIGN(parts[i].size);
+
+    entry = arc_cache_add(&key, ARC_CACHE_STATE_READY, size);
+    if(entry) {
+        arc_cache_stat.miss_cnt++;
+        uint32_t ofs = ALIGN(sizeof(arc_cache_entry_t));
+        for(i = 0; i < ARC_CACHE_PART_CNT; i++) {
+            entry->parts[i] = parts[i];
+            entry->parts[i].ofs = ofs;
+            if(parts[i].size) lv_memcpy((uint8_t *)entry + ofs, data[i], parts[i].size);
+            ofs += ALIGN(parts[i].size);
+        }
+    }
+    else {
+        /*Too large: draw it now but don't compute it again*/
+        arc_cache_add(&key, ARC_CACHE_STATE_SKIP, 0);
+        arc_cache_stat.not_cached_cnt++;
+    }
+
+    for(i = 0; i < ARC_CACHE_PART_CNT; i++) {
+        part_draw(draw_ctx, &blend_dsc, &parts[i], data[i], center);
+        lv_mem_free(data[i]);
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Get the next entry of the cache
+ * @param entry     pointer to an entry or NULL to get the first
+ * @return          the next entry or NULL if there are no more
+ */
+static arc_cache_entry_t * arc_cache_next(arc_cache_entry_t * entry)
+{
+    if(arc_cache_mem == NULL) return NULL;
+
+    uint8_t * next = entry ? (uint8_t *)entry + entry->size : arc_cache_mem;
+    return next < arc_cache_end ? (arc_cache_entry_t *)next : NULL;
+}
+
+static arc_cache_entry_t * arc_cache_find(const arc_cache_key_t * key)
+{
+    arc_cache_entry_t * entry = arc_cache_next(NULL);
+    while(entry) {
+        if(entry->key.radius == key->radius && entry->key.width == key->width &&
+           entry->key.start_angle == key->start_angle && entry->key.end_angle == key->end_angle &&
+           entry->key.opa == key->opa && entry->key.rounded == key->rounded) {
+            return entry;
+        }
+        entry = arc_cache_next(entry);
+    }
+
+    return NULL;
+}
+
+/**
+ * Add an entry to the end of the cache. Remove the least recently used entries if there is no space for it.
+ * @param key       geometry of the arc
+ * @param state     state of the new entry
+ * @param size      bytes needed for the data of the parts
+ * @return          the new entry or NULL if it's larger than the cache
+ */
+static arc_cache_entry_t * arc_cache_add(const arc_cache_key_t * key, arc_cache_state_t state, uint32_t size)
+{
+    size += ALIGN(sizeof(arc_cache_entry_t));
+    if(size > LV_ARC_CACHE_SIZE) return NULL;
+
+    while((uint32_t)(arc_cache_end - arc_cache_mem) + size > LV_ARC_CACHE_SIZE) {
+        arc_cache_entry_t * oldest = arc_cache_next(NULL);
+        arc_cache_entry_t * entry = arc_cache_next(oldest);
+        while(entry) {
+            if(entry->life < oldest->life) oldest = entry;
+            entry = arc_cache_next(entry);
+        }
+        arc_cache_remove(oldest);
+        arc_cache_stat.evict_cnt++;
+    }
+
+    arc_cache_entry_t * entry = (arc_cache_entry_t *)arc_cache_end;
+    lv_memset_00(entry, sizeof(arc_cache_entry_t));
+    entry->key = *key;
+    entry->state = state;
+    entry->life = ++arc_cache_tick;
+    entry->size = size;
+    arc_cache_end += size;
+
+    return entry;
+}
+
+/**
+ * Remove an entry and move the following entries in its place
+ */
+static void arc_cache_remove(arc_cache_entry_t * entry)
+{
+    uint8_t * next = (uint8_t *)entry + entry->size;
+    uint32_t size = entry->size;
+    lv_memcpy((uint8_t *)entry, next, (size_t)(arc_cache_end - next));
+    arc_cache_end -= size;
+}
+
+/**
+ * Compute the coverage of an arc with the same masks and in the same areas as `lv_draw_sw_arc` draws it.
+ * @param parts     save the areas and sizes of the arc and the rounded ends here
+ * @param data      save the coverage of the parts here. Should be freed with `lv_mem_free`.
+ * @return LV_RES_OK: the coverage is computed; LV_RES_INV: out of memory or can't be cached
+ */
+static lv_res_t arc_cache_generate(lv_draw_ctx_t * draw_ctx, const arc_cache_key_t * key, const lv_point_t * center,
+                                   arc_cache_part_t * parts, uint8_t ** data)
+{
+    lv_memset_00(parts, sizeof(arc_cache_part_t) * ARC_CACHE_PART_CNT);
+    lv_memset_00(data, sizeof(uint8_t *) * ARC_CACHE_PART_CNT);
+
+    lv_coord_t radius = key->radius;
+    lv_coord_t width = key->width;
+    if(width > radius) width = radius;
+
+    lv_area_t area_out;
+    area_out.x1 = center->x - radius;
+    area_out.y1 = center->y - radius;
+    area_out.x2 = center->x + radius - 1;
+    area_out.y2 = center->y + radius - 1;
+
+    lv_area_t area_in;
+    lv_area_copy(&area_in, &area_out);
+    area_in.x1 += key->width;
+    area_in.y1 += key->width;
+    area_in.x2 -= key->width;
+    area_in.y2 -= key->width;
+
+    int32_t angle_gap;
+    if(key->end_angle > key->start_angle) {
+        angle_gap = 360 - (key->end_angle - key->start_angle);
+    }
+    else {
+        angle_gap = key->start_angle - key->end_angle;
+    }
+
+    lv_area_t areas[ARC_CACHE_AREA_MAX];
+    uint32_t area_cnt;
+    if(angle_gap > SPLIT_ANGLE_GAP_LIMIT && radius > SPLIT_RADIUS_LIMIT) {
+        quarter_draw_dsc_t q_dsc;
+        q_dsc.center = center;
+        q_dsc.radius = radius;
+        q_dsc.start_angle = key->start_angle;
+        q_dsc.end_angle = key->end_angle;
+        q_dsc.start_quarter = (key->start_angle / 90) & 0x3;
+        q_dsc.end_quarter = (key->end_angle / 90) & 0x3;
+        q_dsc.width = width;
+        q_dsc.draw_dsc = NULL;
+        q_dsc.draw_area = &area_out;
+        q_dsc.draw_ctx = draw_ctx;
+        q_dsc.areas = areas;
+        q_dsc.area_cnt = 0;
+
+        draw_quarter_0(&q_dsc);
+        draw_quarter_1(&q_dsc);
+        draw_quarter_2(&q_dsc);
+        draw_quarter_3(&q_dsc);
+        area_cnt = q_dsc.area_cnt;
+    }
+    else {
+        areas[0] = area_out;
+        area_cnt = 1;
+    }
+
+    /*Overlapping areas are blended twice without the cache. It can't be reproduced with a single coverage.*/
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < area_cnt; i++) {
+        for(j = i + 1; j < area_cnt; j++) {
+            if(_lv_area_is_on(&areas[i], &areas[j])) return LV_RES_INV;
+        }
+    }
+
+    /*Add the masks in the same order as `lv_draw_sw_arc` because the result of mixing them depends on the order*/
+    int16_t ids[3];
+    lv_draw_mask_radius_param_t mask_in_param;
+    bool mask_in_param_valid = false;
+    ids[0] = LV_MASK_ID_INV;
+    if(lv_area_get_width(&area_in) > 0 && lv_area_get_height(&area_in) > 0) {
+        lv_draw_mask_radius_init(&mask_in_param, &area_in, LV_RADIUS_CIRCLE, true);
+        mask_in_param_valid = true;
+        ids[0] = lv_draw_mask_add(&mask_in_param, NULL);
+    }
+
+    lv_draw_mask_radius_param_t mask_out_param;
+    lv_draw_mask_radius_init(&mask_out_param, &area_out, LV_RADIUS_CIRCLE, false);
+    ids[1] = lv_draw_mask_add(&mask_out_param, NULL);
+
+    lv_draw_mask_angle_param_t mask_angle_param;
+    lv_draw_mask_angle_init(&mask_angle_param, center->x, center->y, key->start_angle, key->end_angle);
+    ids[2] = lv_draw_mask_add(&mask_angle_param, NULL);
+
+    lv_res_t res = part_generate(&parts[0], &data[0], &area_out, areas, area_cnt, center, ids, 3, key->opa);
+
+    lv_draw_mask_remove_id(ids[2]);
+    lv_draw_mask_remove_id(ids[1]);
+    if(ids[0] != LV_MASK_ID_INV) lv_draw_mask_remove_id(ids[0]);
+    lv_draw_mask_free_param(&mask_angle_param);
+    lv_draw_mask_free_param(&mask_out_param);
+    if(mask_in_param_valid) lv_draw_mask_free_param(&mask_in_param);
+
+    if(res == LV_RES_OK && key->rounded) {
+        for(i = 0; i < 2 && res == LV_RES_OK; i++) {
+            lv_area_t round_area;
+            get_rounded_area(i == 0 ? key->start_angle : key->end_angle, radius, width, &round_area);
+            lv_area_move(&round_area, center->x, center->y);
+
+            lv_area_t end_area;
+            if(!_lv_area_intersect(&end_area, &round_area, &area_out)) continue;
+
+            lv_draw_mask_radius_param_t mask_end_param;
+            lv_draw_mask_radius_init(&mask_end_param, &round_area, LV_RADIUS_CIRCLE, false);
+            int16_t mask_end_id = lv_draw_mask_add(&mask_end_param, NULL);
+
+            res = part_generate(&parts[1 + i], &data[1 + i], &end_area, &end_area, 1, center, &mask_end_id, 1, key->opa);
+
+            lv_draw_mask_remove_id(mask_end_id);
+            lv_draw_mask_free_param(&mask_end_param);
+        }
+    }
+
+    if(res != LV_RES_OK) {
+        for(i = 0; i < ARC_CACHE_PART_CNT; i++) {
+            lv_mem_free(data[i]);
+            data[i] = NULL;
+        }
+    }
+
+    return res;
+}
+
+/**
+ * Compute the coverage of the given masks in some regions of an area and save it in rows of segments
+ * @param part      save the area and the size of the coverage here
+ * @param data      save the coverage here
+ * @param area      the absolute coordinates of the area
+ * @param regions   apply the masks only in these parts of `area`. The other pixels are transparent.
+ * @param region_cnt number of regions
+ * @param center    center of the arc to save the area relative to it
+ * @param ids       ID of the masks to apply
+ * @param id_cnt    number of mask IDs
+ * @param opa       opacity to start the coverage from
+ * @return LV_RES_OK: the coverage is saved; LV_RES_INV: out of memory
+ */
+static lv_res_t part_generate(arc_cache_part_t * part, uint8_t ** data, const lv_area_t * area,
+                              const lv_area_t * regions, uint32_t region_cnt, const lv_point_t * center, const int16_t * ids, int16_t id_cnt,
+                              lv_opa_t opa)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t h = lv_area_get_height(area);
+
+    /*Worst case of a row: a 1 px long segment on every second pixel*/
+    uint32_t row_max = (w / 2 + 1) * (2 * sizeof(uint16_t) + 2) + sizeof(uint16_t);
+    uint32_t size = h * sizeof(uint32_t);
+    uint32_t alloc_size = size + LV_MAX((uint32_t)h * 8, row_max);
+    uint8_t * rows = lv_mem_alloc(alloc_size);
+    if(rows == NULL) return LV_RES_INV;
+
+    lv_opa_t * mask_buf = lv_mem_buf_get(w);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memset_00(mask_buf, w);
+
+        uint32_t i;
+        for(i = 0; i < region_cnt; i++) {
+            const lv_area_t * r = &regions[i];
+            if(y < r->y1 || y > r->y2) continue;
+
+            lv_opa_t * buf = &mask_buf[r->x1 - area->x1];
+            lv_coord_t len = lv_area_get_width(r);
+            lv_memset(buf, opa, len);
+            if(lv_draw_mask_apply_ids(buf, r->x1, y, len, ids, id_cnt) == LV_DRAW_MASK_RES_TRANSP) {
+                lv_memset_00(buf, len);
+            }
+        }
+
+        if(size + row_max > alloc_size) {
+            alloc_size = LV_MAX(alloc_size * 2, size + row_max);
+            uint8_t * rows_new = lv_mem_realloc(rows, alloc_size);
+            if(rows_new == NULL) {
+                lv_mem_free(rows);
+                lv_mem_buf_release(mask_buf);
+                return LV_RES_INV;
+            }
+            rows = rows_new;
+        }
+
+        ((uint32_t *)rows)[y - area->y1] = size;
+        size += row_encode(rows + size, mask_buf, w);
+    }
+    lv_mem_buf_release(mask_buf);
+
+    /*Shrinking can't fail*/
+    *data = lv_mem_realloc(rows, size);
+    part->size = size;
+    part->area = *area;
+    lv_area_move(&part->area, -center->x, -center->y);
+
+    return LV_RES_OK;
+}
+
+/**
+ * Save the not transparent segments of a row
+ * @param dest      save the segments here
+ * @param mask_buf  coverage of the row
+ * @param len       length of the row
+ * @return          number of bytes written
+ */
+static uint32_t row_encode(uint8_t * dest, const lv_opa_t * mask_buf, lv_coord_t len)
+{
+    uint16_t * p = (uint16_t *)dest;
+    lv_coord_t x = 0;
+    while(x < len) {
+        if(mask_buf[x] == LV_OPA_TRANSP) {
+            x++;
+            continue;
+        }
+
+        lv_coord_t start = x;
+        while(x < len && mask_buf[x] == LV_OPA_COVER) x++;
+        if(x - start >= ARC_CACHE_COVER_MIN) {
+            *p++ = start;
+            *p++ = (x - start) | ARC_CACHE_COVER_FLAG;
+            continue;
+        }
+
+        /*Collect the pixels until a transparent pixel or a long enough fully covered run*/
+        while(x < len && mask_buf[x] != LV_OPA_TRANSP) {
+            if(mask_buf[x] != LV_OPA_COVER) {
+                x++;
+                continue;
+            }
+
+            lv_coord_t cover_start = x;
+            while(x < len && mask_buf[x] == LV_OPA_COVER) x++;
+            if(x - cover_start >= ARC_CACHE_COVER_MIN) {
+                x = cover_start;
+                break;
+            }
+        }
+
+        *p++ = start;
+        *p++ = x - start;
+        lv_memcpy(p, &mask_buf[start], x - start);
+        p += (x - start + 1) / 2;
+    }
+
+    *p++ = ARC_CACHE_ROW_END;
+
+    return (uint8_t *)p - dest;
+}
+
+/**
+ * Blend the segments of a cached coverage in the clip area
+ */
+static void part_draw(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc, const arc_cache_part_t * part,
+                      const uint8_t * data, const lv_point_t * center)
+{
+    if(part->size == 0) return;
+
+    lv_area_t area = part->area;
+    lv_area_move(&area, center->x, center->y);
+
+    lv_area_t clipped_area;
+    if(!_lv_area_intersect(&clipped_area, &area, draw_ctx->clip_area)) return;
+
+    /*The coverage is copied because blending might modify the mask (e.g. without anti-aliasing)*/
+    lv_opa_t * mask_buf = lv_mem_buf_get(lv_area_get_width(&clipped_area));
+
+    lv_area_t blend_area;
+    blend_dsc->blend_area = &blend_area;
+    blend_dsc->mask_area = &blend_area;
+
+    const uint32_t * row_ofs = (const uint32_t *)data;
+    lv_coord_t y;
+    for(y = clipped_area.y1; y <= clipped_area.y2; y++) {
+        blend_area.y1 = y;
+        blend_area.y2 = y;
+
+        const uint16_t * seg = (const uint16_t *)(data + row_ofs[y - area.y1]);
+        while(seg[0] != ARC_CACHE_ROW_END) {
+            lv_coord_t x1 = area.x1 + seg[0];
+            lv_coord_t len = seg[1] & ~ARC_CACHE_COVER_FLAG;
+            bool cover = seg[1] & ARC_CACHE_COVER_FLAG ? true : false;
+            const lv_opa_t * opa_buf = (const lv_opa_t *)&seg[2];
+            seg += cover ? 2 : 2 + (len + 1) / 2;
+
+            if(x1 > clipped_area.x2) break;
+            blend_area.x1 = LV_MAX(x1, clipped_area.x1);
+            blend_area.x2 = LV_MIN(x1 + len - 1, clipped_area.x2);
+            if(blend_area.x1 > blend_area.x2) continue;
+
+            if(cover) {
+                blend_dsc->mask_buf = NULL;
+                blend_dsc->mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+            }
+            else {
+                lv_memcpy(mask_buf, &opa_buf[blend_area.x1 - x1], lv_area_get_width(&blend_area));
+                blend_dsc->mask_buf = mask_buf;
+                blend_dsc->mask_res = LV_DRAW_MASK_RES_CHANGED;
+            }
+            lv_draw_sw_blend(draw_ctx, blend_dsc);
+        }
+    }
+
+    lv_mem_buf_release(mask_buf);
+}
+#endif /*LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE*/
@@ -44,28 +44,80 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
 static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx);
 static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx);
 static lv_res_t find_item(lv_grad_t * c, void * ctx);
+static lv_res_t count_item(lv_grad_t * c, void * ctx);
 static void free_item(lv_grad_t * c);
-static  uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
+static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t size, lv_coord_t map_size, lv_coord_t err_w);
+static lv_coord_t get_err_w(const lv_grad_dsc_t * g, lv_coord_t w);
+static bool grad_is_same(const lv_grad_dsc_t * g1, const lv_grad_dsc_t * g2);
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t key;
+    const lv_grad_dsc_t * dsc;
+    lv_coord_t size;
+    lv_coord_t map_size;
+    lv_coord_t err_w;
+} find_item_ctx_t;
 
 /**********************
  *   STATIC VARIABLE
  **********************/
 static size_t    grad_cache_size = 0;
 static uint8_t * grad_cache_end = 0;
+static lv_grad_cache_stat_t grad_cache_stat;
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
-union void_cast {
-    const void * ptr;
-    const uint32_t value;
-};
+#define KEY_ADD(key, v) (((key) ^ (uint32_t)(v)) * 16777619u)     /*FNV-1a step*/
 
-static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t size, lv_coord_t w)
+/*The key is built from the content of the gradient as the descriptors are usually temporary copies
+ *(e.g. in a draw descriptor on the stack) so their address is the same for different gradients*/
+static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t size, lv_coord_t map_size, lv_coord_t err_w)
 {
-    union void_cast v;
-    v.ptr = g;
-    return (v.value ^ size ^ (w >> 1)); /*Yes, this is correct, it's like a hash that changes if the width changes*/
+    uint32_t key = 2166136261u;
+    uint8_t i;
+    for(i = 0; i < g->stops_count; i++) {
+        key = KEY_ADD(key, lv_color_to32(g->stops[i].color));
+        key = KEY_ADD(key, g->stops[i].frac);
+    }
+    key = KEY_ADD(key, g->stops_count);
+    key = KEY_ADD(key, g->dir);
+#if _DITHER_GRADIENT
+    key = KEY_ADD(key, g->dither);
+#endif
+    key = KEY_ADD(key, size);
+    key = KEY_ADD(key, map_size);
+    key = KEY_ADD(key, err_w);
+    return key;
+}
+
+/*The error diffusion stores the error of a whole row so its items can be used only with the same width*/
+static lv_coord_t get_err_w(const lv_grad_dsc_t * g, lv_coord_t w)
+{
+#if _DITHER_GRADIENT && LV_DITHER_ERROR_DIFFUSION == 1
+    if(g->dither == LV_DITHER_ERR_DIFF) return w;
+#else
+    LV_UNUSED(g);
+    LV_UNUSED(w);
+#endif
+    return 0;
+}
+
+static bool grad_is_same(const lv_grad_dsc_t * g1, const lv_grad_dsc_t * g2)
+{
+    if(g1->stops_count != g2->stops_count || g1->dir != g2->dir) return false;
+#if _DITHER_GRADIENT
+    if(g1->dither != g2->dither) return false;
+#endif
+    uint8_t i;
+    for(i = 0; i < g1->stops_count; i++) {
+        if(g1->stops[i].color.full != g2->stops[i].color.full) return false;
+        if(g1->stops[i].frac != g2->stops[i].frac) return false;
+    }
+    return true;
 }
 
 static size_t get_cache_item_size(lv_grad_t * c)
@@ -142,6 +194,7 @@ static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx)
     if(c->life == *min_life) {
         /*Found, let's kill it*/
         free_item(c);
+        grad_cache_stat.evict_cnt++;
         return LV_RES_OK;
     }
     return LV_RES_INV;
@@ -149,8 +202,21 @@ static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx)
 
 static lv_res_t find_item(lv_grad_t * c, void * ctx)
 {
-    uint32_t * k = (uint32_t *)ctx;
-    if(c->key == *k) return LV_RES_OK;
+    find_item_ctx_t * f = (find_item_ctx_t *)ctx;
+    if(c->key != f->key) return LV_RES_INV;
+    if(c->size != f->size || c->alloc_size != f->map_size) return LV_RES_INV;
+    if(!grad_is_same(&c->dsc, f->dsc)) return LV_RES_INV;
+#if _DITHER_GRADIENT && LV_DITHER_ERROR_DIFFUSION == 1
+    if(f->err_w && c->w != f->err_w) return LV_RES_INV;
+#endif
+    return LV_RES_OK;
+}
+
+static lv_res_t count_item(lv_grad_t * c, void * ctx)
+{
+    LV_UNUSED(c);
+    uint32_t * cnt = (uint32_t *)ctx;
+    (*cnt)++;
     return LV_RES_INV;
 }
 
@@ -192,10 +258,12 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
             LV_ASSERT_MALLOC(item);
             if(item == NULL) return NULL;
             item->not_cached = 1;
+            grad_cache_stat.not_cached_cnt++;
         }
     }
 
-    item->key = compute_key(g, size, w);
+    item->key = compute_key(g, size, map_size, get_err_w(g, w));
+    lv_memcpy(&item->dsc, g, sizeof(lv_grad_dsc_t));
     item->life = 1;
     item->filled = 0;
     item->alloc_size = map_size;
@@ -246,6 +314,20 @@ void lv_gradient_set_cache_size(size_t max_bytes)
     grad_cache_size = max_bytes;
 }
 
+void lv_gradient_get_cache_stat(lv_grad_cache_stat_t * stat)
+{
+    *stat = grad_cache_stat;
+    stat->item_cnt = 0;
+    iterate_cache(&count_item, &stat->item_cnt, NULL);
+    stat->used_size = grad_cache_size ? (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem)) : 0;
+    stat->cache_size = grad_cache_size;
+}
+
+void lv_gradient_reset_cache_stat(void)
+{
+    lv_memset_00(&grad_cache_stat, sizeof(grad_cache_stat));
+}
+
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
 {
     /* No gradient, no cache */
@@ -258,14 +340,27 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
         inited = true;
     }
 
-    /* Step 1: Search cache for the given key */
-    lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
-    uint32_t key = compute_key(g, size, w);
+    /* Step 1: Search cache for the given gradient */
+    find_item_ctx_t f;
+    f.size = g->dir == LV_GRAD_DIR_HOR ? w : h;
+    f.map_size = LV_MAX(w, h);
+    f.err_w = get_err_w(g, w);
+    f.key = compute_key(g, f.size, f.map_size, f.err_w);
+    f.dsc = g;
     lv_grad_t * item = NULL;
-    if(iterate_cache(&find_item, &key, &item) == LV_RES_OK) {
+    if(iterate_cache(&find_item, &f, &item) == LV_RES_OK) {
         item->life++; /* Don't forget to bump the counter */
+        grad_cache_stat.hit_cnt++;
+#if _DITHER_GRADIENT && LV_DITHER_ERROR_DIFFUSION == 1
+        /* The error diffusion starts from zero error in each draw as in a new item */
+        if(g->dither == LV_DITHER_ERR_DIFF) {
+            LV_ASSERT(w <= item->w);
+            lv_memset_00(item->error_acc, w * sizeof(lv_scolor24_t));
+        }
+#endif
         return item;
     }
+    grad_cache_stat.miss_cnt++;
 
     /* Step 2: Need to allocate an item for it */
     item = allocate_item(g, w, h);
@@ -39,6 +39,8 @@ typedef lv_color_t lv_grad_color_t;
 typedef struct _lv_gradient_cache_t {
     uint32_t        key;          /**< A discriminating key that's built from the drawing operation.
                                    * If the key does not match, the cache item is not used */
+    lv_grad_dsc_t   dsc;          /**< The gradient the map was computed for. It's compared on key match
+                                   * to not use a different gradient with the same key */
     uint32_t        life : 30;    /**< A life counter that's incremented on usage. Higher counter is
                                    * less likely to be evicted from the cache */
     uint32_t        filled : 1;   /**< Used to skip dithering in it if already done */
@@ -58,6 +60,17 @@ typedef struct _lv_gradient_cache_t {
 #endif
 } lv_grad_t;
 
+/** Counters of the gradient cache*/
+typedef struct {
+    uint32_t hit_cnt;             /**< The gradient was found in the cache*/
+    uint32_t miss_cnt;            /**< The gradient was computed*/
+    uint32_t evict_cnt;           /**< A gradient was removed from the cache to make space for a new one*/
+    uint32_t not_cached_cnt;      /**< The gradient was larger than the cache so it was allocated and freed*/
+    uint32_t item_cnt;            /**< Number of gradients in the cache now*/
+    size_t   used_size;           /**< Bytes used in the cache now*/
+    size_t   cache_size;          /**< Size of the cache in bytes*/
+} lv_grad_cache_stat_t;
+
 /**********************
  *      PROTOTYPES
  **********************/
@@ -79,6 +92,16 @@ void lv_gradient_set_cache_size(size_t max_bytes);
 /** Free the gradient cache */
 void lv_gradient_free_cache(void);
 
+/**
+ * Get the counters of the gradient cache since the last `lv_gradient_reset_cache_stat()`
+ * and its current usage.
+ * @param stat      store the counters here
+ */
+void lv_gradient_get_cache_stat(lv_grad_cache_stat_t * stat);
+
+/** Reset the hit, miss and eviction counters of the gradient cache */
+void lv_gradient_reset_cache_stat(void);
+
 /** Get a gradient cache from the given parameters */
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * gradient, lv_coord_t w, lv_coord_t h);
 
@@ -30,6 +30,11 @@
 static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 static void draw_bg_img(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 static void draw_border(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+#if LV_DRAW_COMPLEX
+static void bg_edge_mask(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_opa_t opa);
+static void blend_bg_line(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * line_dsc,
+                          const lv_draw_mask_span_t * span, lv_opa_t opa);
+#endif
 
 static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 
@@ -179,7 +184,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     }
 
     if(grad && dither_mode == LV_DITHER_NONE) {
-        grad->filled = 0; /*Should we force refilling it each draw call ?*/
+        /*The cached items are found by the content of the gradient so the map filled in an earlier draw is valid*/
         if(grad_dir == LV_GRAD_DIR_VER)
             grad_size = coords_bg_h;
     }
@@ -234,17 +239,17 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
         goto bg_clean_up;
     }
 
-    /* Draw the top of the rectangle line by line and mirror it to the bottom. */
+    /* Draw the top of the rectangle line by line and mirror it to the bottom.
+     * Only the anti-aliased edges of the lines are masked, their fully covered middle is filled without mask.*/
     for(h = 0; h < rout; h++) {
         lv_coord_t top_y = bg_coords.y1 + h;
         lv_coord_t bottom_y = bg_coords.y2 - h;
         if(top_y < clipped_coords.y1 && bottom_y > clipped_coords.y2) continue;   /*This line is clipped now*/
 
-        /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
-         * It saves calculating the final opa in lv_draw_sw_blend*/
-        lv_memset(mask_buf, opa, clipped_w);
-        blend_dsc.mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, top_y, clipped_w);
-        if(blend_dsc.mask_res == LV_DRAW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        lv_draw_mask_span_t span;
+        if(lv_draw_mask_get_span(blend_area.x1, top_y, clipped_w, &span) == LV_DRAW_MASK_RES_TRANSP) continue;
+        bg_edge_mask(&mask_buf[span.x1 - blend_area.x1], span.x1, top_y, span.opa_x1 - span.x1, opa);
+        bg_edge_mask(&mask_buf[span.opa_x2 + 1 - blend_area.x1], span.opa_x2 + 1, top_y, span.x2 - span.opa_x2, opa);
 
         if(top_y >= clipped_coords.y1) {
             blend_area.y1 = top_y;
@@ -254,7 +259,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
             if(dither_func) dither_func(grad, blend_area.x1,  top_y - bg_coords.y1, grad_size);
 #endif
             if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[top_y - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            blend_bg_line(draw_ctx, &blend_dsc, &span, opa);
         }
 
         if(bottom_y <= clipped_coords.y2) {
@@ -265,7 +270,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
             if(dither_func) dither_func(grad, blend_area.x1,  bottom_y - bg_coords.y1, grad_size);
 #endif
             if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[bottom_y - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            blend_bg_line(draw_ctx, &blend_dsc, &span, opa);
         }
     }
 
@@ -321,6 +326,63 @@ bg_clean_up:
 #endif
 }
 
+#if LV_DRAW_COMPLEX
+/**
+ * Calculate the mask of a partially covered part of a line.
+ * Initialize the mask to opa instead of 0xFF to blend with LV_OPA_COVER.
+ * It saves calculating the final opa in lv_draw_sw_blend
+ */
+static void bg_edge_mask(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_opa_t opa)
+{
+    if(len <= 0) return;
+
+    lv_memset(mask_buf, opa, len);
+    lv_draw_mask_res_t res = lv_draw_mask_apply(mask_buf, abs_x, abs_y, len);
+    if(res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(mask_buf, len);
+}
+
+/**
+ * Blend a line with its left edge, fully covered middle and right edge described by a mask span.
+ * Only the edges are blended with the mask, the middle uses the faster not masked fill/map.
+ * @param line_dsc blend descriptor of the whole line. Its `mask_buf` has the mask of the edges
+ * @param span the coverage of the line from `lv_draw_mask_get_span`
+ * @param opa opacity of the fully covered part (the mask of the edges already contains it)
+ */
+static void blend_bg_line(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * line_dsc,
+                          const lv_draw_mask_span_t * span, lv_opa_t opa)
+{
+    const lv_area_t * line_area = line_dsc->blend_area;
+    lv_draw_sw_blend_dsc_t part_dsc = *line_dsc;
+    lv_area_t part_area = *line_area;
+    part_dsc.blend_area = &part_area;
+    part_dsc.mask_area = &part_area;
+
+    const lv_coord_t part_x1[3] = {span->x1, span->opa_x1, span->opa_x2 + 1};
+    const lv_coord_t part_x2[3] = {span->opa_x1 - 1, span->opa_x2, span->x2};
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        if(part_x1[i] > part_x2[i]) continue;
+
+        part_area.x1 = part_x1[i];
+        part_area.x2 = part_x2[i];
+        lv_coord_t ofs = part_x1[i] - line_area->x1;
+        if(line_dsc->src_buf) part_dsc.src_buf = line_dsc->src_buf + ofs;
+
+        if(i == 1) {
+            part_dsc.mask_buf = NULL;
+            part_dsc.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+            part_dsc.opa = opa;
+        }
+        else {
+            part_dsc.mask_buf = line_dsc->mask_buf + ofs;
+            part_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            part_dsc.opa = LV_OPA_COVER;
+        }
+        lv_draw_sw_blend(draw_ctx, &part_dsc);
+    }
+}
+#endif
+
 static void draw_bg_img(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
 {
     if(dsc->bg_img_src == NULL) return;
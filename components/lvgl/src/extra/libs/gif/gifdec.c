@@ -161,6 +161,7 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     }
     gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     gif->loop_count = -1;
+    gif->frame_idx = -1;
     goto ok;
 fail:
     f_gif_close(gif_base);
@@ -569,17 +570,49 @@ dispose(gd_GIF *gif)
     }
 }
 
+/* Add the area of the current frame to the changed area of the canvas. */
+static void
+add_dirty_area(gd_GIF *gif)
+{
+    uint16_t x2, y2;
+
+    if (!gif->fw || !gif->fh)
+        return;
+    if (!gif->dw || !gif->dh) {
+        gif->dx = gif->fx;
+        gif->dy = gif->fy;
+        gif->dw = gif->fw;
+        gif->dh = gif->fh;
+        return;
+    }
+    x2 = MAX(gif->dx + gif->dw, gif->fx + gif->fw);
+    y2 = MAX(gif->dy + gif->dh, gif->fy + gif->fh);
+    gif->dx = MIN(gif->dx, gif->fx);
+    gif->dy = MIN(gif->dy, gif->fy);
+    gif->dw = x2 - gif->dx;
+    gif->dh = y2 - gif->dy;
+}
+
 /* Return 1 if got a frame; 0 if got GIF trailer; -1 if error. */
 int
 gd_get_frame(gd_GIF *gif)
 {
     char sep;
 
+    /* Only restoring the background changes the canvas in the area of the previous frame. */
+    if (gif->gce.disposal == 2) {
+        gif->dx = gif->fx;
+        gif->dy = gif->fy;
+        gif->dw = gif->fw;
+        gif->dh = gif->fh;
+    } else
+        gif->dw = gif->dh = 0;
     dispose(gif);
     f_gif_read(gif, &sep, 1);
     while (sep != ',') {
         if (sep == ';') {
             f_gif_seek(gif, gif->anim_start, LV_FS_SEEK_SET);
+            gif->frame_idx = -1;
             if(gif->loop_count == 1 || gif->loop_count < 0) {
                 return 0;
             }
@@ -594,6 +627,8 @@ gd_get_frame(gd_GIF *gif)
     }
     if (read_image(gif) == -1)
         return -1;
+    gif->frame_idx++;
+    add_dirty_area(gif);
     return 1;
 }
 
@@ -616,6 +651,7 @@ void
 gd_rewind(gd_GIF *gif)
 {
     gif->loop_count = -1;
+    gif->frame_idx = -1;
     f_gif_seek(gif, gif->anim_start, LV_FS_SEEK_SET);
 }
 
@@ -26,6 +26,13 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void get_frame_area(gd_GIF * gif, lv_area_t * area);
+static void invalidate_frame(lv_obj_t * obj, const lv_area_t * area);
+#if LV_GIF_CACHE_SIZE
+    static void cache_add(lv_gif_t * gifobj, int has_next, const lv_area_t * area);
+    static void cache_play(lv_obj_t * obj);
+    static void cache_free(lv_gif_t * gifobj);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -66,6 +73,11 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
         gifobj->imgdsc.data = NULL;
     }
 
+#if LV_GIF_CACHE_SIZE
+    cache_free(gifobj);
+    gifobj->cache_state = LV_GIF_CACHE_STATE_NONE;
+#endif
+
     if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
         const lv_img_dsc_t * img_dsc = src;
         gifobj->gif = gd_open_gif_data(img_dsc->data);
@@ -98,6 +110,13 @@ void lv_gif_restart(lv_obj_t * obj)
 {
     lv_gif_t * gifobj = (lv_gif_t *) obj;
     gd_rewind(gifobj->gif);
+
+#if LV_GIF_CACHE_SIZE
+    /*The decoder continues from its last frame so the canvas might change anywhere*/
+    if(gifobj->cache_state == LV_GIF_CACHE_STATE_READY) lv_obj_invalidate(obj);
+    cache_free(gifobj);
+    gifobj->cache_state = LV_GIF_CACHE_STATE_NONE;
+#endif
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
 }
@@ -125,6 +144,9 @@ static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     if(gifobj->gif)
         gd_close_gif(gifobj->gif);
     lv_timer_del(gifobj->timer);
+#if LV_GIF_CACHE_SIZE
+    cache_free(gifobj);
+#endif
 }
 
 static void next_frame_task_cb(lv_timer_t * t)
@@ -136,6 +158,13 @@ static void next_frame_task_cb(lv_timer_t * t)
 
     gifobj->last_call = lv_tick_get();
 
+#if LV_GIF_CACHE_SIZE
+    if(gifobj->cache_state == LV_GIF_CACHE_STATE_READY) {
+        cache_play(obj);
+        return;
+    }
+#endif
+
     int has_next = gd_get_frame(gifobj->gif);
     if(has_next == 0) {
         /*It was the last repeat*/
@@ -146,8 +175,171 @@ static void next_frame_task_cb(lv_timer_t * t)
 
     gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
 
+    /*Only the area of the previous and the new frame has changed*/
+    lv_area_t area;
+    get_frame_area(gifobj->gif, &area);
+#if LV_GIF_CACHE_SIZE
+    cache_add(gifobj, has_next, &area);
+#endif
+    invalidate_frame(obj, &area);
+}
+
+/**
+ * Get the area of the canvas changed by the last frame, clipped to the canvas
+ * @param gif       pointer to a decoder after `gd_get_frame()`
+ * @param area      store the result here. Its size is 0 if nothing has changed.
+ */
+static void get_frame_area(gd_GIF * gif, lv_area_t * area)
+{
+    lv_area_t canvas_area;
+    lv_area_set(&canvas_area, 0, 0, gif->width - 1, gif->height - 1);
+    lv_area_set(area, gif->dx, gif->dy, gif->dx + gif->dw - 1, gif->dy + gif->dh - 1);
+    if(!_lv_area_intersect(area, area, &canvas_area)) lv_area_set(area, 0, 0, -1, -1);
+}
+
+/**
+ * Invalidate the area of the object where a changed area of the canvas is drawn
+ * @param obj       pointer to a GIF object
+ * @param area      the changed area in canvas coordinates
+ */
+static void invalidate_frame(lv_obj_t * obj, const lv_area_t * area)
+{
+    if(lv_area_get_size(area) == 0) return;
+
     lv_img_cache_invalidate_src(lv_img_get_src(obj));
-    lv_obj_invalidate(obj);
+
+    /*Zoomed, rotated or tiled images are invalidated as a whole*/
+    lv_img_t * img = (lv_img_t *) obj;
+    lv_area_t content_area;
+    lv_obj_get_content_coords(obj, &content_area);
+    if(img->angle != 0 || img->zoom != LV_IMG_ZOOM_NONE || img->offset.x != 0 || img->offset.y != 0 ||
+       lv_area_get_width(&content_area) != img->w || lv_area_get_height(&content_area) != img->h) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_area_t inv_area;
+    lv_area_copy(&inv_area, area);
+    lv_area_move(&inv_area, content_area.x1, content_area.y1);
+    lv_obj_invalidate_area(obj, &inv_area);
 }
 
+#if LV_GIF_CACHE_SIZE
+
+/**
+ * Store the changes of a decoded frame.
+ * The first loop starts from the background so the changes are stored during the second loop.
+ * When the first frame is reached again the next loops are played from the cache.
+ * @param gifobj    pointer to a GIF object
+ * @param has_next  return value of `gd_get_frame()`
+ * @param area      the area of the canvas changed by the frame
+ */
+static void cache_add(lv_gif_t * gifobj, int has_next, const lv_area_t * area)
+{
+    gd_GIF * gif = gifobj->gif;
+
+    if(gifobj->cache_state == LV_GIF_CACHE_STATE_READY || gifobj->cache_state == LV_GIF_CACHE_STATE_OFF) return;
+
+    /*Finished or broken GIFs are not cached*/
+    if(has_next != 1) {
+        cache_free(gifobj);
+        gifobj->cache_state = LV_GIF_CACHE_STATE_OFF;
+        return;
+    }
+
+    if(gifobj->cache_state == LV_GIF_CACHE_STATE_NONE) {
+        gifobj->cache_state = LV_GIF_CACHE_STATE_WAIT;
+        return;
+    }
+
+    if(gifobj->cache_state == LV_GIF_CACHE_STATE_WAIT) {
+        if(gif->frame_idx != 0) return;
+        /*Only endless loops are cached as the repeat count of the others is handled by the decoder*/
+        gifobj->cache_state = gif->loop_count == 0 ? LV_GIF_CACHE_STATE_RECORD : LV_GIF_CACHE_STATE_OFF;
+        return;
+    }
+
+    uint32_t data_size = lv_area_get_size(area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    if(gifobj->cache_size + data_size + sizeof(lv_gif_frame_t) > LV_GIF_CACHE_SIZE) {
+        LV_LOG_INFO("the frames don't fit into LV_GIF_CACHE_SIZE");
+        cache_free(gifobj);
+        gifobj->cache_state = LV_GIF_CACHE_STATE_OFF;
+        return;
+    }
+
+    lv_gif_frame_t * frames = lv_mem_realloc(gifobj->frames, (gifobj->frame_cnt + 1) * sizeof(lv_gif_frame_t));
+    uint8_t * data = data_size ? lv_mem_alloc(data_size) : NULL;
+    if(frames) gifobj->frames = frames;
+    if(frames == NULL || (data_size && data == NULL)) {
+        LV_LOG_WARN("couldn't allocate memory for the frame");
+        lv_mem_free(data);
+        cache_free(gifobj);
+        gifobj->cache_state = LV_GIF_CACHE_STATE_OFF;
+        return;
+    }
+
+    lv_gif_frame_t * frame = &gifobj->frames[gifobj->frame_cnt];
+    lv_area_copy(&frame->area, area);
+    frame->data = data;
+    frame->delay = gif->gce.delay;
+    gifobj->frame_cnt++;
+    gifobj->cache_size += data_size + sizeof(lv_gif_frame_t);
+
+    const uint8_t * canvas = gifobj->imgdsc.data;
+    uint32_t line_size = lv_area_get_width(area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(data, &canvas[(y * gif->width + area->x1) * LV_IMG_PX_SIZE_ALPHA_BYTE], line_size);
+        data += line_size;
+    }
+
+    /*Arrived back to the first frame so the whole loop is stored*/
+    if(gif->frame_idx == 0) {
+        gifobj->frame_act = 0;
+        gifobj->cache_state = LV_GIF_CACHE_STATE_READY;
+    }
+}
+
+/**
+ * Apply the changes of the next stored frame on the canvas
+ * @param obj       pointer to a GIF object
+ */
+static void cache_play(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    lv_gif_frame_t * frame = &gifobj->frames[gifobj->frame_act];
+
+    uint8_t * canvas = (uint8_t *)gifobj->imgdsc.data;
+    const uint8_t * data = frame->data;
+    uint32_t line_size = lv_area_get_width(&frame->area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_coord_t y;
+    for(y = frame->area.y1; y <= frame->area.y2; y++) {
+        lv_memcpy(&canvas[(y * gifobj->gif->width + frame->area.x1) * LV_IMG_PX_SIZE_ALPHA_BYTE], data, line_size);
+        data += line_size;
+    }
+
+    /*The timer waits for the delay of the current frame*/
+    gifobj->gif->gce.delay = frame->delay;
+
+    gifobj->frame_act++;
+    if(gifobj->frame_act == gifobj->frame_cnt) gifobj->frame_act = 0;
+
+    invalidate_frame(obj, &frame->area);
+}
+
+static void cache_free(lv_gif_t * gifobj)
+{
+    uint32_t i;
+    for(i = 0; i < gifobj->frame_cnt; i++) {
+        lv_mem_free(gifobj->frames[i].data);
+    }
+    lv_mem_free(gifobj->frames);
+    gifobj->frames = NULL;
+    gifobj->frame_cnt = 0;
+    gifobj->frame_act = 0;
+    gifobj->cache_size = 0;
+}
+
+#endif /*LV_GIF_CACHE_SIZE*/
+
 #endif /*LV_USE_GIF*/
@@ -27,12 +27,37 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_GIF_CACHE_SIZE
+enum {
+    LV_GIF_CACHE_STATE_NONE,        /*Waiting for the first frame*/
+    LV_GIF_CACHE_STATE_WAIT,        /*Playing the first loop*/
+    LV_GIF_CACHE_STATE_RECORD,      /*Storing the frames of the second loop*/
+    LV_GIF_CACHE_STATE_READY,       /*Playing from the cache*/
+    LV_GIF_CACHE_STATE_OFF,         /*The GIF can't be cached*/
+};
+typedef uint8_t lv_gif_cache_state_t;
+
+/*The changes of a frame on the canvas*/
+typedef struct {
+    lv_area_t area;             /*Changed area of the canvas*/
+    uint8_t * data;             /*The pixels of `area` after rendering the frame*/
+    uint16_t delay;             /*Delay of the frame [10 ms]*/
+} lv_gif_frame_t;
+#endif
+
 typedef struct {
     lv_img_t img;
     gd_GIF * gif;
     lv_timer_t * timer;
     lv_img_dsc_t imgdsc;
     uint32_t last_call;
+#if LV_GIF_CACHE_SIZE
+    lv_gif_frame_t * frames;
+    uint32_t cache_size;        /*Memory used by `frames` [bytes]*/
+    uint16_t frame_cnt;
+    uint16_t frame_act;         /*Index of the next frame to play from the cache*/
+    lv_gif_cache_state_t cache_state;
+#endif
 } lv_gif_t;
 
 extern const lv_obj_class_t lv_gif_class;
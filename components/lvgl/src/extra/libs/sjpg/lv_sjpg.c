@@ -39,6 +39,12 @@
 /   We are using TJpgDec - Tiny JPEG Decompressor library from ELM-CHAN for decoding each split-jpeg fragments.
 /   The tjpgd.c and tjpgd.h is not modified and those are used as it is. So if any update comes for the tiny-jpeg,
 /   just replace those files with updated files.
+/   Only `jd_decomp_start()` and `jd_decomp_row()` were added to decode normal JPGs MCU row by MCU row. They need to
+/   be added again after an update.
+/
+/   The decoded pixels are stored directly as `lv_color_t` (tjpgd outputs RGB565 if LV_COLOR_DEPTH is 16).
+/   If the `header` of a C array source is smaller than the image, it's decoded scaled down by 1/2, 1/4 or 1/8 to be
+/   still at least as large as the `header`.
 /---------------------------------------------------------------------------------------------------------------------------------*/
 
 /*********************
@@ -77,9 +83,10 @@ enum io_source_type {
 typedef struct {
     enum io_source_type type;
     lv_fs_file_t lv_file;
-    uint8_t * img_cache_buff;
+    lv_color_t * img_cache_buff;
     int img_cache_x_res;
     int img_cache_y_res;
+    int img_cache_y;                      //The row of the image stored in the first row of img_cache_buff.
     uint8_t * raw_sjpg_data;              //Used when type==SJPEG_IO_SOURCE_C_ARRAY.
     uint32_t raw_sjpg_data_size;          //Num bytes pointed to by raw_sjpg_data.
     uint32_t raw_sjpg_data_next_read_pos; //Used for all types.
@@ -95,7 +102,11 @@ typedef struct {
     int sjpeg_cache_frame_index;
     uint8_t ** frame_base_array;        //to save base address of each split frames upto sjpeg_total_frames.
     int * frame_base_offset;            //to save base offset for fseek
-    uint8_t * frame_cache;
+    lv_color_t * frame_cache;
+    uint8_t scale;                      //tjpgd scale factor: the image is decoded at 1 / 2^scale size
+    uint8_t jpg_rows;                   //1: normal JPG whose MCU rows are used as frames
+    int out_x_res;                      //Width of the decoded (scaled) image
+    int out_frame_height;               //Height of the decoded (scaled) frames
     uint8_t * workb;                    //JPG work buffer for jpeg library
     JDEC * tjpeg_jd;
     io_source_t io;
@@ -111,6 +122,10 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
 static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
+static uint8_t get_scale(const void * src, int x_res, int y_res, int frame_height);
+static lv_res_t sjpeg_buffers_alloc(SJPEG * sjpeg, const void * src);
+static lv_res_t decode_frame(SJPEG * sjpeg, int frame_index);
+static lv_res_t decode_jpg_rows(SJPEG * sjpeg, int frame_index);
 static void lv_sjpg_cleanup(SJPEG * sjpeg);
 static void lv_sjpg_free(SJPEG * sjpeg);
 
@@ -166,11 +181,19 @@ static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_im
             header->always_zero = 0;
             header->cf = LV_IMG_CF_RAW;
 
-            header->w = *raw_sjpeg_data++;
-            header->w |= *raw_sjpeg_data++ << 8;
+            int x_res = *raw_sjpeg_data++;
+            x_res |= *raw_sjpeg_data++ << 8;
+
+            int y_res = *raw_sjpeg_data++;
+            y_res |= *raw_sjpeg_data++ << 8;
 
-            header->h = *raw_sjpeg_data++;
-            header->h |= *raw_sjpeg_data++ << 8;
+            raw_sjpeg_data += 2; //skip the total frames
+            int frame_height = *raw_sjpeg_data++;
+            frame_height |= *raw_sjpeg_data++ << 8;
+
+            uint8_t scale = get_scale(src, x_res, y_res, frame_height);
+            header->w = x_res >> scale;
+            header->h = y_res >> scale;
 
             return ret;
 
@@ -192,8 +215,9 @@ static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_im
 
             JRESULT rc = jd_prepare(&jd_tmp, input_func, workb_temp, (size_t)TJPGD_WORKBUFF_SIZE, &io_source_temp);
             if(rc == JDR_OK) {
-                header->w = jd_tmp.width;
-                header->h = jd_tmp.height;
+                uint8_t scale = get_scale(src, jd_tmp.width, jd_tmp.height, jd_tmp.msy * 8);
+                header->w = jd_tmp.width >> scale;
+                header->h = jd_tmp.height >> scale;
 
             }
             else {
@@ -282,17 +306,31 @@ end:
 static int img_data_cb(JDEC * jd, void * data, JRECT * rect)
 {
     io_source_t * io = jd->device;
-    uint8_t * cache = io->img_cache_buff;
+    lv_color_t * cache = io->img_cache_buff;
     const int xres = io->img_cache_x_res;
-    uint8_t * buf = data;
-    const int INPUT_PIXEL_SIZE = 3;
     const int row_width = rect->right - rect->left + 1; // Row width in pixels.
-    const int row_size = row_width * INPUT_PIXEL_SIZE;  // Row size (bytes).
+#if JD_FORMAT == 1
+    const uint16_t * buf = data;                        // RGB565
+#else
+    const uint8_t * buf = data;                         // RGB888
+#endif
 
     for(int y = rect->top; y <= rect->bottom; y++) {
-        int row_offset = y * xres * INPUT_PIXEL_SIZE + rect->left * INPUT_PIXEL_SIZE;
-        memcpy(cache + row_offset, buf, row_size);
-        buf += row_size;
+        lv_color_t * row = cache + (y - io->img_cache_y) * xres + rect->left;
+#if JD_FORMAT == 1 && LV_COLOR_16_SWAP == 0
+        memcpy(row, buf, row_width * sizeof(lv_color_t));
+        buf += row_width;
+#else
+        for(int x = 0; x < row_width; x++) {
+#if JD_FORMAT == 1
+            row[x].full = (uint16_t)((*buf >> 8) | (*buf << 8));
+            buf++;
+#else
+            row[x] = lv_color_make(buf[0], buf[1], buf[2]);
+            buf += 3;
+#endif
+        }
+#endif
     }
 
     return 1;
@@ -395,27 +433,12 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->frame_base_array[i] = sjpeg->frame_base_array[i - 1] + offset;
             }
             sjpeg->sjpeg_cache_frame_index = -1;
-            sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3/*2*/);
-            if(! sjpeg->frame_cache) {
-                lv_sjpg_cleanup(sjpeg);
-                sjpeg = NULL;
-                return LV_RES_INV;
-            }
-            sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-            sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
-            sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
-            if(! sjpeg->workb) {
+            if(sjpeg_buffers_alloc(sjpeg, dsc->src) != LV_RES_OK) {
                 lv_sjpg_cleanup(sjpeg);
                 sjpeg = NULL;
                 return LV_RES_INV;
             }
 
-            sjpeg->tjpeg_jd =   lv_mem_alloc(sizeof(JDEC));
-            if(! sjpeg->tjpeg_jd) {
-                lv_sjpg_cleanup(sjpeg);
-                sjpeg = NULL;
-                return LV_RES_INV;
-            }
             sjpeg->io.type = SJPEG_IO_SOURCE_C_ARRAY;
             sjpeg->io.lv_file.file_d = NULL;
             dsc->img_data = NULL;
@@ -456,25 +479,13 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 uint8_t * img_frame_base = sjpeg->sjpeg_data;
                 sjpeg->frame_base_array[0] = img_frame_base;
 
+                /*Use the MCU rows as frames to decode only the rows up to the requested one*/
+                sjpeg->jpg_rows = 1;
+                sjpeg->sjpeg_single_frame_height = jd_tmp.msy * 8;
+                sjpeg->sjpeg_total_frames = (jd_tmp.height + sjpeg->sjpeg_single_frame_height - 1) /
+                                            sjpeg->sjpeg_single_frame_height;
                 sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_sjpg_cleanup(sjpeg);
-                    sjpeg = NULL;
-                    return LV_RES_INV;
-                }
-
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
-                sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
-                if(! sjpeg->workb) {
-                    lv_sjpg_cleanup(sjpeg);
-                    sjpeg = NULL;
-                    return LV_RES_INV;
-                }
-
-                sjpeg->tjpeg_jd =   lv_mem_alloc(sizeof(JDEC));
-                if(! sjpeg->tjpeg_jd) {
+                if(sjpeg_buffers_alloc(sjpeg, dsc->src) != LV_RES_OK) {
                     lv_sjpg_cleanup(sjpeg);
                     sjpeg = NULL;
                     return LV_RES_INV;
@@ -574,23 +585,7 @@ end:
                 }
 
                 sjpeg->sjpeg_cache_frame_index = -1; //INVALID AT BEGINNING for a forced compare mismatch at first time.
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
-                sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
-                if(! sjpeg->workb) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-
-                sjpeg->tjpeg_jd =    lv_mem_alloc(sizeof(JDEC));
-                if(! sjpeg->tjpeg_jd) {
+                if(sjpeg_buffers_alloc(sjpeg, dsc->src) != LV_RES_OK) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
@@ -660,25 +655,13 @@ end:
                 int img_frame_start_offset = 0;
                 sjpeg->frame_base_offset[0] = img_frame_start_offset;
 
+                /*Use the MCU rows as frames to decode only the rows up to the requested one*/
+                sjpeg->jpg_rows = 1;
+                sjpeg->sjpeg_single_frame_height = jd_tmp.msy * 8;
+                sjpeg->sjpeg_total_frames = (jd_tmp.height + sjpeg->sjpeg_single_frame_height - 1) /
+                                            sjpeg->sjpeg_single_frame_height;
                 sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
-                sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
-                if(! sjpeg->workb) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-
-                sjpeg->tjpeg_jd =   lv_mem_alloc(sizeof(JDEC));
-                if(! sjpeg->tjpeg_jd) {
+                if(sjpeg_buffers_alloc(sjpeg, dsc->src) != LV_RES_OK) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
@@ -717,141 +700,108 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
                                   lv_coord_t len, uint8_t * buf)
 {
     LV_UNUSED(decoder);
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
+    if(dsc->src_type != LV_IMG_SRC_VARIABLE && dsc->src_type != LV_IMG_SRC_FILE) return LV_RES_INV;
 
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[ sjpeg_req_frame_index ];
-            if(sjpeg_req_frame_index == (sjpeg->sjpeg_total_frames - 1)) {
-                /*This is the last frame. */
-                const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
-                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
-            }
-            else {
-                sjpeg->io.raw_sjpg_data_size =
-                    (uint32_t)(sjpeg->frame_base_array[sjpeg_req_frame_index + 1] - sjpeg->io.raw_sjpg_data);
-            }
-            sjpeg->io.raw_sjpg_data_next_read_pos = 0;
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
+    SJPEG * sjpeg = (SJPEG *) dsc->user_data;
+    int sjpeg_req_frame_index = y / sjpeg->out_frame_height;
+
+    /*If line not from cache, refresh cache */
+    if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
+        lv_res_t res;
+        if(sjpeg->jpg_rows) res = decode_jpg_rows(sjpeg, sjpeg_req_frame_index);
+        else res = decode_frame(sjpeg, sjpeg_req_frame_index);
+        if(res != LV_RES_OK) return LV_RES_INV;
+    }
 
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if  LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
+    const lv_color_t * cache = sjpeg->frame_cache + x + (y % sjpeg->out_frame_height) * sjpeg->out_x_res;
+    lv_memcpy(buf, cache, len * sizeof(lv_color_t));
 
-#elif  LV_COLOR_DEPTH == 16
+    return LV_RES_OK;
+}
 
-        for(int i = 0; i < len; i++) {
-            uint16_t col_16bit = (*cache++ & 0xf8) << 8;
-            col_16bit |= (*cache++ & 0xFC) << 3;
-            col_16bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_16bit >> 8;
-            buf[offset++] = col_16bit & 0xff;
-#else
-            buf[offset++] = col_16bit & 0xff;
-            buf[offset++] = col_16bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
+/**
+ * Decode a JPEG fragment of an SJPG into the frame cache
+ * @param sjpeg pointer to the decoding session
+ * @param frame_index index of the fragment to decode
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+static lv_res_t decode_frame(SJPEG * sjpeg, int frame_index)
+{
+    JRESULT rc;
+
+    if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) {
+        sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[frame_index];
+        if(frame_index == (sjpeg->sjpeg_total_frames - 1)) {
+            /*This is the last frame. */
+            const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
+            sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
         }
-
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
+        else {
+            sjpeg->io.raw_sjpg_data_size =
+                (uint32_t)(sjpeg->frame_base_array[frame_index + 1] - sjpeg->io.raw_sjpg_data);
         }
-#else
-#error Unsupported LV_COLOR_DEPTH
-
-#endif // LV_COLOR_DEPTH
-        return LV_RES_OK;
+        sjpeg->io.raw_sjpg_data_next_read_pos = 0;
+    }
+    else {
+        sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset[frame_index]);
+        lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
     }
-    else if(dsc->src_type == LV_IMG_SRC_FILE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        lv_fs_file_t * lv_file_p = &(sjpeg->io.lv_file);
-        if(!lv_file_p) goto end;
 
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset [ sjpeg_req_frame_index ]);
-            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
+    /*Invalidate the cache while it's overwritten*/
+    sjpeg->sjpeg_cache_frame_index = -1;
 
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
+    rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
+    if(rc != JDR_OK) return LV_RES_INV;
 
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
+    sjpeg->io.img_cache_y = 0;
+    rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, sjpeg->scale);
+    if(rc != JDR_OK) return LV_RES_INV;
 
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
+    sjpeg->sjpeg_cache_frame_index = frame_index;
+    return LV_RES_OK;
+}
 
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
-#elif  LV_COLOR_DEPTH == 16
-
-        for(int i = 0; i < len; i++) {
-            uint16_t col_8bit = (*cache++ & 0xf8) << 8;
-            col_8bit |= (*cache++ & 0xFC) << 3;
-            col_8bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_8bit >> 8;
-            buf[offset++] = col_8bit & 0xff;
-#else
-            buf[offset++] = col_8bit & 0xff;
-            buf[offset++] = col_8bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
+/**
+ * Decode the MCU rows of a normal JPG until the requested one is in the frame cache.
+ * The rows can be decoded only in order so the decoding continues from the last decoded row
+ * or starts again from the first one if a previous row is requested.
+ * @param sjpeg pointer to the decoding session
+ * @param frame_index index of the MCU row to decode
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+static lv_res_t decode_jpg_rows(SJPEG * sjpeg, int frame_index)
+{
+    JRESULT rc;
+
+    if(sjpeg->sjpeg_cache_frame_index < 0 || frame_index < sjpeg->sjpeg_cache_frame_index) {
+        sjpeg->sjpeg_cache_frame_index = -1;
+        sjpeg->io.raw_sjpg_data_next_read_pos = 0;
+        if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) {
+            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[0];
+            sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size;
         }
-
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
+        else {
+            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->frame_base_offset[0], LV_FS_SEEK_SET);
         }
 
-#else
-#error Unsupported LV_COLOR_DEPTH
+        rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
+        if(rc != JDR_OK) return LV_RES_INV;
 
-#endif // LV_COLOR_DEPTH
+        rc = jd_decomp_start(sjpeg->tjpeg_jd, sjpeg->scale);
+        if(rc != JDR_OK) return LV_RES_INV;
+    }
 
-        return LV_RES_OK;
+    while(sjpeg->sjpeg_cache_frame_index < frame_index) {
+        sjpeg->io.img_cache_y = (sjpeg->sjpeg_cache_frame_index + 1) * sjpeg->out_frame_height;
+        rc = jd_decomp_row(sjpeg->tjpeg_jd, img_data_cb);
+        if(rc != JDR_OK) {
+            sjpeg->sjpeg_cache_frame_index = -1;
+            return LV_RES_INV;
+        }
+        sjpeg->sjpeg_cache_frame_index++;
     }
-end:
-    return LV_RES_INV;
+
+    return LV_RES_OK;
 }
 
 /**
@@ -890,6 +840,58 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
     return memcmp(jpg_signature, raw_data, sizeof(jpg_signature)) == 0;
 }
 
+/**
+ * Get the tjpgd scale factor for an image.
+ * If the `header` of a C array source is smaller than the image, the image is scaled down
+ * by 1/2, 1/4 or 1/8 while it's still at least as large as the `header`.
+ * @param src the image source
+ * @param x_res width of the image
+ * @param y_res height of the image
+ * @param frame_height height of the frames which needs to remain integer after scaling
+ * @return the scale factor (0..3): the image is decoded at 1 / 2^scale size
+ */
+static uint8_t get_scale(const void * src, int x_res, int y_res, int frame_height)
+{
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return 0;
+
+    const lv_img_dsc_t * img_dsc = src;
+    if(img_dsc->header.w == 0 || img_dsc->header.h == 0) return 0;
+
+    uint8_t scale = 0;
+    while(scale < 3 && (x_res >> (scale + 1)) >= img_dsc->header.w && (y_res >> (scale + 1)) >= img_dsc->header.h &&
+          (frame_height & ((2 << scale) - 1)) == 0) {
+        scale++;
+    }
+
+    return scale;
+}
+
+/**
+ * Select the scale and allocate the frame cache and the tjpgd buffers of a decoding session
+ * @param sjpeg pointer to the decoding session with the resolution and frame height already set
+ * @param src the image source
+ * @return LV_RES_OK: no error; LV_RES_INV: out of memory
+ */
+static lv_res_t sjpeg_buffers_alloc(SJPEG * sjpeg, const void * src)
+{
+    sjpeg->scale = get_scale(src, sjpeg->sjpeg_x_res, sjpeg->sjpeg_y_res, sjpeg->sjpeg_single_frame_height);
+    sjpeg->out_x_res = sjpeg->sjpeg_x_res >> sjpeg->scale;
+    sjpeg->out_frame_height = sjpeg->sjpeg_single_frame_height >> sjpeg->scale;
+
+    sjpeg->frame_cache = lv_mem_alloc(sjpeg->out_x_res * sjpeg->out_frame_height * sizeof(lv_color_t));
+    if(! sjpeg->frame_cache) return LV_RES_INV;
+
+    sjpeg->io.img_cache_buff = sjpeg->frame_cache;
+    sjpeg->io.img_cache_x_res = sjpeg->out_x_res;
+    sjpeg->workb = lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
+    if(! sjpeg->workb) return LV_RES_INV;
+
+    sjpeg->tjpeg_jd = lv_mem_alloc(sizeof(JDEC));
+    if(! sjpeg->tjpeg_jd) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
 static void lv_sjpg_free(SJPEG * sjpeg)
 {
     if(sjpeg->frame_cache) lv_mem_free(sjpeg->frame_cache);
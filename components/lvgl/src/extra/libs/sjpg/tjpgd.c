@@ -1112,41 +1112,77 @@ JRESULT jd_prepare (
 
 
 /*-----------------------------------------------------------------------*/
-/* Start to decompress the JPEG picture                                  */
+/* Start to decompress the JPEG picture MCU row by MCU row               */
 /*-----------------------------------------------------------------------*/
 
-JRESULT jd_decomp (
+JRESULT jd_decomp_start (
 	JDEC* jd,								/* Initialized decompression object */
-	int (*outfunc)(JDEC*, void*, JRECT*),	/* RGB output function */
 	uint8_t scale							/* Output de-scaling factor (0 to 3) */
 )
 {
-	unsigned int x, y, mx, my;
-	uint16_t rst, rsc;
+	if (scale > (JD_USE_SCALE ? 3 : 0)) return JDR_PAR;
+	jd->scale = scale;
+
+	jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;	/* Initialize DC values */
+	jd->rst = jd->rsc = 0;
+	jd->mcu_y = 0;
+
+	return JDR_OK;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Decompress the next MCU row of the JPEG picture                       */
+/*-----------------------------------------------------------------------*/
+
+JRESULT jd_decomp_row (
+	JDEC* jd,								/* Decompression object after jd_decomp_start() */
+	int (*outfunc)(JDEC*, void*, JRECT*)	/* RGB output function */
+)
+{
+	unsigned int x, mx;
 	JRESULT rc;
 
 
-	if (scale > (JD_USE_SCALE ? 3 : 0)) return JDR_PAR;
-	jd->scale = scale;
+	if (jd->mcu_y >= jd->height) return JDR_PAR;	/* No more rows */
 
-	mx = jd->msx * 8; my = jd->msy * 8;			/* Size of the MCU (pixel) */
+	mx = jd->msx * 8;							/* Width of the MCU (pixel) */
 
-	jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;	/* Initialize DC values */
-	rst = rsc = 0;
-
-	rc = JDR_OK;
-	for (y = 0; y < jd->height; y += my) {		/* Vertical loop of MCUs */
-		for (x = 0; x < jd->width; x += mx) {	/* Horizontal loop of MCUs */
-			if (jd->nrst && rst++ == jd->nrst) {	/* Process restart interval if enabled */
-				rc = restart(jd, rsc++);
-				if (rc != JDR_OK) return rc;
-				rst = 1;
-			}
-			rc = mcu_load(jd);					/* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
-			if (rc != JDR_OK) return rc;
-			rc = mcu_output(jd, outfunc, x, y);	/* Output the MCU (YCbCr to RGB, scaling and output) */
+	for (x = 0; x < jd->width; x += mx) {		/* Horizontal loop of MCUs */
+		if (jd->nrst && jd->rst++ == jd->nrst) {	/* Process restart interval if enabled */
+			rc = restart(jd, jd->rsc++);
 			if (rc != JDR_OK) return rc;
+			jd->rst = 1;
 		}
+		rc = mcu_load(jd);					/* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+		if (rc != JDR_OK) return rc;
+		rc = mcu_output(jd, outfunc, x, jd->mcu_y);	/* Output the MCU (YCbCr to RGB, scaling and output) */
+		if (rc != JDR_OK) return rc;
+	}
+	jd->mcu_y += jd->msy * 8;					/* Height of the MCU (pixel) */
+
+	return JDR_OK;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Start to decompress the JPEG picture                                  */
+/*-----------------------------------------------------------------------*/
+
+JRESULT jd_decomp (
+	JDEC* jd,								/* Initialized decompression object */
+	int (*outfunc)(JDEC*, void*, JRECT*),	/* RGB output function */
+	uint8_t scale							/* Output de-scaling factor (0 to 3) */
+)
+{
+	JRESULT rc;
+
+
+	rc = jd_decomp_start(jd, scale);
+	while (rc == JDR_OK && jd->mcu_y < jd->height) {	/* Vertical loop of MCUs */
+		rc = jd_decomp_row(jd, outfunc);
 	}
 
 	return rc;
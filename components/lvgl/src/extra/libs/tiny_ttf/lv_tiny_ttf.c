@@ -2,6 +2,7 @@
 
 #if LV_USE_TINY_TTF
 #include <stdio.h>
+#include <string.h>
 #include "../../../misc/lv_lru.h"
 
 #define STB_RECT_PACK_IMPLEMENTATION
@@ -63,7 +64,21 @@ static void ttf_cb_stream_seek(ttf_cb_stream_t * stream, size_t position)
 #include "stb_rect_pack.h"
 #include "stb_truetype_htcw.h"
 
-typedef struct ttf_font_desc {
+#define TTF_KERN_CACHE_SIZE 64 /*Must be a power of 2*/
+
+typedef struct ttf_kern_cache_entry {
+    uint32_t unicode_letter;
+    uint32_t unicode_letter_next;
+    int kern; /*In font units, so it's the same for every size*/
+} ttf_kern_cache_entry_t;
+
+/* the parsed font data, shared by every font created from the same data or path at any size */
+typedef struct ttf_font_core {
+    struct ttf_font_core * next;
+    const void * data;
+    size_t data_size;
+    char * path;
+    uint32_t ref_cnt;
     lv_fs_file_t file;
 #if LV_TINY_TTF_FILE_SUPPORT
     ttf_cb_stream_t stream;
@@ -71,16 +86,92 @@ typedef struct ttf_font_desc {
     const uint8_t * stream;
 #endif
     stbtt_fontinfo info;
-    float scale;
     int ascent;
     int descent;
-    lv_lru_t * bitmap_cache;
+    int line_gap;
+    lv_lru_t * glyph_cache;   /*Metrics and bitmaps of the glyphs at every size*/
+    ttf_kern_cache_entry_t kern_cache[TTF_KERN_CACHE_SIZE];
+} ttf_font_core_t;
+
+typedef struct ttf_font_desc {
+    ttf_font_core_t * core;
+    lv_coord_t font_size;
+    float scale;
+    size_t cache_size;
 } ttf_font_desc_t;
 
-typedef struct ttf_bitmap_cache_key {
+typedef struct ttf_glyph_cache_key {
     uint32_t unicode_letter;
-    lv_coord_t line_height;
-} ttf_bitmap_cache_key_t;
+    lv_coord_t font_size;
+} ttf_glyph_cache_key_t;
+
+/* the metrics of a glyph at a font size, followed by its bitmap once it's rendered */
+typedef struct ttf_glyph {
+    int glyph_index;
+    int adv_w; /*In font units*/
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+    bool rendered;
+} ttf_glyph_t;
+
+static ttf_font_core_t * core_list;
+
+static void ttf_glyph_cache_key_init(ttf_glyph_cache_key_t * key, const ttf_font_desc_t * dsc, uint32_t unicode_letter)
+{
+    lv_memset_00(key, sizeof(ttf_glyph_cache_key_t)); /*Zero padding*/
+    key->unicode_letter = unicode_letter;
+    key->font_size = dsc->font_size;
+}
+
+static ttf_glyph_t * ttf_glyph_get(const ttf_font_desc_t * dsc, uint32_t unicode_letter)
+{
+    ttf_font_core_t * core = dsc->core;
+    ttf_glyph_cache_key_t cache_key;
+    ttf_glyph_cache_key_init(&cache_key, dsc, unicode_letter);
+    ttf_glyph_t * glyph = NULL;
+    lv_lru_get(core->glyph_cache, &cache_key, sizeof(cache_key), (void **)&glyph);
+    if(glyph) {
+        return glyph;
+    }
+    LV_LOG_TRACE("cache miss for letter: %u", unicode_letter);
+    glyph = lv_mem_alloc(sizeof(ttf_glyph_t));
+    if(!glyph) {
+        LV_LOG_ERROR("failed to allocate cache value");
+        return NULL;
+    }
+    /*A missing glyph is cached too with glyph_index == 0*/
+    glyph->glyph_index = stbtt_FindGlyphIndex(&core->info, (int)unicode_letter);
+    int lsb;
+    stbtt_GetGlyphHMetrics(&core->info, glyph->glyph_index, &glyph->adv_w, &lsb);
+    stbtt_GetGlyphBitmapBox(&core->info, glyph->glyph_index, dsc->scale, dsc->scale, &glyph->x1, &glyph->y1, &glyph->x2,
+                            &glyph->y2);
+    glyph->rendered = false;
+    if(LV_LRU_OK != lv_lru_set(core->glyph_cache, &cache_key, sizeof(cache_key), glyph, sizeof(ttf_glyph_t))) {
+        LV_LOG_ERROR("failed to add cache value");
+        lv_mem_free(glyph);
+        return NULL;
+    }
+    return glyph;
+}
+
+static int ttf_kern_get(ttf_font_core_t * core, int g1, uint32_t unicode_letter, uint32_t unicode_letter_next)
+{
+    uint32_t i = (unicode_letter * 31 + unicode_letter_next) & (TTF_KERN_CACHE_SIZE - 1);
+    ttf_kern_cache_entry_t * entry = &core->kern_cache[i];
+    if(entry->unicode_letter == unicode_letter && entry->unicode_letter_next == unicode_letter_next) {
+        return entry->kern;
+    }
+    int g2 = 0;
+    if(unicode_letter_next != 0) {
+        g2 = stbtt_FindGlyphIndex(&core->info, (int)unicode_letter_next);
+    }
+    entry->unicode_letter = unicode_letter;
+    entry->unicode_letter_next = unicode_letter_next;
+    entry->kern = stbtt_GetGlyphKernAdvance(&core->info, g1, g2);
+    return entry->kern;
+}
 
 static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                  uint32_t unicode_letter_next)
@@ -98,31 +189,19 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
         return true;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    int g1 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter);
-    if(g1 == 0) {
+    ttf_glyph_t * glyph = ttf_glyph_get(dsc, unicode_letter);
+    if(glyph == NULL || glyph->glyph_index == 0) {
         /* Glyph not found */
         return false;
     }
-    int x1, y1, x2, y2;
-
-    stbtt_GetGlyphBitmapBox(&dsc->info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-    int g2 = 0;
-    if(unicode_letter_next != 0) {
-        g2 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter_next);
-    }
-    int advw, lsb;
-    stbtt_GetGlyphHMetrics(&dsc->info, g1, &advw, &lsb);
-    int k = stbtt_GetGlyphKernAdvance(&dsc->info, g1, g2);
-    dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
+    int k = ttf_kern_get(dsc->core, glyph->glyph_index, unicode_letter, unicode_letter_next);
+    dsc_out->adv_w = (uint16_t)floor((((float)glyph->adv_w + (float)k) * dsc->scale) +
                                      0.5f); /*Horizontal space required by the glyph in [px]*/
-
-    dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
-                                     0.5f); /*Horizontal space required by the glyph in [px]*/
-    dsc_out->box_w = (x2 - x1 + 1);         /*width of the bitmap in [px]*/
-    dsc_out->box_h = (y2 - y1 + 1);         /*height of the bitmap in [px]*/
-    dsc_out->ofs_x = x1;                    /*X offset of the bitmap in [pf]*/
-    dsc_out->ofs_y = -y2;                   /*Y offset of the bitmap measured from the as line*/
-    dsc_out->bpp = 8;                       /*Bits per pixel: 1/2/4/8*/
+    dsc_out->box_w = (glyph->x2 - glyph->x1 + 1); /*width of the bitmap in [px]*/
+    dsc_out->box_h = (glyph->y2 - glyph->y1 + 1); /*height of the bitmap in [px]*/
+    dsc_out->ofs_x = glyph->x1;                   /*X offset of the bitmap in [pf]*/
+    dsc_out->ofs_y = -glyph->y2;                  /*Y offset of the bitmap measured from the as line*/
+    dsc_out->bpp = 8;                             /*Bits per pixel: 1/2/4/8*/
     dsc_out->is_placeholder = false;
     return true; /*true: glyph found; false: glyph was not found*/
 }
@@ -130,97 +209,181 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
 static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t unicode_letter)
 {
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    const stbtt_fontinfo * info = (const stbtt_fontinfo *)&dsc->info;
-    int g1 = stbtt_FindGlyphIndex(info, (int)unicode_letter);
-    if(g1 == 0) {
+    ttf_glyph_t * glyph = ttf_glyph_get(dsc, unicode_letter);
+    if(glyph == NULL || glyph->glyph_index == 0) {
         /* Glyph not found */
         return NULL;
     }
-    int x1, y1, x2, y2;
-    stbtt_GetGlyphBitmapBox(info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
+    if(glyph->rendered) {
+        return (const uint8_t *)(glyph + 1);
+    }
     int w, h;
-    w = x2 - x1 + 1;
-    h = y2 - y1 + 1;
+    w = glyph->x2 - glyph->x1 + 1;
+    h = glyph->y2 - glyph->y1 + 1;
     uint32_t stride = w;
-    /*Try to load from cache*/
-    ttf_bitmap_cache_key_t cache_key;
-    lv_memset(&cache_key, 0, sizeof(cache_key)); /*Zero padding*/
-    cache_key.unicode_letter = unicode_letter;
-    cache_key.line_height = font->line_height;
-    uint8_t * buffer = NULL;
-    lv_lru_get(dsc->bitmap_cache, &cache_key, sizeof(cache_key), (void **)&buffer);
-    if(buffer) {
-        return buffer;
-    }
-    LV_LOG_TRACE("cache miss for letter: %u", unicode_letter);
-    /*Prepare space in cache*/
-    size_t szb = h * stride;
-    buffer = lv_mem_alloc(szb);
-    if(!buffer) {
+    /*Replace the metrics in the cache with the metrics and the bitmap*/
+    size_t szb = sizeof(ttf_glyph_t) + h * stride;
+    ttf_glyph_t * rendered = lv_mem_alloc(szb);
+    if(!rendered) {
         LV_LOG_ERROR("failed to allocate cache value");
         return NULL;
     }
-    lv_memset(buffer, 0, szb);
-    if(LV_LRU_OK != lv_lru_set(dsc->bitmap_cache, &cache_key, sizeof(cache_key), buffer, szb)) {
+    *rendered = *glyph;
+    rendered->rendered = true;
+    uint8_t * buffer = (uint8_t *)(rendered + 1);
+    lv_memset_00(buffer, h * stride);
+    /*Render into cache*/
+    stbtt_MakeGlyphBitmap(&dsc->core->info, buffer, w, h, stride, dsc->scale, dsc->scale, rendered->glyph_index);
+    ttf_glyph_cache_key_t cache_key;
+    ttf_glyph_cache_key_init(&cache_key, dsc, unicode_letter);
+    if(LV_LRU_OK != lv_lru_set(dsc->core->glyph_cache, &cache_key, sizeof(cache_key), rendered, szb)) {
         LV_LOG_ERROR("failed to add cache value");
-        lv_mem_free(buffer);
+        lv_mem_free(rendered);
         return NULL;
     }
-    /*Render into cache*/
-    stbtt_MakeGlyphBitmap(info, buffer, w, h, stride, dsc->scale, dsc->scale, g1);
     return buffer;
 }
 
-static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size_t data_size, lv_coord_t font_size,
-                                      size_t cache_size)
+static ttf_font_core_t * ttf_font_core_find(const char * path, const void * data, size_t data_size)
 {
-    if((path == NULL && data == NULL) || 0 >= font_size) {
-        LV_LOG_ERROR("tiny_ttf: invalid argument\n");
-        return NULL;
+    ttf_font_core_t * core;
+    for(core = core_list; core != NULL; core = core->next) {
+        if(path != NULL) {
+            if(core->path != NULL && strcmp(core->path, path) == 0) return core;
+        }
+        else if(core->data == data && core->data_size == data_size) {
+            return core;
+        }
     }
-    ttf_font_desc_t * dsc = (ttf_font_desc_t *)TTF_MALLOC(sizeof(ttf_font_desc_t));
-    if(dsc == NULL) {
+    return NULL;
+}
+
+static ttf_font_core_t * ttf_font_core_get(const char * path, const void * data, size_t data_size,
+                                           lv_coord_t font_size, size_t cache_size)
+{
+    ttf_font_core_t * core = ttf_font_core_find(path, data, data_size);
+    if(core != NULL) {
+        /*Every font adds its cache size to the shared cache*/
+        core->glyph_cache->total_memory += cache_size;
+        core->glyph_cache->free_memory += cache_size;
+        core->ref_cnt++;
+        return core;
+    }
+
+    core = (ttf_font_core_t *)TTF_MALLOC(sizeof(ttf_font_core_t));
+    if(core == NULL) {
         LV_LOG_ERROR("tiny_ttf: out of memory\n");
         return NULL;
     }
+    lv_memset_00(core, sizeof(ttf_font_core_t));
 #if LV_TINY_TTF_FILE_SUPPORT
     if(path != NULL) {
-        if(LV_FS_RES_OK != lv_fs_open(&dsc->file, path, LV_FS_MODE_RD)) {
+        core->path = TTF_MALLOC(strlen(path) + 1);
+        if(core->path == NULL) {
+            LV_LOG_ERROR("tiny_ttf: out of memory\n");
+            goto err_after_core;
+        }
+        strcpy(core->path, path);
+        if(LV_FS_RES_OK != lv_fs_open(&core->file, path, LV_FS_MODE_RD)) {
             LV_LOG_ERROR("tiny_ttf: unable to open %s\n", path);
-            goto err_after_dsc;
+            goto err_after_core;
         }
-        dsc->stream.file = &dsc->file;
+        core->stream.file = &core->file;
     }
     else {
-        dsc->stream.file = NULL;
-        dsc->stream.data = (const uint8_t *)data;
-        dsc->stream.size = data_size;
-        dsc->stream.position = 0;
+        core->stream.file = NULL;
+        core->stream.data = (const uint8_t *)data;
+        core->stream.size = data_size;
+        core->stream.position = 0;
     }
-    if(0 == stbtt_InitFont(&dsc->info, &dsc->stream, stbtt_GetFontOffsetForIndex(&dsc->stream, 0))) {
+    if(0 == stbtt_InitFont(&core->info, &core->stream, stbtt_GetFontOffsetForIndex(&core->stream, 0))) {
         LV_LOG_ERROR("tiny_ttf: init failed\n");
-        goto err_after_dsc;
+        goto err_after_file;
     }
 
 #else
-    dsc->stream = (const uint8_t *)data;
-    LV_UNUSED(data_size);
-    if(0 == stbtt_InitFont(&dsc->info, dsc->stream, stbtt_GetFontOffsetForIndex(dsc->stream, 0))) {
+    core->stream = (const uint8_t *)data;
+    if(0 == stbtt_InitFont(&core->info, core->stream, stbtt_GetFontOffsetForIndex(core->stream, 0))) {
         LV_LOG_ERROR("tiny_ttf: init failed\n");
-        goto err_after_dsc;
+        goto err_after_file;
     }
 #endif
+    core->data = data;
+    core->data_size = data_size;
+    stbtt_GetFontVMetrics(&core->info, &core->ascent, &core->descent, &core->line_gap);
 
-    dsc->bitmap_cache = lv_lru_create(cache_size, font_size * font_size, lv_mem_free, lv_mem_free);
-    if(dsc->bitmap_cache == NULL) {
+    core->glyph_cache = lv_lru_create(cache_size, font_size * font_size, lv_mem_free, lv_mem_free);
+    if(core->glyph_cache == NULL) {
         LV_LOG_ERROR("failed to create lru cache");
+        goto err_after_file;
+    }
+    core->ref_cnt = 1;
+    core->next = core_list;
+    core_list = core;
+    return core;
+
+err_after_file:
+#if LV_TINY_TTF_FILE_SUPPORT
+    if(core->stream.file != NULL) {
+        lv_fs_close(&core->file);
+    }
+err_after_core:
+#endif
+    if(core->path != NULL) TTF_FREE(core->path);
+    TTF_FREE(core);
+    return NULL;
+}
+
+static void ttf_font_core_release(ttf_font_core_t * core, size_t cache_size)
+{
+    core->ref_cnt--;
+    if(core->ref_cnt > 0) {
+        /*Give back the cache size of the font*/
+        lv_lru_t * cache = core->glyph_cache;
+        while(cache->free_memory < cache_size && cache->free_memory < cache->total_memory) {
+            lv_lru_remove_lru_item(cache);
+        }
+        cache->free_memory -= cache_size;
+        cache->total_memory -= cache_size;
+        return;
+    }
+
+    ttf_font_core_t ** prev = &core_list;
+    while(*prev != core) prev = &(*prev)->next;
+    *prev = core->next;
+
+#if LV_TINY_TTF_FILE_SUPPORT
+    if(core->stream.file != NULL) {
+        lv_fs_close(&core->file);
+    }
+#endif
+    lv_lru_del(core->glyph_cache);
+    if(core->path != NULL) TTF_FREE(core->path);
+    TTF_FREE(core);
+}
+
+static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size_t data_size, lv_coord_t font_size,
+                                      size_t cache_size)
+{
+    if((path == NULL && data == NULL) || 0 >= font_size) {
+        LV_LOG_ERROR("tiny_ttf: invalid argument\n");
+        return NULL;
+    }
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)TTF_MALLOC(sizeof(ttf_font_desc_t));
+    if(dsc == NULL) {
+        LV_LOG_ERROR("tiny_ttf: out of memory\n");
+        return NULL;
+    }
+    dsc->cache_size = cache_size;
+    dsc->core = ttf_font_core_get(path, data, data_size, font_size, cache_size);
+    if(dsc->core == NULL) {
         goto err_after_dsc;
     }
 
     lv_font_t * out_font = (lv_font_t *)TTF_MALLOC(sizeof(lv_font_t));
     if(out_font == NULL) {
         LV_LOG_ERROR("tiny_ttf: out of memory\n");
-        goto err_after_bitmap_cache;
+        goto err_after_core;
     }
     lv_memset(out_font, 0, sizeof(lv_font_t));
     out_font->get_glyph_dsc = ttf_get_glyph_dsc_cb;
@@ -228,8 +391,8 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
     out_font->dsc = dsc;
     lv_tiny_ttf_set_size(out_font, font_size);
     return out_font;
-err_after_bitmap_cache:
-    lv_lru_del(dsc->bitmap_cache);
+err_after_core:
+    ttf_font_core_release(dsc->core, cache_size);
 err_after_dsc:
     TTF_FREE(dsc);
     return NULL;
@@ -259,23 +422,18 @@ void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size)
         return;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    dsc->scale = stbtt_ScaleForMappingEmToPixels(&dsc->info, font_size);
-    int line_gap = 0;
-    stbtt_GetFontVMetrics(&dsc->info, &dsc->ascent, &dsc->descent, &line_gap);
-    font->line_height = (lv_coord_t)(dsc->scale * (dsc->ascent - dsc->descent + line_gap));
-    font->base_line = (lv_coord_t)(dsc->scale * (line_gap - dsc->descent));
+    ttf_font_core_t * core = dsc->core;
+    dsc->font_size = font_size;
+    dsc->scale = stbtt_ScaleForMappingEmToPixels(&core->info, font_size);
+    font->line_height = (lv_coord_t)(dsc->scale * (core->ascent - core->descent + core->line_gap));
+    font->base_line = (lv_coord_t)(dsc->scale * (core->line_gap - core->descent));
 }
 void lv_tiny_ttf_destroy(lv_font_t * font)
 {
     if(font != NULL) {
         if(font->dsc != NULL) {
             ttf_font_desc_t * ttf = (ttf_font_desc_t *)font->dsc;
-#if LV_TINY_TTF_FILE_SUPPORT
-            if(ttf->stream.file != NULL) {
-                lv_fs_close(&ttf->file);
-            }
-#endif
-            lv_lru_del(ttf->bitmap_cache);
+            ttf_font_core_release(ttf->core, ttf->cache_size);
             TTF_FREE(ttf);
         }
         TTF_FREE(font);
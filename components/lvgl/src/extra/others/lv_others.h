@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 #include "snapshot/lv_snapshot.h"
 #include "monkey/lv_monkey.h"
+#include "replay/lv_replay.h"
 #include "gridnav/lv_gridnav.h"
 #include "fragment/lv_fragment.h"
 #include "imgfont/lv_imgfont.h"
@@ -25,6 +25,7 @@ typedef struct _lv_monkey {
     lv_indev_data_t indev_data;
     lv_indev_t * indev;
     lv_timer_t * timer;
+    uint32_t rand_state;
 #if LV_USE_USER_DATA
     void * user_data;
 #endif
@@ -50,7 +51,7 @@ static const lv_key_t lv_key_map[] = {
  **********************/
 
 static void lv_monkey_read_cb(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
-static int32_t lv_monkey_random(int32_t howsmall, int32_t howbig);
+static int32_t lv_monkey_random(lv_monkey_t * monkey, int32_t howsmall, int32_t howbig);
 static void lv_monkey_timer_cb(lv_timer_t * timer);
 
 /**********************
@@ -73,6 +74,8 @@ lv_monkey_t * lv_monkey_create(const lv_monkey_config_t * config)
     lv_memset_00(monkey, sizeof(lv_monkey_t));
 
     monkey->config = *config;
+    if(monkey->config.seed == 0) monkey->config.seed = lv_rand(1, UINT32_MAX);
+    monkey->rand_state = monkey->config.seed;
 
     lv_indev_drv_t * drv = &monkey->indev_drv;
     lv_indev_drv_init(drv);
@@ -94,6 +97,12 @@ lv_indev_t * lv_monkey_get_indev(lv_monkey_t * monkey)
     return monkey->indev;
 }
 
+uint32_t lv_monkey_get_seed(lv_monkey_t * monkey)
+{
+    LV_ASSERT_NULL(monkey);
+    return monkey->config.seed;
+}
+
 void lv_monkey_set_enable(lv_monkey_t * monkey, bool en)
 {
     LV_ASSERT_NULL(monkey);
@@ -141,17 +150,29 @@ static void lv_monkey_read_cb(lv_indev_drv_t * indev_drv, lv_indev_data_t * data
 
     data->btn_id = monkey->indev_data.btn_id;
     data->point = monkey->indev_data.point;
+    data->key = monkey->indev_data.key;
     data->enc_diff = monkey->indev_data.enc_diff;
     data->state = monkey->indev_data.state;
 }
 
-static int32_t lv_monkey_random(int32_t howsmall, int32_t howbig)
+static int32_t lv_monkey_random(lv_monkey_t * monkey, int32_t howsmall, int32_t howbig)
 {
     if(howsmall >= howbig) {
         return howsmall;
     }
-    int32_t diff = howbig - howsmall;
-    return (int32_t)lv_rand(0, diff) + howsmall;
+
+    /*Use an own generator so that the other users of `lv_rand()` don't change the sequence.
+     *Algorithm "xor" from p. 4 of Marsaglia, "Xorshift RNGs"*/
+    uint32_t x = monkey->rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    monkey->rand_state = x;
+
+    /*In 32 bit as `howbig - howsmall` can overflow. With the full range every value is valid.*/
+    uint32_t diff = (uint32_t)howbig - (uint32_t)howsmall;
+    if(diff == UINT32_MAX) return (int32_t)x;
+    return (int32_t)(x % (diff + 1) + (uint32_t)howsmall);
 }
 
 static void lv_monkey_timer_cb(lv_timer_t * timer)
@@ -161,17 +182,19 @@ static void lv_monkey_timer_cb(lv_timer_t * timer)
 
     switch(monkey->indev_drv.type) {
         case LV_INDEV_TYPE_POINTER:
-            data->point.x = (lv_coord_t)lv_monkey_random(0, LV_HOR_RES - 1);
-            data->point.y = (lv_coord_t)lv_monkey_random(0, LV_VER_RES - 1);
+            data->point.x = (lv_coord_t)lv_monkey_random(monkey, 0, LV_HOR_RES - 1);
+            data->point.y = (lv_coord_t)lv_monkey_random(monkey, 0, LV_VER_RES - 1);
             break;
         case LV_INDEV_TYPE_ENCODER:
-            data->enc_diff = (int16_t)lv_monkey_random(monkey->config.input_range.min, monkey->config.input_range.max);
+            data->enc_diff = (int16_t)lv_monkey_random(monkey, monkey->config.input_range.min,
+                                                       monkey->config.input_range.max);
             break;
         case LV_INDEV_TYPE_BUTTON:
-            data->btn_id = (uint32_t)lv_monkey_random(monkey->config.input_range.min, monkey->config.input_range.max);
+            data->btn_id = (uint32_t)lv_monkey_random(monkey, monkey->config.input_range.min,
+                                                      monkey->config.input_range.max);
             break;
         case LV_INDEV_TYPE_KEYPAD: {
-                int32_t index = lv_monkey_random(0, sizeof(lv_key_map) / sizeof(lv_key_map[0]) - 1);
+                int32_t index = lv_monkey_random(monkey, 0, sizeof(lv_key_map) / sizeof(lv_key_map[0]) - 1);
                 data->key = lv_key_map[index];
                 break;
             }
@@ -179,9 +202,10 @@ static void lv_monkey_timer_cb(lv_timer_t * timer)
             break;
     }
 
-    data->state = lv_monkey_random(0, 100) < 50 ? LV_INDEV_STATE_RELEASED : LV_INDEV_STATE_PRESSED;
+    data->state = lv_monkey_random(monkey, 0, 100) < 50 ? LV_INDEV_STATE_RELEASED : LV_INDEV_STATE_PRESSED;
 
-    lv_timer_set_period(monkey->timer, lv_monkey_random(monkey->config.period_range.min, monkey->config.period_range.max));
+    lv_timer_set_period(monkey->timer, lv_monkey_random(monkey, monkey->config.period_range.min,
+                                                        monkey->config.period_range.max));
 }
 
 #endif /*LV_USE_MONKEY*/
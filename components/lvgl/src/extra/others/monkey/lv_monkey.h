@@ -41,6 +41,10 @@ typedef struct {
         int32_t min;
         int32_t max;
     } input_range;
+
+    /**< Seed of the random input. The same seed generates the same input sequence.
+     *   0: use a random seed (see `lv_monkey_get_seed()`)*/
+    uint32_t seed;
 } lv_monkey_config_t;
 
 /**********************
@@ -67,6 +71,14 @@ lv_monkey_t * lv_monkey_create(const lv_monkey_config_t * config);
  */
 lv_indev_t * lv_monkey_get_indev(lv_monkey_t * monkey);
 
+/**
+ * Get the seed of the random input of the monkey.
+ * Create a monkey with this seed to generate the same input again.
+ * @param monkey pointer to a monkey
+ * @return the seed
+ */
+uint32_t lv_monkey_get_seed(lv_monkey_t * monkey);
+
 /**
  * Enable monkey
  * @param monkey pointer to a monkey
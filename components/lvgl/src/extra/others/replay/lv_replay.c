@@ -0,0 +1,515 @@
+/**
+ * @file lv_replay.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_replay.h"
+
+#if LV_USE_REPLAY != 0
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/* Log format (little endian):
+ * Header: "LVRP", version (1 byte), input device type (1 byte), 2 reserved bytes
+ * Records: time since the start [ms] (4 bytes), state (1 byte), then
+ *   - pointer: x, y (2 + 2 bytes)
+ *   - keypad: key (4 bytes)
+ *   - encoder: enc_diff (2 bytes)
+ *   - button: btn_id (4 bytes)*/
+#define REPLAY_MAGIC            "LVRP"
+#define REPLAY_VERSION          1
+#define REPLAY_HEADER_SIZE      8
+#define REPLAY_REC_BUF_DEF      256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct _lv_replay_rec {
+    struct _lv_replay_rec * next;
+    lv_indev_t * indev;
+    void (*read_cb)(struct _lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
+    uint8_t * buf;
+    uint32_t size;
+    uint32_t buf_size;
+    uint32_t start_tick;
+    lv_indev_data_t last_data;
+    uint8_t first : 1;
+} lv_replay_rec_t;
+
+typedef struct _lv_replay {
+    lv_indev_drv_t indev_drv;
+    lv_indev_data_t indev_data;
+    lv_indev_t * indev;
+    const uint8_t * log;
+    uint8_t * log_buf;      /*The log if it was loaded from a file*/
+    uint32_t event_cnt;
+    uint32_t event_size;
+    uint32_t index;
+    uint32_t time;
+    uint32_t start_tick;
+    lv_replay_time_cb_t time_cb;
+    lv_replay_event_cb_t event_cb;
+    uint8_t live : 1;
+} lv_replay_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void rec_read_cb(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
+static bool rec_data_changed(lv_indev_type_t type, const lv_indev_data_t * d1, const lv_indev_data_t * d2);
+static void rec_add(lv_replay_rec_t * rec, const lv_indev_data_t * data);
+static void replay_read_cb(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
+static void replay_event_load(lv_replay_t * replay, uint32_t index);
+static uint32_t replay_event_time(lv_replay_t * replay, uint32_t index);
+static uint32_t event_size(lv_indev_type_t type);
+static uint32_t default_time_cb(void);
+static void put_u16(uint8_t * buf, uint16_t v);
+static void put_u32(uint8_t * buf, uint32_t v);
+static uint16_t get_u16(const uint8_t * buf);
+static uint32_t get_u32(const uint8_t * buf);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_replay_rec_t * rec_list;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_replay_rec_t * lv_replay_rec_start(lv_indev_t * indev)
+{
+    LV_ASSERT_NULL(indev);
+
+    /*The read callback of the input device is replaced by the recorder so it can be recorded only once*/
+    lv_replay_rec_t * rec;
+    for(rec = rec_list; rec; rec = rec->next) {
+        if(rec->indev == indev) {
+            LV_LOG_WARN("the input device is already recorded");
+            return NULL;
+        }
+    }
+
+    rec = lv_mem_alloc(sizeof(lv_replay_rec_t));
+    LV_ASSERT_MALLOC(rec);
+    if(rec == NULL) return NULL;
+    lv_memset_00(rec, sizeof(lv_replay_rec_t));
+
+    rec->buf = lv_mem_alloc(REPLAY_REC_BUF_DEF);
+    LV_ASSERT_MALLOC(rec->buf);
+    if(rec->buf == NULL) {
+        lv_mem_free(rec);
+        return NULL;
+    }
+    rec->buf_size = REPLAY_REC_BUF_DEF;
+
+    lv_memcpy(rec->buf, REPLAY_MAGIC, 4);
+    rec->buf[4] = REPLAY_VERSION;
+    rec->buf[5] = indev->driver->type;
+    rec->buf[6] = 0;
+    rec->buf[7] = 0;
+    rec->size = REPLAY_HEADER_SIZE;
+
+    rec->indev = indev;
+    rec->read_cb = indev->driver->read_cb;
+    rec->start_tick = lv_tick_get();
+    rec->first = 1;
+    indev->driver->read_cb = rec_read_cb;
+
+    rec->next = rec_list;
+    rec_list = rec;
+
+    return rec;
+}
+
+const uint8_t * lv_replay_rec_get_data(lv_replay_rec_t * rec, uint32_t * size)
+{
+    LV_ASSERT_NULL(rec);
+    *size = rec->size;
+    return rec->buf;
+}
+
+lv_fs_res_t lv_replay_rec_save(lv_replay_rec_t * rec, const char * path)
+{
+    LV_ASSERT_NULL(rec);
+
+    lv_fs_file_t f;
+    lv_fs_res_t res = lv_fs_open(&f, path, LV_FS_MODE_WR);
+    if(res != LV_FS_RES_OK) return res;
+
+    uint32_t bw;
+    res = lv_fs_write(&f, rec->buf, rec->size, &bw);
+    if(res == LV_FS_RES_OK && bw != rec->size) res = LV_FS_RES_FULL;
+
+    lv_fs_close(&f);
+    return res;
+}
+
+void lv_replay_rec_stop(lv_replay_rec_t * rec)
+{
+    LV_ASSERT_NULL(rec);
+
+    rec->indev->driver->read_cb = rec->read_cb;
+
+    lv_replay_rec_t ** prev = &rec_list;
+    while(*prev != rec) prev = &(*prev)->next;
+    *prev = rec->next;
+
+    lv_mem_free(rec->buf);
+    lv_mem_free(rec);
+}
+
+lv_replay_t * lv_replay_create(const uint8_t * log, uint32_t size)
+{
+    LV_ASSERT_NULL(log);
+
+    if(size < REPLAY_HEADER_SIZE || memcmp(log, REPLAY_MAGIC, 4) != 0 || log[4] != REPLAY_VERSION) {
+        LV_LOG_WARN("not an input log");
+        return NULL;
+    }
+
+    lv_indev_type_t type = log[5];
+    uint32_t ev_size = event_size(type);
+    if(ev_size == 0 || (size - REPLAY_HEADER_SIZE) % ev_size != 0) {
+        LV_LOG_WARN("invalid input log");
+        return NULL;
+    }
+
+    lv_replay_t * replay = lv_mem_alloc(sizeof(lv_replay_t));
+    LV_ASSERT_MALLOC(replay);
+    if(replay == NULL) return NULL;
+    lv_memset_00(replay, sizeof(lv_replay_t));
+
+    replay->log = log;
+    replay->event_size = ev_size;
+    replay->event_cnt = (size - REPLAY_HEADER_SIZE) / ev_size;
+    replay->time_cb = default_time_cb;
+
+    lv_indev_drv_t * drv = &replay->indev_drv;
+    lv_indev_drv_init(drv);
+    drv->type = type;
+    drv->read_cb = replay_read_cb;
+    drv->user_data = replay;
+    replay->indev = lv_indev_drv_register(drv);
+
+    return replay;
+}
+
+lv_replay_t * lv_replay_create_from_file(const char * path)
+{
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        LV_LOG_WARN("can't open %s", path);
+        return NULL;
+    }
+
+    uint32_t size = 0;
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, &size);
+    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+
+    uint8_t * buf = size ? lv_mem_alloc(size) : NULL;
+    uint32_t br = 0;
+    if(buf) lv_fs_read(&f, buf, size, &br);
+    lv_fs_close(&f);
+
+    lv_replay_t * replay = NULL;
+    if(buf && br == size) replay = lv_replay_create(buf, size);
+
+    if(replay) replay->log_buf = buf;
+    else if(buf) lv_mem_free(buf);
+
+    return replay;
+}
+
+lv_indev_t * lv_replay_get_indev(lv_replay_t * replay)
+{
+    LV_ASSERT_NULL(replay);
+    return replay->indev;
+}
+
+uint32_t lv_replay_get_event_cnt(lv_replay_t * replay)
+{
+    LV_ASSERT_NULL(replay);
+    return replay->event_cnt;
+}
+
+void lv_replay_set_time_cb(lv_replay_t * replay, lv_replay_time_cb_t time_cb)
+{
+    LV_ASSERT_NULL(replay);
+    replay->time_cb = time_cb ? time_cb : default_time_cb;
+}
+
+void lv_replay_set_event_cb(lv_replay_t * replay, lv_replay_event_cb_t event_cb)
+{
+    LV_ASSERT_NULL(replay);
+    replay->event_cb = event_cb;
+}
+
+bool lv_replay_step(lv_replay_t * replay, lv_replay_event_stat_t * stat)
+{
+    LV_ASSERT_NULL(replay);
+
+    if(replay->index >= replay->event_cnt) return false;
+
+    uint32_t time = replay_event_time(replay, replay->index);
+#if LV_TICK_CUSTOM == 0
+    /*Let the time dependent things (long press, scroll throw, animations) happen as in the recording*/
+    if(replay->index > 0 && time > replay->time) lv_tick_inc(time - replay->time);
+#endif
+    replay->time = time;
+    replay_event_load(replay, replay->index);
+
+    uint32_t t_start = replay->time_cb();
+    lv_indev_read_timer_cb(replay->indev->driver->read_timer);
+    uint32_t t_refr = replay->time_cb();
+    lv_refr_now(NULL);
+    uint32_t t_end = replay->time_cb();
+
+    lv_replay_event_stat_t s;
+    s.index = replay->index;
+    s.time = time;
+    s.latency = t_end - t_start;
+    s.frame_time = t_end - t_refr;
+    if(stat) *stat = s;
+
+    replay->index++;
+
+    if(replay->event_cb) replay->event_cb(replay, &s);
+
+    return true;
+}
+
+void lv_replay_run(lv_replay_t * replay, lv_replay_stat_t * stat)
+{
+    LV_ASSERT_NULL(replay);
+
+    lv_replay_stat_t sum;
+    lv_memset_00(&sum, sizeof(sum));
+    uint64_t latency_sum = 0;
+    uint64_t frame_time_sum = 0;
+
+    lv_replay_event_stat_t s;
+    while(lv_replay_step(replay, &s)) {
+        sum.event_cnt++;
+        latency_sum += s.latency;
+        frame_time_sum += s.frame_time;
+        if(s.latency > sum.latency_max || sum.event_cnt == 1) {
+            sum.latency_max = s.latency;
+            sum.latency_max_index = s.index;
+        }
+        if(s.frame_time > sum.frame_time_max) sum.frame_time_max = s.frame_time;
+    }
+
+    if(sum.event_cnt) {
+        sum.latency_avg = (uint32_t)(latency_sum / sum.event_cnt);
+        sum.frame_time_avg = (uint32_t)(frame_time_sum / sum.event_cnt);
+    }
+
+    LV_LOG_INFO("%"LV_PRIu32" events, latency avg %"LV_PRIu32" us, max %"LV_PRIu32" us (event %"LV_PRIu32"), "
+                "frame time avg %"LV_PRIu32" us, max %"LV_PRIu32" us",
+                sum.event_cnt, sum.latency_avg, sum.latency_max, sum.latency_max_index,
+                sum.frame_time_avg, sum.frame_time_max);
+
+    if(stat) *stat = sum;
+}
+
+void lv_replay_set_enable(lv_replay_t * replay, bool en)
+{
+    LV_ASSERT_NULL(replay);
+
+    replay->live = en ? 1 : 0;
+    if(en) {
+        replay->index = 0;
+        replay->start_tick = lv_tick_get();
+    }
+}
+
+void lv_replay_del(lv_replay_t * replay)
+{
+    LV_ASSERT_NULL(replay);
+
+    lv_indev_delete(replay->indev);
+    if(replay->log_buf) lv_mem_free(replay->log_buf);
+    lv_mem_free(replay);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void rec_read_cb(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
+{
+    lv_replay_rec_t * rec = rec_list;
+    while(rec && rec->indev->driver != indev_drv) rec = rec->next;
+    if(rec == NULL) return;
+
+    rec->read_cb(indev_drv, data);
+
+    if(rec->first || rec_data_changed(indev_drv->type, &rec->last_data, data)) {
+        rec_add(rec, data);
+        rec->last_data = *data;
+        rec->first = 0;
+    }
+}
+
+static bool rec_data_changed(lv_indev_type_t type, const lv_indev_data_t * d1, const lv_indev_data_t * d2)
+{
+    if(d1->state != d2->state) return true;
+
+    switch(type) {
+        case LV_INDEV_TYPE_POINTER:
+            return d1->point.x != d2->point.x || d1->point.y != d2->point.y;
+        case LV_INDEV_TYPE_KEYPAD:
+            return d1->key != d2->key;
+        case LV_INDEV_TYPE_ENCODER:
+            /*The difference is relative so every non-zero value is a new event*/
+            return d2->enc_diff != 0;
+        case LV_INDEV_TYPE_BUTTON:
+            return d1->btn_id != d2->btn_id;
+        default:
+            return false;
+    }
+}
+
+static void rec_add(lv_replay_rec_t * rec, const lv_indev_data_t * data)
+{
+    lv_indev_type_t type = rec->indev->driver->type;
+    uint32_t ev_size = event_size(type);
+    if(ev_size == 0) return;
+
+    if(rec->size + ev_size > rec->buf_size) {
+        uint8_t * buf = lv_mem_realloc(rec->buf, rec->buf_size * 2);
+        if(buf == NULL) {
+            LV_LOG_WARN("out of memory, the event is not recorded");
+            return;
+        }
+        rec->buf = buf;
+        rec->buf_size *= 2;
+    }
+
+    uint8_t * p = rec->buf + rec->size;
+    put_u32(p, lv_tick_elaps(rec->start_tick));
+    p[4] = data->state;
+    switch(type) {
+        case LV_INDEV_TYPE_POINTER:
+            put_u16(p + 5, (uint16_t)data->point.x);
+            put_u16(p + 7, (uint16_t)data->point.y);
+            break;
+        case LV_INDEV_TYPE_KEYPAD:
+            put_u32(p + 5, data->key);
+            break;
+        case LV_INDEV_TYPE_ENCODER:
+            put_u16(p + 5, (uint16_t)data->enc_diff);
+            break;
+        case LV_INDEV_TYPE_BUTTON:
+            put_u32(p + 5, data->btn_id);
+            break;
+        default:
+            break;
+    }
+
+    rec->size += ev_size;
+}
+
+static void replay_read_cb(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
+{
+    lv_replay_t * replay = indev_drv->user_data;
+
+    if(replay->live) {
+        uint32_t t = lv_tick_elaps(replay->start_tick);
+        while(replay->index < replay->event_cnt && replay_event_time(replay, replay->index) <= t) {
+            replay_event_load(replay, replay->index);
+            replay->index++;
+        }
+        if(replay->index >= replay->event_cnt) replay->live = 0;
+    }
+
+    data->point = replay->indev_data.point;
+    data->key = replay->indev_data.key;
+    data->enc_diff = replay->indev_data.enc_diff;
+    data->btn_id = replay->indev_data.btn_id;
+    data->state = replay->indev_data.state;
+
+    /*The encoder difference is relative so report it only once*/
+    replay->indev_data.enc_diff = 0;
+}
+
+static void replay_event_load(lv_replay_t * replay, uint32_t index)
+{
+    const uint8_t * p = replay->log + REPLAY_HEADER_SIZE + index * replay->event_size;
+    lv_indev_data_t * data = &replay->indev_data;
+
+    data->state = p[4];
+    switch(replay->indev_drv.type) {
+        case LV_INDEV_TYPE_POINTER:
+            data->point.x = (int16_t)get_u16(p + 5);
+            data->point.y = (int16_t)get_u16(p + 7);
+            break;
+        case LV_INDEV_TYPE_KEYPAD:
+            data->key = get_u32(p + 5);
+            break;
+        case LV_INDEV_TYPE_ENCODER:
+            /*Sum the differences not read yet*/
+            data->enc_diff += (int16_t)get_u16(p + 5);
+            break;
+        case LV_INDEV_TYPE_BUTTON:
+            data->btn_id = get_u32(p + 5);
+            break;
+        default:
+            break;
+    }
+}
+
+static uint32_t replay_event_time(lv_replay_t * replay, uint32_t index)
+{
+    return get_u32(replay->log + REPLAY_HEADER_SIZE + index * replay->event_size);
+}
+
+static uint32_t event_size(lv_indev_type_t type)
+{
+    switch(type) {
+        case LV_INDEV_TYPE_POINTER:
+        case LV_INDEV_TYPE_KEYPAD:
+        case LV_INDEV_TYPE_BUTTON:
+            return 9;
+        case LV_INDEV_TYPE_ENCODER:
+            return 7;
+        default:
+            return 0;
+    }
+}
+
+static uint32_t default_time_cb(void)
+{
+    return lv_tick_get() * 1000;
+}
+
+static void put_u16(uint8_t * buf, uint16_t v)
+{
+    buf[0] = v & 0xff;
+    buf[1] = v >> 8;
+}
+
+static void put_u32(uint8_t * buf, uint32_t v)
+{
+    put_u16(buf, v & 0xffff);
+    put_u16(buf + 2, v >> 16);
+}
+
+static uint16_t get_u16(const uint8_t * buf)
+{
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t * buf)
+{
+    return get_u16(buf) | ((uint32_t)get_u16(buf + 2) << 16);
+}
+
+#endif /*LV_USE_REPLAY*/
@@ -0,0 +1,183 @@
+/**
+ * @file lv_replay.h
+ *
+ */
+#ifndef LV_REPLAY_H
+#define LV_REPLAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_REPLAY != 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lv_replay_rec;
+typedef struct _lv_replay_rec lv_replay_rec_t;
+
+struct _lv_replay;
+typedef struct _lv_replay lv_replay_t;
+
+/**
+ * Timing of a replayed input event
+ */
+typedef struct {
+    uint32_t index;         /**< Index of the event in the log*/
+    uint32_t time;          /**< Time of the event in the log since the start of the recording [ms]*/
+    uint32_t latency;       /**< Time from reading the event until the display is refreshed [us]*/
+    uint32_t frame_time;    /**< Time of refreshing the display [us]*/
+} lv_replay_event_stat_t;
+
+/**
+ * Summary of the replayed input events
+ */
+typedef struct {
+    uint32_t event_cnt;         /**< Number of replayed events*/
+    uint32_t latency_avg;       /**< Average latency [us]*/
+    uint32_t latency_max;       /**< The largest latency [us]*/
+    uint32_t latency_max_index; /**< Index of the event with the largest latency*/
+    uint32_t frame_time_avg;    /**< Average frame time [us]*/
+    uint32_t frame_time_max;    /**< The largest frame time [us]*/
+} lv_replay_stat_t;
+
+/**
+ * Called after every replayed event
+ */
+typedef void (*lv_replay_event_cb_t)(lv_replay_t * replay, const lv_replay_event_stat_t * stat);
+
+/**
+ * Return a time stamp in microseconds
+ */
+typedef uint32_t (*lv_replay_time_cb_t)(void);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start recording the data read by an input device.
+ * The data and the time is stored only when the data changes.
+ * @param indev pointer to the input device to record, e.g. a real touch pad or a monkey's input device
+ * @return pointer to the recorder or NULL if out of memory or the input device is already recorded
+ */
+lv_replay_rec_t * lv_replay_rec_start(lv_indev_t * indev);
+
+/**
+ * Get the input log recorded so far
+ * @param rec pointer to a recorder
+ * @param size store the size of the log in bytes here
+ * @return pointer to the log. It's valid until the next read of the input device or until the recorder is stopped
+ */
+const uint8_t * lv_replay_rec_get_data(lv_replay_rec_t * rec, uint32_t * size);
+
+/**
+ * Save the input log recorded so far to a file
+ * @param rec pointer to a recorder
+ * @param path path to the file, e.g. "S:/input.lvrp"
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t
+ */
+lv_fs_res_t lv_replay_rec_save(lv_replay_rec_t * rec, const char * path);
+
+/**
+ * Stop recording and free the log
+ * @param rec pointer to a recorder
+ */
+void lv_replay_rec_stop(lv_replay_rec_t * rec);
+
+/**
+ * Create an input device which replays an input log
+ * @param log pointer to a log recorded by `lv_replay_rec_start()`. It needs to be valid while the replay exists.
+ * @param size size of the log in bytes
+ * @return pointer to the replay or NULL if the log is invalid
+ */
+lv_replay_t * lv_replay_create(const uint8_t * log, uint32_t size);
+
+/**
+ * Create an input device which replays an input log saved to a file
+ * @param path path to the file saved by `lv_replay_rec_save()`
+ * @return pointer to the replay or NULL if the file can't be read or the log is invalid
+ */
+lv_replay_t * lv_replay_create_from_file(const char * path);
+
+/**
+ * Get the input device of a replay
+ * @param replay pointer to a replay
+ * @return pointer to the input device
+ */
+lv_indev_t * lv_replay_get_indev(lv_replay_t * replay);
+
+/**
+ * Get the number of events in the log of a replay
+ * @param replay pointer to a replay
+ * @return number of events
+ */
+uint32_t lv_replay_get_event_cnt(lv_replay_t * replay);
+
+/**
+ * Set a function to measure the latency and the frame time.
+ * By default `lv_tick_get()` is used which has only millisecond resolution.
+ * @param replay pointer to a replay
+ * @param time_cb a function returning a time stamp in microseconds
+ */
+void lv_replay_set_time_cb(lv_replay_t * replay, lv_replay_time_cb_t time_cb);
+
+/**
+ * Set a function to call after every replayed event with its timing
+ * @param replay pointer to a replay
+ * @param event_cb the function or NULL
+ */
+void lv_replay_set_event_cb(lv_replay_t * replay, lv_replay_event_cb_t event_cb);
+
+/**
+ * Replay the next event: read it with the input device, process it and refresh the displays.
+ * If LV_TICK_CUSTOM is 0 the tick is advanced by the time elapsed between the events in the log, so the
+ * replay is deterministic if nothing else calls `lv_tick_inc()`.
+ * @param replay pointer to a replay
+ * @param stat store the timing of the event here (can be NULL)
+ * @return true: an event was replayed; false: the end of the log is reached
+ */
+bool lv_replay_step(lv_replay_t * replay, lv_replay_event_stat_t * stat);
+
+/**
+ * Replay all the remaining events with `lv_replay_step()`
+ * @param replay pointer to a replay
+ * @param stat store the summary of the timings here (can be NULL)
+ */
+void lv_replay_run(lv_replay_t * replay, lv_replay_stat_t * stat);
+
+/**
+ * Replay the log in real time: the input device reads the events when their time is elapsed.
+ * It's useful to replay a recorded session on the device.
+ * @param replay pointer to a replay
+ * @param en true: start from the first event; false: stop
+ */
+void lv_replay_set_enable(lv_replay_t * replay, bool en);
+
+/**
+ * Delete a replay and its input device
+ * @param replay pointer to a replay
+ */
+void lv_replay_del(lv_replay_t * replay);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_REPLAY*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_REPLAY_H*/
@@ -15,14 +15,44 @@
 /*********************
  *      DEFINES
  *********************/
+/*Size of the IDAT chunks written to the PNG file*/
+#define PNG_IDAT_SIZE   512
+
+/*Longest match of deflate*/
+#define PNG_RUN_MAX     258
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct {
+    lv_fs_file_t file;
+    lv_fs_res_t res;        /*The first error while writing the file*/
+    uint32_t adler_a;       /*Adler-32 checksum of the uncompressed data*/
+    uint32_t adler_b;
+    uint32_t bits;          /*Bits of the deflate stream not written to `idat` yet*/
+    uint8_t bit_cnt;
+    bool has_last;
+    uint8_t last;           /*The last uncompressed byte*/
+    uint16_t run;           /*Number of bytes after `last` which are the same as `last`*/
+    uint16_t idat_len;
+    uint8_t idat[PNG_IDAT_SIZE];
+} png_enc_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_res_t draw_area(lv_obj_t * obj, lv_img_cf_t cf, void * buf, lv_area_t * area, bool with_layers);
+static void png_write(png_enc_t * enc, const void * data, uint32_t len);
+static void png_write_chunk(png_enc_t * enc, const char * type, const uint8_t * data, uint32_t len);
+static void png_write_row(png_enc_t * enc, const uint8_t * row, const uint8_t * prev_row, uint32_t len);
+static void png_deflate_byte(png_enc_t * enc, uint8_t b);
+static void png_deflate_run_flush(png_enc_t * enc);
+static void png_put_sym(png_enc_t * enc, uint32_t sym);
+static void png_put_bits(png_enc_t * enc, uint32_t bits, uint8_t cnt);
+static void png_put_byte(png_enc_t * enc, uint8_t b);
+static void png_idat_flush(png_enc_t * enc);
+static uint32_t png_crc(uint32_t crc, const uint8_t * data, uint32_t len);
+static void png_set_u32(uint8_t * buf, uint32_t v);
 
 /**********************
  *  STATIC VARIABLES
@@ -116,36 +146,7 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
     lv_memset(buf, 0x00, buf_size);
     lv_memset_00(dsc, sizeof(lv_img_dsc_t));
 
-    lv_disp_t * obj_disp = lv_obj_get_disp(obj);
-    lv_disp_drv_t driver;
-    lv_disp_drv_init(&driver);
-    /*In lack of a better idea use the resolution of the object's display*/
-    driver.hor_res = lv_disp_get_hor_res(obj_disp);
-    driver.ver_res = lv_disp_get_hor_res(obj_disp);
-    lv_disp_drv_use_generic_set_px_cb(&driver, cf);
-
-    lv_disp_t fake_disp;
-    lv_memset_00(&fake_disp, sizeof(lv_disp_t));
-    fake_disp.driver = &driver;
-
-    lv_draw_ctx_t * draw_ctx = lv_mem_alloc(obj_disp->driver->draw_ctx_size);
-    LV_ASSERT_MALLOC(draw_ctx);
-    if(draw_ctx == NULL) return LV_RES_INV;
-    obj_disp->driver->draw_ctx_init(fake_disp.driver, draw_ctx);
-    fake_disp.driver->draw_ctx = draw_ctx;
-    draw_ctx->clip_area = &snapshot_area;
-    draw_ctx->buf_area = &snapshot_area;
-    draw_ctx->buf = (void *)buf;
-    driver.draw_ctx = draw_ctx;
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
-
-    lv_obj_redraw(draw_ctx, obj);
-
-    _lv_refr_set_disp_refreshing(refr_ori);
-    obj_disp->driver->draw_ctx_deinit(fake_disp.driver, draw_ctx);
-    lv_mem_free(draw_ctx);
+    if(draw_area(obj, cf, buf, &snapshot_area, false) != LV_RES_OK) return LV_RES_INV;
 
     dsc->data = buf;
     dsc->data_size = buf_size_needed;
@@ -207,8 +208,429 @@ void lv_snapshot_free(lv_img_dsc_t * dsc)
     lv_mem_free(dsc);
 }
 
+/** Save a snapshot of an object with its children to a PNG file.
+ *
+ * The object is rendered in horizontal strips and every strip is compressed and written
+ * to the file before rendering the next one, so the snapshot never needs to fit into the memory.
+ * The object is not invalidated, so the display is not affected.
+ *
+ * @param obj      The object to save. If it's the active screen the top and system layers are saved too.
+ * @param path     path of the PNG file, e.g. "S:/screenshot.png"
+ * @param buf      buffer for the strips with `lv_color_t` pixels or NULL to use the draw buffer of the
+ *                 object's display. It can't be used in `direct_mode` and `full_refresh` mode.
+ * @param buf_size size of `buf` in bytes. It needs to store at least one line of the object.
+ *
+ * @return LV_RES_OK on success, LV_RES_INV on error.
+ */
+lv_res_t lv_snapshot_save_png(lv_obj_t * obj, const char * path, void * buf, uint32_t buf_size)
+{
+    LV_ASSERT_NULL(obj);
+    LV_ASSERT_NULL(path);
+
+    if(buf == NULL) {
+        lv_disp_drv_t * disp_drv = lv_obj_get_disp(obj)->driver;
+        if(disp_drv->direct_mode || disp_drv->full_refresh) {
+            LV_LOG_WARN("the draw buffer is a frame buffer, a buffer is required");
+            return LV_RES_INV;
+        }
+
+        /*Wait until the draw buffer is flushed to the display*/
+        lv_disp_draw_buf_t * draw_buf = disp_drv->draw_buf;
+        while(draw_buf->flushing) {
+            if(disp_drv->wait_cb) disp_drv->wait_cb(disp_drv);
+        }
+
+        buf = draw_buf->buf_act;
+        buf_size = draw_buf->size * sizeof(lv_color_t);
+    }
+
+    lv_obj_update_layout(obj);
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(obj == disp->act_scr) {
+        lv_obj_update_layout(disp->top_layer);
+        lv_obj_update_layout(disp->sys_layer);
+    }
+
+    lv_area_t snapshot_area;
+    lv_obj_get_coords(obj, &snapshot_area);
+    lv_coord_t ext_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&snapshot_area, ext_size, ext_size);
+
+    lv_coord_t w = lv_area_get_width(&snapshot_area);
+    lv_coord_t h = lv_area_get_height(&snapshot_area);
+    lv_coord_t strip_h = buf_size / sizeof(lv_color_t) / w;
+    if(strip_h < 1) {
+        LV_LOG_WARN("the buffer is smaller than a line");
+        return LV_RES_INV;
+    }
+    if(strip_h > h) strip_h = h;
+
+    png_enc_t * enc = lv_mem_alloc(sizeof(png_enc_t));
+    LV_ASSERT_MALLOC(enc);
+    uint8_t * rows = lv_mem_alloc(w * 3 * 2);
+    LV_ASSERT_MALLOC(rows);
+    if(enc == NULL || rows == NULL) {
+        lv_mem_free(enc);
+        lv_mem_free(rows);
+        return LV_RES_INV;
+    }
+
+    lv_memset_00(enc, sizeof(png_enc_t));
+    enc->adler_a = 1;
+    enc->res = lv_fs_open(&enc->file, path, LV_FS_MODE_WR);
+    if(enc->res != LV_FS_RES_OK) {
+        LV_LOG_WARN("couldn't open %s", path);
+        lv_mem_free(enc);
+        lv_mem_free(rows);
+        return LV_RES_INV;
+    }
+
+    static const uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png_write(enc, signature, sizeof(signature));
+
+    /*8 bit RGB, no interlace*/
+    uint8_t ihdr[13] = {0};
+    png_set_u32(&ihdr[0], w);
+    png_set_u32(&ihdr[4], h);
+    ihdr[8] = 8;
+    ihdr[9] = 2;
+    png_write_chunk(enc, "IHDR", ihdr, sizeof(ihdr));
+
+    /*zlib header: deflate with 32k window; and a single block with fixed Huffman codes*/
+    png_put_byte(enc, 0x78);
+    png_put_byte(enc, 0x01);
+    png_put_bits(enc, 1, 1);
+    png_put_bits(enc, 1, 2);
+
+    uint8_t * row = rows;
+    uint8_t * prev_row = rows + w * 3;
+    lv_memset_00(prev_row, w * 3);
+
+    lv_area_t strip_area;
+    strip_area.x1 = snapshot_area.x1;
+    strip_area.x2 = snapshot_area.x2;
+    for(strip_area.y1 = snapshot_area.y1; strip_area.y1 <= snapshot_area.y2; strip_area.y1 += strip_h) {
+        strip_area.y2 = LV_MIN(strip_area.y1 + strip_h - 1, snapshot_area.y2);
+
+        lv_memset_00(buf, lv_area_get_size(&strip_area) * sizeof(lv_color_t));
+        if(draw_area(obj, LV_IMG_CF_TRUE_COLOR, buf, &strip_area, true) != LV_RES_OK) {
+            enc->res = LV_FS_RES_OUT_OF_MEM;
+            break;
+        }
+
+        const lv_color_t * px = buf;
+        lv_coord_t y;
+        for(y = strip_area.y1; y <= strip_area.y2; y++) {
+            lv_coord_t x;
+            for(x = 0; x < w; x++) {
+                lv_color32_t c32;
+                c32.full = lv_color_to32(*px);
+                row[x * 3] = c32.ch.red;
+                row[x * 3 + 1] = c32.ch.green;
+                row[x * 3 + 2] = c32.ch.blue;
+                px++;
+            }
+            png_write_row(enc, row, prev_row, w * 3);
+
+            uint8_t * tmp = prev_row;
+            prev_row = row;
+            row = tmp;
+        }
+
+        if(enc->res != LV_FS_RES_OK) break;
+    }
+
+    /*End of block, then the Adler-32 checksum from the first full byte*/
+    png_deflate_run_flush(enc);
+    png_put_sym(enc, 256);
+    if(enc->bit_cnt) png_put_bits(enc, 0, 8 - enc->bit_cnt);
+    png_put_byte(enc, enc->adler_b >> 8);
+    png_put_byte(enc, enc->adler_b & 0xFF);
+    png_put_byte(enc, enc->adler_a >> 8);
+    png_put_byte(enc, enc->adler_a & 0xFF);
+    png_idat_flush(enc);
+    png_write_chunk(enc, "IEND", NULL, 0);
+
+    lv_fs_res_t res = lv_fs_close(&enc->file);
+    if(enc->res == LV_FS_RES_OK) enc->res = res;
+    if(enc->res != LV_FS_RES_OK) LV_LOG_WARN("couldn't write %s", path);
+
+    res = enc->res;
+    lv_mem_free(enc);
+    lv_mem_free(rows);
+
+    return res == LV_FS_RES_OK ? LV_RES_OK : LV_RES_INV;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Draw an area of an object with a temporary display into a buffer
+ * @param obj           the object to draw
+ * @param cf            color format of the buffer
+ * @param buf           the buffer. Its size is the size of `area`.
+ * @param area          the area to draw in absolute coordinates
+ * @param with_layers   true: if `obj` is the active screen draw the top and system layers too
+ * @return              LV_RES_OK on success, LV_RES_INV if out of memory
+ */
+static lv_res_t draw_area(lv_obj_t * obj, lv_img_cf_t cf, void * buf, lv_area_t * area, bool with_layers)
+{
+    lv_disp_t * obj_disp = lv_obj_get_disp(obj);
+    lv_disp_drv_t driver;
+    lv_disp_drv_init(&driver);
+    /*In lack of a better idea use the resolution of the object's display*/
+    driver.hor_res = lv_disp_get_hor_res(obj_disp);
+    driver.ver_res = lv_disp_get_ver_res(obj_disp);
+    lv_disp_drv_use_generic_set_px_cb(&driver, cf);
+
+    lv_disp_t fake_disp;
+    lv_memset_00(&fake_disp, sizeof(lv_disp_t));
+    fake_disp.driver = &driver;
+
+    lv_draw_ctx_t * draw_ctx = lv_mem_alloc(obj_disp->driver->draw_ctx_size);
+    LV_ASSERT_MALLOC(draw_ctx);
+    if(draw_ctx == NULL) return LV_RES_INV;
+    obj_disp->driver->draw_ctx_init(fake_disp.driver, draw_ctx);
+    fake_disp.driver->draw_ctx = draw_ctx;
+    draw_ctx->clip_area = area;
+    draw_ctx->buf_area = area;
+    draw_ctx->buf = (void *)buf;
+    driver.draw_ctx = draw_ctx;
+
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&fake_disp);
+
+    lv_obj_redraw(draw_ctx, obj);
+    if(with_layers && obj == obj_disp->act_scr) {
+        lv_obj_redraw(draw_ctx, obj_disp->top_layer);
+        lv_obj_redraw(draw_ctx, obj_disp->sys_layer);
+    }
+
+    _lv_refr_set_disp_refreshing(refr_ori);
+    obj_disp->driver->draw_ctx_deinit(fake_disp.driver, draw_ctx);
+    lv_mem_free(draw_ctx);
+
+    return LV_RES_OK;
+}
+
+static void png_write(png_enc_t * enc, const void * data, uint32_t len)
+{
+    if(enc->res != LV_FS_RES_OK) return;
+
+    uint32_t bw;
+    enc->res = lv_fs_write(&enc->file, data, len, &bw);
+    if(enc->res == LV_FS_RES_OK && bw != len) enc->res = LV_FS_RES_FULL;
+}
+
+static void png_write_chunk(png_enc_t * enc, const char * type, const uint8_t * data, uint32_t len)
+{
+    uint8_t buf[4];
+    png_set_u32(buf, len);
+    png_write(enc, buf, 4);
+    png_write(enc, type, 4);
+    if(len) png_write(enc, data, len);
+
+    uint32_t crc = png_crc(0xFFFFFFFF, (const uint8_t *)type, 4);
+    crc = png_crc(crc, data, len);
+    png_set_u32(buf, crc ^ 0xFFFFFFFF);
+    png_write(enc, buf, 4);
+}
+
+/**
+ * Filter a line of RGB pixels and compress it.
+ * The filter is selected by the smallest sum of the absolute differences, as suggested by the PNG specification.
+ */
+static void png_write_row(png_enc_t * enc, const uint8_t * row, const uint8_t * prev_row, uint32_t len)
+{
+    uint32_t sum[5] = {0};
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        int32_t a = i >= 3 ? row[i - 3] : 0;
+        int32_t b = prev_row[i];
+        int32_t c = i >= 3 ? prev_row[i - 3] : 0;
+        int32_t p = a + b - c;
+        int32_t pa = LV_ABS(p - a);
+        int32_t pb = LV_ABS(p - b);
+        int32_t pc = LV_ABS(p - c);
+        int32_t paeth = (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+
+        sum[0] += LV_ABS((int8_t)row[i]);
+        sum[1] += LV_ABS((int8_t)(row[i] - a));
+        sum[2] += LV_ABS((int8_t)(row[i] - b));
+        sum[3] += LV_ABS((int8_t)(row[i] - ((a + b) >> 1)));
+        sum[4] += LV_ABS((int8_t)(row[i] - paeth));
+    }
+
+    uint8_t filter = 0;
+    for(i = 1; i < 5; i++) {
+        if(sum[i] < sum[filter]) filter = i;
+    }
+
+    png_deflate_byte(enc, filter);
+    for(i = 0; i < len; i++) {
+        int32_t a = i >= 3 ? row[i - 3] : 0;
+        int32_t b = prev_row[i];
+        int32_t c = i >= 3 ? prev_row[i - 3] : 0;
+        uint8_t v;
+        switch(filter) {
+            case 1:
+                v = row[i] - a;
+                break;
+            case 2:
+                v = row[i] - b;
+                break;
+            case 3:
+                v = row[i] - ((a + b) >> 1);
+                break;
+            case 4: {
+                    int32_t p = a + b - c;
+                    int32_t pa = LV_ABS(p - a);
+                    int32_t pb = LV_ABS(p - b);
+                    int32_t pc = LV_ABS(p - c);
+                    v = row[i] - ((pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c));
+                    break;
+                }
+            default:
+                v = row[i];
+                break;
+        }
+        png_deflate_byte(enc, v);
+    }
+}
+
+/**
+ * Compress a byte. Only the repetitions of the previous byte are matched (distance 1)
+ * which needs no window but compresses the filtered lines of flat UI areas well.
+ */
+static void png_deflate_byte(png_enc_t * enc, uint8_t b)
+{
+    enc->adler_a += b;
+    if(enc->adler_a >= 65521) enc->adler_a -= 65521;
+    enc->adler_b += enc->adler_a;
+    if(enc->adler_b >= 65521) enc->adler_b -= 65521;
+
+    if(enc->has_last && b == enc->last) {
+        enc->run++;
+        if(enc->run == PNG_RUN_MAX) png_deflate_run_flush(enc);
+        return;
+    }
+
+    png_deflate_run_flush(enc);
+    png_put_sym(enc, b);
+    enc->last = b;
+    enc->has_last = true;
+}
+
+static void png_deflate_run_flush(png_enc_t * enc)
+{
+    static const uint16_t len_base[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59,
+                                          67, 83, 99, 115, 131, 163, 195, 227, 258
+                                         };
+    static const uint8_t len_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                          4, 4, 4, 4, 5, 5, 5, 5, 0
+                                         };
+
+    if(enc->run < 3) {
+        while(enc->run) {
+            png_put_sym(enc, enc->last);
+            enc->run--;
+        }
+        return;
+    }
+
+    uint32_t i = 28;
+    while(len_base[i] > enc->run) i--;
+    png_put_sym(enc, 257 + i);
+    png_put_bits(enc, enc->run - len_base[i], len_extra[i]);
+    png_put_bits(enc, 0, 5);    /*Distance 1 has code 0*/
+    enc->run = 0;
+}
+
+/**
+ * Write a literal/length symbol with the fixed Huffman codes of deflate.
+ * Huffman codes are stored from the most significant bit so they are reversed.
+ */
+static void png_put_sym(png_enc_t * enc, uint32_t sym)
+{
+    uint32_t code;
+    uint8_t len;
+    if(sym < 144) {
+        code = 0x30 + sym;
+        len = 8;
+    }
+    else if(sym < 256) {
+        code = 0x190 + sym - 144;
+        len = 9;
+    }
+    else if(sym < 280) {
+        code = sym - 256;
+        len = 7;
+    }
+    else {
+        code = 0xC0 + sym - 280;
+        len = 8;
+    }
+
+    uint32_t rev = 0;
+    uint8_t i;
+    for(i = 0; i < len; i++) {
+        rev = (rev << 1) | (code & 1);
+        code >>= 1;
+    }
+    png_put_bits(enc, rev, len);
+}
+
+static void png_put_bits(png_enc_t * enc, uint32_t bits, uint8_t cnt)
+{
+    enc->bits |= bits << enc->bit_cnt;
+    enc->bit_cnt += cnt;
+    while(enc->bit_cnt >= 8) {
+        png_put_byte(enc, enc->bits & 0xFF);
+        enc->bits >>= 8;
+        enc->bit_cnt -= 8;
+    }
+}
+
+static void png_put_byte(png_enc_t * enc, uint8_t b)
+{
+    enc->idat[enc->idat_len] = b;
+    enc->idat_len++;
+    if(enc->idat_len == PNG_IDAT_SIZE) png_idat_flush(enc);
+}
+
+static void png_idat_flush(png_enc_t * enc)
+{
+    if(enc->idat_len == 0) return;
+    png_write_chunk(enc, "IDAT", enc->idat, enc->idat_len);
+    enc->idat_len = 0;
+}
+
+static uint32_t png_crc(uint32_t crc, const uint8_t * data, uint32_t len)
+{
+    /*CRC-32 by nibbles to keep the table small*/
+    static const uint32_t crc_table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+
+    while(len) {
+        crc ^= *data;
+        crc = (crc >> 4) ^ crc_table[crc & 0x0F];
+        crc = (crc >> 4) ^ crc_table[crc & 0x0F];
+        data++;
+        len--;
+    }
+    return crc;
+}
+
+static void png_set_u32(uint8_t * buf, uint32_t v)
+{
+    buf[0] = v >> 24;
+    buf[1] = (v >> 16) & 0xFF;
+    buf[2] = (v >> 8) & 0xFF;
+    buf[3] = v & 0xFF;
+}
+
 #endif /*LV_USE_SNAPSHOT*/
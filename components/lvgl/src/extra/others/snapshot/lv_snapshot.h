@@ -71,6 +71,22 @@ uint32_t lv_snapshot_buf_size_needed(lv_obj_t * obj, lv_img_cf_t cf);
  */
 lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t * dsc, void * buf, uint32_t buf_size);
 
+/** Save a snapshot of an object with its children to a PNG file.
+ *
+ * The object is rendered in horizontal strips and every strip is compressed and written
+ * to the file before rendering the next one, so the snapshot never needs to fit into the memory.
+ * The object is not invalidated, so the display is not affected.
+ *
+ * @param obj      The object to save. If it's the active screen the top and system layers are saved too.
+ * @param path     path of the PNG file, e.g. "S:/screenshot.png"
+ * @param buf      buffer for the strips with `lv_color_t` pixels or NULL to use the draw buffer of the
+ *                 object's display. It can't be used in `direct_mode` and `full_refresh` mode.
+ * @param buf_size size of `buf` in bytes. It needs to store at least one line of the object.
+ *
+ * @return LV_RES_OK on success, LV_RES_INV on error.
+ */
+lv_res_t lv_snapshot_save_png(lv_obj_t * obj, const char * path, void * buf, uint32_t buf_size);
+
 /**********************
  *      MACROS
  **********************/
@@ -54,6 +54,7 @@ static uint16_t get_angle(lv_obj_t * obj);
 const lv_obj_class_t lv_colorwheel_class = {.instance_size = sizeof(lv_colorwheel_t), .base_class = &lv_obj_class,
                                             .constructor_cb = lv_colorwheel_constructor,
                                             .event_cb = lv_colorwheel_event,
+                                            .draw_events = LV_OBJ_CLASS_DRAW_EVENTS_DEF,
                                             .width_def = LV_DPI_DEF * 2,
                                             .height_def = LV_DPI_DEF * 2,
                                             .editable = LV_OBJ_CLASS_EDITABLE_TRUE,
@@ -38,6 +38,7 @@ const lv_obj_class_t lv_imgbtn_class = {
     .instance_size = sizeof(lv_imgbtn_t),
     .constructor_cb = lv_imgbtn_constructor,
     .event_cb = lv_imgbtn_event,
+    .draw_events = LV_OBJ_CLASS_DRAW_EVENTS_DEF,
 };
 
 /**********************
@@ -35,6 +35,7 @@ const lv_obj_class_t lv_led_class  = {
     .width_def = LV_DPI_DEF / 5,
     .height_def = LV_DPI_DEF / 5,
     .event_cb = lv_led_event,
+    .draw_events = LV_OBJ_CLASS_DRAW_EVENTS_DEF,
     .instance_size = sizeof(lv_led_t),
 };
 
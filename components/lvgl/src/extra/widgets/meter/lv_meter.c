@@ -31,6 +31,8 @@ static void draw_ticks_and_labels(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, cons
 static void draw_needles(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, const lv_area_t * scale_area);
 static void inv_arc(lv_obj_t * obj, lv_meter_indicator_t * indic, int32_t old_value, int32_t new_value);
 static void inv_line(lv_obj_t * obj, lv_meter_indicator_t * indic, int32_t value);
+static void inv_scale_lines(lv_obj_t * obj, lv_meter_indicator_t * indic, int32_t old_start, int32_t old_end);
+static void inv_scale_sector(lv_obj_t * obj, lv_meter_indicator_t * indic, int32_t value1, int32_t value2);
 
 /**********************
  *  STATIC VARIABLES
@@ -39,6 +41,7 @@ const lv_obj_class_t lv_meter_class = {
     .constructor_cb = lv_meter_constructor,
     .destructor_cb = lv_meter_destructor,
     .event_cb = lv_meter_event,
+    .draw_events = LV_OBJ_CLASS_DRAW_EVENTS_DEF,
     .instance_size = sizeof(lv_meter_t),
     .base_class = &lv_obj_class
 };
@@ -220,6 +223,9 @@ void lv_meter_set_indicator_value(lv_obj_t * obj, lv_meter_indicator_t * indic,
         inv_line(obj, indic, old_end);
         inv_line(obj, indic, value);
     }
+    else if(indic->type == LV_METER_INDICATOR_TYPE_SCALE_LINES) {
+        inv_scale_lines(obj, indic, old_start, old_end);
+    }
     else {
         lv_obj_invalidate(obj);
     }
@@ -237,6 +243,9 @@ void lv_meter_set_indicator_start_value(lv_obj_t * obj, lv_meter_indicator_t * i
         inv_line(obj, indic, old_value);
         inv_line(obj, indic, value);
     }
+    else if(indic->type == LV_METER_INDICATOR_TYPE_SCALE_LINES) {
+        inv_scale_lines(obj, indic, old_value, indic->end_value);
+    }
     else {
         lv_obj_invalidate(obj);
     }
@@ -254,11 +263,26 @@ void lv_meter_set_indicator_end_value(lv_obj_t * obj, lv_meter_indicator_t * ind
         inv_line(obj, indic, old_value);
         inv_line(obj, indic, value);
     }
+    else if(indic->type == LV_METER_INDICATOR_TYPE_SCALE_LINES) {
+        inv_scale_lines(obj, indic, indic->start_value, old_value);
+    }
     else {
         lv_obj_invalidate(obj);
     }
 }
 
+/*=====================
+ * Other functions
+ *====================*/
+
+void lv_meter_set_needle_inv_segments(lv_obj_t * obj, uint8_t seg_cnt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_meter_t * meter = (lv_meter_t *)obj;
+
+    meter->needle_inv_seg_cnt = seg_cnt;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -533,9 +557,28 @@ static void draw_ticks_and_labels(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, cons
                 lv_event_send(obj, LV_EVENT_DRAW_PART_BEGIN, &part_draw_dsc);
             }
 
-            inner_act_mask_id = lv_draw_mask_add(major ? &inner_major_mask : &inner_minor_mask, NULL);
-            lv_draw_line(draw_ctx, &line_dsc, &p_outer, &p_center);
-            lv_draw_mask_remove_id(inner_act_mask_id);
+            /*The line is drawn from the center so its area is large. Skip the masks if the visible part is not redrawn*/
+            lv_point_t p_tick_out;
+            p_tick_out.x = p_center.x + r_out;
+            p_tick_out.y = p_center.y;
+            lv_point_transform(&p_tick_out, angle_upscale, 256, &p_center);
+
+            lv_point_t p_tick_in;
+            p_tick_in.x = p_center.x + LV_MAX(major ? r_in_major : r_in_minor, 0);
+            p_tick_in.y = p_center.y;
+            lv_point_transform(&p_tick_in, angle_upscale, 256, &p_center);
+
+            lv_area_t tick_area;
+            tick_area.x1 = LV_MIN(p_tick_out.x, p_tick_in.x) - line_dsc.width / 2 - 2;
+            tick_area.y1 = LV_MIN(p_tick_out.y, p_tick_in.y) - line_dsc.width / 2 - 2;
+            tick_area.x2 = LV_MAX(p_tick_out.x, p_tick_in.x) + line_dsc.width / 2 + 2;
+            tick_area.y2 = LV_MAX(p_tick_out.y, p_tick_in.y) + line_dsc.width / 2 + 2;
+
+            if(_lv_area_is_on(&tick_area, draw_ctx->clip_area)) {
+                inner_act_mask_id = lv_draw_mask_add(major ? &inner_major_mask : &inner_minor_mask, NULL);
+                lv_draw_line(draw_ctx, &line_dsc, &p_outer, &p_center);
+                lv_draw_mask_remove_id(inner_act_mask_id);
+            }
             lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, &part_draw_dsc);
 
             line_dsc.color = line_color_ori;
@@ -669,13 +712,30 @@ static void inv_line(lv_obj_t * obj, lv_meter_indicator_t * indic, int32_t value
         p_end.y = (lv_trigo_sin(angle) * (r_out)) / LV_TRIGO_SIN_MAX + scale_center.y;
         p_end.x = (lv_trigo_cos(angle) * (r_out)) / LV_TRIGO_SIN_MAX + scale_center.x;
 
-        lv_area_t a;
-        a.x1 = LV_MIN(scale_center.x, p_end.x) - indic->type_data.needle_line.width - 2;
-        a.y1 = LV_MIN(scale_center.y, p_end.y) - indic->type_data.needle_line.width - 2;
-        a.x2 = LV_MAX(scale_center.x, p_end.x) + indic->type_data.needle_line.width + 2;
-        a.y2 = LV_MAX(scale_center.y, p_end.y) + indic->type_data.needle_line.width + 2;
+        /*Invalidate the needle in segments to not redraw the whole bounding box of diagonal needles*/
+        lv_meter_t * meter = (lv_meter_t *)obj;
+        int32_t seg_cnt = LV_MAX(meter->needle_inv_seg_cnt, 1);
+        lv_coord_t dx = p_end.x - scale_center.x;
+        lv_coord_t dy = p_end.y - scale_center.y;
+        /*Half of the width is enough around the center line, +2 for anti-aliasing and rounding*/
+        lv_coord_t ext = seg_cnt > 1 ? indic->type_data.needle_line.width / 2 + 2 : indic->type_data.needle_line.width + 2;
+        int32_t i;
+        for(i = 0; i < seg_cnt; i++) {
+            lv_point_t p1;
+            p1.x = scale_center.x + (dx * i) / seg_cnt;
+            p1.y = scale_center.y + (dy * i) / seg_cnt;
+            lv_point_t p2;
+            p2.x = scale_center.x + (dx * (i + 1)) / seg_cnt;
+            p2.y = scale_center.y + (dy * (i + 1)) / seg_cnt;
 
-        lv_obj_invalidate_area(obj, &a);
+            lv_area_t a;
+            a.x1 = LV_MIN(p1.x, p2.x) - ext;
+            a.y1 = LV_MIN(p1.y, p2.y) - ext;
+            a.x2 = LV_MAX(p1.x, p2.x) + ext;
+            a.y2 = LV_MAX(p1.y, p2.y) + ext;
+
+            lv_obj_invalidate_area(obj, &a);
+        }
     }
     else if(indic->type == LV_METER_INDICATOR_TYPE_NEEDLE_IMG) {
         int32_t angle = lv_map(value, scale->min, scale->max, scale->rotation, scale->rotation + scale->angle_range);
@@ -697,4 +757,48 @@ static void inv_line(lv_obj_t * obj, lv_meter_indicator_t * indic, int32_t value
         lv_obj_invalidate_area(obj, &a);
     }
 }
+
+/**
+ * Invalidate the ticks whose look changed by the new start or end value of a scale lines indicator
+ */
+static void inv_scale_lines(lv_obj_t * obj, lv_meter_indicator_t * indic, int32_t old_start, int32_t old_end)
+{
+    /*With local gradient the color of every tick in the range changes*/
+    if(indic->type_data.scale_lines.local_grad &&
+       indic->type_data.scale_lines.color_start.full != indic->type_data.scale_lines.color_end.full) {
+        inv_scale_sector(obj, indic, LV_MIN(old_start, indic->start_value), LV_MAX(old_end, indic->end_value));
+    }
+    else {
+        inv_scale_sector(obj, indic, old_start, indic->start_value);
+        inv_scale_sector(obj, indic, old_end, indic->end_value);
+    }
+}
+
+static void inv_scale_sector(lv_obj_t * obj, lv_meter_indicator_t * indic, int32_t value1, int32_t value2)
+{
+    if(value1 == value2) return;
+
+    lv_area_t scale_area;
+    lv_obj_get_content_coords(obj, &scale_area);
+
+    /*The same center and radius as in `draw_ticks_and_labels`*/
+    lv_coord_t r_edge = LV_MIN(lv_area_get_width(&scale_area) / 2, lv_area_get_height(&scale_area) / 2);
+    lv_point_t scale_center;
+    scale_center.x = scale_area.x1 + r_edge;
+    scale_center.y = scale_area.y1 + r_edge;
+
+    lv_meter_scale_t * scale = indic->scale;
+    int32_t angle1 = lv_map(value1, scale->min, scale->max, scale->rotation, scale->rotation + scale->angle_range);
+    int32_t angle2 = lv_map(value2, scale->min, scale->max, scale->rotation, scale->rotation + scale->angle_range);
+    lv_coord_t tick_len = LV_MIN(LV_MAX(scale->tick_length, scale->tick_major_length), r_edge);
+
+    lv_area_t a;
+    lv_draw_arc_get_area(scale_center.x, scale_center.y, r_edge, LV_MIN(angle1, angle2), LV_MAX(angle1, angle2),
+                         tick_len, false, &a);
+
+    /*The ticks on the edges of the sector are wider than the sector*/
+    lv_coord_t tick_w = LV_MAX(scale->tick_width, scale->tick_major_width) + LV_ABS(indic->type_data.scale_lines.width_mod);
+    lv_area_increase(&a, tick_w / 2 + 2, tick_w / 2 + 2);
+    lv_obj_invalidate_area(obj, &a);
+}
 #endif
@@ -94,6 +94,7 @@ typedef struct {
     lv_obj_t obj;
     lv_ll_t scale_ll;
     lv_ll_t indicator_ll;
+    uint8_t needle_inv_seg_cnt;     /*Invalidate the line needles in this many areas along them*/
 } lv_meter_t;
 
 extern const lv_obj_class_t lv_meter_class;
@@ -252,6 +253,18 @@ void lv_meter_set_indicator_start_value(lv_obj_t * obj, lv_meter_indicator_t * i
  */
 void lv_meter_set_indicator_end_value(lv_obj_t * obj, lv_meter_indicator_t * indic, int32_t value);
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Invalidate the old and new position of the line needles in smaller areas along them instead of their bounding box.
+ * The bounding box of a diagonal needle covers a large part of the scale which would be redrawn on every change.
+ * @param obj           pointer to a meter object
+ * @param seg_cnt       number of areas along a needle. 0 or 1: invalidate the bounding box
+ */
+void lv_meter_set_needle_inv_segments(lv_obj_t * obj, uint8_t seg_cnt);
+
 /**********************
  *      MACROS
  **********************/
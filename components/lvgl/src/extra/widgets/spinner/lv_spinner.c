@@ -73,6 +73,7 @@ static void lv_spinner_constructor(const lv_obj_class_t * class_p, lv_obj_t * ob
     lv_anim_t a;
     lv_anim_init(&a);
     lv_anim_set_var(&a, obj);
+    lv_anim_set_skip_hidden(&a, true);
     lv_anim_set_exec_cb(&a, arc_anim_end_angle);
     lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
     lv_anim_set_time(&a, time_param);
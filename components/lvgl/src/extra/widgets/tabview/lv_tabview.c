@@ -36,6 +36,7 @@ const lv_obj_class_t lv_tabview_class = {
     .constructor_cb = lv_tabview_constructor,
     .destructor_cb = lv_tabview_destructor,
     .event_cb = lv_tabview_event,
+    .draw_events = LV_OBJ_CLASS_DRAW_EVENTS_DEF,
     .width_def = LV_PCT(100),
     .height_def = LV_PCT(100),
     .base_class = &lv_obj_class,
@@ -157,6 +157,26 @@ void lv_disp_draw_buf_init(lv_disp_draw_buf_t * draw_buf, void * buf1, void * bu
     draw_buf->size    = size_in_px_cnt;
 }
 
+#if LV_DISP_DRAW_BUF_RING_MAX
+void lv_disp_draw_buf_init_ring(lv_disp_draw_buf_t * draw_buf, void * bufs[], uint32_t buf_cnt,
+                                uint32_t size_in_px_cnt)
+{
+    LV_ASSERT_NULL(bufs);
+    if(buf_cnt > LV_DISP_DRAW_BUF_RING_MAX) {
+        LV_LOG_WARN("only %d buffers can be used (LV_DISP_DRAW_BUF_RING_MAX)", LV_DISP_DRAW_BUF_RING_MAX);
+        buf_cnt = LV_DISP_DRAW_BUF_RING_MAX;
+    }
+
+    lv_disp_draw_buf_init(draw_buf, bufs[0], buf_cnt > 1 ? bufs[1] : NULL, size_in_px_cnt);
+
+    uint32_t i;
+    for(i = 0; i < buf_cnt; i++) {
+        draw_buf->ring_bufs[i] = bufs[i];
+    }
+    draw_buf->ring_cnt = buf_cnt;
+}
+#endif
+
 /**
  * Register an initialized display driver.
  * Automatically set the first display as active.
@@ -204,6 +224,13 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
         LV_LOG_WARN("full_refresh requires at least screen sized draw buffer(s)");
     }
 
+#if LV_DISP_DRAW_BUF_RING_MAX
+    if(driver->draw_buf->ring_cnt && (driver->full_refresh || driver->direct_mode)) {
+        driver->draw_buf->ring_cnt = 0;
+        LV_LOG_WARN("the draw buffer ring works only in partial refresh mode. Using buf1 and buf2 only.");
+    }
+#endif
+
     disp->bg_color = lv_color_white();
 #if LV_COLOR_SCREEN_TRANSP
     disp->bg_opa = LV_OPA_TRANSP;
@@ -281,6 +308,12 @@ void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
 
     lv_obj_tree_walk(NULL, invalidate_layout_cb, NULL);
 
+#if LV_DISP_DAMAGE_TILE_W
+    /*The resolution might be changed, the hashes are allocated again on the next flush*/
+    lv_mem_free(disp->damage_hashes);
+    disp->damage_hashes = NULL;
+#endif
+
     if(disp->driver->drv_update_cb) disp->driver->drv_update_cb(disp->driver);
 }
 
@@ -320,6 +353,9 @@ void lv_disp_remove(lv_disp_t * disp)
     _lv_ll_remove(&LV_GC_ROOT(_lv_disp_ll), disp);
     _lv_ll_clear(&disp->sync_areas);
     if(disp->refr_timer) lv_timer_del(disp->refr_timer);
+#if LV_DISP_DAMAGE_TILE_W
+    lv_mem_free(disp->damage_hashes);
+#endif
     lv_mem_free(disp);
 
     if(was_default) lv_disp_set_default(_lv_ll_get_head(&LV_GC_ROOT(_lv_disp_ll)));
@@ -518,6 +554,18 @@ lv_coord_t lv_disp_get_dpi(const lv_disp_t * disp)
  */
 void LV_ATTRIBUTE_FLUSH_READY lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
 {
+#if LV_DISP_DRAW_BUF_RING_MAX
+    /*Other bands might be still waiting for flushing so clear `flushing_last` only when the last band is flushed*/
+    if(disp_drv->draw_buf->ring_cnt) {
+        disp_drv->draw_buf->ring_flush_done++;
+        disp_drv->draw_buf->flushing = 0;
+        if(disp_drv->draw_buf->ring_flush_done == disp_drv->draw_buf->ring_flush_last_req) {
+            disp_drv->draw_buf->flushing_last = 0;
+        }
+        return;
+    }
+#endif
+
     disp_drv->draw_buf->flushing = 0;
     disp_drv->draw_buf->flushing_last = 0;
 }
@@ -533,6 +581,18 @@ bool LV_ATTRIBUTE_FLUSH_READY lv_disp_flush_is_last(lv_disp_drv_t * disp_drv)
     return disp_drv->draw_buf->flushing_last;
 }
 
+#if LV_DISP_DAMAGE_TILE_W
+void lv_disp_damage_reset(lv_disp_t * disp)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) return;
+
+    /*The hashes are allocated again (as unknown) on the next flush*/
+    lv_mem_free(disp->damage_hashes);
+    disp->damage_hashes = NULL;
+}
+#endif
+
 /**
  * Get the next display.
  * @param disp pointer to the current display. NULL to initialize.
@@ -61,6 +61,20 @@ typedef struct _lv_disp_draw_buf_t {
     volatile int flushing_last;
     volatile uint32_t last_area         : 1; /*1: the last area is being rendered*/
     volatile uint32_t last_part         : 1; /*1: the last part of the current area is being rendered*/
+
+#if LV_DISP_DRAW_BUF_RING_MAX
+    /*Set by `lv_disp_draw_buf_init_ring()`. The bands are rendered into the buffers one after the other.*/
+    void * ring_bufs[LV_DISP_DRAW_BUF_RING_MAX];
+    uint8_t ring_cnt;   /*Number of buffers in the ring. 0: the ring is not used*/
+    uint8_t ring_idx;   /*Index of the buffer to render the next band into*/
+    /*Number of bands passed to `flush_cb`. Written only by LVGL.*/
+    volatile uint32_t ring_flush_req;
+    /*Number of bands reported by `lv_disp_flush_ready()`. Written only by the flushing side
+     *(e.g. a task on an other CPU core) so no locking is required.*/
+    volatile uint32_t ring_flush_done;
+    /*Value of `ring_flush_req` after passing the last band of the refresh cycle to `flush_cb`*/
+    volatile uint32_t ring_flush_last_req;
+#endif
 } lv_disp_draw_buf_t;
 
 typedef enum {
@@ -102,6 +116,12 @@ typedef struct _lv_disp_drv_t {
 
     uint32_t dpi : 10;              /** DPI (dot per inch) of the display. Default value is `LV_DPI_DEF`.*/
 
+#if LV_DISP_DAMAGE_TILE_W
+    uint32_t damage_track : 1;      /**< 1: flush only the tiles of the bands which are different from the display's content.
+                                      *  Works only in partial refresh mode with a non-transparent screen.
+                                      *  `flush_cb` is not called for unchanged bands.*/
+#endif
+
     /** MANDATORY: Write the internal buffer (draw_buf) to the display. 'lv_disp_flush_ready()' has to be
      * called when finished*/
     void (*flush_cb)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
@@ -176,6 +196,7 @@ typedef struct _lv_disp_t {
     uint8_t draw_prev_over_act : 1; /**< 1: Draw previous screen over active screen*/
     uint8_t del_prev : 1;           /**< 1: Automatically delete the previous screen when the screen load anim. is ready*/
     uint8_t rendering_in_progress : 1; /**< 1: The current screen rendering is in progress*/
+    uint8_t refr_paused : 1;        /**< 1: Don't refresh even if something was invalidated. @see lv_disp_set_refr_paused*/
 
     lv_opa_t bg_opa;                /**<Opacity of the background color or wallpaper*/
     lv_color_t bg_color;            /**< Default display color when screens are transparent*/
@@ -192,6 +213,13 @@ typedef struct _lv_disp_t {
 
     /*Miscellaneous data*/
     uint32_t last_activity_time;        /**< Last time when there was activity on this display*/
+
+#if LV_DISP_DAMAGE_TILE_W
+    /** Hash of every tile row as it was flushed to the display. 0: unknown*/
+    uint32_t * damage_hashes;
+    uint32_t damage_px_rendered;        /**< Number of rendered pixels checked by damage tracking*/
+    uint32_t damage_px_flushed;         /**< Number of pixels flushed of them*/
+#endif
 } lv_disp_t;
 
 /**********************
@@ -223,6 +251,25 @@ void lv_disp_drv_init(lv_disp_drv_t * driver);
  */
 void lv_disp_draw_buf_init(lv_disp_draw_buf_t * draw_buf, void * buf1, void * buf2, uint32_t size_in_px_cnt);
 
+#if LV_DISP_DRAW_BUF_RING_MAX
+/**
+ * Initialize a display buffer with a ring of draw buffers.
+ * The invalidated areas are rendered in bands and every band goes to the next buffer of the ring.
+ * `flush_cb` can pass the band to a worker (e.g. a task on an other CPU core) and return immediately.
+ * The worker calls `lv_disp_flush_ready()` for every band in the order they were received.
+ * LVGL renders the next band while the previous ones are being flushed and waits only
+ * if all buffers are waiting for flushing. All bands of a refresh cycle are flushed
+ * when the refresh cycle ends.
+ * Works only in partial refresh mode (not with `direct_mode` and `full_refresh`).
+ * @param draw_buf pointer `lv_disp_draw_buf_t` variable to initialize
+ * @param bufs array of buffers. The array is copied so it can be a local variable.
+ * @param buf_cnt number of buffers in `bufs` (at most `LV_DISP_DRAW_BUF_RING_MAX`)
+ * @param size_in_px_cnt size of each buffer in pixel count
+ */
+void lv_disp_draw_buf_init_ring(lv_disp_draw_buf_t * draw_buf, void * bufs[], uint32_t buf_cnt,
+                                uint32_t size_in_px_cnt);
+#endif
+
 /**
  * Register an initialized display driver.
  * Automatically set the first display as active.
@@ -344,6 +391,15 @@ bool /* LV_ATTRIBUTE_FLUSH_READY */ lv_disp_flush_is_last(lv_disp_drv_t * disp_d
 
 //! @endcond
 
+#if LV_DISP_DAMAGE_TILE_W
+/**
+ * Forget what was flushed to the display so the next bands are flushed without cropping.
+ * Call it if the content of the display was changed not by LVGL (e.g. the panel was reset or drawn directly).
+ * @param disp pointer to a display (NULL to use the default display)
+ */
+void lv_disp_damage_reset(lv_disp_t * disp);
+#endif
+
 /**
  * Get the next display.
  * @param disp pointer to the current display. NULL to initialize.
@@ -268,6 +268,60 @@
     #endif
 #endif
 
+/*Maximum number of draw buffers which can be passed to `lv_disp_draw_buf_init_ring()`.
+ *With more than 2 buffers several rendered bands can wait for flushing (e.g. by a task on an other CPU core)
+ *while LVGL renders the next band. 0: disable the draw buffer ring*/
+#ifndef LV_DISP_DRAW_BUF_RING_MAX
+    #ifdef CONFIG_LV_DISP_DRAW_BUF_RING_MAX
+        #define LV_DISP_DRAW_BUF_RING_MAX CONFIG_LV_DISP_DRAW_BUF_RING_MAX
+    #else
+        #define LV_DISP_DRAW_BUF_RING_MAX 0
+    #endif
+#endif
+
+/*Width of the tiles (in pixels) used to find the parts of the bands which are the same as on the display.
+ *With `lv_disp_drv_t.damage_track = 1` the hash of every tile row is kept and the bands are cropped
+ *to the changed tiles before flushing. 0: disable damage tracking*/
+#ifndef LV_DISP_DAMAGE_TILE_W
+    #ifdef CONFIG_LV_DISP_DAMAGE_TILE_W
+        #define LV_DISP_DAMAGE_TILE_W CONFIG_LV_DISP_DAMAGE_TILE_W
+    #else
+        #define LV_DISP_DAMAGE_TILE_W 0
+    #endif
+#endif
+
+/*Run the animations right before the refreshing of the default display instead of with their own timer.
+ *This way every frame shows the animations updated together and nothing is animated while it's not refreshed*/
+#ifndef LV_ANIM_SYNC_REFR
+    #ifdef CONFIG_LV_ANIM_SYNC_REFR
+        #define LV_ANIM_SYNC_REFR CONFIG_LV_ANIM_SYNC_REFR
+    #else
+        #define LV_ANIM_SYNC_REFR 0
+    #endif
+#endif
+#if LV_ANIM_SYNC_REFR
+    /*Update the animations less frequently (down to every 4th refresh period) while LVGL's idle time
+     *is below this percentage. 0: always update them in every refresh*/
+    #ifndef LV_ANIM_THROTTLE_IDLE
+        #ifdef CONFIG_LV_ANIM_THROTTLE_IDLE
+            #define LV_ANIM_THROTTLE_IDLE CONFIG_LV_ANIM_THROTTLE_IDLE
+        #else
+            #define LV_ANIM_THROTTLE_IDLE 10
+        #endif
+    #endif
+#endif
+
+/*Maximum number of opaque objects collected front to back for every refreshed area.
+ *Objects (or the rows/columns of them) which are fully under these are not drawn.
+ *0: disable occlusion culling*/
+#ifndef LV_REFR_OCCLUSION_CULL
+    #ifdef CONFIG_LV_REFR_OCCLUSION_CULL
+        #define LV_REFR_OCCLUSION_CULL CONFIG_LV_REFR_OCCLUSION_CULL
+    #else
+        #define LV_REFR_OCCLUSION_CULL 0
+    #endif
+#endif
+
 /*=======================
  * FEATURE CONFIGURATION
  *=======================*/
@@ -315,6 +369,19 @@
     #endif
 #endif /*LV_DRAW_COMPLEX*/
 
+/*Size of the arc coverage cache in bytes. 0: to disable the cache
+ *The anti-aliased coverage of arcs drawn again with the same radius, width, angles and opacity is saved
+ *and blended without evaluating the angle and radius masks again. The least recently used arcs are freed if the cache is full.
+ *The memory is allocated when the first arc is drawn.
+ *Requires `LV_DRAW_COMPLEX 1`*/
+#ifndef LV_ARC_CACHE_SIZE
+    #ifdef CONFIG_LV_ARC_CACHE_SIZE
+        #define LV_ARC_CACHE_SIZE CONFIG_LV_ARC_CACHE_SIZE
+    #else
+        #define LV_ARC_CACHE_SIZE 0
+    #endif
+#endif
+
 /**
  * "Simple layers" are used when a widget has `style_opa < 255` to buffer the widget into a layer
  * and blend it as an image with the given opacity.
@@ -343,6 +410,18 @@
     #endif
 #endif
 
+/*Size of the layer cache in bytes. 0: to disable the layer cache
+ *Objects with `LV_OBJ_FLAG_LAYER_CACHE` are rendered into a layer (with their children) which is kept
+ *and only its changed parts are rendered again. The least recently used layers are freed if the cache is full.
+ *Requires `LV_COLOR_SCREEN_TRANSP 1`*/
+#ifndef LV_LAYER_CACHE_SIZE
+    #ifdef CONFIG_LV_LAYER_CACHE_SIZE
+        #define LV_LAYER_CACHE_SIZE CONFIG_LV_LAYER_CACHE_SIZE
+    #else
+        #define LV_LAYER_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -848,6 +927,18 @@
     #endif
 #endif
 
+/*Number of light objects allocated together in a slab (max. 32). 0: to disable light objects
+ *The objects created after `lv_obj_enable_light_create(true)` can't be clicked, scrolled or focused
+ *and are allocated from slabs of same sized objects. The slab also stores their extra draw size,
+ *so e.g. labels need no special attributes. Meant for many decorative labels, lines and images.*/
+#ifndef LV_OBJ_LIGHT_SLAB_CNT
+    #ifdef CONFIG_LV_OBJ_LIGHT_SLAB_CNT
+        #define LV_OBJ_LIGHT_SLAB_CNT CONFIG_LV_OBJ_LIGHT_SLAB_CNT
+    #else
+        #define LV_OBJ_LIGHT_SLAB_CNT 0
+    #endif
+#endif
+
 /*Garbage Collector settings
  *Used if lvgl is bound to higher level language and the memory is managed by that language*/
 #ifndef LV_ENABLE_GC
@@ -1497,6 +1588,13 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LINE_CACHE
+        #ifdef CONFIG_LV_LABEL_LINE_CACHE
+            #define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+        #else
+            #define LV_LABEL_LINE_CACHE 0     /*Store the line breaks and line widths in labels to measure and draw the text only once*/
+        #endif
+    #endif
 #endif
 
 #ifndef LV_USE_LINE
@@ -1972,6 +2070,16 @@
     #endif
 #endif
 
+/*1: Skip calculating the layout of an object again if the size, flags and position of its children haven't changed
+ *since the last layout calculation. Adds 4 bytes to the special attributes of the objects.*/
+#ifndef LV_USE_LAYOUT_CACHE
+    #ifdef CONFIG_LV_USE_LAYOUT_CACHE
+        #define LV_USE_LAYOUT_CACHE CONFIG_LV_USE_LAYOUT_CACHE
+    #else
+        #define LV_USE_LAYOUT_CACHE 0
+    #endif
+#endif
+
 /*---------------------
  * 3rd party libraries
  *--------------------*/
@@ -2160,6 +2268,17 @@
         #define LV_USE_GIF 0
     #endif
 #endif
+#if LV_USE_GIF
+    /*Memory for the changed areas of the frames of an endlessly looping GIF [bytes].
+     *After the first repeat the loop is played from this cache without decoding. (0: disable)*/
+    #ifndef LV_GIF_CACHE_SIZE
+        #ifdef CONFIG_LV_GIF_CACHE_SIZE
+            #define LV_GIF_CACHE_SIZE CONFIG_LV_GIF_CACHE_SIZE
+        #else
+            #define LV_GIF_CACHE_SIZE 0
+        #endif
+    #endif
+#endif
 
 /*QR code library*/
 #ifndef LV_USE_QRCODE
@@ -2287,6 +2406,15 @@
     #endif
 #endif
 
+/*1: Enable recording and replaying input devices with latency and frame time statistics*/
+#ifndef LV_USE_REPLAY
+    #ifdef CONFIG_LV_USE_REPLAY
+        #define LV_USE_REPLAY CONFIG_LV_USE_REPLAY
+    #else
+        #define LV_USE_REPLAY 0
+    #endif
+#endif
+
 /*1: Enable grid navigation*/
 #ifndef LV_USE_GRIDNAV
     #ifdef CONFIG_LV_USE_GRIDNAV
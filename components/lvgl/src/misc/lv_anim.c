@@ -9,6 +9,7 @@
 #include "lv_anim.h"
 
 #include "../hal/lv_hal_tick.h"
+#include "../hal/lv_hal_disp.h"
 #include "lv_assert.h"
 #include "lv_timer.h"
 #include "lv_math.h"
@@ -39,6 +40,10 @@ static uint32_t last_timer_run;
 static bool anim_list_changed;
 static bool anim_run_round;
 static lv_timer_t * _lv_anim_tmr;
+static bool (*var_visible_cb)(void * var);
+#if LV_ANIM_SYNC_REFR && LV_ANIM_THROTTLE_IDLE
+    static uint32_t throttle; /*Update the animations only in every 1, 2 or 4 periods*/
+#endif
 
 /**********************
  *      MACROS
@@ -59,8 +64,43 @@ void _lv_anim_core_init(void)
     _lv_anim_tmr = lv_timer_create(anim_timer, LV_DISP_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
     anim_list_changed = false;
+    var_visible_cb = NULL;
+#if LV_ANIM_SYNC_REFR && LV_ANIM_THROTTLE_IDLE
+    throttle = 1;
+#endif
+}
+
+void _lv_anim_set_var_visible_cb(bool (*cb)(void * var))
+{
+    var_visible_cb = cb;
 }
 
+#if LV_ANIM_SYNC_REFR
+bool _lv_anim_refr_frame(void)
+{
+    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL) return false;
+
+    uint32_t period = _lv_anim_tmr->period;
+#if LV_ANIM_THROTTLE_IDLE
+    period *= throttle;
+#endif
+
+    /*The refresh timer's runs can be 1 ms closer to each other than the animations' period (tick granularity).
+     *Accept it to not skip a frame.*/
+    if(lv_tick_elaps(last_timer_run) + 1 >= period) {
+#if LV_ANIM_THROTTLE_IDLE
+        /*Give the CPU to the drawing and the other tasks if LVGL is hardly ever idle*/
+        uint32_t idle = lv_timer_get_idle();
+        if(idle < LV_ANIM_THROTTLE_IDLE && throttle < 4) throttle *= 2;
+        else if(idle >= 2 * LV_ANIM_THROTTLE_IDLE && throttle > 1) throttle /= 2;
+#endif
+        anim_timer(NULL);
+    }
+
+    return _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) != NULL;
+}
+#endif
+
 void lv_anim_init(lv_anim_t * a)
 {
     lv_memset_00(a, sizeof(lv_anim_t));
@@ -382,13 +422,20 @@ static void anim_timer(lv_timer_t * param)
             if(a->act_time >= 0) {
                 if(a->act_time > a->time) a->act_time = a->time;
 
-                int32_t new_value;
-                new_value = a->path_cb(a);
+                /*Nothing to calculate if the intermediate values couldn't be seen anyway.
+                 *`current_value` is left as it is so the value is applied again when it's visible.*/
+                bool skip = false;
+                if(a->skip_hidden && a->act_time < a->time && var_visible_cb) skip = !var_visible_cb(a->var);
 
-                if(new_value != a->current_value) {
-                    a->current_value = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
+                if(!skip) {
+                    int32_t new_value;
+                    new_value = a->path_cb(a);
+
+                    if(new_value != a->current_value) {
+                        a->current_value = new_value;
+                        /*Apply the calculated value*/
+                        if(a->exec_cb) a->exec_cb(a->var, new_value);
+                    }
                 }
 
                 /*If the time is elapsed the animation is ready*/
@@ -462,8 +509,17 @@ static void anim_ready_handler(lv_anim_t * a)
 static void anim_mark_list_change(void)
 {
     anim_list_changed = true;
+#if LV_ANIM_SYNC_REFR
+    /*The animations are run by the refresh timer of the default display. Wake it up if it's not paused.*/
+    lv_timer_pause(_lv_anim_tmr);
+    lv_disp_t * disp = lv_disp_get_default();
+    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) != NULL && disp && disp->refr_timer && !disp->refr_paused) {
+        lv_timer_resume(disp->refr_timer);
+    }
+#else
     if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
         lv_timer_pause(_lv_anim_tmr);
     else
         lv_timer_resume(_lv_anim_tmr);
+#endif
 }
@@ -91,6 +91,7 @@ typedef struct _lv_anim_t {
     uint32_t repeat_delay;       /**< Wait before repeat*/
     uint16_t repeat_cnt;         /**< Repeat count for the animation*/
     uint8_t early_apply  : 1;    /**< 1: Apply start value immediately even is there is `delay`*/
+    uint8_t skip_hidden  : 1;    /**< 1: Don't calculate and apply the values while the animated object is not visible*/
 
     /*Animation system use these - user shouldn't set*/
     uint8_t playback_now : 1; /**< Play back is in progress*/
@@ -107,6 +108,23 @@ typedef struct _lv_anim_t {
  */
 void _lv_anim_core_init(void);
 
+/**
+ * Set a function to tell whether the variable of an animation is visible.
+ * Animations with `skip_hidden` don't apply their values while it returns `false`.
+ * Used by the object module to check the visibility of the animated objects.
+ * @param cb        the function to call with the animated variable or NULL to never skip
+ */
+void _lv_anim_set_var_visible_cb(bool (*cb)(void * var));
+
+#if LV_ANIM_SYNC_REFR
+/**
+ * Run the animations if it's time for the next frame of them.
+ * Called by the default display's refresh timer when `LV_ANIM_SYNC_REFR` is enabled.
+ * @return          true: there are animations, the refreshing should go on
+ */
+bool _lv_anim_refr_frame(void);
+#endif
+
 /**
  * Initialize an animation variable.
  * E.g.:
@@ -290,6 +308,18 @@ static inline void lv_anim_set_early_apply(lv_anim_t * a, bool en)
     a->early_apply = en;
 }
 
+/**
+ * Skip the steps of the animation while its variable, an object, is not visible:
+ * it's hidden, scrolled or clipped out, on an inactive screen or its display's refreshing is paused.
+ * The elapsed time still counts and the end value is always applied.
+ * @param a         pointer to an initialized `lv_anim_t` variable
+ * @param en        true: skip the steps while the object is not visible; false: animate it anyway
+ */
+static inline void lv_anim_set_skip_hidden(lv_anim_t * a, bool en)
+{
+    a->skip_hidden = en;
+}
+
 /**
  * Set the custom user data field of the animation.
  * @param a           pointer to an initialized `lv_anim_t` variable
@@ -362,6 +392,8 @@ lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb);
 
 /**
  * Get global animation refresher timer.
+ * With `LV_ANIM_SYNC_REFR` the timer is always paused but its period still sets
+ * how frequently the animations are updated.
  * @return pointer to the animation refresher timer.
  */
 struct _lv_timer_t * lv_anim_get_timer(void);
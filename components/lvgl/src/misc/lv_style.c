@@ -30,6 +30,11 @@ static void lv_style_set_prop_helper(lv_style_prop_t prop, lv_style_value_t valu
                                      lv_style_value_t * value_storage);
 static void lv_style_set_prop_meta_helper(lv_style_prop_t prop, lv_style_value_t value, uint16_t * prop_storage,
                                           lv_style_value_t * value_storage);
+static uint8_t * props_alloc(uint32_t cnt);
+static lv_style_value_t * props_get_values(uint8_t * values_and_props);
+static uint16_t * props_get_props(uint8_t * values_and_props, uint32_t cnt);
+static int32_t props_find(uint8_t * values_and_props, uint32_t cnt, lv_style_prop_t prop_id);
+static void props_update_map(uint8_t * values_and_props, uint32_t cnt);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -239,45 +244,38 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
         return false;
     }
 
-    uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-    uint16_t * old_props = (uint16_t *)tmp;
-    uint32_t i;
-    for(i = 0; i < style->prop_cnt; i++) {
-        if(LV_STYLE_PROP_ID_MASK(old_props[i]) == prop) {
-            lv_style_value_t * old_values = (lv_style_value_t *)style->v_p.values_and_props;
-
-            if(style->prop_cnt == 2) {
-                style->prop_cnt = 1;
-                style->prop1 = i == 0 ? old_props[1] : old_props[0];
-                style->v_p.value1 = i == 0 ? old_values[1] : old_values[0];
-            }
-            else {
-                size_t size = (style->prop_cnt - 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
-                uint8_t * new_values_and_props = lv_mem_alloc(size);
-                if(new_values_and_props == NULL) return false;
-                style->v_p.values_and_props = new_values_and_props;
-                style->prop_cnt--;
-
-                tmp = new_values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-                uint16_t * new_props = (uint16_t *)tmp;
-                lv_style_value_t * new_values = (lv_style_value_t *)new_values_and_props;
-
-                uint32_t j;
-                for(i = j = 0; j <= style->prop_cnt;
-                    j++) { /*<=: because prop_cnt already reduced but all the old props. needs to be checked.*/
-                    if(old_props[j] != prop) {
-                        new_values[i] = old_values[j];
-                        new_props[i++] = old_props[j];
-                    }
-                }
-            }
-
-            lv_mem_free(old_values);
-            return true;
-        }
+    uint8_t * old_values_and_props = style->v_p.values_and_props;
+    uint32_t cnt = style->prop_cnt;
+    int32_t i = props_find(old_values_and_props, cnt, prop);
+    if(i < 0) return false;
+
+    lv_style_value_t * old_values = props_get_values(old_values_and_props);
+    uint16_t * old_props = props_get_props(old_values_and_props, cnt);
+
+    if(cnt == 2) {
+        style->prop_cnt = 1;
+        style->prop1 = i == 0 ? old_props[1] : old_props[0];
+        style->v_p.value1 = i == 0 ? old_values[1] : old_values[0];
+    }
+    else {
+        uint8_t * new_values_and_props = props_alloc(cnt - 1);
+        if(new_values_and_props == NULL) return false;
+
+        /*Copy all but the removed one, keeping the order*/
+        lv_style_value_t * new_values = props_get_values(new_values_and_props);
+        uint16_t * new_props = props_get_props(new_values_and_props, cnt - 1);
+        lv_memcpy(new_values, old_values, i * sizeof(lv_style_value_t));
+        lv_memcpy(new_values + i, old_values + i + 1, (cnt - i - 1) * sizeof(lv_style_value_t));
+        lv_memcpy(new_props, old_props, i * sizeof(uint16_t));
+        lv_memcpy(new_props + i, old_props + i + 1, (cnt - i - 1) * sizeof(uint16_t));
+        props_update_map(new_values_and_props, cnt - 1);
+
+        style->v_p.values_and_props = new_values_and_props;
+        style->prop_cnt--;
     }
 
-    return false;
+    lv_mem_free(old_values_and_props);
+    return true;
 }
 
 void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
@@ -425,56 +423,62 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
     lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(prop_and_meta);
 
     if(style->prop_cnt > 1) {
-        uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        uint16_t * props = (uint16_t *)tmp;
-        int32_t i;
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            if(LV_STYLE_PROP_ID_MASK(props[i]) == prop_id) {
-                lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
-                value_adjustment_helper(prop_and_meta, value, &props[i], &values[i]);
-                return;
-            }
+        uint8_t * old_values_and_props = style->v_p.values_and_props;
+        uint32_t cnt = style->prop_cnt;
+        lv_style_value_t * old_values = props_get_values(old_values_and_props);
+        uint16_t * old_props = props_get_props(old_values_and_props, cnt);
+
+        int32_t i = props_find(old_values_and_props, cnt, prop_id);
+        if(i >= 0) {
+            value_adjustment_helper(prop_and_meta, value, &old_props[i], &old_values[i]);
+            return;
         }
 
-        size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
-        uint8_t * values_and_props = lv_mem_realloc(style->v_p.values_and_props, size);
-        if(values_and_props == NULL) return;
-        style->v_p.values_and_props = values_and_props;
-
-        tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        props = (uint16_t *)tmp;
-        /*Shift all props to make place for the value before them*/
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            props[i + sizeof(lv_style_value_t) / sizeof(uint16_t)] = props[i];
+        if(cnt == UINT8_MAX) {
+            LV_LOG_WARN("Too many properties in the style");
+            return;
         }
-        style->prop_cnt++;
 
-        /*Go to the new position wit the props*/
-        tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        props = (uint16_t *)tmp;
-        lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+        uint8_t * values_and_props = props_alloc(cnt + 1);
+        if(values_and_props == NULL) return;
+
+        /*Copy the old properties leaving place for the new one to keep the order*/
+        uint32_t pos = -(i + 1);
+        lv_style_value_t * values = props_get_values(values_and_props);
+        uint16_t * props = props_get_props(values_and_props, cnt + 1);
+        lv_memcpy(values, old_values, pos * sizeof(lv_style_value_t));
+        lv_memcpy(values + pos + 1, old_values + pos, (cnt - pos) * sizeof(lv_style_value_t));
+        lv_memcpy(props, old_props, pos * sizeof(uint16_t));
+        lv_memcpy(props + pos + 1, old_props + pos, (cnt - pos) * sizeof(uint16_t));
 
         /*Set the new property and value*/
-        value_adjustment_helper(prop_and_meta, value, &props[style->prop_cnt - 1], &values[style->prop_cnt - 1]);
+        values[pos] = null_style_value;
+        value_adjustment_helper(prop_and_meta, value, &props[pos], &values[pos]);
+        props_update_map(values_and_props, cnt + 1);
+
+        lv_mem_free(old_values_and_props);
+        style->v_p.values_and_props = values_and_props;
+        style->prop_cnt++;
     }
     else if(style->prop_cnt == 1) {
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop_id) {
             value_adjustment_helper(prop_and_meta, value, &style->prop1, &style->v_p.value1);
             return;
         }
-        size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
-        uint8_t * values_and_props = lv_mem_alloc(size);
+        uint8_t * values_and_props = props_alloc(2);
         if(values_and_props == NULL) return;
-        lv_style_value_t value_tmp = style->v_p.value1;
+
+        lv_style_value_t * values = props_get_values(values_and_props);
+        uint16_t * props = props_get_props(values_and_props, 2);
+        uint32_t pos = LV_STYLE_PROP_ID_MASK(style->prop1) < prop_id ? 1 : 0;
+        props[1 - pos] = style->prop1;
+        values[1 - pos] = style->v_p.value1;
+        values[pos] = null_style_value;
+        value_adjustment_helper(prop_and_meta, value, &props[pos], &values[pos]);
+        props_update_map(values_and_props, 2);
+
         style->v_p.values_and_props = values_and_props;
         style->prop_cnt++;
-
-        uint8_t * tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        uint16_t * props = (uint16_t *)tmp;
-        lv_style_value_t * values = (lv_style_value_t *)values_and_props;
-        props[0] = style->prop1;
-        values[0] = value_tmp;
-        value_adjustment_helper(prop_and_meta, value, &props[1], &values[1]);
     }
     else {
         style->prop_cnt = 1;
@@ -485,3 +489,63 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
     style->has_group |= 1 << group;
 }
 
+static uint8_t * props_alloc(uint32_t cnt)
+{
+    size_t size = _LV_STYLE_PROP_VALUES_OFS + cnt * (sizeof(lv_style_value_t) + sizeof(uint16_t));
+    uint8_t * values_and_props = lv_mem_alloc(size);
+    LV_ASSERT_MALLOC(values_and_props);
+    return values_and_props;
+}
+
+static lv_style_value_t * props_get_values(uint8_t * values_and_props)
+{
+    return (lv_style_value_t *)(values_and_props + _LV_STYLE_PROP_VALUES_OFS);
+}
+
+static uint16_t * props_get_props(uint8_t * values_and_props, uint32_t cnt)
+{
+    return (uint16_t *)(props_get_values(values_and_props) + cnt);
+}
+
+/**
+ * Find a property in the sorted array of a style
+ * @param values_and_props  the array of the style
+ * @param cnt               number of properties in the array
+ * @param prop_id           the property to find without meta bits
+ * @return                  index of the property, or if it's not found `-(index to insert it) - 1`
+ */
+static int32_t props_find(uint8_t * values_and_props, uint32_t cnt, lv_style_prop_t prop_id)
+{
+    uint16_t * props = props_get_props(values_and_props, cnt);
+    int32_t min = 0;
+    int32_t max = (int32_t)cnt - 1;
+    while(min <= max) {
+        int32_t mid = (min + max) / 2;
+        lv_style_prop_t mid_id = LV_STYLE_PROP_ID_MASK(props[mid]);
+        if(mid_id == prop_id) return mid;
+        if(mid_id < prop_id) min = mid + 1;
+        else max = mid - 1;
+    }
+
+    return -(min + 1);
+}
+
+/*Set the bits of the built-in properties and the number of them before each word*/
+static void props_update_map(uint8_t * values_and_props, uint32_t cnt)
+{
+    _lv_style_prop_map_t * map = (_lv_style_prop_map_t *)values_and_props;
+    uint16_t * props = props_get_props(values_and_props, cnt);
+    lv_memset_00(map, sizeof(_lv_style_prop_map_t));
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(props[i]);
+        if(prop_id < _LV_STYLE_NUM_BUILT_IN_PROPS) map->map[prop_id >> 5] |= (uint32_t)1 << (prop_id & 0x1F);
+    }
+
+    uint32_t base = 0;
+    for(i = 0; i < _LV_STYLE_PROP_MAP_WORDS; i++) {
+        map->base[i] = (uint8_t)base;
+        base += _lv_style_popcount(map->map[i]);
+    }
+}
@@ -323,7 +323,8 @@ typedef struct {
 #endif
 
     /*If there is only one property store it directly.
-     *For more properties allocate an array*/
+     *For more properties allocate an array: a `_lv_style_prop_map_t`, the values and the property IDs,
+     *sorted by ID*/
     union {
         lv_style_value_t value1;
         uint8_t * values_and_props;
@@ -335,6 +336,22 @@ typedef struct {
     uint8_t prop_cnt;
 } lv_style_t;
 
+#define _LV_STYLE_PROP_MAP_WORDS ((_LV_STYLE_NUM_BUILT_IN_PROPS + 31) / 32)
+
+/**
+ * The start of the array of a style with more properties.
+ * As the properties are sorted by ID the index of a built-in property is
+ * the number of bits set before its own bit in `map`.
+ */
+typedef struct {
+    uint32_t map[_LV_STYLE_PROP_MAP_WORDS];     /**< Bit `n` is set if the built-in property `n` is in the style*/
+    uint8_t base[_LV_STYLE_PROP_MAP_WORDS];     /**< Number of properties in the previous words of `map`*/
+} _lv_style_prop_map_t;
+
+/*Offset of the values in the array, after the map, aligned for `lv_style_value_t`*/
+#define _LV_STYLE_PROP_VALUES_OFS \
+    ((sizeof(_lv_style_prop_map_t) + sizeof(lv_style_value_t) - 1) / sizeof(lv_style_value_t) * sizeof(lv_style_value_t))
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -435,6 +452,14 @@ void lv_style_transition_dsc_init(lv_style_transition_dsc_t * tr, const lv_style
  */
 lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 
+/*Number of set bits, to index the properties by `_lv_style_prop_map_t`*/
+static inline uint32_t _lv_style_popcount(uint32_t v)
+{
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
+
 /**
  * Get the value of a property
  * @param style pointer to a style
@@ -467,23 +492,29 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
     if(style->prop_cnt == 0) return LV_STYLE_RES_NOT_FOUND;
 
     if(style->prop_cnt > 1) {
-        uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        uint16_t * props = (uint16_t *)tmp;
+        const _lv_style_prop_map_t * map = (const _lv_style_prop_map_t *)style->v_p.values_and_props;
+        const lv_style_value_t * values = (const lv_style_value_t *)(style->v_p.values_and_props +
+                                                                     _LV_STYLE_PROP_VALUES_OFS);
+        const uint16_t * props = (const uint16_t *)(values + style->prop_cnt);
         uint32_t i;
-        for(i = 0; i < style->prop_cnt; i++) {
-            lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(props[i]);
-            if(prop_id == prop) {
-                if(props[i] & LV_STYLE_PROP_META_INHERIT)
-                    return LV_STYLE_RES_INHERIT;
-                if(props[i] & LV_STYLE_PROP_META_INITIAL)
-                    *value = lv_style_prop_get_default(prop_id);
-                else {
-                    lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
-                    *value = values[i];
-                }
-                return LV_STYLE_RES_FOUND;
-            }
+        if(prop < _LV_STYLE_NUM_BUILT_IN_PROPS) {
+            /*A missing property is only a bit test*/
+            uint32_t bit = (uint32_t)1 << (prop & 0x1F);
+            uint32_t word = map->map[prop >> 5];
+            if((word & bit) == 0) return LV_STYLE_RES_NOT_FOUND;
+            i = map->base[prop >> 5] + _lv_style_popcount(word & (bit - 1));
         }
+        else {
+            /*The custom properties are at the end*/
+            for(i = style->prop_cnt; i > 0 && LV_STYLE_PROP_ID_MASK(props[i - 1]) > prop; i--);
+            if(i == 0 || LV_STYLE_PROP_ID_MASK(props[i - 1]) != prop) return LV_STYLE_RES_NOT_FOUND;
+            i--;
+        }
+
+        if(props[i] & LV_STYLE_PROP_META_INHERIT)
+            return LV_STYLE_RES_INHERIT;
+        *value = (props[i] & LV_STYLE_PROP_META_INITIAL) ? lv_style_prop_get_default(prop) : values[i];
+        return LV_STYLE_RES_FOUND;
     }
     else if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop) {
         if(style->prop1 & LV_STYLE_PROP_META_INHERIT)
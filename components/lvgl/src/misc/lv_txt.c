@@ -99,9 +99,16 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
 
     if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
 
+    uint16_t letter_height = lv_font_get_line_height(font);
+
+    /*Measure the short, single line texts (e.g. values and button labels) only once*/
+    if(text[0] != '\0' && _lv_txt_get_single_line_width(text, font, letter_space, max_width, flag, &size_res->x)) {
+        size_res->y = letter_height;
+        return;
+    }
+
     uint32_t line_start     = 0;
     uint32_t new_line_start = 0;
-    uint16_t letter_height = lv_font_get_line_height(font);
 
     /*Calc. the height and longest line*/
     while(text[line_start] != '\0') {
@@ -340,6 +347,48 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font,
     return i;
 }
 
+bool _lv_txt_get_single_line_width(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                                   lv_coord_t max_width, lv_text_flag_t flag, lv_coord_t * width_res)
+{
+    if(txt == NULL) return false;
+    if(font == NULL) return false;
+    if(flag & LV_TEXT_FLAG_RECOLOR) return false;
+
+    /*With negative letter space a longer text can be narrower so the wrapping can't be predicted*/
+    bool wrap = (flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) == 0;
+    if(wrap && letter_space < 0) return false;
+
+    int32_t width = 0;
+    uint32_t i = 0;
+    while(txt[i] != '\0') {
+        uint32_t letter;
+        uint32_t letter_next;
+        if((uint8_t)txt[i] < 0x80 && (uint8_t)txt[i + 1] < 0x80) {
+            letter = txt[i];
+            letter_next = txt[i + 1];
+            i++;
+        }
+        else {
+            _lv_txt_encoded_letter_next_2(txt, &letter, &letter_next, &i);
+        }
+
+        if(letter == '\n' || letter == '\r') return false;
+
+        lv_coord_t char_width = lv_font_get_glyph_width(font, letter, letter_next);
+        if(char_width > 0) {
+            width += char_width + letter_space;
+            if(width > LV_COORD_MAX) return false;
+        }
+    }
+
+    /*`_lv_txt_get_next_line()` keeps the text in one line only if it fits with the trailing letter space too*/
+    if(wrap && width >= max_width) return false;
+
+    if(width > 0) width -= letter_space;
+    *width_res = width;
+    return true;
+}
+
 lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                             lv_text_flag_t flag)
 {
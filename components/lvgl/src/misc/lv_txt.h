@@ -99,6 +99,21 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
 uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
                                lv_coord_t max_width, lv_coord_t * used_width, lv_text_flag_t flag);
 
+/**
+ * Get the width of a text if it is a single line which doesn't need to be wrapped.
+ * It's a faster alternative of `_lv_txt_get_next_line()` + `lv_txt_get_width()` for short texts
+ * as the letters are measured only once and ASCII characters are not decoded.
+ * @param txt a '\0' terminated string
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max width of the text
+ * @param flags settings for the text from 'txt_flag_t' enum
+ * @param width_res store the width of the text here
+ * @return true: the text is a single line and `width_res` is set; false: measure the lines normally
+ */
+bool _lv_txt_get_single_line_width(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                                   lv_coord_t max_width, lv_text_flag_t flag, lv_coord_t * width_res);
+
 /**
  * Give the length of a text with a given font
  * @param txt a '\0' terminate string
@@ -24,6 +24,15 @@
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct _lv_canvas_batch_t {
+    lv_disp_t disp;
+    lv_disp_drv_t drv;
+    lv_area_t clip_area;
+    lv_area_t inv_area;         /*Union of the areas drawn on in the batch*/
+    lv_disp_t * refr_ori;       /*The display refreshing before the current primitive*/
+    uint8_t antialiasing : 1;
+    uint8_t inv : 1;            /*1: `inv_area` is set*/
+} lv_canvas_batch_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -32,6 +41,9 @@ static void lv_canvas_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
 static void lv_canvas_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void init_fake_disp(lv_obj_t * canvas, lv_disp_t * disp, lv_disp_drv_t * drv, lv_area_t * clip_area);
 static void deinit_fake_disp(lv_obj_t * canvas, lv_disp_t * disp);
+static lv_canvas_batch_t * draw_start(lv_obj_t * canvas, lv_canvas_batch_t * tmp);
+static void draw_finish(lv_obj_t * canvas, lv_canvas_batch_t * batch, const lv_area_t * area);
+static void get_points_area(lv_area_t * area, const lv_point_t points[], uint32_t point_cnt, lv_coord_t ext);
 
 /**********************
  *  STATIC VARIABLES
@@ -70,6 +82,11 @@ void lv_canvas_set_buffer(lv_obj_t * obj, void * buf, lv_coord_t w, lv_coord_t h
 
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
+    if(canvas->batch) {
+        LV_LOG_WARN("lv_canvas_set_buffer: the buffer is changed in a drawing batch, finish it first");
+        lv_canvas_draw_end(obj);
+    }
+
     canvas->dsc.header.cf = cf;
     canvas->dsc.header.w  = w;
     canvas->dsc.header.h  = h;
@@ -523,21 +540,16 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
+    /*Draw with a dummy display to fool the lv_draw function.
      *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    lv_canvas_batch_t tmp;
+    lv_canvas_batch_t * batch = draw_start(canvas, &tmp);
 
     /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
     lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
     if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
        draw_dsc->bg_color.full == ctransp.full) {
-        fake_disp.driver->antialiasing = 0;
+        batch->drv.antialiasing = 0;
     }
 
     lv_area_t coords;
@@ -546,13 +558,21 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
     coords.x2 = x + w - 1;
     coords.y2 = y + h - 1;
 
-    lv_draw_rect(driver.draw_ctx, draw_dsc, &coords);
-
-    _lv_refr_set_disp_refreshing(refr_ori);
+    lv_draw_rect(batch->drv.draw_ctx, draw_dsc, &coords);
 
-    deinit_fake_disp(canvas, &fake_disp);
+    /*The outline and the shadow are drawn out of the coordinates*/
+    lv_coord_t ext = 0;
+    if(draw_dsc->outline_width && draw_dsc->outline_opa > LV_OPA_MIN) {
+        ext = draw_dsc->outline_width + draw_dsc->outline_pad;
+    }
+    if(draw_dsc->shadow_width && draw_dsc->shadow_opa > LV_OPA_MIN) {
+        lv_coord_t sh_ext = draw_dsc->shadow_width / 2 + LV_ABS(draw_dsc->shadow_spread) + 1;
+        sh_ext += LV_MAX(LV_ABS(draw_dsc->shadow_ofs_x), LV_ABS(draw_dsc->shadow_ofs_y));
+        ext = LV_MAX(ext, sh_ext);
+    }
+    lv_area_increase(&coords, ext, ext);
 
-    lv_obj_invalidate(canvas);
+    draw_finish(canvas, batch, &coords);
 }
 
 void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
@@ -567,28 +587,23 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
+    /*Draw with a dummy display to fool the lv_draw function.
      *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    lv_canvas_batch_t tmp;
+    lv_canvas_batch_t * batch = draw_start(canvas, &tmp);
 
     lv_area_t coords;
     coords.x1 = x;
     coords.y1 = y;
     coords.x2 = x + max_w - 1;
     coords.y2 = dsc->header.h - 1;
-    lv_draw_label(driver.draw_ctx, draw_dsc, &coords, txt, NULL);
-
-    _lv_refr_set_disp_refreshing(refr_ori);
+    lv_draw_label(batch->drv.draw_ctx, draw_dsc, &coords, txt, NULL);
 
-    deinit_fake_disp(canvas, &fake_disp);
+    /*The letters can stick out on the sides, so take the whole rows*/
+    coords.x1 = 0;
+    coords.x2 = dsc->header.w - 1;
 
-    lv_obj_invalidate(canvas);
+    draw_finish(canvas, batch, &coords);
 }
 
 void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const void * src,
@@ -609,15 +624,10 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
         LV_LOG_WARN("lv_canvas_draw_img: Couldn't get the image data.");
         return;
     }
-    /*Create a dummy display to fool the lv_draw function.
+    /*Draw with a dummy display to fool the lv_draw function.
      *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    lv_canvas_batch_t tmp;
+    lv_canvas_batch_t * batch = draw_start(canvas, &tmp);
 
     lv_area_t coords;
     coords.x1 = x;
@@ -625,13 +635,15 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
     coords.x2 = x + header.w - 1;
     coords.y2 = y + header.h - 1;
 
-    lv_draw_img(driver.draw_ctx, draw_dsc, &coords, src);
+    lv_draw_img(batch->drv.draw_ctx, draw_dsc, &coords, src);
 
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    deinit_fake_disp(canvas, &fake_disp);
+    if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
+        _lv_img_buf_get_transformed_area(&coords, header.w, header.h, draw_dsc->angle, draw_dsc->zoom,
+                                         &draw_dsc->pivot);
+        lv_area_move(&coords, x, y);
+    }
 
-    lv_obj_invalidate(canvas);
+    draw_finish(canvas, batch, &coords);
 }
 
 void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t point_cnt,
@@ -646,33 +658,26 @@ void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
+    /*Draw with a dummy display to fool the lv_draw function.
      *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    lv_canvas_batch_t tmp;
+    lv_canvas_batch_t * batch = draw_start(canvas, &tmp);
 
     /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
     lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
     if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
        draw_dsc->color.full == ctransp.full) {
-        fake_disp.driver->antialiasing = 0;
+        batch->drv.antialiasing = 0;
     }
 
     uint32_t i;
     for(i = 0; i < point_cnt - 1; i++) {
-        lv_draw_line(driver.draw_ctx, draw_dsc, &points[i], &points[i + 1]);
+        lv_draw_line(batch->drv.draw_ctx, draw_dsc, &points[i], &points[i + 1]);
     }
 
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    deinit_fake_disp(canvas, &fake_disp);
-
-    lv_obj_invalidate(canvas);
+    lv_area_t area;
+    get_points_area(&area, points, point_cnt, draw_dsc->width / 2 + 1);
+    draw_finish(canvas, batch, &area);
 }
 
 void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32_t point_cnt,
@@ -687,30 +692,23 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
+    /*Draw with a dummy display to fool the lv_draw function.
      *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    lv_canvas_batch_t tmp;
+    lv_canvas_batch_t * batch = draw_start(canvas, &tmp);
 
     /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
     lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
     if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
        draw_dsc->bg_color.full == ctransp.full) {
-        fake_disp.driver->antialiasing = 0;
+        batch->drv.antialiasing = 0;
     }
 
-    lv_draw_polygon(driver.draw_ctx, draw_dsc, points, point_cnt);
-
-    _lv_refr_set_disp_refreshing(refr_ori);
+    lv_draw_polygon(batch->drv.draw_ctx, draw_dsc, points, point_cnt);
 
-    deinit_fake_disp(canvas, &fake_disp);
-
-    lv_obj_invalidate(canvas);
+    lv_area_t area;
+    get_points_area(&area, points, point_cnt, 1);
+    draw_finish(canvas, batch, &area);
 }
 
 void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t r, int32_t start_angle,
@@ -726,24 +724,21 @@ void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
+    /*Draw with a dummy display to fool the lv_draw function.
      *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    lv_canvas_batch_t tmp;
+    lv_canvas_batch_t * batch = draw_start(canvas, &tmp);
 
     lv_point_t p = {x, y};
-    lv_draw_arc(driver.draw_ctx, draw_dsc, &p, r,  start_angle, end_angle);
-
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    deinit_fake_disp(canvas, &fake_disp);
-
-    lv_obj_invalidate(canvas);
+    lv_draw_arc(batch->drv.draw_ctx, draw_dsc, &p, r,  start_angle, end_angle);
+
+    /*The arc is drawn inside the radius*/
+    lv_area_t area;
+    area.x1 = x - r;
+    area.y1 = y - r;
+    area.x2 = x + r;
+    area.y2 = y + r;
+    draw_finish(canvas, batch, &area);
 #else
     LV_UNUSED(canvas);
     LV_UNUSED(x);
@@ -756,6 +751,63 @@ void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_
 #endif
 }
 
+void lv_canvas_draw_begin(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    if(canvas->batch) {
+        LV_LOG_WARN("lv_canvas_draw_begin: already drawing in a batch");
+        return;
+    }
+
+    lv_canvas_batch_t * batch = lv_mem_alloc(sizeof(lv_canvas_batch_t));
+    LV_ASSERT_MALLOC(batch);
+    if(batch == NULL) return;
+
+    init_fake_disp(obj, &batch->disp, &batch->drv, &batch->clip_area);
+    if(batch->drv.draw_ctx == NULL) {
+        lv_mem_free(batch);
+        return;
+    }
+
+    batch->antialiasing = batch->drv.antialiasing;
+    batch->inv = 0;
+    canvas->batch = batch;
+}
+
+void lv_canvas_draw_end(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    lv_canvas_batch_t * batch = canvas->batch;
+    if(batch == NULL) return;
+
+    canvas->batch = NULL;
+    deinit_fake_disp(obj, &batch->disp);
+
+    if(batch->inv) {
+        lv_img_t * img = &canvas->img;
+        lv_area_t content;
+        lv_obj_get_content_coords(obj, &content);
+
+        /*If the image is drawn 1:1 only the drawn area needs to be refreshed,
+         *else it's transformed or repeated so invalidate the whole canvas*/
+        if(img->zoom == LV_IMG_ZOOM_NONE && img->angle == 0 && img->offset.x == 0 && img->offset.y == 0 &&
+           lv_area_get_width(&content) == canvas->dsc.header.w &&
+           lv_area_get_height(&content) == canvas->dsc.header.h) {
+            lv_area_move(&batch->inv_area, content.x1, content.y1);
+            lv_obj_invalidate_area(obj, &batch->inv_area);
+        }
+        else {
+            lv_obj_invalidate(obj);
+        }
+    }
+
+    lv_mem_free(batch);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -773,6 +825,7 @@ static void lv_canvas_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
     canvas->dsc.header.w           = 0;
     canvas->dsc.data_size          = 0;
     canvas->dsc.data               = NULL;
+    canvas->batch                  = NULL;
 
     lv_img_set_src(obj, &canvas->dsc);
 
@@ -785,6 +838,12 @@ static void lv_canvas_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_TRACE_OBJ_CREATE("begin");
 
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    if(canvas->batch) {
+        deinit_fake_disp(obj, &canvas->batch->disp);
+        lv_mem_free(canvas->batch);
+        canvas->batch = NULL;
+    }
+
     lv_img_cache_invalidate_src(&canvas->dsc);
 }
 
@@ -827,4 +886,71 @@ static void deinit_fake_disp(lv_obj_t * canvas, lv_disp_t * disp)
     lv_mem_free(disp->driver->draw_ctx);
 }
 
+/**
+ * Get the context to draw a primitive with: the one of the batch or a new one in `tmp`
+ */
+static lv_canvas_batch_t * draw_start(lv_obj_t * obj, lv_canvas_batch_t * tmp)
+{
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    lv_canvas_batch_t * batch = canvas->batch;
+    if(batch == NULL) {
+        batch = tmp;
+        init_fake_disp(obj, &batch->disp, &batch->drv, &batch->clip_area);
+    }
+
+    batch->refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&batch->disp);
+
+    return batch;
+}
+
+/**
+ * Finish drawing a primitive. Out of a batch the context is freed and the canvas is invalidated,
+ * in a batch only the area drawn on (relative to the canvas) is collected.
+ */
+static void draw_finish(lv_obj_t * obj, lv_canvas_batch_t * batch, const lv_area_t * area)
+{
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+
+    _lv_refr_set_disp_refreshing(batch->refr_ori);
+
+    if(batch != canvas->batch) {
+        deinit_fake_disp(obj, &batch->disp);
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /*The anti-aliasing might be disabled for the primitive*/
+    batch->drv.antialiasing = batch->antialiasing;
+
+    lv_area_t a;
+    if(!_lv_area_intersect(&a, area, &batch->clip_area)) return;
+
+    if(batch->inv) {
+        _lv_area_join(&batch->inv_area, &batch->inv_area, &a);
+    }
+    else {
+        lv_area_copy(&batch->inv_area, &a);
+        batch->inv = 1;
+    }
+}
+
+static void get_points_area(lv_area_t * area, const lv_point_t points[], uint32_t point_cnt, lv_coord_t ext)
+{
+    area->x1 = LV_COORD_MAX;
+    area->y1 = LV_COORD_MAX;
+    area->x2 = LV_COORD_MIN;
+    area->y2 = LV_COORD_MIN;
+
+    uint32_t i;
+    for(i = 0; i < point_cnt; i++) {
+        area->x1 = LV_MIN(area->x1, points[i].x);
+        area->y1 = LV_MIN(area->y1, points[i].y);
+        area->x2 = LV_MAX(area->x2, points[i].x);
+        area->y2 = LV_MAX(area->y2, points[i].y);
+    }
+
+    lv_area_increase(area, ext, ext);
+}
+
 #endif
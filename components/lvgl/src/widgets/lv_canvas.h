@@ -30,10 +30,13 @@ extern "C" {
  **********************/
 extern const lv_obj_class_t lv_canvas_class;
 
+struct _lv_canvas_batch_t;
+
 /*Data of canvas*/
 typedef struct {
     lv_img_t img;
     lv_img_dsc_t dsc;
+    struct _lv_canvas_batch_t * batch;   /*The drawing context between `lv_canvas_draw_begin/end`*/
 } lv_canvas_t;
 
 /**********************
@@ -251,6 +254,21 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32
 void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t r, int32_t start_angle,
                         int32_t end_angle, const lv_draw_arc_dsc_t * draw_dsc);
 
+/**
+ * Start drawing more primitives on the canvas with the same drawing context.
+ * The `lv_canvas_draw_...` functions called until `lv_canvas_draw_end()` don't create a new context
+ * and don't invalidate the whole canvas each, only the areas they draw on are collected.
+ * The buffer of the canvas shouldn't be changed until `lv_canvas_draw_end()`.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_begin(lv_obj_t * canvas);
+
+/**
+ * Finish drawing started with `lv_canvas_draw_begin()` and invalidate the area drawn on.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_end(lv_obj_t * canvas);
+
 /**********************
  *      MACROS
  **********************/
@@ -63,6 +63,7 @@ const lv_obj_class_t lv_dropdown_class = {
     .constructor_cb = lv_dropdown_constructor,
     .destructor_cb = lv_dropdown_destructor,
     .event_cb = lv_dropdown_event,
+    .draw_events = LV_OBJ_CLASS_DRAW_EVENTS_DEF,
     .width_def = LV_DPI_DEF,
     .height_def = LV_SIZE_CONTENT,
     .instance_size = sizeof(lv_dropdown_t),
@@ -75,6 +76,7 @@ const lv_obj_class_t lv_dropdownlist_class = {
     .constructor_cb = lv_dropdownlist_constructor,
     .destructor_cb = lv_dropdownlist_destructor,
     .event_cb = lv_dropdown_list_event,
+    .draw_events = LV_OBJ_CLASS_DRAW_EVENTS_DEF,
     .instance_size = sizeof(lv_dropdown_list_t),
     .base_class = &lv_obj_class
 };
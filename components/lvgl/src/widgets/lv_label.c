@@ -46,8 +46,16 @@ static void lv_label_revert_dots(lv_obj_t * label);
 static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
+static void get_text_size(lv_obj_t * obj, lv_point_t * size_res, const lv_font_t * font, lv_coord_t letter_space,
+                          lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag);
+#if LV_LABEL_LINE_CACHE
+static const lv_label_line_cache_t * line_cache_get(lv_obj_t * obj, const lv_font_t * font, lv_coord_t letter_space,
+                                                    lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag);
+static void line_cache_invalidate(lv_obj_t * obj);
+#endif
 static void set_ofs_x_anim(void * obj, int32_t v);
 static void set_ofs_y_anim(void * obj, int32_t v);
+static uint32_t num_to_str(char * buf, int32_t value, uint8_t frac, uint8_t prec, lv_label_num_conv_t conv);
 
 /**********************
  *  STATIC VARIABLES
@@ -56,6 +64,7 @@ const lv_obj_class_t lv_label_class = {
     .constructor_cb = lv_label_constructor,
     .destructor_cb = lv_label_destructor,
     .event_cb = lv_label_event,
+    .draw_events = LV_OBJ_CLASS_DRAW_EVENTS_DEF,
     .width_def = LV_SIZE_CONTENT,
     .height_def = LV_SIZE_CONTENT,
     .instance_size = sizeof(lv_label_t),
@@ -190,6 +199,46 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
     lv_label_refr_text(obj);
 }
 
+void lv_label_set_num(lv_obj_t * obj, int32_t value, uint8_t frac, uint8_t prec, lv_label_num_conv_t conv,
+                      const char * suffix)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_label_t * label = (lv_label_t *)obj;
+
+    /*Sign, 10 integer digits, decimal point, decimals, suffix, '\0'*/
+    char buf[1 + 10 + 1 + LV_LABEL_NUM_FRAC_MAX + LV_LABEL_NUM_SUFFIX_MAX + 1];
+    uint32_t len = num_to_str(buf, value, frac, prec, conv);
+    if(suffix) {
+        uint32_t suffix_len = 0;
+        while(suffix[suffix_len] != '\0' && suffix_len < LV_LABEL_NUM_SUFFIX_MAX) suffix_len++;
+
+        /*Don't cut a UTF-8 character in half: drop its bytes before the cut too*/
+        if(suffix[suffix_len] != '\0') {
+            while(suffix_len > 0 && (suffix[suffix_len] & 0xC0) == 0x80) suffix_len--;
+        }
+
+        lv_memcpy(&buf[len], suffix, suffix_len);
+        len += suffix_len;
+    }
+    buf[len] = '\0';
+
+    /*Nothing to do if the same characters are shown.
+     *(With Arabic and Persian characters in the suffix the stored text is processed so it's always updated)*/
+    if(label->text && strcmp(label->text, buf) == 0) return;
+
+#if LV_USE_ARABIC_PERSIAN_CHARS == 0
+    /*Overwrite the text in place if it has the same length. (Not in dot mode as the dots are written in the text too)*/
+    if(label->text && label->static_txt == 0 && label->dot_end == LV_LABEL_DOT_END_INV && strlen(label->text) == len) {
+        lv_obj_invalidate(obj);
+        lv_memcpy(label->text, buf, len);
+        lv_label_refr_text(obj);
+        return;
+    }
+#endif
+
+    lv_label_set_text(obj, buf);
+}
+
 void lv_label_set_long_mode(lv_obj_t * obj, lv_label_long_mode_t long_mode)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -706,6 +755,10 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    label->line_cache.lines = NULL;
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     label->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -726,6 +779,9 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_t * label = (lv_label_t *)obj;
 
     lv_label_dot_tmp_free(obj);
+#if LV_LABEL_LINE_CACHE
+    line_cache_invalidate(obj);
+#endif
     if(!label->static_txt) lv_mem_free(label->text);
     label->text = NULL;
 }
@@ -772,10 +828,14 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
         if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
 
         lv_coord_t w = lv_obj_get_content_width(obj);
-        if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) w = LV_COORD_MAX;
+        if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) {
+            /*The same as in `lv_label_refr_text` and `draw_main` to use the same measured lines*/
+            w = LV_COORD_MAX;
+            flag |= LV_TEXT_FLAG_FIT;
+        }
         else w = lv_obj_get_content_width(obj);
 
-        lv_txt_get_size(&size, label->text, font, letter_space, line_space, w, flag);
+        get_text_size(obj, &size, font, letter_space, line_space, w, flag);
 
         lv_point_t * self_size = lv_event_get_param(e);
         self_size->x = LV_MAX(self_size->x, size.x);
@@ -838,6 +898,16 @@ static void draw_main(lv_event_t * e)
     lv_draw_label_hint_t * hint = NULL;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    /*Draw the lines measured in advance instead of measuring them again in every refresh*/
+    const lv_label_line_cache_t * line_cache = line_cache_get(obj, label_draw_dsc.font, label_draw_dsc.letter_space,
+                                                              label_draw_dsc.line_space, lv_area_get_width(&txt_coords), flag);
+    if(line_cache) {
+        label_draw_dsc.lines = line_cache->lines;
+        label_draw_dsc.line_cnt = line_cache->line_cnt;
+    }
+#endif
+
     lv_area_t txt_clip;
     bool is_common = _lv_area_intersect(&txt_clip, &txt_coords, draw_ctx->clip_area);
     if(!is_common) return;
@@ -897,6 +967,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
 #if LV_LABEL_LONG_TXT_HINT
     label->hint.line_start = -1; /*The hint is invalid if the text changes*/
 #endif
+#if LV_LABEL_LINE_CACHE
+    line_cache_invalidate(obj);
+#endif
 
     lv_area_t txt_coords;
     lv_obj_get_content_coords(obj, &txt_coords);
@@ -912,7 +985,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    get_text_size(obj, &size, font, letter_space, line_space, max_w, flag);
 
     lv_obj_refresh_self_size(obj);
 
@@ -923,6 +996,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
         lv_anim_t a;
         lv_anim_init(&a);
         lv_anim_set_var(&a, obj);
+        lv_anim_set_skip_hidden(&a, true);
         lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
         lv_anim_set_playback_delay(&a, LV_LABEL_SCROLL_DELAY);
         lv_anim_set_repeat_delay(&a, a.playback_delay);
@@ -1025,6 +1099,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
         lv_anim_t a;
         lv_anim_init(&a);
         lv_anim_set_var(&a, obj);
+        lv_anim_set_skip_hidden(&a, true);
         lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
 
         bool hor_anim = false;
@@ -1156,6 +1231,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
                 }
                 label->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 label->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+#if LV_LABEL_LINE_CACHE
+                line_cache_invalidate(obj);
+#endif
             }
         }
     }
@@ -1187,6 +1265,9 @@ static void lv_label_revert_dots(lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
 
     label->dot_end = LV_LABEL_DOT_END_INV;
+#if LV_LABEL_LINE_CACHE
+    line_cache_invalidate(obj);
+#endif
 }
 
 /**
@@ -1252,6 +1333,150 @@ static void lv_label_dot_tmp_free(lv_obj_t * obj)
     label->dot.tmp_ptr   = NULL;
 }
 
+/**
+ * Get the size of the label's text. Use the measured lines if possible.
+ * @param obj           pointer to a label object
+ * @param size_res      pointer to a 'point_t' variable to store the result
+ * @param font          the font of the text
+ * @param letter_space  letter space of the text
+ * @param line_space    line space of the text
+ * @param max_w         max width of the text (break the lines to fit this size)
+ * @param flag          settings for the text from 'txt_flag_t' enum
+ */
+static void get_text_size(lv_obj_t * obj, lv_point_t * size_res, const lv_font_t * font, lv_coord_t letter_space,
+                          lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag)
+{
+#if LV_LABEL_LINE_CACHE
+    const lv_label_line_cache_t * line_cache = line_cache_get(obj, font, letter_space, line_space, max_w, flag);
+    if(line_cache) {
+        *size_res = line_cache->size;
+        return;
+    }
+#endif
+
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_txt_get_size(size_res, label->text, font, letter_space, line_space, max_w, flag);
+}
+
+#if LV_LABEL_LINE_CACHE
+/**
+ * Get the lines of the label's text. They are measured only if the text or the parameters
+ * have changed since the last measurement.
+ * @param obj           pointer to a label object
+ * @param font          the font of the text
+ * @param letter_space  letter space of the text
+ * @param line_space    line space of the text
+ * @param max_w         max width of the text (break the lines to fit this size)
+ * @param flag          settings for the text from 'txt_flag_t' enum
+ * @return              the measured lines or NULL if they couldn't be stored
+ */
+static const lv_label_line_cache_t * line_cache_get(lv_obj_t * obj, const lv_font_t * font, lv_coord_t letter_space,
+                                                    lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_label_line_cache_t * cache = &label->line_cache;
+    const char * txt = label->text;
+    if(txt == NULL || font == NULL) return NULL;
+
+    /*The max. width doesn't matter if the lines are not wrapped*/
+    if(flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) max_w = LV_COORD_MAX;
+
+    if(cache->lines && cache->font == font && cache->max_w == max_w && cache->flag == flag &&
+       cache->letter_space == letter_space && cache->line_space == line_space) {
+        return cache;
+    }
+
+    line_cache_invalidate(obj);
+
+    lv_coord_t letter_height = lv_font_get_line_height(font);
+    lv_draw_label_line_t * lines = &cache->line;
+    uint32_t line_cnt = 0;
+    lv_point_t size = {0, 0};
+
+    /*Most of the labels are single line so try the fast path first*/
+    lv_coord_t line_w;
+    if(txt[0] != '\0' && _lv_txt_get_single_line_width(txt, font, letter_space, max_w, flag, &line_w)) {
+        lines[0].end = strlen(txt);
+        lines[0].width = line_w;
+        line_cnt = 1;
+        size.x = line_w;
+        size.y = letter_height;
+    }
+    else {
+        uint32_t line_cap = 1;
+        uint32_t line_start = 0;
+        int32_t h = 0;
+        while(txt[line_start] != '\0') {
+            uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+
+            if(h + letter_height + line_space > (int32_t)LV_MAX_OF(lv_coord_t)) {
+                LV_LOG_WARN("integer overflow while calculating text height");
+                if(lines != &cache->line) lv_mem_free(lines);
+                return NULL;
+            }
+            h += letter_height + line_space;
+
+            if(line_cnt == line_cap) {
+                line_cap *= 2;
+                lv_draw_label_line_t * lines_new;
+                if(lines == &cache->line) {
+                    lines_new = lv_mem_alloc(line_cap * sizeof(lv_draw_label_line_t));
+                    if(lines_new) lines_new[0] = cache->line;
+                }
+                else {
+                    lines_new = lv_mem_realloc(lines, line_cap * sizeof(lv_draw_label_line_t));
+                }
+
+                if(lines_new == NULL) {
+                    LV_LOG_WARN("couldn't allocate memory for the lines");
+                    if(lines != &cache->line) lv_mem_free(lines);
+                    return NULL;
+                }
+                lines = lines_new;
+            }
+
+            lines[line_cnt].end = line_end;
+            lines[line_cnt].width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+            size.x = LV_MAX(size.x, lines[line_cnt].width);
+            line_cnt++;
+            line_start = line_end;
+        }
+
+        /*Make the text one line taller if the last character is '\n' or '\r'*/
+        if(line_start != 0 && (txt[line_start - 1] == '\n' || txt[line_start - 1] == '\r')) {
+            h += letter_height + line_space;
+        }
+
+        /*Correction with the last line space or set the height manually if the text is empty*/
+        size.y = h == 0 ? letter_height : h - line_space;
+    }
+
+    cache->lines = lines;
+    cache->line_cnt = line_cnt;
+    cache->size = size;
+    cache->font = font;
+    cache->max_w = max_w;
+    cache->letter_space = letter_space;
+    cache->line_space = line_space;
+    cache->flag = flag;
+
+    return cache;
+}
+
+/**
+ * Free the measured lines. Should be called when the text changes.
+ * @param obj       pointer to a label object
+ */
+static void line_cache_invalidate(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_label_line_cache_t * cache = &label->line_cache;
+    if(cache->lines && cache->lines != &cache->line) lv_mem_free(cache->lines);
+    cache->lines = NULL;
+    cache->line_cnt = 0;
+}
+#endif
+
 static void set_ofs_x_anim(void * obj, int32_t v)
 {
     lv_label_t * label = (lv_label_t *)obj;
@@ -1267,3 +1492,82 @@ static void set_ofs_y_anim(void * obj, int32_t v)
 }
 
 #endif
+
+static int64_t div_round(int64_t a, int64_t b)
+{
+    return (a >= 0 ? a + b / 2 : a - b / 2) / b;
+}
+
+/*`a * mul / div` rounded, without overflowing with large `a` and `div`*/
+static int64_t mul_div_round(int64_t a, int64_t mul, int64_t div)
+{
+    return (a / div) * mul + div_round((a % div) * mul, div);
+}
+
+/**
+ * Write a fixed-point number to a buffer with integer operations
+ * @param buf       buffer for at least 18 characters, not '\0' terminated
+ * @param value     the value multiplied by 10^`frac`
+ * @param frac      number of decimal digits in `value`
+ * @param prec      number of decimal digits to write
+ * @param conv      unit conversion to apply
+ * @return          number of characters written
+ */
+static uint32_t num_to_str(char * buf, int32_t value, uint8_t frac, uint8_t prec, lv_label_num_conv_t conv)
+{
+    static const int32_t pow10_tbl[LV_LABEL_NUM_FRAC_MAX + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+    if(frac > LV_LABEL_NUM_FRAC_MAX) frac = LV_LABEL_NUM_FRAC_MAX;
+    if(prec > LV_LABEL_NUM_FRAC_MAX) prec = LV_LABEL_NUM_FRAC_MAX;
+
+    /*Convert and round to the shown decimals in one step, so the extra decimals are not only zeros
+     *and the value is not rounded twice*/
+    int64_t v = value;
+    int64_t div = 1;
+    if(prec > frac) v *= pow10_tbl[prec - frac];
+    else div = pow10_tbl[frac - prec];
+
+    switch(conv) {
+        case LV_LABEL_NUM_CONV_C_TO_F:
+            v = mul_div_round(v, 9, 5 * div) + 32 * (int64_t)pow10_tbl[prec];
+            break;
+        case LV_LABEL_NUM_CONV_HPA_TO_INHG:
+            v = mul_div_round(v, 2953, 100000 * div);          /*1 hPa = 0.02953 inHg*/
+            break;
+        case LV_LABEL_NUM_CONV_HPA_TO_MMHG:
+            v = mul_div_round(v, 750062, 1000000 * div);       /*1 hPa = 0.750062 mmHg*/
+            break;
+        default:
+            v = div_round(v, div);
+            break;
+    }
+
+    uint32_t len = 0;
+    if(v < 0) {
+        buf[len] = '-';
+        len++;
+        v = -v;
+    }
+
+    /*The digits backward, at least one integer digit*/
+    char tmp[20];
+    uint32_t digit_cnt = 0;
+    uint64_t u = (uint64_t)v;
+    do {
+        tmp[digit_cnt] = (char)('0' + u % 10);
+        digit_cnt++;
+        u /= 10;
+    } while(u != 0 || digit_cnt <= prec);
+
+    while(digit_cnt > 0) {
+        if(digit_cnt == prec) {
+            buf[len] = '.';
+            len++;
+        }
+        digit_cnt--;
+        buf[len] = tmp[digit_cnt];
+        len++;
+    }
+
+    return len;
+}
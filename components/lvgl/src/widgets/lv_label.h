@@ -31,6 +31,8 @@ extern "C" {
 #define LV_LABEL_DOT_NUM 3
 #define LV_LABEL_POS_LAST 0xFFFF
 #define LV_LABEL_TEXT_SELECTION_OFF LV_DRAW_LABEL_NO_TXT_SEL
+#define LV_LABEL_NUM_FRAC_MAX 6     /*Max. number of decimal digits in `lv_label_set_num`*/
+#define LV_LABEL_NUM_SUFFIX_MAX 15  /*Max. length of the suffix in `lv_label_set_num` in bytes*/
 
 LV_EXPORT_CONST_INT(LV_LABEL_DOT_NUM);
 LV_EXPORT_CONST_INT(LV_LABEL_POS_LAST);
@@ -50,6 +52,30 @@ enum {
 };
 typedef uint8_t lv_label_long_mode_t;
 
+/** Unit conversions of `lv_label_set_num`*/
+enum {
+    LV_LABEL_NUM_CONV_NONE,         /**< Show the value as it is*/
+    LV_LABEL_NUM_CONV_C_TO_F,       /**< Convert °C to °F*/
+    LV_LABEL_NUM_CONV_HPA_TO_INHG,  /**< Convert hPa to inches of mercury*/
+    LV_LABEL_NUM_CONV_HPA_TO_MMHG,  /**< Convert hPa to millimeters of mercury*/
+};
+typedef uint8_t lv_label_num_conv_t;
+
+#if LV_LABEL_LINE_CACHE
+/** The lines of the text and the parameters they were measured with*/
+typedef struct {
+    lv_draw_label_line_t * lines;   /*NULL: not measured yet. Points to `line` if there is at most one line*/
+    lv_draw_label_line_t line;
+    uint32_t line_cnt;
+    lv_point_t size;                /*Size of the whole text*/
+    const lv_font_t * font;
+    lv_coord_t max_w;
+    lv_coord_t letter_space;
+    lv_coord_t line_space;
+    lv_text_flag_t flag;
+} lv_label_line_cache_t;
+#endif
+
 typedef struct {
     lv_obj_t obj;
     char * text;
@@ -63,6 +89,10 @@ typedef struct {
     lv_draw_label_hint_t hint;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_label_line_cache_t line_cache;
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
@@ -116,6 +146,21 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...) LV_FORMAT_ATTR
  */
 void lv_label_set_text_static(lv_obj_t * obj, const char * text);
 
+/**
+ * Set a fixed-point number with a unit as the text of a label. It's formatted with integer
+ * operations only, without `printf`, and the label is refreshed only if its text changes.
+ * @param obj           pointer to a label object
+ * @param value         the value multiplied by 10^`frac`, e.g. 2550 with `frac` 2 is 25.50
+ * @param frac          number of decimal digits in `value` (max. `LV_LABEL_NUM_FRAC_MAX`)
+ * @param prec          number of decimal digits to show, the value is rounded to it (max. `LV_LABEL_NUM_FRAC_MAX`)
+ * @param conv          unit conversion to apply on the value before rounding, e.g. `LV_LABEL_NUM_CONV_C_TO_F`
+ * @param suffix        text to append after the number (e.g. "°F" or " hPa"), NULL if not used.
+ *                      Longer suffixes than `LV_LABEL_NUM_SUFFIX_MAX` bytes are cut before the character that doesn't fit.
+ * @example lv_label_set_num(label, 1013250, 3, 2, LV_LABEL_NUM_CONV_HPA_TO_INHG, " inHg"); -> "29.92 inHg"
+ */
+void lv_label_set_num(lv_obj_t * obj, int32_t value, uint8_t frac, uint8_t prec, lv_label_num_conv_t conv,
+                      const char * suffix);
+
 /**
  * Set the behavior of the label with longer text then the object size
  * @param obj           pointer to a label object
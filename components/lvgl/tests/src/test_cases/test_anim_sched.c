@@ -0,0 +1,164 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_ANIM_SYNC_REFR
+
+static lv_obj_t * obj;
+static uint32_t exec_cnt;
+static int32_t last_value;
+
+static void exec_cb(void * var, int32_t v)
+{
+    LV_UNUSED(var);
+    exec_cnt++;
+    last_value = v;
+}
+
+static void start_anim(bool skip_hidden)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, obj);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_values(&a, 0, 1000);
+    lv_anim_set_time(&a, 150);
+    lv_anim_set_skip_hidden(&a, skip_hidden);
+    lv_anim_start(&a);
+
+    /*The start value is applied immediately*/
+    TEST_ASSERT_EQUAL_UINT32(1, exec_cnt);
+    TEST_ASSERT_EQUAL_INT32(0, last_value);
+}
+
+static void wait_ms(uint32_t ms)
+{
+    uint32_t i;
+    for(i = 0; i < ms; i++) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+}
+
+void setUp(void)
+{
+    obj = lv_obj_create(lv_scr_act());
+    exec_cnt = 0;
+    last_value = -1;
+    lv_refr_now(NULL);
+}
+
+void tearDown(void)
+{
+    lv_disp_set_refr_paused(NULL, false);
+    lv_anim_del_all();
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_anim_sched_runs_with_the_refresh(void)
+{
+    start_anim(false);
+
+    /*Only the refresh timer runs the animations*/
+    TEST_ASSERT_TRUE(lv_anim_get_timer()->paused);
+    TEST_ASSERT_FALSE(lv_disp_get_default()->refr_timer->paused);
+
+    wait_ms(300);
+    TEST_ASSERT_GREATER_THAN_UINT32(2, exec_cnt);
+    TEST_ASSERT_EQUAL_INT32(1000, last_value);
+    TEST_ASSERT_EQUAL_UINT16(0, lv_anim_count_running());
+
+    /*Nothing is left to do*/
+    TEST_ASSERT_TRUE(lv_disp_get_default()->refr_timer->paused);
+}
+
+void test_anim_sched_paused_refresh_stops_the_anims(void)
+{
+    lv_disp_set_refr_paused(NULL, true);
+    start_anim(false);
+    TEST_ASSERT_TRUE(lv_disp_get_default()->refr_timer->paused);
+
+    wait_ms(200);
+    TEST_ASSERT_EQUAL_UINT32(1, exec_cnt);
+    TEST_ASSERT_EQUAL_UINT16(1, lv_anim_count_running());
+
+    /*The time elapsed in the meantime is caught up in one step*/
+    lv_disp_set_refr_paused(NULL, false);
+    wait_ms(20);
+    TEST_ASSERT_EQUAL_UINT32(2, exec_cnt);
+    TEST_ASSERT_EQUAL_INT32(1000, last_value);
+}
+
+void test_anim_sched_1ms_jitter(void)
+{
+    start_anim(false);
+
+    /*A refresh 1 ms earlier than the animation's period still steps the animations*/
+    lv_tick_inc(lv_anim_get_timer()->period - 1);
+    TEST_ASSERT_TRUE(_lv_anim_refr_frame());
+    TEST_ASSERT_EQUAL_UINT32(2, exec_cnt);
+
+    /*But not twice in the same period*/
+    lv_tick_inc(1);
+    TEST_ASSERT_TRUE(_lv_anim_refr_frame());
+    TEST_ASSERT_EQUAL_UINT32(2, exec_cnt);
+}
+
+void test_anim_sched_skip_hidden(void)
+{
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    start_anim(true);
+
+    wait_ms(100);
+    TEST_ASSERT_EQUAL_UINT32(1, exec_cnt);
+
+    /*The end value is applied even if the object is still hidden*/
+    wait_ms(200);
+    TEST_ASSERT_EQUAL_UINT32(2, exec_cnt);
+    TEST_ASSERT_EQUAL_INT32(1000, last_value);
+
+    /*A visible object is animated as usual*/
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    exec_cnt = 0;
+    start_anim(true);
+    wait_ms(300);
+    TEST_ASSERT_GREATER_THAN_UINT32(2, exec_cnt);
+    TEST_ASSERT_EQUAL_INT32(1000, last_value);
+}
+
+#else /*LV_ANIM_SYNC_REFR*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_anim_sched_runs_with_the_refresh(void)
+{
+
+}
+
+void test_anim_sched_paused_refresh_stops_the_anims(void)
+{
+
+}
+
+void test_anim_sched_1ms_jitter(void)
+{
+
+}
+
+void test_anim_sched_skip_hidden(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,176 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_CANVAS && LV_DRAW_COMPLEX
+
+#define CANVAS_W    100
+#define CANVAS_H    80
+
+static lv_color_t canvas_buf1[CANVAS_W * CANVAS_H];
+static lv_color_t canvas_buf2[CANVAS_W * CANVAS_H];
+static lv_obj_t * canvas;
+
+/*A small gauge: a frame, a scale arc, a needle and a caption*/
+static void draw_gauge(int32_t value)
+{
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.radius = 8;
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_BLUE_GREY);
+    rect_dsc.border_width = 2;
+    rect_dsc.border_color = lv_palette_main(LV_PALETTE_ORANGE);
+    lv_canvas_draw_rect(canvas, 5, 5, 90, 70, &rect_dsc);
+
+    lv_draw_arc_dsc_t arc_dsc;
+    lv_draw_arc_dsc_init(&arc_dsc);
+    arc_dsc.color = lv_palette_main(LV_PALETTE_GREEN);
+    arc_dsc.width = 6;
+    lv_canvas_draw_arc(canvas, 50, 45, 30, 135, 45, &arc_dsc);
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    line_dsc.color = lv_palette_main(LV_PALETTE_RED);
+    line_dsc.width = 3;
+    line_dsc.round_end = 1;
+    lv_point_t needle[2];
+    needle[0].x = 50;
+    needle[0].y = 45;
+    needle[1].x = 50 + ((lv_trigo_cos(value) * 25) >> LV_TRIGO_SHIFT);
+    needle[1].y = 45 + ((lv_trigo_sin(value) * 25) >> LV_TRIGO_SHIFT);
+    lv_canvas_draw_line(canvas, needle, 2, &line_dsc);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.color = lv_color_white();
+    lv_canvas_draw_text(canvas, 30, 55, 40, &label_dsc, "hPa");
+}
+
+/*`lv_obj_invalidate_area()` adds a few pixels of margin to the area*/
+static void check_inv_area(const lv_area_t * inv_area, const lv_area_t * expected)
+{
+    TEST_ASSERT_TRUE(_lv_area_is_in(expected, inv_area, 0));
+    TEST_ASSERT_LESS_OR_EQUAL(lv_area_get_width(expected) + 10, lv_area_get_width(inv_area));
+    TEST_ASSERT_LESS_OR_EQUAL(lv_area_get_height(expected) + 10, lv_area_get_height(inv_area));
+}
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_scr_act());
+    lv_obj_set_pos(canvas, 40, 30);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_canvas_batch_draws_the_same(void)
+{
+    lv_canvas_set_buffer(canvas, canvas_buf1, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_COVER);
+    draw_gauge(200);
+
+    lv_canvas_set_buffer(canvas, canvas_buf2, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_COVER);
+    lv_canvas_draw_begin(canvas);
+    draw_gauge(200);
+    lv_canvas_draw_end(canvas);
+
+    TEST_ASSERT_EQUAL_MEMORY(canvas_buf1, canvas_buf2, sizeof(canvas_buf1));
+}
+
+void test_canvas_batch_invalidates_only_the_drawn_area(void)
+{
+    lv_canvas_set_buffer(canvas, canvas_buf1, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_COVER);
+    lv_refr_now(NULL);
+
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    line_dsc.width = 2;
+    lv_point_t p1[2] = {{10, 10}, {20, 15}};
+    lv_point_t p2[2] = {{30, 20}, {25, 30}};
+
+    lv_canvas_draw_begin(canvas);
+    lv_canvas_draw_line(canvas, p1, 2, &line_dsc);
+    lv_canvas_draw_line(canvas, p2, 2, &line_dsc);
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+    lv_canvas_draw_end(canvas);
+
+    /*One area around the lines, moved to the position of the canvas*/
+    lv_area_t lines_area = {40 + 8, 30 + 8, 40 + 32, 30 + 32};
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    check_inv_area(&disp->inv_areas[0], &lines_area);
+    lv_refr_now(NULL);
+
+    /*The area is clipped to the canvas*/
+    lv_point_t p3[2] = {{-20, 70}, {CANVAS_W + 20, 70}};
+    lv_canvas_draw_begin(canvas);
+    lv_canvas_draw_line(canvas, p3, 2, &line_dsc);
+    lv_canvas_draw_end(canvas);
+    lv_area_t row_area = {40, 30 + 68, 40 + CANVAS_W - 1, 30 + 72};
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    check_inv_area(&disp->inv_areas[0], &row_area);
+    lv_refr_now(NULL);
+
+    /*A zoomed canvas is invalidated entirely*/
+    lv_img_set_zoom(canvas, 512);
+    lv_refr_now(NULL);
+    lv_area_t coords;
+    lv_obj_get_coords(canvas, &coords);
+    lv_canvas_draw_begin(canvas);
+    lv_canvas_draw_line(canvas, p1, 2, &line_dsc);
+    lv_canvas_draw_end(canvas);
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&coords, &disp->inv_areas[0], 0));
+}
+
+void test_canvas_batch_without_drawing(void)
+{
+    lv_canvas_set_buffer(canvas, canvas_buf1, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_refr_now(NULL);
+
+    lv_canvas_draw_begin(canvas);
+    lv_canvas_draw_end(canvas);
+    TEST_ASSERT_EQUAL_UINT16(0, lv_disp_get_default()->inv_p);
+
+    /*A batch not finished is freed with the canvas*/
+    lv_canvas_draw_begin(canvas);
+    lv_obj_del(canvas);
+}
+
+#else /*LV_USE_CANVAS && LV_DRAW_COMPLEX*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_canvas_batch_draws_the_same(void)
+{
+
+}
+
+void test_canvas_batch_invalidates_only_the_drawn_area(void)
+{
+
+}
+
+void test_canvas_batch_without_drawing(void)
+{
+
+}
+
+#endif
+
+#endif
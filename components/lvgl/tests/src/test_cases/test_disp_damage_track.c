@@ -0,0 +1,265 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_DISP_DAMAGE_TILE_W
+
+#define DISP_HOR_RES    200
+#define DISP_VER_RES    150
+#define BUF_PX_CNT      (DISP_HOR_RES * 20)
+
+static lv_color_t track_buf[BUF_PX_CNT];
+static lv_color_t ref_buf[BUF_PX_CNT];
+static lv_color_t track_fb[DISP_HOR_RES * DISP_VER_RES];
+static lv_color_t ref_fb[DISP_HOR_RES * DISP_VER_RES];
+
+static uint32_t flush_cnt;
+static uint32_t flush_px_cnt;
+static uint32_t flush_last_cnt;
+static lv_area_t flush_area_sum;    /*Join of the flushed areas except the last one of the frame*/
+static lv_area_t flush_last_area;
+
+static lv_disp_t * def_disp;
+static lv_disp_t * track_disp;
+static lv_disp_t * ref_disp;
+static lv_obj_t * track_label;
+static lv_obj_t * ref_label;
+
+static void fb_copy(lv_color_t * fb, const lv_area_t * area, const lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb[y * DISP_HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+}
+
+static void ref_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    fb_copy(ref_fb, area, color_p);
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void track_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    if(lv_disp_flush_is_last(disp_drv)) {
+        flush_last_area = *area;
+        flush_last_cnt++;
+    }
+    else if(flush_cnt - flush_last_cnt == 0) flush_area_sum = *area;
+    else _lv_area_join(&flush_area_sum, &flush_area_sum, area);
+    flush_cnt++;
+    flush_px_cnt += lv_area_get_size(area);
+
+    fb_copy(track_fb, area, color_p);
+    lv_disp_flush_ready(disp_drv);
+}
+
+static lv_obj_t * scene_create(lv_disp_t * disp)
+{
+    lv_obj_t * scr = lv_disp_get_scr_act(disp);
+    lv_obj_set_style_bg_color(scr, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t * label = lv_label_create(scr);
+    lv_label_set_text(label, "25.5");
+    lv_obj_set_pos(label, 37, 61);
+    return label;
+}
+
+/*The displays are registered for every test so free their draw context too*/
+static void disp_del(lv_disp_t * disp)
+{
+    lv_disp_drv_t * drv = disp->driver;
+    lv_disp_remove(disp);
+    drv->draw_ctx_deinit(drv, drv->draw_ctx);
+    lv_mem_free(drv->draw_ctx);
+    drv->draw_ctx = NULL;
+}
+
+static void flush_stat_reset(void)
+{
+    flush_cnt = 0;
+    flush_px_cnt = 0;
+    flush_last_cnt = 0;
+}
+
+void setUp(void)
+{
+    def_disp = lv_disp_get_default();
+
+    static lv_disp_draw_buf_t ref_draw_buf;
+    static lv_disp_drv_t ref_drv;
+    lv_disp_draw_buf_init(&ref_draw_buf, ref_buf, NULL, BUF_PX_CNT);
+    lv_disp_drv_init(&ref_drv);
+    ref_drv.draw_buf = &ref_draw_buf;
+    ref_drv.flush_cb = ref_flush_cb;
+    ref_drv.hor_res = DISP_HOR_RES;
+    ref_drv.ver_res = DISP_VER_RES;
+    ref_disp = lv_disp_drv_register(&ref_drv);
+
+    static lv_disp_draw_buf_t track_draw_buf;
+    static lv_disp_drv_t track_drv;
+    lv_disp_draw_buf_init(&track_draw_buf, track_buf, NULL, BUF_PX_CNT);
+    lv_disp_drv_init(&track_drv);
+    track_drv.draw_buf = &track_draw_buf;
+    track_drv.flush_cb = track_flush_cb;
+    track_drv.hor_res = DISP_HOR_RES;
+    track_drv.ver_res = DISP_VER_RES;
+    track_drv.damage_track = 1;
+    track_disp = lv_disp_drv_register(&track_drv);
+
+    lv_disp_set_default(ref_disp);
+    ref_label = scene_create(ref_disp);
+    lv_disp_set_default(track_disp);
+    track_label = scene_create(track_disp);
+
+    lv_refr_now(ref_disp);
+    lv_refr_now(track_disp);
+    flush_stat_reset();
+}
+
+void tearDown(void)
+{
+    disp_del(track_disp);
+    disp_del(ref_disp);
+    lv_disp_set_default(def_disp);
+}
+
+void test_damage_track_first_refresh_flushes_everything(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(DISP_HOR_RES * DISP_VER_RES, track_disp->damage_px_flushed);
+    TEST_ASSERT_EQUAL_UINT32(track_disp->damage_px_rendered, track_disp->damage_px_flushed);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, track_fb, sizeof(ref_fb));
+}
+
+void test_damage_track_unchanged_bands_are_not_flushed(void)
+{
+    lv_obj_invalidate(lv_disp_get_scr_act(track_disp));
+    lv_refr_now(track_disp);
+
+    /*Only a pixel of the last band is sent to finish the frame*/
+    TEST_ASSERT_EQUAL_UINT32(1, flush_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, flush_px_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, flush_last_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, track_fb, sizeof(ref_fb));
+}
+
+void test_damage_track_last_flush_in_every_frame(void)
+{
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        /*Only the band of the label changes, the last band is unchanged*/
+        lv_label_set_text_fmt(ref_label, "2%d.1", (int)i);
+        lv_label_set_text_fmt(track_label, "2%d.1", (int)i);
+        lv_obj_invalidate(lv_disp_get_scr_act(track_disp));
+        lv_refr_now(ref_disp);
+        lv_refr_now(track_disp);
+
+        TEST_ASSERT_EQUAL_UINT32(i + 1, flush_last_cnt);
+        TEST_ASSERT_FALSE(lv_disp_flush_is_last(track_disp->driver));
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, track_fb, sizeof(ref_fb));
+    }
+}
+
+void test_damage_track_flushes_only_the_changed_tiles(void)
+{
+    lv_area_t label_tiles = track_label->coords;
+    lv_label_set_text(ref_label, "26.1");
+    lv_label_set_text(track_label, "26.1");
+
+    /*The screen is redrawn but only the tiles of the label should be flushed*/
+    lv_obj_invalidate(lv_disp_get_scr_act(track_disp));
+    lv_refr_now(ref_disp);
+    lv_refr_now(track_disp);
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, track_fb, sizeof(ref_fb));
+    TEST_ASSERT_GREATER_THAN_UINT32(1, flush_cnt);
+    TEST_ASSERT_LESS_THAN_UINT32(lv_area_get_size(&track_label->coords) * 2, flush_px_cnt);
+
+    /*The last band is unchanged so only its first pixel finishes the frame*/
+    TEST_ASSERT_EQUAL_UINT32(1, flush_last_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_area_get_size(&flush_last_area));
+
+    _lv_area_join(&label_tiles, &label_tiles, &track_label->coords);
+    label_tiles.x1 -= label_tiles.x1 % LV_DISP_DAMAGE_TILE_W;
+    label_tiles.x2 += LV_DISP_DAMAGE_TILE_W - 1 - label_tiles.x2 % LV_DISP_DAMAGE_TILE_W;
+    TEST_ASSERT_TRUE(_lv_area_is_in(&flush_area_sum, &label_tiles, 0));
+}
+
+void test_damage_track_invalidates_whole_tiles(void)
+{
+    lv_area_t a;
+    lv_area_set(&a, 20, 5, 40, 10);
+    _lv_inv_area(track_disp, &a);
+
+    TEST_ASSERT_EQUAL_UINT16(1, track_disp->inv_p);
+    TEST_ASSERT_EQUAL_INT(16, track_disp->inv_areas[0].x1);
+    TEST_ASSERT_EQUAL_INT(47, track_disp->inv_areas[0].x2);
+    TEST_ASSERT_EQUAL_INT(5, track_disp->inv_areas[0].y1);
+
+    /*The last tile is clipped to the screen*/
+    lv_area_set(&a, 190, 5, 300, 10);
+    _lv_inv_area(track_disp, &a);
+    TEST_ASSERT_EQUAL_INT(176, track_disp->inv_areas[1].x1);
+    TEST_ASSERT_EQUAL_INT(DISP_HOR_RES - 1, track_disp->inv_areas[1].x2);
+}
+
+void test_damage_track_reset_flushes_everything_again(void)
+{
+    lv_disp_damage_reset(track_disp);
+    lv_obj_invalidate(lv_disp_get_scr_act(track_disp));
+    lv_refr_now(track_disp);
+
+    TEST_ASSERT_EQUAL_UINT32(DISP_HOR_RES * DISP_VER_RES, flush_px_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, track_fb, sizeof(ref_fb));
+}
+
+#else /*LV_DISP_DAMAGE_TILE_W*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_damage_track_first_refresh_flushes_everything(void)
+{
+
+}
+
+void test_damage_track_unchanged_bands_are_not_flushed(void)
+{
+
+}
+
+void test_damage_track_last_flush_in_every_frame(void)
+{
+
+}
+
+void test_damage_track_flushes_only_the_changed_tiles(void)
+{
+
+}
+
+void test_damage_track_invalidates_whole_tiles(void)
+{
+
+}
+
+void test_damage_track_reset_flushes_everything_again(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,375 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_DISP_DRAW_BUF_RING_MAX >= 3
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DISP_HOR_RES    200
+#define DISP_VER_RES    150
+#define BAND_PX_CNT     (DISP_HOR_RES * 10)
+#define RING_BUF_CNT    3
+
+typedef struct {
+    lv_area_t area;
+    const lv_color_t * color_p;
+    bool last;
+} pending_band_t;
+
+static lv_color_t ring_bufs[RING_BUF_CNT][BAND_PX_CNT];
+static lv_color_t ref_buf[DISP_HOR_RES * DISP_VER_RES];
+static lv_color_t ring_fb[DISP_HOR_RES * DISP_VER_RES];
+static lv_color_t ref_fb[DISP_HOR_RES * DISP_VER_RES];
+
+static pending_band_t pending[RING_BUF_CNT];
+static uint32_t pending_cnt;
+static uint32_t pending_max;
+static uint32_t last_cnt;
+
+/*Bands passed to the pthread flush workers. They are taken in order by any free worker,
+ *but reported to LVGL in order, like a bus which sends them one after the other.*/
+#define WORKER_MAX      3
+#define WORKER_BAND_US  2000    /*Simulated time of flushing a band*/
+#define WORKER_FRAMES   5
+
+static pthread_t workers[WORKER_MAX];
+static pthread_mutex_t worker_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t worker_cond = PTHREAD_COND_INITIALIZER;
+static pending_band_t worker_bands[RING_BUF_CNT];
+static lv_disp_drv_t * worker_drv;
+static uint32_t worker_queued;      /*Bands passed to the workers*/
+static uint32_t worker_taken;       /*Bands taken by a worker*/
+static uint32_t worker_reported;    /*Bands reported by `lv_disp_flush_ready()`*/
+static bool worker_quit;
+
+static lv_disp_t * def_disp;
+static lv_disp_t * ring_disp;
+static lv_disp_t * ref_disp;
+
+static void fb_copy(lv_color_t * fb, const lv_area_t * area, const lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb[y * DISP_HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+}
+
+static void ref_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    fb_copy(ref_fb, area, color_p);
+    lv_disp_flush_ready(disp_drv);
+}
+
+/*Only queue the band. It's flushed later in `ring_wait_cb` as if it was done by an other CPU core.*/
+static void ring_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    TEST_ASSERT_LESS_THAN(RING_BUF_CNT, pending_cnt);
+
+    pending[pending_cnt].area = *area;
+    pending[pending_cnt].color_p = color_p;
+    pending[pending_cnt].last = lv_disp_flush_is_last(disp_drv);
+    pending_cnt++;
+    if(pending_cnt > pending_max) pending_max = pending_cnt;
+}
+
+/*Flush the oldest band. If LVGL rendered into its buffer in the meantime the result will differ.*/
+static void ring_wait_cb(lv_disp_drv_t * disp_drv)
+{
+    TEST_ASSERT_GREATER_THAN(0, pending_cnt);
+
+    fb_copy(ring_fb, &pending[0].area, pending[0].color_p);
+    bool last = pending[0].last;
+    lv_memcpy(&pending[0], &pending[1], (pending_cnt - 1) * sizeof(pending_band_t));
+    pending_cnt--;
+
+    lv_disp_flush_ready(disp_drv);
+
+    /*The last band stays the last until it's flushed*/
+    if(last) last_cnt++;
+    TEST_ASSERT_EQUAL(last ? false : pending_cnt > 0 && pending[pending_cnt - 1].last, lv_disp_flush_is_last(disp_drv));
+}
+
+static void * worker_main(void * arg)
+{
+    LV_UNUSED(arg);
+
+    pthread_mutex_lock(&worker_mutex);
+    while(1) {
+        while(!worker_quit && worker_taken == worker_queued) pthread_cond_wait(&worker_cond, &worker_mutex);
+        if(worker_quit) break;
+
+        uint32_t seq = worker_taken++;
+        pending_band_t band = worker_bands[seq % RING_BUF_CNT];
+        pthread_mutex_unlock(&worker_mutex);
+
+        /*The bands of a refresh don't overlap so they can be copied in any order*/
+        fb_copy(ring_fb, &band.area, band.color_p);
+        usleep(WORKER_BAND_US);
+
+        pthread_mutex_lock(&worker_mutex);
+        while(worker_reported != seq) pthread_cond_wait(&worker_cond, &worker_mutex);
+        lv_disp_flush_ready(worker_drv);
+        worker_reported++;
+        pthread_cond_broadcast(&worker_cond);
+    }
+    pthread_mutex_unlock(&worker_mutex);
+
+    return NULL;
+}
+
+static void worker_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    /*No workers: flush it right here, it's the serial case*/
+    if(worker_drv == NULL) {
+        fb_copy(ring_fb, area, color_p);
+        usleep(WORKER_BAND_US);
+        lv_disp_flush_ready(disp_drv);
+        return;
+    }
+
+    pthread_mutex_lock(&worker_mutex);
+    TEST_ASSERT_LESS_THAN(RING_BUF_CNT, worker_queued - worker_reported);
+    pending_band_t * band = &worker_bands[worker_queued % RING_BUF_CNT];
+    band->area = *area;
+    band->color_p = color_p;
+    worker_queued++;
+    pthread_cond_broadcast(&worker_cond);
+    pthread_mutex_unlock(&worker_mutex);
+}
+
+static void worker_wait_cb(lv_disp_drv_t * disp_drv)
+{
+    LV_UNUSED(disp_drv);
+    sched_yield();
+}
+
+static uint32_t time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+static lv_disp_t * disp_create(lv_disp_drv_t * disp_drv, lv_disp_draw_buf_t * draw_buf,
+                               void (*flush_cb)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *))
+{
+    lv_disp_drv_init(disp_drv);
+    disp_drv->draw_buf = draw_buf;
+    disp_drv->flush_cb = flush_cb;
+    disp_drv->hor_res = DISP_HOR_RES;
+    disp_drv->ver_res = DISP_VER_RES;
+    return lv_disp_drv_register(disp_drv);
+}
+
+static void scene_create(lv_disp_t * disp)
+{
+    lv_obj_t * scr = lv_disp_get_scr_act(disp);
+    lv_obj_set_style_bg_color(scr, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t * btn = lv_btn_create(scr);
+    lv_obj_set_size(btn, 120, 70);
+    lv_obj_center(btn);
+
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Ring");
+    lv_obj_center(label);
+}
+
+void setUp(void)
+{
+    def_disp = lv_disp_get_default();
+    pending_cnt = 0;
+    pending_max = 0;
+    last_cnt = 0;
+    ring_disp = NULL;
+    ref_disp = NULL;
+}
+
+void tearDown(void)
+{
+    if(ring_disp) lv_disp_remove(ring_disp);
+    if(ref_disp) lv_disp_remove(ref_disp);
+    lv_disp_set_default(def_disp);
+}
+
+void test_draw_buf_ring_renders_same_as_single_buffer(void)
+{
+    static lv_disp_draw_buf_t ref_draw_buf;
+    static lv_disp_drv_t ref_drv;
+    lv_disp_draw_buf_init(&ref_draw_buf, ref_buf, NULL, DISP_HOR_RES * DISP_VER_RES);
+    ref_disp = disp_create(&ref_drv, &ref_draw_buf, ref_flush_cb);
+
+    static lv_disp_draw_buf_t ring_draw_buf;
+    static lv_disp_drv_t ring_drv;
+    void * bufs[RING_BUF_CNT] = {ring_bufs[0], ring_bufs[1], ring_bufs[2]};
+    lv_disp_draw_buf_init_ring(&ring_draw_buf, bufs, RING_BUF_CNT, BAND_PX_CNT);
+    ring_disp = disp_create(&ring_drv, &ring_draw_buf, ring_flush_cb);
+    ring_drv.wait_cb = ring_wait_cb;
+
+    lv_disp_set_default(ref_disp);
+    scene_create(ref_disp);
+    lv_disp_set_default(ring_disp);
+    scene_create(ring_disp);
+
+    lv_refr_now(ref_disp);
+    lv_refr_now(ring_disp);
+
+    /*All the buffers were waiting for flushing at least once and nothing remained after the refresh*/
+    TEST_ASSERT_EQUAL_UINT32(RING_BUF_CNT, pending_max);
+    TEST_ASSERT_EQUAL_UINT32(0, pending_cnt);
+    TEST_ASSERT_EQUAL_UINT32(ring_draw_buf.ring_flush_req, ring_draw_buf.ring_flush_done);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, ring_fb, sizeof(ref_fb));
+}
+
+void test_draw_buf_ring_flush_is_last(void)
+{
+    static lv_disp_draw_buf_t ring_draw_buf;
+    static lv_disp_drv_t ring_drv;
+    void * bufs[RING_BUF_CNT] = {ring_bufs[0], ring_bufs[1], ring_bufs[2]};
+    lv_disp_draw_buf_init_ring(&ring_draw_buf, bufs, RING_BUF_CNT, BAND_PX_CNT);
+    ring_disp = disp_create(&ring_drv, &ring_draw_buf, ring_flush_cb);
+    ring_drv.wait_cb = ring_wait_cb;
+
+    lv_disp_set_default(ring_disp);
+    scene_create(ring_disp);
+
+    /*Only the last band of each refresh cycle is the last*/
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(ring_disp);
+        TEST_ASSERT_EQUAL_UINT32(i + 1, last_cnt);
+        TEST_ASSERT_FALSE(lv_disp_flush_is_last(&ring_drv));
+    }
+}
+
+void test_draw_buf_ring_is_disabled_in_direct_mode(void)
+{
+    static lv_disp_draw_buf_t ring_draw_buf;
+    static lv_disp_drv_t ring_drv;
+    static lv_color_t full_bufs[2][DISP_HOR_RES * DISP_VER_RES];
+    void * bufs[2] = {full_bufs[0], full_bufs[1]};
+    lv_disp_draw_buf_init_ring(&ring_draw_buf, bufs, 2, DISP_HOR_RES * DISP_VER_RES);
+
+    lv_disp_drv_init(&ring_drv);
+    ring_drv.draw_buf = &ring_draw_buf;
+    ring_drv.flush_cb = ref_flush_cb;
+    ring_drv.hor_res = DISP_HOR_RES;
+    ring_drv.ver_res = DISP_VER_RES;
+    ring_drv.direct_mode = 1;
+    ring_disp = lv_disp_drv_register(&ring_drv);
+
+    TEST_ASSERT_EQUAL_UINT8(0, ring_draw_buf.ring_cnt);
+    TEST_ASSERT_EQUAL_PTR(full_bufs[0], ring_draw_buf.buf1);
+    TEST_ASSERT_EQUAL_PTR(full_bufs[1], ring_draw_buf.buf2);
+}
+
+void test_draw_buf_ring_flush_workers(void)
+{
+    static lv_disp_draw_buf_t ref_draw_buf;
+    static lv_disp_drv_t ref_drv;
+    lv_disp_draw_buf_init(&ref_draw_buf, ref_buf, NULL, DISP_HOR_RES * DISP_VER_RES);
+    ref_disp = disp_create(&ref_drv, &ref_draw_buf, ref_flush_cb);
+    lv_disp_set_default(ref_disp);
+    scene_create(ref_disp);
+    lv_refr_now(ref_disp);
+
+    static lv_disp_draw_buf_t ring_draw_buf;
+    static lv_disp_drv_t ring_drv;
+    void * bufs[RING_BUF_CNT] = {ring_bufs[0], ring_bufs[1], ring_bufs[2]};
+    lv_disp_draw_buf_init_ring(&ring_draw_buf, bufs, RING_BUF_CNT, BAND_PX_CNT);
+    ring_disp = disp_create(&ring_drv, &ring_draw_buf, worker_flush_cb);
+    ring_drv.wait_cb = worker_wait_cb;
+    lv_disp_set_default(ring_disp);
+    scene_create(ring_disp);
+
+    /*0 workers: every band is flushed in `flush_cb` while LVGL waits*/
+    uint32_t frame_us[WORKER_MAX + 1];
+    uint32_t worker_cnt;
+    for(worker_cnt = 0; worker_cnt <= WORKER_MAX; worker_cnt++) {
+        worker_queued = 0;
+        worker_taken = 0;
+        worker_reported = 0;
+        worker_quit = false;
+        worker_drv = worker_cnt ? &ring_drv : NULL;
+
+        uint32_t i;
+        for(i = 0; i < worker_cnt; i++) {
+            TEST_ASSERT_EQUAL_INT(0, pthread_create(&workers[i], NULL, worker_main, NULL));
+        }
+
+        lv_memset_00(ring_fb, sizeof(ring_fb));
+        uint32_t t_start = time_us();
+        for(i = 0; i < WORKER_FRAMES; i++) {
+            lv_obj_invalidate(lv_scr_act());
+            lv_refr_now(ring_disp);
+        }
+        frame_us[worker_cnt] = (time_us() - t_start) / WORKER_FRAMES;
+
+        pthread_mutex_lock(&worker_mutex);
+        worker_quit = true;
+        pthread_cond_broadcast(&worker_cond);
+        pthread_mutex_unlock(&worker_mutex);
+        for(i = 0; i < worker_cnt; i++) {
+            pthread_join(workers[i], NULL);
+        }
+
+        /*Every band was flushed before `lv_refr_now()` returned, into the right place*/
+        TEST_ASSERT_EQUAL_UINT32(worker_queued, worker_reported);
+        TEST_ASSERT_EQUAL_UINT32(ring_draw_buf.ring_flush_req, ring_draw_buf.ring_flush_done);
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, ring_fb, sizeof(ref_fb));
+
+        TEST_PRINTF("%u flush worker(s): %u us/frame (%u bands of %u us)", worker_cnt, frame_us[worker_cnt],
+                    DISP_VER_RES / 10, WORKER_BAND_US);
+    }
+    worker_drv = NULL;
+
+    /*The gain of a single worker is only the rendering time, too close to the noise of `usleep()`.
+     *With all of them the bands are flushed in parallel too.*/
+    TEST_ASSERT_LESS_THAN_UINT32(frame_us[0], frame_us[WORKER_MAX]);
+}
+
+#else /*LV_DISP_DRAW_BUF_RING_MAX >= 3*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_draw_buf_ring_renders_same_as_single_buffer(void)
+{
+
+}
+
+void test_draw_buf_ring_flush_is_last(void)
+{
+
+}
+
+void test_draw_buf_ring_is_disabled_in_direct_mode(void)
+{
+
+}
+
+void test_draw_buf_ring_flush_workers(void)
+{
+
+}
+
+#endif
+
+#endif
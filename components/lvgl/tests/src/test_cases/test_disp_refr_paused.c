@@ -0,0 +1,85 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * obj;
+
+static void wait_ms(uint32_t ms)
+{
+    uint32_t i;
+    for(i = 0; i < ms; i++) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+}
+
+void setUp(void)
+{
+    obj = lv_obj_create(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void tearDown(void)
+{
+    lv_disp_get_default()->driver->full_refresh = 0;
+    lv_disp_set_refr_paused(NULL, false);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_disp_refr_paused_invalidate_does_not_resume(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_set_refr_paused(disp, true);
+    TEST_ASSERT_TRUE(lv_disp_is_refr_paused(disp));
+
+    /*The area is saved but the refreshing is not started*/
+    lv_obj_invalidate(obj);
+    TEST_ASSERT_TRUE(disp->refr_timer->paused);
+    TEST_ASSERT_GREATER_THAN_UINT16(0, disp->inv_p);
+    wait_ms(50);
+    TEST_ASSERT_GREATER_THAN_UINT16(0, disp->inv_p);
+
+    /*The invalidated areas are drawn at once after resuming*/
+    lv_disp_set_refr_paused(disp, false);
+    TEST_ASSERT_FALSE(lv_disp_is_refr_paused(disp));
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+}
+
+void test_disp_refr_paused_full_refresh(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    disp->driver->full_refresh = 1;
+    lv_disp_set_refr_paused(disp, true);
+
+    lv_obj_invalidate(obj);
+    TEST_ASSERT_TRUE(disp->refr_timer->paused);
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    wait_ms(50);
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+
+    lv_disp_set_refr_paused(disp, false);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+}
+
+void test_disp_refr_paused_layout_change(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_set_refr_paused(disp, true);
+
+    /*E.g. a label's new text changes its size and marks the layout as dirty*/
+    lv_obj_set_width(obj, 50);
+    TEST_ASSERT_TRUE(disp->refr_timer->paused);
+    wait_ms(50);
+    TEST_ASSERT_TRUE(obj->layout_inv);
+
+    /*The layout is updated with the next refresh*/
+    lv_disp_set_refr_paused(disp, false);
+    lv_timer_handler();
+    TEST_ASSERT_FALSE(obj->layout_inv);
+    TEST_ASSERT_EQUAL(50, lv_obj_get_width(obj));
+}
+
+#endif
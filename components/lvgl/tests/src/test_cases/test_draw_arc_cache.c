@@ -0,0 +1,226 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "../../../src/draw/sw/lv_draw_sw.h"
+
+#if LV_USE_CANVAS && LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE
+
+#define CANVAS_W    200
+#define CANVAS_H    200
+
+typedef struct {
+    lv_coord_t radius;
+    lv_coord_t width;
+    int32_t start_angle;
+    int32_t end_angle;
+    lv_opa_t opa;
+    bool rounded;
+} arc_t;
+
+static lv_color_t canvas_buf[CANVAS_W * CANVAS_H];
+static lv_color_t ref_buf[CANVAS_W * CANVAS_H];
+static lv_obj_t * canvas;
+
+static void draw_arc(const arc_t * arc, lv_coord_t x, lv_coord_t y)
+{
+    lv_draw_arc_dsc_t dsc;
+    lv_draw_arc_dsc_init(&dsc);
+    dsc.color = lv_palette_main(LV_PALETTE_BLUE);
+    dsc.width = arc->width;
+    dsc.opa = arc->opa;
+    dsc.rounded = arc->rounded;
+
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    lv_canvas_draw_arc(canvas, x, y, arc->radius, arc->start_angle, arc->end_angle, &dsc);
+}
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_draw_sw_arc_free_cache();
+    lv_draw_sw_arc_reset_cache_stat();
+}
+
+void tearDown(void)
+{
+    lv_draw_sw_arc_free_cache();
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_draw_arc_cache_same_pixels(void)
+{
+    static const arc_t arcs[] = {
+        {80, 16, 135, 45, LV_OPA_COVER, true},      /*Drawn in quarters*/
+        {60, 10, 0, 300, LV_OPA_60, false},         /*Small gap: drawn in one area*/
+        {90, 30, 200, 250, LV_OPA_COVER, true},     /*Small arc in one quarter*/
+        {70, 70, 300, 100, LV_OPA_COVER, false},    /*No inner circle*/
+        {50, 8, 300, 400, LV_OPA_80, true},         /*Over 360*/
+    };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(arcs) / sizeof(arcs[0]); i++) {
+        const arc_t * arc = &arcs[i];
+        lv_draw_sw_arc_reset_cache_stat();
+
+        /*Not cached for the first time*/
+        draw_arc(arc, CANVAS_W / 2, CANVAS_H / 2);
+        lv_memcpy(ref_buf, canvas_buf, sizeof(canvas_buf));
+
+        /*Cached when drawn again*/
+        draw_arc(arc, CANVAS_W / 2, CANVAS_H / 2);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, canvas_buf, sizeof(canvas_buf));
+
+        draw_arc(arc, CANVAS_W / 2, CANVAS_H / 2);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, canvas_buf, sizeof(canvas_buf));
+
+        lv_draw_sw_arc_cache_stat_t stat;
+        lv_draw_sw_arc_get_cache_stat(&stat);
+        TEST_ASSERT_EQUAL_UINT32(2, stat.miss_cnt);
+        TEST_ASSERT_EQUAL_UINT32(1, stat.hit_cnt);
+        TEST_ASSERT_EQUAL_UINT32(0, stat.not_cached_cnt);
+
+        /*Used at an other position too*/
+        draw_arc(arc, CANVAS_W / 2 - 7, CANVAS_H / 2 - 3);
+        lv_coord_t x;
+        lv_coord_t y;
+        for(y = 0; y < CANVAS_H - 3; y++) {
+            for(x = 0; x < CANVAS_W - 7; x++) {
+                TEST_ASSERT_EQUAL_COLOR(ref_buf[(y + 3) * CANVAS_W + x + 7], canvas_buf[y * CANVAS_W + x]);
+            }
+        }
+        lv_draw_sw_arc_get_cache_stat(&stat);
+        TEST_ASSERT_EQUAL_UINT32(2, stat.hit_cnt);
+    }
+}
+
+void test_draw_arc_cache_keyed_by_geometry(void)
+{
+    arc_t arc = {80, 16, 135, 45, LV_OPA_COVER, true};
+    draw_arc(&arc, CANVAS_W / 2, CANVAS_H / 2);
+    draw_arc(&arc, CANVAS_W / 2, CANVAS_H / 2);
+
+    lv_draw_sw_arc_cache_stat_t stat;
+    lv_draw_sw_arc_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.item_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.used_size);
+    TEST_ASSERT_EQUAL(LV_ARC_CACHE_SIZE, stat.cache_size);
+
+    /*The color is not part of the coverage*/
+    lv_draw_arc_dsc_t dsc;
+    lv_draw_arc_dsc_init(&dsc);
+    dsc.color = lv_palette_main(LV_PALETTE_RED);
+    dsc.width = arc.width;
+    dsc.rounded = arc.rounded;
+    lv_canvas_draw_arc(canvas, CANVAS_W / 2, CANVAS_H / 2, arc.radius, arc.start_angle, arc.end_angle, &dsc);
+    lv_draw_sw_arc_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_RED), lv_canvas_get_px(canvas, CANVAS_W / 2, CANVAS_H / 2 - 72));
+
+    /*Other angles, opacity or end style is an other arc*/
+    arc.end_angle = 46;
+    draw_arc(&arc, CANVAS_W / 2, CANVAS_H / 2);
+    arc.opa = LV_OPA_50;
+    draw_arc(&arc, CANVAS_W / 2, CANVAS_H / 2);
+    arc.rounded = false;
+    draw_arc(&arc, CANVAS_W / 2, CANVAS_H / 2);
+    lv_draw_sw_arc_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(5, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, stat.item_cnt);
+}
+
+void test_draw_arc_cache_not_cached(void)
+{
+    const arc_t arc = {80, 16, 135, 45, LV_OPA_COVER, true};
+
+    /*An other mask on the arc*/
+    lv_area_t mask_area;
+    lv_area_set(&mask_area, 0, 0, CANVAS_W / 2, CANVAS_H - 1);
+    lv_draw_mask_radius_param_t mask_param;
+    lv_draw_mask_radius_init(&mask_param, &mask_area, 0, false);
+    int16_t mask_id = lv_draw_mask_add(&mask_param, NULL);
+    draw_arc(&arc, CANVAS_W / 2, CANVAS_H / 2);
+    draw_arc(&arc, CANVAS_W / 2, CANVAS_H / 2);
+    lv_draw_mask_remove_id(mask_id);
+    lv_draw_mask_free_param(&mask_param);
+
+    lv_draw_sw_arc_cache_stat_t stat;
+    lv_draw_sw_arc_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.not_cached_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.item_cnt);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_white(), lv_canvas_get_px(canvas, CANVAS_W - 28, CANVAS_H / 2));
+
+    /*Full rings are not cached*/
+    const arc_t ring = {80, 16, 0, 360, LV_OPA_COVER, false};
+    draw_arc(&ring, CANVAS_W / 2, CANVAS_H / 2);
+    draw_arc(&ring, CANVAS_W / 2, CANVAS_H / 2);
+    lv_draw_sw_arc_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.item_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.miss_cnt);
+}
+
+void test_draw_arc_cache_eviction(void)
+{
+    /*Arcs with more and more radius until some are evicted*/
+    arc_t arc = {20, 10, 135, 45, LV_OPA_COVER, true};
+    lv_draw_sw_arc_cache_stat_t stat;
+    uint32_t i;
+    for(i = 0; i < 16; i++) {
+        arc.radius = 20 + i * 5;
+        draw_arc(&arc, CANVAS_W / 2, CANVAS_H / 2);
+        draw_arc(&arc, CANVAS_W / 2, CANVAS_H / 2);
+    }
+
+    lv_draw_sw_arc_get_cache_stat(&stat);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.evict_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(stat.cache_size, stat.used_size);
+
+    /*The last one is still there*/
+    lv_draw_sw_arc_reset_cache_stat();
+    draw_arc(&arc, CANVAS_W / 2, CANVAS_H / 2);
+    lv_draw_sw_arc_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.hit_cnt);
+
+    lv_draw_sw_arc_free_cache();
+    lv_draw_sw_arc_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.item_cnt);
+    TEST_ASSERT_EQUAL(0, stat.used_size);
+}
+
+#else /*LV_USE_CANVAS && LV_DRAW_COMPLEX && LV_ARC_CACHE_SIZE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_draw_arc_cache_same_pixels(void)
+{
+
+}
+
+void test_draw_arc_cache_keyed_by_geometry(void)
+{
+
+}
+
+void test_draw_arc_cache_not_cached(void)
+{
+
+}
+
+void test_draw_arc_cache_eviction(void)
+{
+
+}
+
+#endif
+
+#endif
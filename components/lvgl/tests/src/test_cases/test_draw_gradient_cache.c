@@ -0,0 +1,200 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_CANVAS && LV_DRAW_COMPLEX && LV_GRAD_CACHE_DEF_SIZE
+
+#define CANVAS_W    120
+#define CANVAS_H    120
+
+static lv_color_t canvas_buf[CANVAS_W * CANVAS_H];
+static lv_obj_t * canvas;
+
+static void draw_grad(lv_color_t top, lv_color_t bottom, lv_coord_t h)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = top;
+    dsc.bg_grad.stops[0].color = top;
+    dsc.bg_grad.stops[1].color = bottom;
+    dsc.bg_grad.dir = LV_GRAD_DIR_VER;
+    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_W, h, &dsc);
+}
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+    lv_gradient_reset_cache_stat();
+}
+
+void tearDown(void)
+{
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_draw_gradient_cache_hit(void)
+{
+    lv_grad_cache_stat_t stat;
+
+    draw_grad(lv_palette_main(LV_PALETTE_BLUE), lv_palette_lighten(LV_PALETTE_BLUE, 4), CANVAS_H);
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.item_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.used_size);
+    TEST_ASSERT_LESS_OR_EQUAL(stat.cache_size, stat.used_size);
+    TEST_ASSERT_EQUAL(LV_GRAD_CACHE_DEF_SIZE, stat.cache_size);
+
+    draw_grad(lv_palette_main(LV_PALETTE_BLUE), lv_palette_lighten(LV_PALETTE_BLUE, 4), CANVAS_H);
+    draw_grad(lv_palette_main(LV_PALETTE_BLUE), lv_palette_lighten(LV_PALETTE_BLUE, 4), CANVAS_H);
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.item_cnt);
+
+    /*Other length is another gradient*/
+    draw_grad(lv_palette_main(LV_PALETTE_BLUE), lv_palette_lighten(LV_PALETTE_BLUE, 4), CANVAS_H / 2);
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.item_cnt);
+
+    lv_gradient_reset_cache_stat();
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.item_cnt);
+}
+
+void test_draw_gradient_cache_keyed_by_colors(void)
+{
+    /*The descriptors are at the same address in both draws but the colors are different*/
+    lv_color_t red = lv_palette_main(LV_PALETTE_RED);
+    lv_color_t green = lv_palette_main(LV_PALETTE_GREEN);
+    draw_grad(red, lv_color_white(), CANVAS_H);
+    TEST_ASSERT_EQUAL_COLOR(red, lv_canvas_get_px(canvas, CANVAS_W / 2, 0));
+
+    draw_grad(green, lv_color_white(), CANVAS_H);
+    TEST_ASSERT_EQUAL_COLOR(green, lv_canvas_get_px(canvas, CANVAS_W / 2, 0));
+
+    lv_grad_cache_stat_t stat;
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.miss_cnt);
+
+    /*Drawing from the cache gives the same result*/
+    static lv_color_t ref_buf[CANVAS_W * CANVAS_H];
+    lv_memcpy(ref_buf, canvas_buf, sizeof(canvas_buf));
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_COVER);
+    draw_grad(green, lv_color_white(), CANVAS_H);
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, canvas_buf, sizeof(canvas_buf));
+}
+
+void test_draw_gradient_cache_eviction(void)
+{
+    /*Room for about 2 gradients of 120 px*/
+    lv_gradient_set_cache_size(CANVAS_H * sizeof(lv_color_t) * 2 + 256);
+    lv_gradient_reset_cache_stat();
+
+    draw_grad(lv_palette_main(LV_PALETTE_RED), lv_color_white(), CANVAS_H);
+    draw_grad(lv_palette_main(LV_PALETTE_RED), lv_color_white(), CANVAS_H);
+    draw_grad(lv_palette_main(LV_PALETTE_GREEN), lv_color_white(), CANVAS_H);
+    draw_grad(lv_palette_main(LV_PALETTE_BLUE), lv_color_white(), CANVAS_H);
+
+    /*The least used green was evicted*/
+    lv_grad_cache_stat_t stat;
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.evict_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.item_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(stat.cache_size, stat.used_size);
+
+    draw_grad(lv_palette_main(LV_PALETTE_RED), lv_color_white(), CANVAS_H);
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.hit_cnt);
+
+    /*A gradient larger than the whole cache is computed for the draw only*/
+    lv_gradient_set_cache_size(256);
+    lv_gradient_reset_cache_stat();
+    draw_grad(lv_palette_main(LV_PALETTE_RED), lv_color_white(), CANVAS_H);
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.not_cached_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.item_cnt);
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_RED), lv_canvas_get_px(canvas, 0, 0));
+}
+
+void test_draw_gradient_cache_err_diff_width(void)
+{
+#if _DITHER_GRADIENT && LV_DITHER_ERROR_DIFFUSION
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_grad.stops[0].color = lv_palette_main(LV_PALETTE_BLUE);
+    dsc.bg_grad.stops[1].color = lv_color_white();
+    dsc.bg_grad.dir = LV_GRAD_DIR_VER;
+    dsc.bg_grad.dither = LV_DITHER_ERR_DIFF;
+
+    /*The same height, so the same color map, but the error of a wider row needs to be stored*/
+    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_W / 2, CANVAS_H, &dsc);
+    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_W, CANVAS_H, &dsc);
+    lv_grad_cache_stat_t stat;
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.item_cnt);
+
+    /*Both are found with their own width*/
+    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_W / 2, CANVAS_H, &dsc);
+    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_W, CANVAS_H, &dsc);
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.item_cnt);
+
+    /*Without error diffusion the width doesn't matter*/
+    dsc.bg_grad.dither = LV_DITHER_ORDERED;
+    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_W / 2, CANVAS_H, &dsc);
+    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_W, CANVAS_H, &dsc);
+    lv_gradient_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(3, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, stat.item_cnt);
+#endif
+}
+
+#else /*LV_USE_CANVAS && LV_DRAW_COMPLEX && LV_GRAD_CACHE_DEF_SIZE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_draw_gradient_cache_hit(void)
+{
+
+}
+
+void test_draw_gradient_cache_keyed_by_colors(void)
+{
+
+}
+
+void test_draw_gradient_cache_eviction(void)
+{
+
+}
+
+void test_draw_gradient_cache_err_diff_width(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_COMPLEX && LV_USE_CANVAS
+
+#define LINE_LEN    200
+#define CANVAS_W    160
+#define CANVAS_H    200
+
+static lv_opa_t mask_buf[LINE_LEN];
+static lv_color_t canvas_buf1[CANVAS_W * CANVAS_H];
+static lv_color_t canvas_buf2[CANVAS_W * CANVAS_H];
+
+/*Compare the span of the added masks with the per-pixel mask on every line of an area*/
+static void check_spans(lv_coord_t x, lv_coord_t y1, lv_coord_t y2, lv_coord_t len)
+{
+    lv_coord_t y;
+    for(y = y1; y <= y2; y++) {
+        lv_memset_ff(mask_buf, len);
+        lv_draw_mask_res_t res = lv_draw_mask_apply(mask_buf, x, y, len);
+
+        lv_draw_mask_span_t span;
+        lv_draw_mask_res_t span_res = lv_draw_mask_get_span(x, y, len, &span);
+        if(res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(mask_buf, len);
+
+        lv_coord_t i;
+        if(span_res == LV_DRAW_MASK_RES_TRANSP) {
+            for(i = 0; i < len; i++) TEST_ASSERT_EQUAL_UINT8(LV_OPA_TRANSP, mask_buf[i]);
+            continue;
+        }
+
+        TEST_ASSERT_TRUE(span.x1 >= x && span.x2 < x + len);
+        TEST_ASSERT_TRUE(span.x1 <= span.opa_x1);
+        TEST_ASSERT_TRUE(span.opa_x2 <= span.x2);
+        if(span_res == LV_DRAW_MASK_RES_FULL_COVER) {
+            TEST_ASSERT_EQUAL(x, span.opa_x1);
+            TEST_ASSERT_EQUAL(x + len - 1, span.opa_x2);
+        }
+
+        for(i = 0; i < len; i++) {
+            lv_coord_t abs_x = x + i;
+            if(abs_x < span.x1 || abs_x > span.x2) TEST_ASSERT_EQUAL_UINT8(LV_OPA_TRANSP, mask_buf[i]);
+            else if(abs_x >= span.opa_x1 && abs_x <= span.opa_x2) TEST_ASSERT_EQUAL_UINT8(LV_OPA_COVER, mask_buf[i]);
+        }
+    }
+}
+
+static void draw_card(lv_obj_t * canvas, lv_opa_t opa, lv_grad_dir_t grad_dir)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.radius = 15;
+    dsc.bg_color = lv_palette_main(LV_PALETTE_BLUE);
+    dsc.bg_grad.dir = grad_dir;
+    dsc.bg_grad.stops[1].color = lv_palette_main(LV_PALETTE_RED);
+    dsc.bg_opa = opa;
+
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    lv_canvas_draw_rect(canvas, 15, 15, 130, 170, &dsc);
+}
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_draw_mask_span_of_radius_mask(void)
+{
+    const lv_coord_t radii[] = {0, 1, 5, 15, 40, LV_RADIUS_CIRCLE};
+    uint32_t i;
+    for(i = 0; i < sizeof(radii) / sizeof(radii[0]); i++) {
+        lv_area_t rect = {20, 10, 149, 179};
+        lv_draw_mask_radius_param_t param;
+        lv_draw_mask_radius_init(&param, &rect, radii[i], false);
+        int16_t id = lv_draw_mask_add(&param, NULL);
+
+        /*Whole lines, lines starting and ending in the corners, lines inside the rectangle*/
+        check_spans(0, 0, 190, LINE_LEN);
+        check_spans(25, 0, 190, 50);
+        check_spans(120, 0, 190, 40);
+        check_spans(60, 0, 190, 50);
+
+        lv_draw_mask_remove_id(id);
+        lv_draw_mask_free_param(&param);
+    }
+}
+
+void test_draw_mask_span_of_more_masks(void)
+{
+    lv_area_t rect1 = {20, 10, 149, 179};
+    lv_area_t rect2 = {60, 0, 199, 120};
+    lv_draw_mask_radius_param_t param1;
+    lv_draw_mask_radius_param_t param2;
+    lv_draw_mask_radius_init(&param1, &rect1, 15, false);
+    lv_draw_mask_radius_init(&param2, &rect2, 30, false);
+    int16_t id1 = lv_draw_mask_add(&param1, NULL);
+    int16_t id2 = lv_draw_mask_add(&param2, NULL);
+
+    check_spans(0, 0, 190, LINE_LEN);
+
+    /*An inverted mask has no fully covered span*/
+    lv_area_t rect3 = {80, 40, 100, 60};
+    lv_draw_mask_radius_param_t param3;
+    lv_draw_mask_radius_init(&param3, &rect3, 5, true);
+    int16_t id3 = lv_draw_mask_add(&param3, NULL);
+
+    lv_draw_mask_span_t span;
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_CHANGED, lv_draw_mask_get_span(0, 50, LINE_LEN, &span));
+    TEST_ASSERT_EQUAL(60, span.x1);
+    TEST_ASSERT_EQUAL(149, span.x2);
+    TEST_ASSERT_GREATER_THAN(span.opa_x2, span.opa_x1);
+    check_spans(0, 0, 190, LINE_LEN);
+
+    lv_draw_mask_remove_id(id3);
+    lv_draw_mask_remove_id(id2);
+    lv_draw_mask_remove_id(id1);
+    lv_draw_mask_free_param(&param3);
+    lv_draw_mask_free_param(&param2);
+    lv_draw_mask_free_param(&param1);
+}
+
+void test_draw_mask_span_rounded_rect_same_as_masked(void)
+{
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+    const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_50};
+    const lv_grad_dir_t grad_dirs[] = {LV_GRAD_DIR_NONE, LV_GRAD_DIR_VER, LV_GRAD_DIR_HOR};
+
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < sizeof(opas) / sizeof(opas[0]); i++) {
+        for(j = 0; j < sizeof(grad_dirs) / sizeof(grad_dirs[0]); j++) {
+            /*Only the radius mask: the edges are masked in spans*/
+            lv_canvas_set_buffer(canvas, canvas_buf1, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+            draw_card(canvas, opas[i], grad_dirs[j]);
+
+            /*A not changing fade mask forces masking all the pixels of the lines*/
+            lv_draw_mask_fade_param_t fade;
+            lv_area_t fade_area = {0, 0, CANVAS_W - 1, CANVAS_H - 1};
+            lv_draw_mask_fade_init(&fade, &fade_area, LV_OPA_COVER, 0, LV_OPA_COVER, CANVAS_H - 1);
+            int16_t id = lv_draw_mask_add(&fade, NULL);
+            lv_canvas_set_buffer(canvas, canvas_buf2, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+            draw_card(canvas, opas[i], grad_dirs[j]);
+            lv_draw_mask_remove_id(id);
+            lv_draw_mask_free_param(&fade);
+
+            TEST_ASSERT_EQUAL_MEMORY(canvas_buf2, canvas_buf1, sizeof(canvas_buf1));
+        }
+    }
+}
+
+#else /*LV_DRAW_COMPLEX && LV_USE_CANVAS*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_draw_mask_span_of_radius_mask(void)
+{
+
+}
+
+void test_draw_mask_span_of_more_masks(void)
+{
+
+}
+
+void test_draw_mask_span_rounded_rect_same_as_masked(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -16,6 +16,39 @@ static const lv_obj_class_t event_object_deletion_class = {
     .base_class = &lv_obj_class
 };
 
+static uint32_t draw_event_cnt[LV_EVENT_DRAW_PART_END + 1];
+
+static void draw_event_class_cb(const lv_obj_class_t * cls, lv_event_t * e)
+{
+    lv_res_t res = lv_obj_event_base(cls, e);
+    if(res != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    if(code >= LV_EVENT_DRAW_MAIN_BEGIN && code <= LV_EVENT_DRAW_PART_END) draw_event_cnt[code]++;
+}
+
+/*Doesn't tell which draw events it handles*/
+static const lv_obj_class_t draw_event_class = {
+    .event_cb = draw_event_class_cb,
+    .base_class = &lv_obj_class
+};
+
+static void draw_event_cb(lv_event_t * e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if(code >= LV_EVENT_DRAW_MAIN_BEGIN && code <= LV_EVENT_DRAW_PART_END) draw_event_cnt[code]++;
+}
+
+void setUp(void)
+{
+    lv_memset_00(draw_event_cnt, sizeof(draw_event_cnt));
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
 /* Checks for memory leaks/invalid memory accesses on deleted objects */
 void test_event_object_deletion(void)
 {
@@ -23,4 +56,61 @@ void test_event_object_deletion(void)
     lv_event_send(obj, LV_EVENT_VALUE_CHANGED, NULL);
 }
 
+void test_event_draw_events_skipped_without_handler(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_invalidate(lv_scr_act());
+    lv_event_reset_stat();
+    lv_refr_now(NULL);
+
+    lv_event_stat_t stat;
+    lv_event_get_stat(&stat);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.sent);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.draw_skipped);
+
+    /*Nothing is skipped for the object with a callback*/
+    lv_obj_add_event_cb(obj, draw_event_cb, LV_EVENT_DRAW_PART_BEGIN, NULL);
+    lv_obj_add_event_cb(obj, draw_event_cb, LV_EVENT_DRAW_MAIN_END | LV_EVENT_PREPROCESS, NULL);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_PART_BEGIN]);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_MAIN_END]);
+    TEST_ASSERT_EQUAL_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_POST_END]);
+
+    /*Skipped again when the callbacks are removed*/
+    lv_obj_remove_event_cb(obj, draw_event_cb);
+    TEST_ASSERT_EQUAL_UINT8(LV_OBJ_CLASS_DRAW_EVENT(LV_EVENT_DRAW_MAIN_END), obj->spec_attr->event_draw_observed);
+    lv_obj_remove_event_cb(obj, draw_event_cb);
+    TEST_ASSERT_EQUAL_UINT8(0, obj->spec_attr->event_draw_observed);
+
+    lv_memset_00(draw_event_cnt, sizeof(draw_event_cnt));
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_PART_BEGIN]);
+    TEST_ASSERT_EQUAL_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_MAIN_END]);
+
+    /*A callback for all events gets the draw events too*/
+    lv_obj_add_event_cb(obj, draw_event_cb, LV_EVENT_ALL, NULL);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_MAIN_BEGIN]);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_POST_END]);
+}
+
+void test_event_draw_events_sent_to_classes(void)
+{
+    TEST_ASSERT_EQUAL_UINT8(LV_OBJ_CLASS_DRAW_EVENTS_DEF, _lv_obj_class_get_draw_events(&lv_btn_class));
+    TEST_ASSERT_EQUAL_UINT8(LV_OBJ_CLASS_DRAW_EVENT_ALL, _lv_obj_class_get_draw_events(&draw_event_class));
+
+    /*Every draw event is sent to a class which doesn't tell what it handles*/
+    lv_obj_t * obj = lv_obj_class_create_obj(&draw_event_class, lv_scr_act());
+    lv_obj_class_init_obj(obj);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_MAIN_BEGIN]);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_MAIN]);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_POST_END]);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, draw_event_cnt[LV_EVENT_DRAW_PART_BEGIN]);
+}
+
 #endif
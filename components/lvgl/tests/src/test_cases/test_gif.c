@@ -0,0 +1,175 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_GIF
+
+/*113 frames of 60x80 px, looping endlessly*/
+LV_IMG_DECLARE(img_bulb_gif)
+
+#define BULB_FRAME_CNT  113
+
+static lv_obj_t * gif;
+static gd_GIF * ref;
+
+/*Pretend that the delay of the current frame has elapsed and show the next frame*/
+static void next_frame(void)
+{
+    lv_gif_t * gifobj = (lv_gif_t *)gif;
+    gifobj->last_call = lv_tick_get() - gifobj->gif->gce.delay * 10;
+    gifobj->timer->timer_cb(gifobj->timer);
+}
+
+/*Decode the next frame with a separate decoder the same way as the GIF object did before the cache*/
+static void ref_next_frame(void)
+{
+    gd_get_frame(ref);
+    gd_render_frame(ref, ref->canvas);
+}
+
+static void assert_canvas_same_as_ref(void)
+{
+    lv_gif_t * gifobj = (lv_gif_t *)gif;
+    TEST_ASSERT_EQUAL_MEMORY(ref->canvas, gifobj->imgdsc.data, ref->width * ref->height * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    TEST_ASSERT_EQUAL_UINT16(ref->gce.delay, gifobj->gif->gce.delay);
+}
+
+void setUp(void)
+{
+    gif = lv_gif_create(lv_scr_act());
+    lv_gif_set_src(gif, &img_bulb_gif);
+    lv_obj_set_pos(gif, 100, 50);
+    lv_refr_now(NULL);
+
+    ref = gd_open_gif_data(img_bulb_gif.data);
+    ref_next_frame();
+}
+
+void tearDown(void)
+{
+    gd_close_gif(ref);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_gif_invalidates_only_the_frame_area(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+
+    /*The 2nd frame of the bulb is (25;51) 4x2 px and the 1st frame is not restored to the background*/
+    next_frame();
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    TEST_ASSERT_EQUAL_INT(125, disp->inv_areas[0].x1);
+    TEST_ASSERT_EQUAL_INT(101, disp->inv_areas[0].y1);
+    TEST_ASSERT_EQUAL_INT(128, disp->inv_areas[0].x2);
+    TEST_ASSERT_EQUAL_INT(102, disp->inv_areas[0].y2);
+
+    lv_gif_t * gifobj = (lv_gif_t *)gif;
+    TEST_ASSERT_EQUAL_INT32(1, gifobj->gif->frame_idx);
+
+    ref_next_frame();
+    assert_canvas_same_as_ref();
+}
+
+void test_gif_invalidates_the_whole_object_if_zoomed(void)
+{
+    lv_img_set_zoom(gif, 512);
+    lv_refr_now(NULL);
+
+    next_frame();
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&gif->coords, &disp->inv_areas[0], 0));
+}
+
+void test_gif_plays_the_next_loops_from_the_cache(void)
+{
+#if LV_GIF_CACHE_SIZE
+    lv_gif_t * gifobj = (lv_gif_t *)gif;
+    uint32_t i;
+
+    /*The first loop is only decoded*/
+    for(i = 1; i < BULB_FRAME_CNT; i++) {
+        next_frame();
+        ref_next_frame();
+    }
+    TEST_ASSERT_EQUAL_UINT8(LV_GIF_CACHE_STATE_WAIT, gifobj->cache_state);
+    assert_canvas_same_as_ref();
+
+    /*The second loop is stored*/
+    for(i = 0; i < BULB_FRAME_CNT; i++) {
+        next_frame();
+        ref_next_frame();
+        assert_canvas_same_as_ref();
+    }
+    TEST_ASSERT_EQUAL_UINT8(LV_GIF_CACHE_STATE_READY, gifobj->cache_state);
+    TEST_ASSERT_EQUAL_UINT16(BULB_FRAME_CNT, gifobj->frame_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_GIF_CACHE_SIZE, gifobj->cache_size);
+
+    /*The next loops are played without decoding*/
+    for(i = 0; i < 2 * BULB_FRAME_CNT; i++) {
+        next_frame();
+        ref_next_frame();
+        assert_canvas_same_as_ref();
+        TEST_ASSERT_EQUAL_INT32(0, gifobj->gif->frame_idx);
+    }
+#endif
+}
+
+void test_gif_restart_frees_the_cache(void)
+{
+#if LV_GIF_CACHE_SIZE
+    lv_gif_t * gifobj = (lv_gif_t *)gif;
+    uint32_t i;
+    for(i = 0; i < 2 * BULB_FRAME_CNT + 1; i++) {
+        next_frame();
+    }
+    TEST_ASSERT_EQUAL_UINT8(LV_GIF_CACHE_STATE_READY, gifobj->cache_state);
+
+    lv_gif_restart(gif);
+    TEST_ASSERT_EQUAL_UINT8(LV_GIF_CACHE_STATE_NONE, gifobj->cache_state);
+    TEST_ASSERT_NULL(gifobj->frames);
+    TEST_ASSERT_EQUAL_UINT32(0, gifobj->cache_size);
+
+    next_frame();
+    next_frame();
+    TEST_ASSERT_EQUAL_INT32(1, gifobj->gif->frame_idx);
+#endif
+}
+
+#else /*LV_USE_GIF*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_gif_invalidates_only_the_frame_area(void)
+{
+
+}
+
+void test_gif_invalidates_the_whole_object_if_zoomed(void)
+{
+
+}
+
+void test_gif_plays_the_next_loops_from_the_cache(void)
+{
+
+}
+
+void test_gif_restart_frees_the_cache(void)
+{
+
+}
+
+#endif
+
+#endif
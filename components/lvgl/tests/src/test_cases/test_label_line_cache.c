@@ -0,0 +1,215 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_LABEL_LINE_CACHE
+
+extern lv_color_t test_fb[];
+
+#define FB_PX_CNT   (800 * 480)
+
+static lv_color_t label_fb[FB_PX_CNT];
+static lv_color_t ref_fb[FB_PX_CNT];
+static const char * ref_txt;
+
+/*Draw `ref_txt` with `lv_draw_label()` measuring the lines while drawing*/
+static void ref_draw_event_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+
+    lv_area_t coords;
+    lv_obj_get_content_coords(obj, &coords);
+    lv_draw_label(lv_event_get_draw_ctx(e), &dsc, &coords, ref_txt, NULL);
+}
+
+static void render(lv_color_t * fb)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_memcpy(fb, test_fb, FB_PX_CNT * sizeof(lv_color_t));
+}
+
+/*Render the label, then replace it with a plain object drawing the same text and compare the results*/
+static void assert_label_renders_same_as_ref(lv_obj_t * label)
+{
+    render(label_fb);
+    TEST_ASSERT_NOT_NULL(((lv_label_t *)label)->line_cache.lines);
+
+    ref_txt = lv_label_get_text(label);
+    lv_area_t coords;
+    lv_obj_get_coords(label, &coords);
+    lv_text_align_t align = lv_obj_get_style_text_align(label, LV_PART_MAIN);
+    lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
+
+    lv_obj_t * ref = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(ref);
+    lv_obj_set_pos(ref, coords.x1, coords.y1);
+    lv_obj_set_size(ref, lv_area_get_width(&coords), lv_area_get_height(&coords));
+    lv_obj_set_style_text_align(ref, align, 0);
+    lv_obj_add_event_cb(ref, ref_draw_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+    render(ref_fb);
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, label_fb, sizeof(ref_fb));
+}
+
+/*Measure the width of a single line text with the general line breaking algorithm*/
+static lv_coord_t line_width_ref(const char * txt, lv_coord_t letter_space)
+{
+    const lv_font_t * font = LV_FONT_DEFAULT;
+    uint32_t line_end = _lv_txt_get_next_line(txt, font, letter_space, LV_COORD_MAX, NULL, LV_TEXT_FLAG_EXPAND);
+    TEST_ASSERT_EQUAL_UINT32(strlen(txt), line_end);
+    return lv_txt_get_width(txt, line_end, font, letter_space, LV_TEXT_FLAG_NONE);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_label_line_cache_single_line_width_same_as_general_path(void)
+{
+    const char * txts[] = {"25.5", "1013 hPa", "Refresh", "25.5\xC2\xB0""C", "a", NULL};
+    lv_coord_t letter_spaces[] = {0, 2};
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; txts[i]; i++) {
+        for(j = 0; j < sizeof(letter_spaces) / sizeof(letter_spaces[0]); j++) {
+            lv_coord_t w = -1;
+            bool res = _lv_txt_get_single_line_width(txts[i], LV_FONT_DEFAULT, letter_spaces[j], LV_COORD_MAX,
+                                                     LV_TEXT_FLAG_EXPAND, &w);
+            TEST_ASSERT_TRUE(res);
+            TEST_ASSERT_EQUAL_INT(line_width_ref(txts[i], letter_spaces[j]), w);
+        }
+    }
+}
+
+void test_label_line_cache_single_line_width_rejects_multi_line_texts(void)
+{
+    lv_coord_t w;
+    const lv_font_t * font = LV_FONT_DEFAULT;
+    TEST_ASSERT_FALSE(_lv_txt_get_single_line_width("Line 1\nLine 2", font, 0, LV_COORD_MAX, LV_TEXT_FLAG_EXPAND, &w));
+    TEST_ASSERT_FALSE(_lv_txt_get_single_line_width("Refresh", font, 0, 10, LV_TEXT_FLAG_NONE, &w));
+    TEST_ASSERT_FALSE(_lv_txt_get_single_line_width("#ff0000 red#", font, 0, LV_COORD_MAX, LV_TEXT_FLAG_RECOLOR, &w));
+
+    /*Exactly as wide as the text: the general path wraps it because of the trailing letter space*/
+    lv_coord_t txt_w = line_width_ref("Refresh", 2);
+    TEST_ASSERT_FALSE(_lv_txt_get_single_line_width("Refresh", font, 2, txt_w, LV_TEXT_FLAG_NONE, &w));
+    TEST_ASSERT_TRUE(_lv_txt_get_single_line_width("Refresh", font, 2, txt_w, LV_TEXT_FLAG_FIT, &w));
+    TEST_ASSERT_EQUAL_INT(txt_w, w);
+}
+
+void test_label_line_cache_size_same_as_txt_get_size(void)
+{
+    const char * txt = "Temperature\nHumidity and pressure";
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, txt);
+    lv_obj_update_layout(label);
+
+    lv_point_t size;
+    lv_txt_get_size(&size, txt, LV_FONT_DEFAULT, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL_INT(size.x, lv_obj_get_width(label));
+    TEST_ASSERT_EQUAL_INT(size.y, lv_obj_get_height(label));
+
+    lv_label_line_cache_t * cache = &((lv_label_t *)label)->line_cache;
+    TEST_ASSERT_EQUAL_UINT32(2, cache->line_cnt);
+    TEST_ASSERT_EQUAL_UINT32(strlen("Temperature\n"), cache->lines[0].end);
+    TEST_ASSERT_EQUAL_UINT32(strlen(txt), cache->lines[1].end);
+    TEST_ASSERT_EQUAL_INT(size.x, cache->lines[1].width);
+
+    /*A new text is measured again*/
+    lv_label_set_text(label, "25.5");
+    lv_obj_update_layout(label);
+    TEST_ASSERT_EQUAL_UINT32(1, cache->line_cnt);
+    TEST_ASSERT_EQUAL_PTR(&cache->line, cache->lines);
+    TEST_ASSERT_EQUAL_INT(cache->line.width, lv_obj_get_width(label));
+}
+
+void test_label_line_cache_renders_same_as_without_cache(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "25.5\xC2\xB0""C");
+    lv_obj_set_pos(label, 10, 10);
+    assert_label_renders_same_as_ref(label);
+}
+
+void test_label_line_cache_renders_wrapped_centered_text_same_as_without_cache(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 120);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_text(label, "A long text which needs to be wrapped into multiple lines\nand a new line");
+    lv_obj_set_pos(label, 100, 50);
+    assert_label_renders_same_as_ref(label);
+}
+
+void test_label_line_cache_renders_dots_same_as_without_cache(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_long_mode(label, LV_LABEL_LONG_DOT);
+    lv_obj_set_size(label, 100, 40);
+    lv_label_set_text(label, "A long text which doesn't fit into the label so it ends with dots");
+    lv_obj_set_pos(label, 200, 100);
+    assert_label_renders_same_as_ref(label);
+
+    /*The dots are replaced by the original text and the lines are measured again*/
+    lv_obj_clear_flag(label, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_height(label, 200);
+    lv_obj_update_layout(label);
+    TEST_ASSERT_EQUAL_STRING("A long text which doesn't fit into the label so it ends with dots", lv_label_get_text(label));
+    lv_label_line_cache_t * cache = &((lv_label_t *)label)->line_cache;
+    TEST_ASSERT_EQUAL_UINT32(strlen(lv_label_get_text(label)), cache->lines[cache->line_cnt - 1].end);
+}
+
+#else /*LV_LABEL_LINE_CACHE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_label_line_cache_single_line_width_same_as_general_path(void)
+{
+
+}
+
+void test_label_line_cache_single_line_width_rejects_multi_line_texts(void)
+{
+
+}
+
+void test_label_line_cache_size_same_as_txt_get_size(void)
+{
+
+}
+
+void test_label_line_cache_renders_same_as_without_cache(void)
+{
+
+}
+
+void test_label_line_cache_renders_wrapped_centered_text_same_as_without_cache(void)
+{
+
+}
+
+void test_label_line_cache_renders_dots_same_as_without_cache(void)
+{
+
+}
+
+#endif
+
+#endif
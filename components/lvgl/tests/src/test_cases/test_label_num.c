@@ -0,0 +1,122 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * label;
+
+void setUp(void)
+{
+    label = lv_label_create(lv_scr_act());
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_label_num_format(void)
+{
+    lv_label_set_num(label, 2550, 2, 1, LV_LABEL_NUM_CONV_NONE, "°C");
+    TEST_ASSERT_EQUAL_STRING("25.5°C", lv_label_get_text(label));
+
+    /*Rounded half away from zero*/
+    lv_label_set_num(label, 2555, 2, 1, LV_LABEL_NUM_CONV_NONE, NULL);
+    TEST_ASSERT_EQUAL_STRING("25.6", lv_label_get_text(label));
+    lv_label_set_num(label, -2555, 2, 1, LV_LABEL_NUM_CONV_NONE, NULL);
+    TEST_ASSERT_EQUAL_STRING("-25.6", lv_label_get_text(label));
+    lv_label_set_num(label, -5, 2, 1, LV_LABEL_NUM_CONV_NONE, NULL);
+    TEST_ASSERT_EQUAL_STRING("-0.1", lv_label_get_text(label));
+
+    /*No negative zero*/
+    lv_label_set_num(label, -4, 2, 1, LV_LABEL_NUM_CONV_NONE, NULL);
+    TEST_ASSERT_EQUAL_STRING("0.0", lv_label_get_text(label));
+
+    /*Leading zeros of the decimals and more decimals than in the value*/
+    lv_label_set_num(label, 7, 3, 3, LV_LABEL_NUM_CONV_NONE, NULL);
+    TEST_ASSERT_EQUAL_STRING("0.007", lv_label_get_text(label));
+    lv_label_set_num(label, 5, 0, 2, LV_LABEL_NUM_CONV_NONE, "%");
+    TEST_ASSERT_EQUAL_STRING("5.00%", lv_label_get_text(label));
+    lv_label_set_num(label, 101325, 2, 0, LV_LABEL_NUM_CONV_NONE, " hPa");
+    TEST_ASSERT_EQUAL_STRING("1013 hPa", lv_label_get_text(label));
+
+    lv_label_set_num(label, INT32_MIN, 0, 0, LV_LABEL_NUM_CONV_NONE, NULL);
+    TEST_ASSERT_EQUAL_STRING("-2147483648", lv_label_get_text(label));
+
+    /*Too long suffix is cut*/
+    lv_label_set_num(label, 1, 0, 0, LV_LABEL_NUM_CONV_NONE, " 123456789abcdefghij");
+    TEST_ASSERT_EQUAL_STRING("1 123456789abcde", lv_label_get_text(label));
+
+    /*Not in the middle of a UTF-8 character ("°" is 2 bytes from the 15th byte)*/
+    lv_label_set_num(label, 1, 0, 0, LV_LABEL_NUM_CONV_NONE, " 1234567890123°C");
+    TEST_ASSERT_EQUAL_STRING("1 1234567890123", lv_label_get_text(label));
+}
+
+void test_label_num_conversion(void)
+{
+    lv_label_set_num(label, 2550, 2, 1, LV_LABEL_NUM_CONV_C_TO_F, "°F");
+    TEST_ASSERT_EQUAL_STRING("77.9°F", lv_label_get_text(label));
+    lv_label_set_num(label, -4000, 2, 1, LV_LABEL_NUM_CONV_C_TO_F, NULL);
+    TEST_ASSERT_EQUAL_STRING("-40.0", lv_label_get_text(label));
+
+    lv_label_set_num(label, 101325, 2, 2, LV_LABEL_NUM_CONV_HPA_TO_INHG, " inHg");
+    TEST_ASSERT_EQUAL_STRING("29.92 inHg", lv_label_get_text(label));
+    lv_label_set_num(label, 101325, 2, 0, LV_LABEL_NUM_CONV_HPA_TO_MMHG, " mmHg");
+    TEST_ASSERT_EQUAL_STRING("760 mmHg", lv_label_get_text(label));
+
+    /*More decimals than in the value: converted with the shown precision*/
+    lv_label_set_num(label, 26, 0, 1, LV_LABEL_NUM_CONV_C_TO_F, NULL);
+    TEST_ASSERT_EQUAL_STRING("78.8", lv_label_get_text(label));
+    lv_label_set_num(label, -3, 0, 2, LV_LABEL_NUM_CONV_C_TO_F, NULL);
+    TEST_ASSERT_EQUAL_STRING("26.60", lv_label_get_text(label));
+    lv_label_set_num(label, 1013, 0, 2, LV_LABEL_NUM_CONV_HPA_TO_INHG, NULL);
+    TEST_ASSERT_EQUAL_STRING("29.91", lv_label_get_text(label));
+    lv_label_set_num(label, 1013, 0, 1, LV_LABEL_NUM_CONV_HPA_TO_MMHG, NULL);
+    TEST_ASSERT_EQUAL_STRING("759.8", lv_label_get_text(label));
+    lv_label_set_num(label, 10132, 1, 3, LV_LABEL_NUM_CONV_HPA_TO_MMHG, NULL);
+    TEST_ASSERT_EQUAL_STRING("759.963", lv_label_get_text(label));
+
+    /*Rounded only once: 29.9146 is not rounded to 29.915 and then to 29.92*/
+    lv_label_set_num(label, 1013025, 3, 2, LV_LABEL_NUM_CONV_HPA_TO_INHG, NULL);
+    TEST_ASSERT_EQUAL_STRING("29.91", lv_label_get_text(label));
+}
+
+void test_label_num_invalidates_only_changes(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+
+    lv_label_set_num(label, 2550, 2, 1, LV_LABEL_NUM_CONV_NONE, "°C");
+    lv_refr_now(NULL);
+    char * txt = lv_label_get_text(label);
+
+    /*Same characters: not invalidated*/
+    lv_label_set_num(label, 2549, 2, 1, LV_LABEL_NUM_CONV_NONE, "°C");
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+
+    /*Same length: written in place*/
+    lv_label_set_num(label, 2561, 2, 1, LV_LABEL_NUM_CONV_NONE, "°C");
+    TEST_ASSERT_GREATER_THAN_UINT16(0, disp->inv_p);
+#if LV_USE_ARABIC_PERSIAN_CHARS == 0
+    TEST_ASSERT_EQUAL_PTR(txt, lv_label_get_text(label));
+#else
+    LV_UNUSED(txt);
+#endif
+    TEST_ASSERT_EQUAL_STRING("25.6°C", lv_label_get_text(label));
+    lv_refr_now(NULL);
+
+    /*The size follows the longer text*/
+    lv_coord_t w = lv_obj_get_width(label);
+    lv_label_set_num(label, 10050, 2, 1, LV_LABEL_NUM_CONV_NONE, "°C");
+    TEST_ASSERT_EQUAL_STRING("100.5°C", lv_label_get_text(label));
+    lv_obj_update_layout(label);
+    TEST_ASSERT_GREATER_THAN(w, lv_obj_get_width(label));
+
+    /*A static text is not overwritten*/
+    static const char static_txt[] = "00.0°C";
+    lv_label_set_text_static(label, static_txt);
+    lv_label_set_num(label, 2561, 2, 1, LV_LABEL_NUM_CONV_NONE, "°C");
+    TEST_ASSERT_EQUAL_STRING("00.0°C", static_txt);
+    TEST_ASSERT_EQUAL_STRING("25.6°C", lv_label_get_text(label));
+}
+
+#endif
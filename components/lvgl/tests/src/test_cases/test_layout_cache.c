@@ -0,0 +1,224 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_LAYOUT_CACHE && LV_USE_GRID && LV_USE_FLEX
+
+static lv_obj_t * grid;
+static lv_obj_t * cards[3];
+static lv_obj_t * value_labels[3];
+static lv_layout_monitor_t mon_ori;
+
+static void grid_create(void)
+{
+    static const lv_coord_t col_dsc[] = {140, 140, 140, LV_GRID_TEMPLATE_LAST};
+    static const lv_coord_t row_dsc[] = {200, LV_GRID_TEMPLATE_LAST};
+
+    grid = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(grid, 440, 200);
+    lv_obj_center(grid);
+    lv_obj_set_style_pad_all(grid, 0, 0);
+    lv_obj_set_style_pad_column(grid, 10, 0);
+    lv_obj_set_grid_dsc_array(grid, col_dsc, row_dsc);
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        cards[i] = lv_obj_create(grid);
+        lv_obj_set_size(cards[i], 130, 170);
+        lv_obj_set_grid_cell(cards[i], LV_GRID_ALIGN_CENTER, i, 1, LV_GRID_ALIGN_CENTER, 0, 1);
+
+        value_labels[i] = lv_label_create(cards[i]);
+        lv_obj_set_width(value_labels[i], 100);
+        lv_label_set_text(value_labels[i], "25.5");
+        lv_obj_align(value_labels[i], LV_ALIGN_BOTTOM_MID, 0, 0);
+    }
+}
+
+static void mon_save(void)
+{
+    lv_obj_layout_monitor(&mon_ori);
+}
+
+static uint32_t calc_cnt_diff(void)
+{
+    lv_layout_monitor_t mon;
+    lv_obj_layout_monitor(&mon);
+    return mon.calc_cnt - mon_ori.calc_cnt;
+}
+
+static uint32_t skip_cnt_diff(void)
+{
+    lv_layout_monitor_t mon;
+    lv_obj_layout_monitor(&mon);
+    return mon.skip_cnt - mon_ori.skip_cnt;
+}
+
+static uint32_t obj_cnt_diff(void)
+{
+    lv_layout_monitor_t mon;
+    lv_obj_layout_monitor(&mon);
+    return mon.obj_cnt - mon_ori.obj_cnt;
+}
+
+void setUp(void)
+{
+    grid_create();
+    lv_obj_update_layout(grid);
+    mon_save();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_layout_cache_label_text_change_updates_only_the_label(void)
+{
+    lv_label_set_text(value_labels[1], "26.1");
+    lv_obj_update_layout(grid);
+
+    TEST_ASSERT_EQUAL_UINT32(0, calc_cnt_diff());
+    TEST_ASSERT_EQUAL_UINT32(0, skip_cnt_diff());
+    TEST_ASSERT_EQUAL_UINT32(1, obj_cnt_diff());
+}
+
+void test_layout_cache_skips_layout_if_children_are_not_changed(void)
+{
+    lv_area_t coords_ori[3];
+    uint32_t i;
+    for(i = 0; i < 3; i++) lv_obj_get_coords(cards[i], &coords_ori[i]);
+
+    /*The children of the screen are updated on size change but the cards stay where they are*/
+    lv_obj_set_style_text_letter_space(lv_scr_act(), 1, 0);
+    lv_obj_update_layout(grid);
+
+    TEST_ASSERT_EQUAL_UINT32(0, calc_cnt_diff());
+    TEST_ASSERT_GREATER_THAN_UINT32(0, skip_cnt_diff());
+
+    for(i = 0; i < 3; i++) {
+        lv_area_t coords;
+        lv_obj_get_coords(cards[i], &coords);
+        TEST_ASSERT_TRUE(_lv_area_is_equal(&coords_ori[i], &coords));
+    }
+}
+
+void test_layout_cache_calculates_layout_if_a_child_size_changes(void)
+{
+    lv_obj_set_height(cards[1], 100);
+    lv_obj_update_layout(grid);
+
+    TEST_ASSERT_EQUAL_UINT32(1, calc_cnt_diff());
+    TEST_ASSERT_EQUAL_INT(50, lv_obj_get_y(cards[1]));
+    TEST_ASSERT_EQUAL_INT(15, lv_obj_get_y(cards[0]));
+
+    /*Size change only of a grandchild's content*/
+    mon_save();
+    lv_obj_set_width(value_labels[1], LV_SIZE_CONTENT);
+    lv_obj_update_layout(grid);
+    TEST_ASSERT_EQUAL_UINT32(0, calc_cnt_diff());
+}
+
+void test_layout_cache_calculates_layout_if_a_style_changes(void)
+{
+    lv_obj_set_style_pad_column(grid, 0, 0);
+    lv_obj_update_layout(grid);
+
+    TEST_ASSERT_EQUAL_UINT32(1, calc_cnt_diff());
+    TEST_ASSERT_EQUAL_INT(145, lv_obj_get_x(cards[1]));
+
+    mon_save();
+    lv_obj_set_grid_cell(cards[2], LV_GRID_ALIGN_START, 2, 1, LV_GRID_ALIGN_START, 0, 1);
+    lv_obj_update_layout(grid);
+
+    TEST_ASSERT_EQUAL_UINT32(1, calc_cnt_diff());
+    TEST_ASSERT_EQUAL_INT(280, lv_obj_get_x(cards[2]));
+    TEST_ASSERT_EQUAL_INT(0, lv_obj_get_y(cards[2]));
+}
+
+void test_layout_cache_mark_layout_as_dirty_forces_calculation(void)
+{
+    lv_obj_mark_layout_as_dirty(grid);
+    lv_obj_update_layout(grid);
+
+    TEST_ASSERT_EQUAL_UINT32(1, calc_cnt_diff());
+    TEST_ASSERT_EQUAL_UINT32(0, skip_cnt_diff());
+}
+
+void test_layout_cache_calculates_layout_if_a_child_is_hidden(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 300, LV_SIZE_CONTENT);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+    lv_obj_set_style_pad_gap(cont, 0, 0);
+    lv_obj_set_style_border_width(cont, 0, 0);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW);
+
+    lv_obj_t * items[3];
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        items[i] = lv_obj_create(cont);
+        lv_obj_set_size(items[i], 50, 40);
+    }
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT(100, lv_obj_get_x(items[2]));
+
+    mon_save();
+    lv_obj_add_flag(items[0], LV_OBJ_FLAG_HIDDEN);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_UINT32(1, calc_cnt_diff());
+    TEST_ASSERT_EQUAL_INT(50, lv_obj_get_x(items[2]));
+
+    /*The height of the content sized container follows the children*/
+    mon_save();
+    lv_obj_set_height(items[1], 60);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, calc_cnt_diff());
+    TEST_ASSERT_EQUAL_INT(60, lv_obj_get_height(cont));
+}
+
+#else /*LV_USE_LAYOUT_CACHE && LV_USE_GRID && LV_USE_FLEX*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_layout_cache_label_text_change_updates_only_the_label(void)
+{
+
+}
+
+void test_layout_cache_skips_layout_if_children_are_not_changed(void)
+{
+
+}
+
+void test_layout_cache_calculates_layout_if_a_child_size_changes(void)
+{
+
+}
+
+void test_layout_cache_calculates_layout_if_a_style_changes(void)
+{
+
+}
+
+void test_layout_cache_mark_layout_as_dirty_forces_calculation(void)
+{
+
+}
+
+void test_layout_cache_calculates_layout_if_a_child_is_hidden(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,139 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_METER
+
+static lv_obj_t * meter;
+static lv_meter_scale_t * scale;
+
+static uint32_t get_inv_size(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    uint32_t size = 0;
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        size += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    return size;
+}
+
+void setUp(void)
+{
+    meter = lv_meter_create(lv_scr_act());
+    lv_obj_set_size(meter, 300, 300);
+    lv_obj_center(meter);
+    scale = lv_meter_add_scale(meter);
+    lv_meter_set_scale_ticks(meter, scale, 41, 2, 10, lv_palette_main(LV_PALETTE_GREY));
+    lv_meter_set_scale_major_ticks(meter, scale, 8, 4, 15, lv_color_black(), 10);
+    lv_refr_now(NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_meter_inv_needle_segments(void)
+{
+    lv_meter_indicator_t * needle = lv_meter_add_needle_line(meter, scale, 4, lv_palette_main(LV_PALETTE_RED), -10);
+    lv_refr_now(NULL);
+
+    /*From the bottom left to the bottom right corner: diagonal needles with large bounding boxes*/
+    lv_meter_set_indicator_value(meter, needle, 100);
+    uint32_t box_size = get_inv_size();
+    lv_refr_now(NULL);
+
+    lv_meter_set_needle_inv_segments(meter, 4);
+    lv_meter_set_indicator_value(meter, needle, 0);
+    uint32_t seg_size = get_inv_size();
+    TEST_ASSERT_LESS_THAN_UINT32(box_size * 2 / 3, seg_size);
+}
+
+void test_meter_inv_scale_lines(void)
+{
+    lv_meter_indicator_t * indic = lv_meter_add_scale_lines(meter, scale, lv_palette_main(LV_PALETTE_BLUE),
+                                                            lv_palette_main(LV_PALETTE_BLUE), false, 2);
+    lv_meter_set_indicator_start_value(meter, indic, 0);
+    lv_meter_set_indicator_end_value(meter, indic, 20);
+    lv_refr_now(NULL);
+
+    /*Only the ticks between the old and new end value*/
+    lv_meter_set_indicator_end_value(meter, indic, 30);
+    TEST_ASSERT_LESS_THAN_UINT32(lv_area_get_size(&meter->coords) / 8, get_inv_size());
+    lv_refr_now(NULL);
+
+    lv_meter_set_indicator_end_value(meter, indic, 30);
+    TEST_ASSERT_EQUAL_UINT32(0, get_inv_size());
+
+    /*With local gradient all the ticks get new color*/
+    indic->type_data.scale_lines.color_end = lv_palette_main(LV_PALETTE_RED);
+    indic->type_data.scale_lines.local_grad = 1;
+    lv_meter_set_indicator_end_value(meter, indic, 35);
+    TEST_ASSERT_GREATER_THAN_UINT32(lv_area_get_size(&meter->coords) / 8, get_inv_size());
+}
+
+void test_meter_inv_same_as_full_redraw(void)
+{
+    static lv_color_t partial_buf[800 * 480];
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_draw_buf_t * draw_buf = disp->driver->draw_buf;
+
+    lv_meter_indicator_t * arc = lv_meter_add_arc(meter, scale, 10, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_meter_indicator_t * lines = lv_meter_add_scale_lines(meter, scale, lv_palette_main(LV_PALETTE_GREEN),
+                                                            lv_palette_main(LV_PALETTE_RED), false, 1);
+    lv_meter_indicator_t * needle = lv_meter_add_needle_line(meter, scale, 4, lv_palette_main(LV_PALETTE_RED), -10);
+    lv_meter_set_needle_inv_segments(meter, 4);
+
+    /*In direct mode the buffer keeps the whole screen and only the invalidated areas are redrawn*/
+    disp->driver->direct_mode = 1;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    uint32_t i;
+    for(i = 0; i <= 100; i += 20) {
+        lv_meter_set_indicator_end_value(meter, arc, i);
+        lv_meter_set_indicator_end_value(meter, lines, i);
+        lv_meter_set_indicator_value(meter, needle, i);
+        lv_refr_now(NULL);
+    }
+    lv_memcpy(partial_buf, draw_buf->buf_act, sizeof(partial_buf));
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    disp->driver->direct_mode = 0;
+
+    TEST_ASSERT_EQUAL_MEMORY(draw_buf->buf_act, partial_buf, sizeof(partial_buf));
+}
+
+#else /*LV_USE_METER*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_meter_inv_needle_segments(void)
+{
+
+}
+
+void test_meter_inv_scale_lines(void)
+{
+
+}
+
+void test_meter_inv_same_as_full_redraw(void)
+{
+
+}
+
+#endif
+
+#endif
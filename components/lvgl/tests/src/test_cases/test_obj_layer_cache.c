@@ -0,0 +1,240 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_LAYER_CACHE_SIZE
+
+extern lv_color_t test_fb[];
+
+#define FB_PX_CNT   (800 * 480)
+
+static lv_color_t ref_fb[FB_PX_CNT];
+static lv_color_t cached_fb[FB_PX_CNT];
+static lv_obj_t * card;
+static lv_obj_t * value_label;
+
+static void card_create(void)
+{
+    card = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(card, 130, 170);
+    lv_obj_center(card);
+    lv_obj_set_style_radius(card, 15, 0);
+    lv_obj_set_style_shadow_width(card, 10, 0);
+    lv_obj_set_style_shadow_opa(card, LV_OPA_20, 0);
+
+    lv_obj_t * title = lv_label_create(card);
+    lv_label_set_text(title, "Temperature");
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 0);
+
+    value_label = lv_label_create(card);
+    lv_label_set_text(value_label, "25.5");
+    lv_obj_align(value_label, LV_ALIGN_BOTTOM_MID, 0, 0);
+}
+
+/*Render the screen with the layer cache disabled on `card` to get the reference image*/
+static void ref_render(void)
+{
+    lv_obj_clear_flag(card, LV_OBJ_FLAG_LAYER_CACHE);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    lv_obj_add_flag(card, LV_OBJ_FLAG_LAYER_CACHE);
+}
+
+/*Redraw the whole screen while `card` is drawn from its up to date layer*/
+static void cached_render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_memcpy(cached_fb, test_fb, sizeof(cached_fb));
+}
+
+static void assert_same_as_ref(void)
+{
+    /*Blending the layer with alpha channel can differ from the direct rendering due to rounding*/
+    uint32_t i;
+    for(i = 0; i < FB_PX_CNT; i++) {
+        TEST_ASSERT_INT_WITHIN(2, ref_fb[i].ch.red, cached_fb[i].ch.red);
+        TEST_ASSERT_INT_WITHIN(2, ref_fb[i].ch.green, cached_fb[i].ch.green);
+        TEST_ASSERT_INT_WITHIN(2, ref_fb[i].ch.blue, cached_fb[i].ch.blue);
+    }
+}
+
+void setUp(void)
+{
+    lv_obj_layer_cache_clean();
+    card_create();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_layer_cache_renders_same_as_without_cache(void)
+{
+    ref_render();
+
+    lv_layer_cache_monitor_t mon_ori;
+    lv_obj_layer_cache_monitor(&mon_ori);
+
+    cached_render();
+    assert_same_as_ref();
+
+    lv_layer_cache_monitor_t mon;
+    lv_obj_layer_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mon_ori.miss_cnt + 1, mon.miss_cnt);
+}
+
+void test_layer_cache_is_used_if_only_the_background_changes(void)
+{
+    lv_obj_add_flag(card, LV_OBJ_FLAG_LAYER_CACHE);
+    lv_refr_now(NULL);
+
+    lv_layer_cache_monitor_t mon_ori;
+    lv_obj_layer_cache_monitor(&mon_ori);
+
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_refr_now(NULL);
+
+    lv_layer_cache_monitor_t mon;
+    lv_obj_layer_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(mon_ori.hit_cnt + 1, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mon_ori.update_cnt, mon.update_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mon_ori.miss_cnt, mon.miss_cnt);
+
+    cached_render();
+    ref_render();
+    assert_same_as_ref();
+}
+
+void test_layer_cache_updates_only_the_changed_child(void)
+{
+    lv_obj_add_flag(card, LV_OBJ_FLAG_LAYER_CACHE);
+    lv_refr_now(NULL);
+
+    lv_layer_cache_monitor_t mon_ori;
+    lv_obj_layer_cache_monitor(&mon_ori);
+
+    lv_label_set_text(value_label, "26.0");
+    lv_refr_now(NULL);
+
+    lv_layer_cache_monitor_t mon;
+    lv_obj_layer_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(mon_ori.update_cnt + 1, mon.update_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mon_ori.miss_cnt, mon.miss_cnt);
+
+    /*The updated layer should look like the object rendered from scratch*/
+    cached_render();
+    ref_render();
+    assert_same_as_ref();
+}
+
+void test_layer_cache_is_rendered_again_if_the_object_moves(void)
+{
+    lv_obj_add_flag(card, LV_OBJ_FLAG_LAYER_CACHE);
+    lv_refr_now(NULL);
+
+    lv_layer_cache_monitor_t mon_ori;
+    lv_obj_layer_cache_monitor(&mon_ori);
+
+    lv_obj_set_x(card, 10);
+    lv_refr_now(NULL);
+
+    lv_layer_cache_monitor_t mon;
+    lv_obj_layer_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(mon_ori.miss_cnt + 1, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.entry_cnt);
+}
+
+void test_layer_cache_is_freed_with_the_object(void)
+{
+    lv_obj_add_flag(card, LV_OBJ_FLAG_LAYER_CACHE);
+    lv_refr_now(NULL);
+
+    lv_layer_cache_monitor_t mon;
+    lv_obj_layer_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.entry_cnt);
+    TEST_ASSERT_GREATER_THAN(0, mon.used_size);
+
+    lv_obj_del(card);
+
+    lv_obj_layer_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used_size);
+}
+
+void test_layer_cache_keeps_the_size_limit(void)
+{
+    /*Each layer needs more than half of the cache so only one of them can be cached*/
+    lv_obj_set_size(card, 200, 200);
+    lv_obj_t * card2 = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(card2, 200, 200);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_LAYER_CACHE);
+    lv_obj_add_flag(card2, LV_OBJ_FLAG_LAYER_CACHE);
+
+    ref_render();
+    cached_render();
+    assert_same_as_ref();
+
+    lv_layer_cache_monitor_t mon;
+    lv_obj_layer_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.entry_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_LAYER_CACHE_SIZE, mon.used_size);
+
+    /*Only card2 is used so it can evict the layer of card*/
+    lv_obj_add_flag(card, LV_OBJ_FLAG_HIDDEN);
+    lv_refr_now(NULL);
+
+    lv_obj_layer_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.entry_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_LAYER_CACHE_SIZE, mon.used_size);
+}
+
+#else /*LV_LAYER_CACHE_SIZE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_layer_cache_renders_same_as_without_cache(void)
+{
+
+}
+
+void test_layer_cache_is_used_if_only_the_background_changes(void)
+{
+
+}
+
+void test_layer_cache_updates_only_the_changed_child(void)
+{
+
+}
+
+void test_layer_cache_is_rendered_again_if_the_object_moves(void)
+{
+
+}
+
+void test_layer_cache_is_freed_with_the_object(void)
+{
+
+}
+
+void test_layer_cache_keeps_the_size_limit(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,200 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#if LV_OBJ_LIGHT_SLAB_CNT && LV_USE_LABEL && LV_USE_BTN
+
+#define LABEL_CNT   (LV_OBJ_LIGHT_SLAB_CNT * 2)
+
+static void create_labels(lv_obj_t ** labels, uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        labels[i] = lv_label_create(lv_scr_act());
+        lv_label_set_text_static(labels[i], "12");
+        lv_obj_set_pos(labels[i], (i % 10) * 30, (i / 10) * 20);
+        lv_obj_set_style_text_color(labels[i], lv_palette_main(LV_PALETTE_BLUE), 0);
+        lv_obj_set_style_text_opa(labels[i], LV_OPA_80, 0);
+    }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_enable_light_create(false);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_obj_light_no_input(void)
+{
+    lv_group_t * g = lv_group_create();
+    lv_group_set_default(g);
+
+    lv_obj_enable_light_create(true);
+    lv_obj_t * light = lv_btn_create(lv_scr_act());
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_enable_light_create(false);
+    lv_obj_t * normal = lv_btn_create(lv_scr_act());
+
+    TEST_ASSERT_TRUE(lv_obj_is_light(light));
+    TEST_ASSERT_FALSE(lv_obj_is_light(normal));
+    TEST_ASSERT_FALSE(lv_obj_is_light(scr));
+
+    TEST_ASSERT_FALSE(lv_obj_has_flag(light, LV_OBJ_FLAG_CLICKABLE));
+    TEST_ASSERT_FALSE(lv_obj_has_flag(light, LV_OBJ_FLAG_SCROLLABLE));
+    TEST_ASSERT_TRUE(lv_obj_has_flag(normal, LV_OBJ_FLAG_CLICKABLE));
+
+    /*Not added to any group and no scroll attributes*/
+    lv_group_add_obj(g, light);
+    TEST_ASSERT_NULL(lv_obj_get_group(light));
+    TEST_ASSERT_EQUAL_PTR(g, lv_obj_get_group(normal));
+
+    lv_obj_set_scrollbar_mode(light, LV_SCROLLBAR_MODE_ON);
+    lv_obj_set_scroll_dir(light, LV_DIR_HOR);
+    lv_obj_scroll_by(light, 10, 10, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL(LV_SCROLLBAR_MODE_AUTO, lv_obj_get_scrollbar_mode(light));
+    TEST_ASSERT_EQUAL(LV_DIR_ALL, lv_obj_get_scroll_dir(light));
+    TEST_ASSERT_EQUAL(0, lv_obj_get_scroll_x(light));
+
+    lv_obj_del(scr);
+    lv_group_set_default(NULL);
+    lv_group_del(g);
+}
+
+void test_obj_light_flags_stay_cleared(void)
+{
+    lv_obj_enable_light_create(true);
+    lv_obj_t * light = lv_label_create(lv_scr_act());
+    lv_obj_enable_light_create(false);
+
+    /*The input flags are ignored, the others are set*/
+    lv_obj_add_flag(light, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_HIDDEN);
+    TEST_ASSERT_FALSE(lv_obj_has_flag(light, LV_OBJ_FLAG_CLICKABLE));
+    TEST_ASSERT_FALSE(lv_obj_has_flag(light, LV_OBJ_FLAG_SCROLLABLE));
+    TEST_ASSERT_TRUE(lv_obj_has_flag(light, LV_OBJ_FLAG_HIDDEN));
+
+    lv_obj_clear_flag(light, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_pos(light, 10, 10);
+    lv_refr_now(NULL);
+    lv_point_t p = {12, 12};
+    TEST_ASSERT_TRUE(lv_indev_search_obj(lv_scr_act(), &p) != light);
+}
+
+void test_obj_light_ext_draw_size(void)
+{
+    lv_obj_t * labels[2];
+    lv_obj_enable_light_create(true);
+    create_labels(labels, 1);
+    lv_obj_enable_light_create(false);
+    create_labels(&labels[1], 1);
+
+    /*Labels have extra draw area for italic letters. Light objects store it without special attributes.*/
+    lv_coord_t ext_size = _lv_obj_get_ext_draw_size(labels[1]);
+    TEST_ASSERT_GREATER_THAN(0, ext_size);
+    TEST_ASSERT_NOT_NULL(labels[1]->spec_attr);
+    TEST_ASSERT_NULL(labels[0]->spec_attr);
+    TEST_ASSERT_EQUAL(ext_size, _lv_obj_get_ext_draw_size(labels[0]));
+
+    /*It's kept when the special attributes are allocated*/
+    lv_obj_set_ext_click_area(labels[0], 5);
+    TEST_ASSERT_NOT_NULL(labels[0]->spec_attr);
+    TEST_ASSERT_EQUAL(ext_size, _lv_obj_get_ext_draw_size(labels[0]));
+}
+
+void test_obj_light_slabs(void)
+{
+    lv_obj_t * labels[LABEL_CNT];
+    lv_obj_enable_light_create(true);
+    create_labels(labels, LABEL_CNT);
+
+    lv_obj_light_monitor_t mon;
+    lv_obj_light_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.slab_cnt);
+
+    /*Objects with other size are in other slabs*/
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_light_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(3, mon.slab_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LABEL_CNT + 1, mon.obj_cnt);
+
+    /*A slab is freed only when all its objects are deleted*/
+    lv_obj_del(obj);
+    lv_obj_del(labels[0]);
+    lv_obj_light_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.slab_cnt);
+
+    /*The free places are reused*/
+    labels[0] = lv_label_create(lv_scr_act());
+    lv_obj_light_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.slab_cnt);
+
+    lv_obj_clean(lv_scr_act());
+    lv_obj_light_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.slab_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.obj_cnt);
+}
+
+void test_obj_light_less_memory(void)
+{
+    lv_obj_t * labels[LABEL_CNT];
+    uint32_t mem_before = lv_test_get_free_mem();
+    create_labels(labels, LABEL_CNT);
+    uint32_t normal_size = mem_before - lv_test_get_free_mem();
+    lv_obj_clean(lv_scr_act());
+
+    mem_before = lv_test_get_free_mem();
+    lv_obj_enable_light_create(true);
+    create_labels(labels, LABEL_CNT);
+    uint32_t light_size = mem_before - lv_test_get_free_mem();
+    LV_HEAP_CHECK(TEST_ASSERT_LESS_THAN_UINT32(normal_size, light_size));
+    LV_HEAP_CHECK((TEST_PRINTF("%u labels: normal %u B, light %u B", LABEL_CNT, normal_size, light_size)));
+
+    lv_obj_clean(lv_scr_act());
+    LV_HEAP_CHECK(TEST_ASSERT_EQUAL_UINT32(mem_before, lv_test_get_free_mem()));
+}
+
+#else /*LV_OBJ_LIGHT_SLAB_CNT && LV_USE_LABEL && LV_USE_BTN*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_obj_light_no_input(void)
+{
+
+}
+
+void test_obj_light_flags_stay_cleared(void)
+{
+
+}
+
+void test_obj_light_ext_draw_size(void)
+{
+
+}
+
+void test_obj_light_slabs(void)
+{
+
+}
+
+void test_obj_light_less_memory(void)
+{
+
+}
+
+#endif
+
+#endif
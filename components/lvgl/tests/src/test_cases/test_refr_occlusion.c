@@ -0,0 +1,240 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_REFR_OCCLUSION_CULL
+
+static lv_obj_t * back;
+static lv_obj_t * front;
+static uint32_t back_draw_cnt;
+static uint32_t back_post_cnt;
+static lv_area_t back_clip_area;
+
+static void back_draw_event_cb(lv_event_t * e)
+{
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+    back_draw_cnt++;
+    back_clip_area = *draw_ctx->clip_area;
+}
+
+static void back_post_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    back_post_cnt++;
+}
+
+static lv_obj_t * create_rect(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    return obj;
+}
+
+static void refr(void)
+{
+    back_draw_cnt = 0;
+    back_post_cnt = 0;
+    lv_refr_reset_occlusion_stat();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+    back = create_rect(lv_scr_act(), 100, 100, 200, 100);
+    lv_obj_add_event_cb(back, back_draw_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(back, back_post_event_cb, LV_EVENT_DRAW_POST, NULL);
+    front = create_rect(lv_scr_act(), 50, 50, 300, 200);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_refr_occlusion_cull_covered(void)
+{
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(0, back_draw_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, back_post_cnt);
+
+    lv_refr_occlusion_stat_t stat;
+    lv_refr_get_occlusion_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.culled_cnt);
+    TEST_ASSERT_EQUAL_UINT32(200 * 100, stat.culled_px);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.occluder_cnt);
+    TEST_ASSERT_EQUAL_UINT32(800 * 480, stat.area_px);
+    /*The screen, the top and system layers and `front`*/
+    TEST_ASSERT_EQUAL_UINT32(3 * 800 * 480 + 300 * 200, stat.drawn_px);
+
+    /*The children are still drawn*/
+    lv_obj_set_parent(front, back);
+    lv_obj_set_pos(front, 0, 0);
+    lv_obj_set_size(front, 200, 100);
+    lv_obj_t * child = create_rect(back, 10, 10, 50, 50);
+    lv_obj_move_background(child);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(0, back_draw_cnt);
+    lv_refr_get_occlusion_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.culled_cnt);
+
+    /*Not covered by an object behind it*/
+    lv_obj_set_parent(front, lv_scr_act());
+    lv_obj_set_pos(front, 50, 50);
+    lv_obj_set_size(front, 300, 200);
+    lv_obj_move_background(front);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(1, back_draw_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, back_post_cnt);
+}
+
+void test_refr_occlusion_trim(void)
+{
+    /*Only the bottom 40 rows are visible*/
+    lv_obj_set_height(front, 110);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(1, back_draw_cnt);
+    TEST_ASSERT_EQUAL_INT(160, back_clip_area.y1);
+    TEST_ASSERT_EQUAL_INT(199, back_clip_area.y2);
+    TEST_ASSERT_EQUAL_INT(100, back_clip_area.x1);
+    TEST_ASSERT_EQUAL_INT(299, back_clip_area.x2);
+
+    /*Two objects cover it together*/
+    lv_obj_t * front2 = create_rect(lv_scr_act(), 50, 160, 300, 40);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(0, back_draw_cnt);
+    lv_obj_del(front2);
+
+    /*In the middle only: can't be trimmed to a rectangle*/
+    lv_obj_set_pos(front, 150, 50);
+    lv_obj_set_width(front, 100);
+    lv_obj_set_height(front, 300);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(1, back_draw_cnt);
+    TEST_ASSERT_EQUAL_INT(100, back_clip_area.x1);
+    TEST_ASSERT_EQUAL_INT(299, back_clip_area.x2);
+}
+
+void test_refr_occlusion_not_opaque(void)
+{
+    /*Rounded corners over the object*/
+    lv_obj_set_style_radius(front, 60, 0);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(1, back_draw_cnt);
+
+    /*The corners are out of the object*/
+    lv_obj_set_style_radius(front, 10, 0);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(0, back_draw_cnt);
+    lv_obj_set_style_radius(front, 0, 0);
+
+    lv_obj_set_style_bg_opa(front, LV_OPA_90, 0);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(1, back_draw_cnt);
+    lv_obj_set_style_bg_opa(front, LV_OPA_COVER, 0);
+
+    lv_obj_set_style_transform_angle(front, 100, 0);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(1, back_draw_cnt);
+    lv_obj_set_style_transform_angle(front, 0, 0);
+
+    /*Children masked by the rounded corners of their parent*/
+    lv_obj_t * parent = create_rect(lv_scr_act(), 0, 0, 400, 300);
+    lv_obj_set_style_radius(parent, 20, 0);
+    lv_obj_set_style_clip_corner(parent, true, 0);
+    lv_obj_set_style_bg_opa(parent, LV_OPA_TRANSP, 0);
+    lv_obj_set_parent(front, parent);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(1, back_draw_cnt);
+
+    lv_obj_add_flag(parent, LV_OBJ_FLAG_HIDDEN);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(1, back_draw_cnt);
+}
+
+void test_refr_occlusion_layer_cache(void)
+{
+#if LV_LAYER_CACHE_SIZE
+    /*A cached layer covers too*/
+    lv_obj_add_flag(front, LV_OBJ_FLAG_LAYER_CACHE);
+    refr();
+    TEST_ASSERT_EQUAL_UINT32(0, back_draw_cnt);
+
+    /*The drawing starts inside a cached layer: objects in front of `back` are drawn*/
+    lv_obj_t * card = create_rect(lv_scr_act(), 0, 0, 400, 300);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_LAYER_CACHE);
+    lv_obj_set_parent(back, card);
+    lv_obj_set_parent(front, card);
+    lv_obj_set_pos(front, 250, 50);
+    lv_obj_set_size(front, 100, 100);
+    lv_refr_now(NULL);
+
+    lv_area_t a;
+    lv_area_set(&a, 150, 120, 280, 180);
+    back_draw_cnt = 0;
+    lv_refr_reset_occlusion_stat();
+    lv_obj_invalidate_area(back, &a);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, back_draw_cnt);
+
+    lv_refr_occlusion_stat_t stat;
+    lv_refr_get_occlusion_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.culled_cnt);
+#endif
+}
+
+void test_refr_occlusion_snapshot(void)
+{
+    /*Drawing outside of the refreshing is not culled*/
+    back_draw_cnt = 0;
+    lv_img_dsc_t * snapshot = lv_snapshot_take(lv_scr_act(), LV_IMG_CF_TRUE_COLOR);
+    TEST_ASSERT_NOT_NULL(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(1, back_draw_cnt);
+    lv_snapshot_free(snapshot);
+}
+
+#else /*LV_REFR_OCCLUSION_CULL*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_refr_occlusion_cull_covered(void)
+{
+
+}
+
+void test_refr_occlusion_trim(void)
+{
+
+}
+
+void test_refr_occlusion_not_opaque(void)
+{
+
+}
+
+void test_refr_occlusion_layer_cache(void)
+{
+
+}
+
+void test_refr_occlusion_snapshot(void)
+{
+
+}
+
+#endif
+
+#endif
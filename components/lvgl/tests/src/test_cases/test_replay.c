@@ -0,0 +1,303 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_REPLAY && LV_USE_MONKEY
+
+#include <string.h>
+
+#define EVENT_SIZE_POINTER  9
+#define HEADER_SIZE         8
+#define LOG_MAX             8192
+
+static lv_monkey_t * monkey;
+static lv_replay_rec_t * rec;
+static uint8_t log_buf[LOG_MAX];
+static uint32_t log_size;
+static uint32_t click_cnt[3];
+
+static lv_monkey_t * monkey_create(lv_indev_type_t type, uint32_t seed)
+{
+    lv_monkey_config_t config;
+    lv_monkey_config_init(&config);
+    config.type = type;
+    config.input_range.min = -5;
+    config.input_range.max = 5;
+    config.seed = seed;
+    return lv_monkey_create(&config);
+}
+
+/*Let the monkey generate the next input and read it with its input device*/
+static void monkey_step(lv_monkey_t * m, uint32_t step_cnt)
+{
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer && timer->user_data != m) timer = lv_timer_get_next(timer);
+    TEST_ASSERT_NOT_NULL(timer);
+
+    uint32_t i;
+    for(i = 0; i < step_cnt; i++) {
+        timer->timer_cb(timer);
+        lv_indev_read_timer_cb(lv_monkey_get_indev(m)->driver->read_timer);
+    }
+}
+
+static void rec_save_and_stop(void)
+{
+    const uint8_t * data = lv_replay_rec_get_data(rec, &log_size);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LOG_MAX, log_size);
+    lv_memcpy(log_buf, data, log_size);
+    lv_replay_rec_stop(rec);
+    rec = NULL;
+}
+
+/*Compare the events of two logs without their time*/
+static bool same_events(const uint8_t * log1, uint32_t size1, const uint8_t * log2, uint32_t size2,
+                        uint32_t event_size)
+{
+    if(size1 != size2) return false;
+    if(memcmp(log1, log2, HEADER_SIZE) != 0) return false;
+
+    uint32_t i;
+    for(i = HEADER_SIZE; i < size1; i += event_size) {
+        if(memcmp(log1 + i + 4, log2 + i + 4, event_size - 4) != 0) return false;
+    }
+    return true;
+}
+
+static void click_event_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
+void setUp(void)
+{
+    monkey = NULL;
+    rec = NULL;
+    lv_memset_00(click_cnt, sizeof(click_cnt));
+}
+
+void tearDown(void)
+{
+    if(rec) lv_replay_rec_stop(rec);
+    if(monkey) lv_monkey_del(monkey);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_replay_monkey_with_the_same_seed_generates_the_same_input(void)
+{
+    static uint8_t log_ref[LOG_MAX];
+    uint32_t log_ref_size;
+
+    monkey = monkey_create(LV_INDEV_TYPE_POINTER, 1234);
+    TEST_ASSERT_EQUAL_UINT32(1234, lv_monkey_get_seed(monkey));
+    rec = lv_replay_rec_start(lv_monkey_get_indev(monkey));
+    monkey_step(monkey, 100);
+    rec_save_and_stop();
+    lv_monkey_del(monkey);
+    lv_memcpy(log_ref, log_buf, log_size);
+    log_ref_size = log_size;
+
+    /*Other users of lv_rand() don't change the sequence*/
+    lv_rand(0, 100);
+
+    monkey = monkey_create(LV_INDEV_TYPE_POINTER, 1234);
+    rec = lv_replay_rec_start(lv_monkey_get_indev(monkey));
+    monkey_step(monkey, 100);
+    rec_save_and_stop();
+    lv_monkey_del(monkey);
+    TEST_ASSERT_TRUE(same_events(log_ref, log_ref_size, log_buf, log_size, EVENT_SIZE_POINTER));
+
+    monkey = monkey_create(LV_INDEV_TYPE_POINTER, 4321);
+    rec = lv_replay_rec_start(lv_monkey_get_indev(monkey));
+    monkey_step(monkey, 100);
+    rec_save_and_stop();
+    lv_monkey_del(monkey);
+    TEST_ASSERT_FALSE(same_events(log_ref, log_ref_size, log_buf, log_size, EVENT_SIZE_POINTER));
+
+    /*A random seed is reported to repeat the run later*/
+    monkey = monkey_create(LV_INDEV_TYPE_POINTER, 0);
+    TEST_ASSERT_NOT_EQUAL(0, lv_monkey_get_seed(monkey));
+}
+
+void test_replay_reproduces_the_clicks_of_a_monkey(void)
+{
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_t * btn = lv_btn_create(lv_scr_act());
+        lv_obj_set_size(btn, lv_pct(30), lv_pct(80));
+        lv_obj_align(btn, LV_ALIGN_LEFT_MID, lv_pct(i * 33), 0);
+        lv_obj_add_event_cb(btn, click_event_cb, LV_EVENT_CLICKED, &click_cnt[i]);
+    }
+    lv_obj_update_layout(lv_scr_act());
+
+    monkey = monkey_create(LV_INDEV_TYPE_POINTER, 42);
+    rec = lv_replay_rec_start(lv_monkey_get_indev(monkey));
+    monkey_step(monkey, 300);
+    rec_save_and_stop();
+    lv_monkey_del(monkey);
+    monkey = NULL;
+
+    uint32_t click_cnt_ref[3];
+    lv_memcpy(click_cnt_ref, click_cnt, sizeof(click_cnt));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, click_cnt_ref[0] + click_cnt_ref[1] + click_cnt_ref[2]);
+    lv_memset_00(click_cnt, sizeof(click_cnt));
+
+    lv_replay_t * replay = lv_replay_create(log_buf, log_size);
+    TEST_ASSERT_NOT_NULL(replay);
+    TEST_ASSERT_EQUAL_UINT32((log_size - HEADER_SIZE) / EVENT_SIZE_POINTER, lv_replay_get_event_cnt(replay));
+
+    lv_replay_stat_t stat;
+    lv_replay_run(replay, &stat);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(click_cnt_ref, click_cnt, 3);
+
+    TEST_ASSERT_EQUAL_UINT32(lv_replay_get_event_cnt(replay), stat.event_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stat.latency_max, stat.latency_avg);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stat.frame_time_max, stat.frame_time_avg);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stat.latency_avg, stat.frame_time_avg);
+    TEST_ASSERT_LESS_THAN_UINT32(stat.event_cnt, stat.latency_max_index);
+
+    /*No more events*/
+    TEST_ASSERT_FALSE(lv_replay_step(replay, NULL));
+    lv_replay_del(replay);
+}
+
+void test_replay_reads_the_same_data_as_recorded(void)
+{
+    static uint8_t log_ref[LOG_MAX];
+    const lv_indev_type_t types[] = {LV_INDEV_TYPE_POINTER, LV_INDEV_TYPE_KEYPAD, LV_INDEV_TYPE_ENCODER};
+    const uint32_t event_sizes[] = {9, 9, 7};
+
+    uint32_t t;
+    for(t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        monkey = monkey_create(types[t], 7);
+        rec = lv_replay_rec_start(lv_monkey_get_indev(monkey));
+        monkey_step(monkey, 100);
+        rec_save_and_stop();
+        lv_monkey_del(monkey);
+        monkey = NULL;
+        lv_memcpy(log_ref, log_buf, log_size);
+        uint32_t log_ref_size = log_size;
+
+        /*Record the input device of the replay too*/
+        lv_replay_t * replay = lv_replay_create(log_ref, log_ref_size);
+        TEST_ASSERT_NOT_NULL(replay);
+        rec = lv_replay_rec_start(lv_replay_get_indev(replay));
+        while(lv_replay_step(replay, NULL));
+        rec_save_and_stop();
+        lv_replay_del(replay);
+
+        TEST_ASSERT_TRUE(same_events(log_ref, log_ref_size, log_buf, log_size, event_sizes[t]));
+    }
+}
+
+void test_replay_log_saved_to_file(void)
+{
+    monkey = monkey_create(LV_INDEV_TYPE_POINTER, 99);
+    rec = lv_replay_rec_start(lv_monkey_get_indev(monkey));
+    monkey_step(monkey, 50);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_replay_rec_save(rec, "A:/tmp/lv_test_replay.lvrp"));
+    rec_save_and_stop();
+
+    lv_replay_t * replay = lv_replay_create_from_file("A:/tmp/lv_test_replay.lvrp");
+    TEST_ASSERT_NOT_NULL(replay);
+    TEST_ASSERT_EQUAL_UINT32((log_size - HEADER_SIZE) / EVENT_SIZE_POINTER, lv_replay_get_event_cnt(replay));
+    lv_replay_del(replay);
+}
+
+void test_replay_records_an_input_device_only_once(void)
+{
+    monkey = monkey_create(LV_INDEV_TYPE_POINTER, 1234);
+    lv_indev_t * indev = lv_monkey_get_indev(monkey);
+    rec = lv_replay_rec_start(indev);
+    TEST_ASSERT_NOT_NULL(rec);
+    TEST_ASSERT_NULL(lv_replay_rec_start(indev));
+
+    /*The single recorder still works and restores the original read callback*/
+    monkey_step(monkey, 10);
+    rec_save_and_stop();
+    TEST_ASSERT_GREATER_THAN_UINT32(HEADER_SIZE, log_size);
+
+    rec = lv_replay_rec_start(indev);
+    TEST_ASSERT_NOT_NULL(rec);
+}
+
+void test_replay_monkey_full_input_range(void)
+{
+    lv_monkey_config_t config;
+    lv_monkey_config_init(&config);
+    config.type = LV_INDEV_TYPE_ENCODER;
+    config.input_range.min = INT32_MIN;
+    config.input_range.max = INT32_MAX;
+    config.seed = 1234;
+    monkey = lv_monkey_create(&config);
+
+    /*The span of the range doesn't fit in 32 bit*/
+    rec = lv_replay_rec_start(lv_monkey_get_indev(monkey));
+    monkey_step(monkey, 10);
+    rec_save_and_stop();
+    TEST_ASSERT_GREATER_THAN_UINT32(HEADER_SIZE, log_size);
+}
+
+void test_replay_rejects_invalid_logs(void)
+{
+    static const uint8_t not_a_log[] = {'L', 'V', 'X', 'X', 1, LV_INDEV_TYPE_POINTER, 0, 0};
+    TEST_ASSERT_NULL(lv_replay_create(not_a_log, sizeof(not_a_log)));
+
+    static const uint8_t truncated_log[] = {'L', 'V', 'R', 'P', 1, LV_INDEV_TYPE_POINTER, 0, 0, 1, 2, 3};
+    TEST_ASSERT_NULL(lv_replay_create(truncated_log, sizeof(truncated_log)));
+
+    TEST_ASSERT_NULL(lv_replay_create_from_file("A:/tmp/lv_test_replay_missing.lvrp"));
+}
+
+#else /*LV_USE_REPLAY && LV_USE_MONKEY*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_replay_monkey_with_the_same_seed_generates_the_same_input(void)
+{
+
+}
+
+void test_replay_reproduces_the_clicks_of_a_monkey(void)
+{
+
+}
+
+void test_replay_reads_the_same_data_as_recorded(void)
+{
+
+}
+
+void test_replay_log_saved_to_file(void)
+{
+
+}
+
+void test_replay_records_an_input_device_only_once(void)
+{
+
+}
+
+void test_replay_monkey_full_input_range(void)
+{
+
+}
+
+void test_replay_rejects_invalid_logs(void)
+{
+
+}
+
+#endif
+
+#endif
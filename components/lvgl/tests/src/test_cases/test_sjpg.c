@@ -0,0 +1,217 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_SJPG
+
+/*40x24 px grayscale JPG of 8x8 px blocks with constant colors*/
+static const uint8_t jpg_data[] = {
+    0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+    0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xff, 0xc0, 0x00, 0x0b, 0x08, 0x00, 0x18,
+    0x00, 0x28, 0x01, 0x01, 0x11, 0x00, 0xff, 0xc4, 0x00, 0x1f, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04,
+    0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0x14, 0x10, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xda, 0x00,
+    0x08, 0x01, 0x01, 0x00, 0x00, 0x3f, 0x00, 0xfe, 0x4f, 0xdf, 0x78, 0x3e, 0xf0, 0x7d, 0xe0, 0xfb,
+    0xc1, 0xfc, 0xe7, 0xbe, 0xf0, 0x7d, 0xe0, 0xfb, 0xc1, 0xf7, 0x83, 0xf9, 0xcf, 0x7d, 0xe0, 0xfb,
+    0xc1, 0xf7, 0x83, 0xfc, 0xab, 0xdf, 0xff, 0xd9,
+};
+/*The same image as an SJPG with 8 px high fragments*/
+static const uint8_t sjpg_data[] = {
+    0x5f, 0x53, 0x4a, 0x50, 0x47, 0x5f, 0x5f, 0x00, 0x56, 0x31, 0x2e, 0x30, 0x30, 0x00, 0x28, 0x00,
+    0x18, 0x00, 0x03, 0x00, 0x08, 0x00, 0xb3, 0x00, 0xb3, 0x00, 0xb3, 0x00, 0xff, 0xd8, 0xff, 0xe0,
+    0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00,
+    0xff, 0xdb, 0x00, 0x43, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0xff, 0xc0, 0x00, 0x0b, 0x08, 0x00, 0x08, 0x00, 0x28, 0x01, 0x01,
+    0x11, 0x00, 0xff, 0xc4, 0x00, 0x1f, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+    0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0x14, 0x10, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xda, 0x00, 0x08, 0x01, 0x01, 0x00,
+    0x00, 0x3f, 0x00, 0xfe, 0x4f, 0xdf, 0x78, 0x3e, 0xf0, 0x7d, 0xe0, 0xfb, 0xc1, 0xff, 0xd9, 0xff,
+    0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00,
+    0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xff, 0xc0, 0x00, 0x0b, 0x08, 0x00, 0x08, 0x00,
+    0x28, 0x01, 0x01, 0x11, 0x00, 0xff, 0xc4, 0x00, 0x1f, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0x14, 0x10, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xda, 0x00, 0x08,
+    0x01, 0x01, 0x00, 0x00, 0x3f, 0x00, 0xfc, 0xcf, 0x7d, 0xe0, 0xfb, 0xc1, 0xf7, 0x83, 0xef, 0x07,
+    0xff, 0xd9, 0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00,
+    0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xff, 0xc0, 0x00, 0x0b, 0x08,
+    0x00, 0x08, 0x00, 0x28, 0x01, 0x01, 0x11, 0x00, 0xff, 0xc4, 0x00, 0x1f, 0x00, 0x00, 0x01, 0x05,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02,
+    0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0x14, 0x10, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
+    0xda, 0x00, 0x08, 0x01, 0x01, 0x00, 0x00, 0x3f, 0x00, 0xf6, 0x07, 0xde, 0x0f, 0xbc, 0x1f, 0x78,
+    0x3f, 0xca, 0xbd, 0xff, 0xd9,
+};
+
+static const uint8_t block_vals[3][5] = {
+    {40, 70, 100, 130, 160},
+    {90, 120, 150, 180, 210},
+    {140, 170, 200, 230, 60},
+};
+
+static lv_img_dsc_t img_dsc;
+
+static void img_dsc_init(const uint8_t * data, uint32_t data_size, lv_coord_t w, lv_coord_t h)
+{
+    lv_memset_00(&img_dsc, sizeof(img_dsc));
+    img_dsc.header.cf = LV_IMG_CF_RAW;
+    img_dsc.header.w = w;
+    img_dsc.header.h = h;
+    img_dsc.data = data;
+    img_dsc.data_size = data_size;
+}
+
+static void assert_line(lv_img_decoder_dsc_t * dsc, lv_coord_t y, uint32_t scale)
+{
+    lv_color_t buf[40];
+    lv_coord_t w = 40 >> scale;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(dsc, 0, y, w, (uint8_t *)buf));
+
+    lv_coord_t x;
+    for(x = 0; x < w; x++) {
+        uint8_t v = block_vals[(y << scale) / 8][(x << scale) / 8];
+        TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_color_make(v, v, v)), lv_color_to32(buf[x]));
+    }
+}
+
+/*Decode the image of `img_dsc` and check all the lines in order and in reverse order too*/
+static void assert_decoded(uint32_t scale)
+{
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info(&img_dsc, &header));
+    TEST_ASSERT_EQUAL_INT(40 >> scale, header.w);
+    TEST_ASSERT_EQUAL_INT(24 >> scale, header.h);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL_INT(40 >> scale, dsc.header.w);
+    TEST_ASSERT_EQUAL_INT(24 >> scale, dsc.header.h);
+
+    lv_coord_t y;
+    for(y = 0; y < header.h; y++) assert_line(&dsc, y, scale);
+    for(y = header.h - 1; y >= 0; y--) assert_line(&dsc, y, scale);
+
+    lv_img_decoder_close(&dsc);
+}
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_sjpg_jpg_is_decoded_to_lv_color(void)
+{
+    img_dsc_init(jpg_data, sizeof(jpg_data), 40, 24);
+    assert_decoded(0);
+}
+
+void test_sjpg_jpg_is_scaled_down_to_the_header(void)
+{
+    img_dsc_init(jpg_data, sizeof(jpg_data), 20, 12);
+    assert_decoded(1);
+
+    img_dsc_init(jpg_data, sizeof(jpg_data), 10, 6);
+    assert_decoded(2);
+
+    /*Never smaller than the header*/
+    img_dsc_init(jpg_data, sizeof(jpg_data), 8, 3);
+    assert_decoded(2);
+
+    img_dsc_init(jpg_data, sizeof(jpg_data), 1, 1);
+    assert_decoded(3);
+}
+
+void test_sjpg_sjpg_is_decoded_to_lv_color(void)
+{
+    img_dsc_init(sjpg_data, sizeof(sjpg_data), 40, 24);
+    assert_decoded(0);
+}
+
+void test_sjpg_sjpg_is_scaled_down_to_the_header(void)
+{
+    img_dsc_init(sjpg_data, sizeof(sjpg_data), 20, 12);
+    assert_decoded(1);
+
+    img_dsc_init(sjpg_data, sizeof(sjpg_data), 5, 3);
+    assert_decoded(3);
+}
+
+void test_sjpg_line_in_the_middle_of_a_row(void)
+{
+    img_dsc_init(jpg_data, sizeof(jpg_data), 40, 24);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+
+    lv_color_t buf[10];
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 15, 20, 10, (uint8_t *)buf));
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_color_make(170, 170, 170)), lv_color_to32(buf[0]));
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_color_make(200, 200, 200)), lv_color_to32(buf[1]));
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_color_make(230, 230, 230)), lv_color_to32(buf[9]));
+
+    lv_img_decoder_close(&dsc);
+}
+
+#else /*LV_USE_SJPG*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_sjpg_jpg_is_decoded_to_lv_color(void)
+{
+
+}
+
+void test_sjpg_jpg_is_scaled_down_to_the_header(void)
+{
+
+}
+
+void test_sjpg_sjpg_is_decoded_to_lv_color(void)
+{
+
+}
+
+void test_sjpg_sjpg_is_scaled_down_to_the_header(void)
+{
+
+}
+
+void test_sjpg_line_in_the_middle_of_a_row(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -4,9 +4,74 @@
 #if LV_USE_SNAPSHOT
 
 #include "unity/unity.h"
+#include "../../../src/extra/libs/png/lodepng.h"
 
 #define NUM_SNAPSHOTS 1
 
+static lv_obj_t * create_panel(void)
+{
+    lv_obj_t * panel = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(panel, 300, 200);
+    lv_obj_set_pos(panel, 40, 30);
+    lv_obj_set_style_bg_grad_color(panel, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_dir(panel, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t * btn = lv_btn_create(panel);
+    lv_obj_set_size(btn, 120, 50);
+    lv_obj_align(btn, LV_ALIGN_TOP_LEFT, 0, 20);
+
+    lv_obj_t * label = lv_label_create(panel);
+    lv_label_set_text(label, "23.5 \xC2\xB0""C\nHumidity 48 %");
+    lv_obj_align(label, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+
+    lv_obj_t * arc = lv_arc_create(panel);
+    lv_obj_set_size(arc, 90, 90);
+    lv_obj_align(arc, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+
+    return panel;
+}
+
+static unsigned char * decode_png(const char * path, unsigned * w, unsigned * h)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+    uint32_t size;
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, &size);
+    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+    uint8_t * data = lv_mem_alloc(size);
+    uint32_t br;
+    lv_fs_read(&f, data, size, &br);
+    lv_fs_close(&f);
+    TEST_ASSERT_EQUAL_UINT32(size, br);
+
+    unsigned char * img = NULL;
+    TEST_ASSERT_EQUAL_UINT32(0, lodepng_decode24(&img, w, h, data, size));
+    lv_mem_free(data);
+    return img;
+}
+
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(disp_drv);
+}
+
+/*Compare a decoded PNG with a true color snapshot*/
+static void assert_png_same_as_snapshot(const unsigned char * img, const lv_img_dsc_t * dsc)
+{
+    const lv_color_t * px = (const lv_color_t *)dsc->data;
+    uint32_t i;
+    for(i = 0; i < (uint32_t)dsc->header.w * dsc->header.h; i++) {
+        lv_color32_t c32;
+        c32.full = lv_color_to32(px[i]);
+        if(img[i * 3] != c32.ch.red || img[i * 3 + 1] != c32.ch.green || img[i * 3 + 2] != c32.ch.blue) {
+            TEST_FAIL_MESSAGE("pixels differ");
+        }
+    }
+}
+
 void test_snapshot_should_not_leak_memory(void)
 {
     uint32_t idx = 0;
@@ -34,6 +99,105 @@ void test_snapshot_should_not_leak_memory(void)
     TEST_ASSERT_EQUAL(initial_available_memory, final_available_memory);
 }
 
+void test_snapshot_save_png_in_strips(void)
+{
+    lv_obj_t * panel = create_panel();
+    lv_img_dsc_t * ref = lv_snapshot_take(panel, LV_IMG_CF_TRUE_COLOR);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    /*7 lines at once, the last strip is shorter*/
+    static lv_color_t strip[300 * 7];
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_snapshot_save_png(panel, "A:/tmp/lv_test_snapshot.png", strip, sizeof(strip)));
+
+    unsigned w;
+    unsigned h;
+    unsigned char * img = decode_png("A:/tmp/lv_test_snapshot.png", &w, &h);
+    TEST_ASSERT_EQUAL_UINT32(ref->header.w, w);
+    TEST_ASSERT_EQUAL_UINT32(ref->header.h, h);
+    assert_png_same_as_snapshot(img, ref);
+    lv_mem_free(img);
+
+    /*Too small buffer*/
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_snapshot_save_png(panel, "A:/tmp/lv_test_snapshot.png", strip,
+                                                       299 * sizeof(lv_color_t)));
+
+    lv_snapshot_free(ref);
+    lv_obj_del(panel);
+}
+
+void test_snapshot_save_png_with_the_draw_buffer_keeps_the_display(void)
+{
+    lv_obj_t * panel = create_panel();
+    lv_img_dsc_t * ref = lv_snapshot_take(panel, LV_IMG_CF_TRUE_COLOR);
+    lv_refr_now(NULL);
+
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_snapshot_save_png(panel, "A:/tmp/lv_test_snapshot.png", NULL, 0));
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+
+    /*Nothing is kept allocated apart from what the draw caches store on the first run*/
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+    uint32_t free_size = monitor.free_size;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_snapshot_save_png(panel, "A:/tmp/lv_test_snapshot.png", NULL, 0));
+
+    lv_mem_monitor(&monitor);
+    TEST_ASSERT_EQUAL_UINT32(free_size, monitor.free_size);
+
+    unsigned w;
+    unsigned h;
+    unsigned char * img = decode_png("A:/tmp/lv_test_snapshot.png", &w, &h);
+    assert_png_same_as_snapshot(img, ref);
+    lv_mem_free(img);
+
+    lv_snapshot_free(ref);
+    lv_obj_del(panel);
+}
+
+void test_snapshot_save_png_of_the_screen_has_the_top_layer(void)
+{
+    /*A small display whose draw buffer is used for 10 lines at once*/
+    static lv_color_t buf[100 * 10];
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, 100 * 10);
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = 100;
+    drv.ver_res = 80;
+    lv_disp_t * def_disp = lv_disp_get_default();
+    lv_disp_t * disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(def_disp);
+
+    lv_obj_t * obj = lv_obj_create(lv_disp_get_layer_top(disp));
+    lv_obj_set_pos(obj, 10, 10);
+    lv_obj_set_size(obj, 40, 40);
+    lv_obj_set_style_bg_color(obj, lv_color_make(0xff, 0x00, 0x00), 0);
+    lv_obj_set_style_border_width(obj, 0, 0);
+
+    lv_obj_t * scr = lv_disp_get_scr_act(disp);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_snapshot_save_png(scr, "A:/tmp/lv_test_snapshot.png", NULL, 0));
+
+    unsigned w;
+    unsigned h;
+    unsigned char * img = decode_png("A:/tmp/lv_test_snapshot.png", &w, &h);
+    TEST_ASSERT_EQUAL_UINT32(100, w);
+    TEST_ASSERT_EQUAL_UINT32(80, h);
+
+    uint32_t i = (30 * w + 30) * 3;
+    TEST_ASSERT_EQUAL_UINT8(0xff, img[i]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, img[i + 1]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, img[i + 2]);
+    lv_mem_free(img);
+
+    lv_disp_remove(disp);
+    drv.draw_ctx_deinit(&drv, drv.draw_ctx);
+    lv_mem_free(drv.draw_ctx);
+}
+
 #else /*LV_USE_SNAPSHOT*/
 
 void test_snapshot_should_not_leak_memory(void)
@@ -41,6 +205,21 @@ void test_snapshot_should_not_leak_memory(void)
 
 }
 
+void test_snapshot_save_png_in_strips(void)
+{
+
+}
+
+void test_snapshot_save_png_with_the_draw_buffer_keeps_the_display(void)
+{
+
+}
+
+void test_snapshot_save_png_of_the_screen_has_the_top_layer(void)
+{
+
+}
+
 #endif
 
 #endif
@@ -106,4 +106,74 @@ void test_inherit_meta_with_lower_precedence_style(void)
     TEST_ASSERT_EQUAL_HEX(lv_color_hex(0xff0000).full, lv_obj_get_style_text_color(grandchild, LV_PART_MAIN).full);
 }
 
+void test_style_sorted_props(void)
+{
+    /*Set in mixed order, with a custom property too*/
+    const lv_style_prop_t props[] = {LV_STYLE_TEXT_FONT, LV_STYLE_BG_COLOR, LV_STYLE_WIDTH, LV_STYLE_PAD_TOP,
+                                     _LV_STYLE_NUM_BUILT_IN_PROPS + 5, LV_STYLE_RADIUS, LV_STYLE_BORDER_WIDTH,
+                                     LV_STYLE_TRANSFORM_ZOOM, LV_STYLE_X, _LV_STYLE_LAST_BUILT_IN_PROP
+                                    };
+    const uint32_t cnt = sizeof(props) / sizeof(props[0]);
+
+    lv_style_t style;
+    lv_style_init(&style);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_style_value_t v = {.num = 100 + i};
+        lv_style_set_prop(&style, props[i], v);
+    }
+    TEST_ASSERT_EQUAL(cnt, style.prop_cnt);
+
+    /*Overwriting doesn't add a new property*/
+    lv_style_value_t v = {.num = 5};
+    lv_style_set_prop(&style, LV_STYLE_WIDTH, v);
+    TEST_ASSERT_EQUAL(cnt, style.prop_cnt);
+
+    lv_style_prop_t p;
+    for(p = 1; p <= _LV_STYLE_NUM_BUILT_IN_PROPS + 10; p++) {
+        int32_t idx = -1;
+        for(i = 0; i < cnt; i++) {
+            if(props[i] == p) idx = i;
+        }
+
+        lv_style_res_t res = lv_style_get_prop(&style, p, &v);
+        if(idx < 0) {
+            TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, res);
+        }
+        else {
+            TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, res);
+            TEST_ASSERT_EQUAL(p == LV_STYLE_WIDTH ? 5 : 100 + idx, v.num);
+        }
+    }
+
+    lv_style_set_prop_meta(&style, LV_STYLE_RADIUS, LV_STYLE_PROP_META_INHERIT);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_INHERIT, lv_style_get_prop(&style, LV_STYLE_RADIUS, &v));
+    lv_style_set_prop_meta(&style, LV_STYLE_OPA, LV_STYLE_PROP_META_INITIAL);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_OPA, &v));
+    TEST_ASSERT_EQUAL(LV_OPA_COVER, v.num);
+
+    /*The others are still found after removing some*/
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_OPA));
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_BG_COLOR));
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, _LV_STYLE_NUM_BUILT_IN_PROPS + 5));
+    TEST_ASSERT_FALSE(lv_style_remove_prop(&style, LV_STYLE_BG_COLOR));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_BG_COLOR, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, _LV_STYLE_NUM_BUILT_IN_PROPS + 5, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, _LV_STYLE_LAST_BUILT_IN_PROP, &v));
+    TEST_ASSERT_EQUAL(100 + cnt - 1, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_X, &v));
+    TEST_ASSERT_EQUAL(108, v.num);
+
+    /*Down to a single property stored in the style itself*/
+    const lv_style_prop_t to_remove[] = {LV_STYLE_PAD_TOP, LV_STYLE_TEXT_FONT, LV_STYLE_WIDTH, LV_STYLE_RADIUS,
+                                         LV_STYLE_BORDER_WIDTH, LV_STYLE_TRANSFORM_ZOOM, LV_STYLE_X
+                                        };
+    for(i = 0; i < sizeof(to_remove) / sizeof(to_remove[0]); i++) {
+        TEST_ASSERT_TRUE(lv_style_remove_prop(&style, to_remove[i]));
+    }
+    TEST_ASSERT_EQUAL(1, style.prop_cnt);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, _LV_STYLE_LAST_BUILT_IN_PROP, &v));
+    lv_style_reset(&style);
+}
+
 #endif
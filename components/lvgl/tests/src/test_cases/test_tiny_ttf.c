@@ -13,6 +13,18 @@ void tearDown(void)
     /* Function run after every test */
 }
 
+#if LV_USE_TINY_TTF
+static void assert_glyph_dsc_equal(const lv_font_glyph_dsc_t * expected, const lv_font_glyph_dsc_t * actual)
+{
+    TEST_ASSERT_EQUAL(expected->adv_w, actual->adv_w);
+    TEST_ASSERT_EQUAL(expected->box_w, actual->box_w);
+    TEST_ASSERT_EQUAL(expected->box_h, actual->box_h);
+    TEST_ASSERT_EQUAL(expected->ofs_x, actual->ofs_x);
+    TEST_ASSERT_EQUAL(expected->ofs_y, actual->ofs_y);
+    TEST_ASSERT_EQUAL(expected->bpp, actual->bpp);
+}
+#endif
+
 void test_tiny_ttf_rendering_test(void)
 {
 #if LV_USE_TINY_TTF
@@ -46,4 +58,112 @@ void test_tiny_ttf_rendering_test(void)
 #endif
 }
 
+void test_tiny_ttf_fonts_of_the_same_data_share_the_glyphs(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font_30 = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 30);
+
+    lv_font_glyph_dsc_t ref_dsc;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_30, &ref_dsc, 'A', 'V'));
+    static uint8_t ref_bitmap[64 * 64];
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(ref_bitmap), ref_dsc.box_w * ref_dsc.box_h);
+    lv_memcpy(ref_bitmap, lv_font_get_glyph_bitmap(font_30, 'A'), ref_dsc.box_w * ref_dsc.box_h);
+
+    /*The glyphs of an other size are cached separately*/
+    lv_font_t * font_20 = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 20);
+    lv_font_glyph_dsc_t dsc;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_20, &dsc, 'A', 'V'));
+    TEST_ASSERT_LESS_THAN(ref_dsc.box_h, dsc.box_h);
+    TEST_ASSERT_LESS_THAN(ref_dsc.adv_w, dsc.adv_w);
+    TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(font_20, 'A'));
+
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_30, &dsc, 'A', 'V'));
+    assert_glyph_dsc_equal(&ref_dsc, &dsc);
+    TEST_ASSERT_EQUAL_MEMORY(ref_bitmap, lv_font_get_glyph_bitmap(font_30, 'A'), ref_dsc.box_w * ref_dsc.box_h);
+
+    /*The same glyph with an other next letter (the Ubuntu Mono test font has no kerning)*/
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_30, &dsc, 'A', 'A'));
+    TEST_ASSERT_EQUAL(ref_dsc.box_w, dsc.box_w);
+
+    /*The other font keeps working after one of them is destroyed*/
+    lv_tiny_ttf_destroy(font_30);
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_20, &dsc, 'B', 0));
+    TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(font_20, 'B'));
+    TEST_ASSERT_FALSE(font_20->get_glyph_dsc(font_20, &dsc, 0x10FFF0, 0));
+
+    lv_tiny_ttf_destroy(font_20);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_kerning_narrows_the_pairs(void)
+{
+#if LV_USE_TINY_TTF && LV_TINY_TTF_FILE_SUPPORT
+    /*Arial has a `kern` table. (stb_truetype doesn't read the GPOS pair lookups of Lato or DejaVu.)*/
+    lv_font_t * font = lv_tiny_ttf_create_file("A:../src/extra/libs/freetype/arial.ttf", 30);
+    TEST_ASSERT_NOT_NULL(font);
+
+    /*"AV" is kerned, "AA" is not*/
+    lv_font_glyph_dsc_t alone_dsc;
+    lv_font_glyph_dsc_t dsc;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &alone_dsc, 'A', 0));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &dsc, 'A', 'V'));
+    TEST_ASSERT_LESS_THAN(alone_dsc.adv_w, dsc.adv_w);
+    TEST_ASSERT_EQUAL(alone_dsc.box_w, dsc.box_w);
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &dsc, 'A', 'A'));
+    TEST_ASSERT_EQUAL(alone_dsc.adv_w, dsc.adv_w);
+
+    /*The same from the kerning cache, and in the width of a text*/
+    lv_font_glyph_dsc_t kerned_dsc;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &kerned_dsc, 'A', 'V'));
+    TEST_ASSERT_LESS_THAN(alone_dsc.adv_w, kerned_dsc.adv_w);
+    lv_coord_t a_w = lv_txt_get_width("A", 1, font, 0, LV_TEXT_FLAG_NONE);
+    lv_coord_t v_w = lv_txt_get_width("V", 1, font, 0, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL(a_w + v_w - (alone_dsc.adv_w - kerned_dsc.adv_w),
+                      lv_txt_get_width("AV", 2, font, 0, LV_TEXT_FLAG_NONE));
+
+    lv_tiny_ttf_destroy(font);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_set_size_uses_the_glyphs_of_the_new_size(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data_ex(ubuntu_font, ubuntu_font_size, 30, 1024);
+
+    lv_font_glyph_dsc_t ref_dsc;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &ref_dsc, 'H', 0));
+    lv_coord_t ref_line_height = lv_font_get_line_height(font);
+
+    lv_tiny_ttf_set_size(font, 15);
+    lv_font_glyph_dsc_t dsc;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &dsc, 'H', 0));
+    TEST_ASSERT_LESS_THAN(ref_dsc.box_h, dsc.box_h);
+    TEST_ASSERT_LESS_THAN(ref_line_height, lv_font_get_line_height(font));
+
+    /*Render more glyphs than the cache can hold*/
+    const char * txt = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    uint32_t i;
+    for(i = 0; txt[i]; i++) {
+        TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(font, txt[i]));
+    }
+
+    lv_tiny_ttf_set_size(font, 30);
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &dsc, 'H', 0));
+    assert_glyph_dsc_equal(&ref_dsc, &dsc);
+    TEST_ASSERT_EQUAL(ref_line_height, lv_font_get_line_height(font));
+
+    lv_tiny_ttf_destroy(font);
+#else
+    TEST_PASS();
+#endif
+}
+
 #endif
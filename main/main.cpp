@@ -1,7 +1,9 @@
 #include <stdio.h>
+#include <inttypes.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/semphr.h>
+#include <freertos/queue.h>
 #include <string>
 #include <math.h>
 #include "sdkconfig.h"
@@ -14,6 +16,32 @@
 
 static const char *TAG = "MAIN";
 #define LV_TICK_PERIOD_MS 1
+#define LABEL_BENCHMARK 0 // 1: log the cost of lv_label_set_text() on the dashboard's labels at startup
+#define OBJ_MEM_BENCHMARK 0 // 1: log how many decorative labels fit in 1 kB as normal and as light objects at startup
+#define EVENT_BENCHMARK 0 // 1: log the events LVGL dispatched and the draw events it skipped per rendered frame
+#define EVENT_BENCHMARK_PERIOD_MS 5000
+#define GRAD_CACHE_REPORT 0 // 1: log the memory usage and hit rate of LVGL's gradient cache periodically
+#define GRAD_CACHE_REPORT_PERIOD_MS 10000
+#define ARC_CACHE_REPORT 0 // 1: log the memory usage and hit rate of LVGL's arc coverage cache periodically
+#define ARC_CACHE_REPORT_PERIOD_MS 10000
+#define OVERDRAW_REPORT 0 // 1: log the overdraw and what occlusion culling saved periodically
+#define OVERDRAW_REPORT_PERIOD_MS 10000
+#define DISPLAY_BACKEND_BSP 0 // 1: drive an 8-bit parallel ST7796 board revision with the esp_lcd i80 backend of bsp_wt32_sc01
+#define DISPLAY_BENCHMARK 0   // 1: compare the i80 throughput of bsp_wt32_sc01 and LovyanGFX's Bus_Parallel8 at startup
+#define DISPLAY_BENCHMARK_FRAMES 30
+#define POWER_DIM_TIMEOUT_MS 30000    // Dim the backlight after this much time without touch
+#define POWER_BLANK_TIMEOUT_MS 120000 // Turn the backlight off and stop rendering after this much time without touch
+#define POWER_SLEEP_TIMEOUT_MS 125000 // Put the panel to sleep when the backlight has faded out
+#define BACKLIGHT_DIM_LEVEL 10        // 0-255
+#define BACKLIGHT_FADE_MS 400
+#define TOUCH_DEBUG_OVERLAY 0       // 1: show the last touch point in the top right corner
+#define TOUCH_OVERLAY_PERIOD_MS 200 // The overlay is updated at most this often and only if the point changed
+#define TOUCH_POLL_MS 10            // Period of reading the touch controller (5x longer while the display is dark)
+#define TOUCH_DEBOUNCE_CNT 2        // A press or release is accepted after this many equal reads
+#define TOUCH_JITTER_PX 3           // Smaller movements of the filtered point are not sent to LVGL
+#define TOUCH_SWIPE_MIN_PX 40       // A swipe moves at least this much from the press...
+#define TOUCH_SWIPE_MIN_SPEED 300   // ...and is at least this fast at the release [px/s]
+#define TOUCH_PINCH_STEP 50         // A pinch event is sent when the distance of the points changes this much [1/1000]
 #define LGFX_WT32_SC01 // Wireless Tag / Seeed WT32-SC01
 #define LGFX_USE_V1    // LovyanGFX version
 #define MY_USB_SYMBOL "\xEF\x8A\x87"
@@ -29,41 +57,165 @@ static LGFX lcd;
 #include <lvgl.h>
 #include "../components/lvgl/examples/lv_examples.h"
 #include "../components/lvgl/demos/lv_demos.h"
+#include "../components/lvgl/src/draw/sw/lv_draw_sw.h" // Arc cache counters of the software renderer
+#if DISPLAY_BACKEND_BSP || DISPLAY_BENCHMARK
+#include "bsp_wt32_sc01.h"
+#endif
 
 /*** Setup screen resolution for LVGL ***/
 static const uint16_t screenWidth = 480;
 static const uint16_t screenHeight = 320;
+#if !DISPLAY_BACKEND_BSP
 static lv_disp_draw_buf_t draw_buf;
+#if LV_DISP_DRAW_BUF_RING_MAX >= 3
+/* Bands are flushed by a task on the other core while LVGL renders the next band */
+#define DRAW_BUF_CNT 3
+static lv_color_t buf[DRAW_BUF_CNT][screenWidth * 10];
+
+static TaskHandle_t gui_task_handle;
+
+#if LV_COLOR_16_SWAP
+/* The bands are queued as SPI DMA jobs together with their address window and the
+ * DMA interrupt reports when they are sent, so no CPU time is spent on flushing */
+#define LCD_DMA_JOBS 1
+static lgfx::Bus_SPI *lcd_bus;
+#else
+/* The pixels need to be swapped while sending, so a task does it */
+#define LCD_DMA_JOBS 0
+typedef struct {
+    lv_disp_drv_t *disp;
+    lv_area_t area;
+    lv_color_t *color_p;
+} flush_job_t;
+
+static QueueHandle_t flush_queue;
+#endif
+#else
 static lv_color_t buf[screenWidth * 10];
+#endif
+#endif
 
 /*** Function declaration ***/
+#if !DISPLAY_BACKEND_BSP
 void display_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p);
+#endif
 void touchpad_read(lv_indev_drv_t *indev_driver, lv_indev_data_t *data);
+#if !DISPLAY_BACKEND_BSP
+static void touch_task(void *arg);
+#endif
+#if TOUCH_DEBUG_OVERLAY
+static void touch_overlay_timer_cb(lv_timer_t *timer);
+#endif
 void lv_button_demo(void);
 void lv_weather_dashboard(void);
 void draw_thermometer_icon(lv_obj_t *parent, lv_coord_t x_offset, lv_coord_t y_offset, lv_color_t color);
 void draw_pressure_gauge_icon(lv_obj_t *parent, lv_coord_t x_offset, lv_coord_t y_offset, lv_color_t color);
+#if !DISPLAY_BACKEND_BSP
 static void lv_tick_task(void *arg);
+#endif
+#if !DISPLAY_BACKEND_BSP && LV_DISP_DRAW_BUF_RING_MAX >= 3
+#if LCD_DMA_JOBS
+static void display_dma_done(void *user_data);
+#else
+static void display_flush_task(void *arg);
+#endif
+static void display_wait(lv_disp_drv_t *disp);
+#endif
+#if DISPLAY_BENCHMARK
+static void display_benchmark(void);
+#endif
+static void backlight_fade(uint8_t level, uint32_t time_ms);
+static void display_sleep(bool en);
+#if !DISPLAY_BACKEND_BSP
+static void power_timer_cb(lv_timer_t *timer);
+#endif
+static bool power_wake(void);
 static void sensor_task(void *arg);
+static void sensor_timer_cb(lv_timer_t *timer);
 static esp_err_t i2c_master_init(void);
+#if LABEL_BENCHMARK
+static void label_benchmark(void);
+#endif
+#if OBJ_MEM_BENCHMARK && LV_OBJ_LIGHT_SLAB_CNT
+static void obj_mem_benchmark(void);
+#endif
+#if EVENT_BENCHMARK
+static void event_benchmark_monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+static void event_benchmark_timer_cb(lv_timer_t *timer);
+#endif
+#if GRAD_CACHE_REPORT
+static void grad_cache_report_timer_cb(lv_timer_t *timer);
+#endif
+#if ARC_CACHE_REPORT && LV_ARC_CACHE_SIZE
+static void arc_cache_report_timer_cb(lv_timer_t *timer);
+#endif
+#if OVERDRAW_REPORT && LV_REFR_OCCLUSION_CULL
+static void overdraw_report_timer_cb(lv_timer_t *timer);
+#endif
 
 char txt[100];
-lv_obj_t *tlabel; // touch x,y label
+lv_obj_t *tlabel; // touch x,y label (TOUCH_DEBUG_OVERLAY)
+
+// Touch events published by the touch task for LVGL
+typedef enum : uint8_t
+{
+    TOUCH_EV_PRESS,
+    TOUCH_EV_MOVE,
+    TOUCH_EV_RELEASE,
+    TOUCH_EV_SWIPE, // x, y: release point; dx, dy: velocity [px/s]
+    TOUCH_EV_PINCH, // x, y: center of the two points; dx: their distance / distance at the start [1/1000]
+} touch_event_type_t;
+
+typedef struct
+{
+    touch_event_type_t type;
+    int16_t x;
+    int16_t y;
+    int16_t dx;
+    int16_t dy;
+} touch_event_t;
+
+static QueueHandle_t touch_queue;
+static lv_point_t touch_point;          // Last point sent to LVGL
+static lv_event_code_t touch_swipe_event; // Sent to the active screen with a touch_event_t parameter
+static lv_event_code_t touch_pinch_event;
 lv_obj_t *brightness_btn_label; // Brightness button label
 
 // Brightness levels and current index
 static uint8_t brightness_levels[] = {25, 128, 242}; // ~10%, 50%, 95%
 static uint8_t current_brightness_index = 0;
 
+// Power states after inactivity, in this order. Nothing is rendered from POWER_BLANK.
+typedef enum
+{
+    POWER_ACTIVE,
+    POWER_DIM,   // Backlight dimmed
+    POWER_BLANK, // Backlight off, the display's refresh is paused
+    POWER_SLEEP, // The panel is in sleep mode too
+} power_state_t;
+
+static power_state_t power_state = POWER_ACTIVE;
+static uint8_t backlight_level = 100; // Level when active, 0-255
+static bool wake_touch = false;       // The touch which woke up the display is not sent to LVGL
+
 // Temperature unit: false = Celsius, true = Fahrenheit
 static bool temp_unit_fahrenheit = false;
 
 // BMP280 sensor and data
 static bmp280_dev_t bmp280_dev;
-static float sensor_temperature = 25.5;  // Default value
-static float sensor_pressure = 1013.0;   // Default value (hPa)
+static int32_t sensor_temperature = 2550; // 0.01 °C, default value
+static int32_t sensor_pressure = 101300;  // Pa (0.01 hPa), default value
 static float sensor_humidity = 65.0;     // BMP280 doesn't measure humidity, keep dummy value
 
+// Readings published by the sensor task for LVGL. Only the latest one is kept.
+typedef struct
+{
+    int32_t temperature; // 0.01 °C
+    int32_t pressure;    // Pa (0.01 hPa)
+} sensor_reading_t;
+
+static QueueHandle_t sensor_queue;
+
 // Labels for updating sensor values
 lv_obj_t *temp_value_label = NULL;
 lv_obj_t *humid_value_label = NULL;
@@ -103,18 +255,43 @@ extern "C"
             ESP_LOGI(TAG, "I2C bus initialized successfully");
         }
 
+#if DISPLAY_BENCHMARK
+        display_benchmark();
+#endif
+
+#if DISPLAY_BACKEND_BSP
+        /* The BSP initializes lvgl and its tick, and registers the landscape display flushed by the i80 DMA */
+        lv_disp_t *disp;
+        ESP_ERROR_CHECK(bsp_display_init(&disp));
+        bsp_display_brightness_set((backlight_level * 100) / 255);
+#else
         lcd.init(); // Initialize LovyanGFX (will use existing I2C)
         lv_init();  // Initialize lvgl
 
         // Set backlight brightness (0-255, where 255 is maximum brightness)
-        lcd.setBrightness(100); // Set to 78% brightness (200/255)
+        lcd.setBrightness(backlight_level); // Set to 39% brightness (100/255)
 
         // Setting display to landscape
         if (lcd.width() < lcd.height())
             lcd.setRotation(lcd.getRotation() ^ 1);
 
         /* LVGL : Setting up buffer to use for display */
+#if LV_DISP_DRAW_BUF_RING_MAX >= 3
+        void *bufs[DRAW_BUF_CNT] = {buf[0], buf[1], buf[2]};
+        lv_disp_draw_buf_init_ring(&draw_buf, bufs, DRAW_BUF_CNT, screenWidth * 10);
+
+        gui_task_handle = xTaskGetCurrentTaskHandle();
+#if LCD_DMA_JOBS
+        // The WT32-SC01 panel is on SPI: its bands are sent as DMA jobs (see display_flush)
+        if (lcd.getPanel()->getBus()->busType() == lgfx::bus_type_t::bus_spi)
+            lcd_bus = static_cast<lgfx::Bus_SPI *>(lcd.getPanel()->getBus());
+#else
+        flush_queue = xQueueCreate(DRAW_BUF_CNT, sizeof(flush_job_t));
+        xTaskCreatePinnedToCore(display_flush_task, "display_flush", 4096, NULL, 5, NULL, 1);
+#endif
+#else
         lv_disp_draw_buf_init(&draw_buf, buf, NULL, screenWidth * 10);
+#endif
 
         /*** LVGL : Setup & Initialize the display device driver ***/
         static lv_disp_drv_t disp_drv;
@@ -123,9 +300,25 @@ extern "C"
         disp_drv.ver_res = screenHeight;
         disp_drv.flush_cb = display_flush;
         disp_drv.draw_buf = &draw_buf;
+#if LV_DISP_DRAW_BUF_RING_MAX >= 3
+        disp_drv.wait_cb = display_wait;
+#endif
+#if LV_DISP_DAMAGE_TILE_W
+        disp_drv.damage_track = 1; // Send only the tiles which are different from the LCD's content
+#endif
         lv_disp_drv_register(&disp_drv);
+#endif
 
         /*** LVGL : Setup & Initialize the input device driver ***/
+#if DISPLAY_BACKEND_BSP
+        // No input device: the BSP has no touch driver, the FT6336 is read by LovyanGFX only on the SPI board
+#else
+        // The touch task on core 1 reads the touch controller, LVGL only takes its events
+        touch_queue = xQueueCreate(32, sizeof(touch_event_t));
+        touch_swipe_event = (lv_event_code_t)lv_event_register_id();
+        touch_pinch_event = (lv_event_code_t)lv_event_register_id();
+        xTaskCreatePinnedToCore(touch_task, "touch", 3072, NULL, 4, NULL, 1);
+
         static lv_indev_drv_t indev_drv;
         lv_indev_drv_init(&indev_drv);
         indev_drv.type = LV_INDEV_TYPE_POINTER;
@@ -139,6 +332,7 @@ extern "C"
         esp_timer_handle_t periodic_timer;
         ESP_ERROR_CHECK(esp_timer_create(&periodic_timer_args, &periodic_timer));
         ESP_ERROR_CHECK(esp_timer_start_periodic(periodic_timer, LV_TICK_PERIOD_MS * 1000));
+#endif
 
         /* I2C bus already initialized before LCD init */
 
@@ -150,75 +344,492 @@ extern "C"
         // lv_label_set_text(label, txt);                   // set label text
         // lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 20);    // Center but 20 from the top
 
+#if TOUCH_DEBUG_OVERLAY
         tlabel = lv_label_create(lv_scr_act());         // full screen as the parent
         lv_label_set_text(tlabel, "Touch:(000,000)");   // set label text
         lv_obj_align(tlabel, LV_ALIGN_TOP_RIGHT, 0, 0); // Center but 20 from the top
+        lv_timer_create(touch_overlay_timer_cb, TOUCH_OVERLAY_PERIOD_MS, NULL);
+#endif
 
         //lv_button_demo(); // lvl buttons
         //lv_example_anim_1();
         //lv_demo_widgets();
+#if LABEL_BENCHMARK
+        label_benchmark();
+#endif
+#if OBJ_MEM_BENCHMARK && LV_OBJ_LIGHT_SLAB_CNT
+        obj_mem_benchmark();
+#endif
         lv_weather_dashboard();
 
+#if EVENT_BENCHMARK
+        lv_disp_get_default()->driver->monitor_cb = event_benchmark_monitor_cb; // Called after every rendered frame
+        lv_event_reset_stat();
+        lv_timer_create(event_benchmark_timer_cb, EVENT_BENCHMARK_PERIOD_MS, NULL);
+#endif
+#if GRAD_CACHE_REPORT
+        lv_timer_create(grad_cache_report_timer_cb, GRAD_CACHE_REPORT_PERIOD_MS, NULL);
+#endif
+#if ARC_CACHE_REPORT && LV_ARC_CACHE_SIZE
+        lv_timer_create(arc_cache_report_timer_cb, ARC_CACHE_REPORT_PERIOD_MS, NULL);
+#endif
+#if OVERDRAW_REPORT && LV_REFR_OCCLUSION_CULL
+        lv_timer_create(overdraw_report_timer_cb, OVERDRAW_REPORT_PERIOD_MS, NULL);
+#endif
+
+#if !DISPLAY_BACKEND_BSP
+        lv_timer_create(power_timer_cb, 250, NULL); // The BSP backend has no input device to wake the display up
+#endif
+
         /* Start BMP280 sensor reading task (with lower priority to not interfere with GUI) */
+        // LVGL is not thread-safe: the sensor task only publishes its readings and an LVGL timer sets the labels
+        sensor_queue = xQueueCreate(1, sizeof(sensor_reading_t));
+        lv_timer_create(sensor_timer_cb, 500, NULL);
         xTaskCreate(sensor_task, "sensor_task", 4096, NULL, 3, NULL);
         ESP_LOGI(TAG, "Sensor task created");
 
         while (1)
         {
-            lv_timer_handler(); /* let the GUI do its work */
-            vTaskDelay(1);
+            uint32_t time_till_next = lv_timer_handler(); /* let the GUI do its work */
+            // Nothing is rendered while the display is dark, only the touch is read
+            if (power_state >= POWER_BLANK)
+                vTaskDelay(pdMS_TO_TICKS(LV_MIN(time_till_next, LV_INDEV_DEF_READ_PERIOD)) + 1);
+            else
+                vTaskDelay(1);
         }
     }
 }
 
-/*** Display callback to flush the buffer to screen ***/
-void display_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+#if !DISPLAY_BACKEND_BSP
+/*** Push a rendered band to the LCD ***/
+static void display_push(const lv_area_t *area, lv_color_t *color_p)
 {
     uint32_t w = (area->x2 - area->x1 + 1);
     uint32_t h = (area->y2 - area->y1 + 1);
 
     lcd.startWrite();
     lcd.setAddrWindow(area->x1, area->y1, w, h);
-    lcd.pushColors((uint16_t *)&color_p->full, w * h, true);
+    lcd.pushColors((uint16_t *)&color_p->full, w * h, !LV_COLOR_16_SWAP);
     lcd.endWrite();
+}
 
+#if LV_DISP_DRAW_BUF_RING_MAX >= 3
+#if LCD_DMA_JOBS
+/*** Pack a start and end coordinate as the big endian parameter of CASET/RASET (see Panel_LCD::set_window_8) ***/
+static uint32_t window_param(uint32_t start, uint32_t end)
+{
+    static constexpr uint32_t mask = 0xFF00FF;
+    uint32_t v = start + (end << 16);
+    return ((v >> 8) & mask) + ((v & mask) << 8);
+}
+
+/*** Display callback: queue the band with its address window, it's sent while LVGL renders the next one ***/
+void display_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    if (lcd_bus == nullptr)
+    {
+        display_push(area, color_p);
+        lv_disp_flush_ready(disp);
+        return;
+    }
+
+    // The transaction is open from the first band of a refresh to the last one only,
+    // so the bus is free between the refreshes. Read `last` now: the band's callback clears it.
+    bool last = lv_disp_flush_is_last(disp);
+    static bool writing = false;
+    if (!writing)
+    {
+        lcd.startWrite();
+        writing = true;
+    }
+
+    lgfx::Bus_SPI::dma_job_t job;
+    job.cmd[0] = 0x2A; // CASET
+    job.param[0] = window_param(area->x1, area->x2);
+    job.param_bits[0] = 32;
+    job.cmd[1] = 0x2B; // RASET
+    job.param[1] = window_param(area->y1, area->y2);
+    job.param_bits[1] = 32;
+    job.cmd[2] = 0x2C; // RAMWR
+    job.cmd_count = 3;
+    job.data = (const uint8_t *)color_p;
+    job.length = lv_area_get_size(area) * sizeof(lv_color_t);
+    job.done_cb = display_dma_done;
+    job.user_data = disp;
+
+    // LVGL never has more than DRAW_BUF_CNT bands in flight, so the queue is full only if
+    // the DMA descriptors couldn't be allocated. Try again when the other bands are sent.
+    if (!lcd_bus->queueDMAJob(job))
+    {
+        lcd_bus->wait();
+        if (!lcd_bus->queueDMAJob(job))
+        {
+            ESP_LOGE(TAG, "Failed to queue a band for DMA");
+            lv_disp_flush_ready(disp);
+        }
+    }
+
+    if (last)
+    {
+        lcd.endWrite(); // Waits until the queued bands are sent
+        writing = false;
+    }
+}
+
+/*** DMA job task of the bus: the band is on the LCD, its buffer can be rendered again ***/
+static void display_dma_done(void *user_data)
+{
+    lv_disp_flush_ready((lv_disp_drv_t *)user_data);
+    xTaskNotifyGive(gui_task_handle);
+}
+#else
+/*** Display callback: hand the band over to the flush task ***/
+void display_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    flush_job_t job = {disp, *area, color_p};
+    // LVGL never has more than DRAW_BUF_CNT bands in flight, so this never blocks
+    xQueueSend(flush_queue, &job, portMAX_DELAY);
+}
+
+/*** Flush task on core 1: pushes the bands in order while LVGL renders on core 0 ***/
+static void display_flush_task(void *arg)
+{
+    flush_job_t job;
+    while (1)
+    {
+        if (xQueueReceive(flush_queue, &job, portMAX_DELAY) != pdTRUE)
+            continue;
+
+        display_push(&job.area, job.color_p);
+        lv_disp_flush_ready(job.disp);
+        xTaskNotifyGive(gui_task_handle);
+    }
+}
+#endif
+
+/*** Called by LVGL while all draw buffers are waiting for the flush task ***/
+static void display_wait(lv_disp_drv_t *disp)
+{
+    (void)disp;
+    ulTaskNotifyTake(pdTRUE, 1); // Time out after 1 tick in case the notification was taken already
+}
+#else
+/*** Display callback to flush the buffer to screen ***/
+void display_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    display_push(area, color_p);
     lv_disp_flush_ready(disp);
 }
+#endif
+#endif
 
-/*** Touchpad callback to read the touchpad ***/
+/*** Touchpad callback: take the events of the touch task ***/
 void touchpad_read(lv_indev_drv_t *indev_driver, lv_indev_data_t *data)
 {
-    uint16_t touchX, touchY;
-    bool touched = false;
+    static bool pressed = false;
+    touch_event_t ev;
 
-    // Take I2C mutex before reading touch (uses I2C)
-    if (i2c_mutex != NULL && xSemaphoreTake(i2c_mutex, pdMS_TO_TICKS(50)) == pdTRUE)
+    while (touch_queue != NULL && xQueueReceive(touch_queue, &ev, 0) == pdTRUE)
     {
-        touched = lcd.getTouch(&touchX, &touchY);
-        xSemaphoreGive(i2c_mutex);
+        if (ev.type == TOUCH_EV_SWIPE || ev.type == TOUCH_EV_PINCH)
+        {
+            lv_event_send(lv_scr_act(), ev.type == TOUCH_EV_SWIPE ? touch_swipe_event : touch_pinch_event, &ev);
+            continue;
+        }
+
+        touch_point.x = ev.x;
+        touch_point.y = ev.y;
+        if (ev.type == TOUCH_EV_MOVE)
+            continue; // Only the last point matters
+
+        // A touch on the dark panel only wakes it up, it's not a click
+        pressed = ev.type == TOUCH_EV_PRESS;
+        if (pressed && power_wake())
+            wake_touch = true;
+
+        // Let LVGL process this press or release before the next event
+        data->continue_reading = uxQueueMessagesWaiting(touch_queue) > 0;
+        break;
     }
-    else
+
+    data->point = touch_point;
+    data->state = pressed && !wake_touch ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+    if (!pressed)
+        wake_touch = false;
+}
+
+#if !DISPLAY_BACKEND_BSP
+/*** Touch pipeline: debounce, filter and detect the gestures of the touch points ***/
+#define TOUCH_HISTORY_LEN 4
+
+typedef struct
+{
+    bool pressed;         // Debounced state
+    uint8_t change_cnt;   // Number of consecutive reads different from `pressed`
+    bool two_points;      // A two point gesture is in progress
+    int16_t x, y;         // Filtered point
+    int16_t pub_x, pub_y; // Last published point
+    int16_t start_x, start_y;
+    int32_t pinch_dist;   // Distance of the two points at the start of the gesture
+    int16_t pinch_ratio;  // Last published distance ratio [1/1000]
+    struct
     {
-        // If mutex not available, skip this read cycle
-        touched = false;
-    }
+        int16_t x, y;
+        uint32_t time;
+    } history[TOUCH_HISTORY_LEN]; // The last filtered points to estimate the velocity
+    uint8_t history_cnt;
+    uint8_t history_idx;
+} touch_pipeline_t;
+
+static void touch_publish(touch_event_type_t type, int16_t x, int16_t y, int16_t dx, int16_t dy)
+{
+    touch_event_t ev = {type, x, y, dx, dy};
+    // A lost move is corrected by the next one, but a lost press or release is not
+    xQueueSend(touch_queue, &ev, type == TOUCH_EV_MOVE ? 0 : pdMS_TO_TICKS(100));
+}
+
+static void touch_history_reset(touch_pipeline_t *tp)
+{
+    tp->history_cnt = 0;
+    tp->history_idx = 0;
+}
+
+static void touch_history_add(touch_pipeline_t *tp, uint32_t now)
+{
+    tp->history[tp->history_idx].x = tp->x;
+    tp->history[tp->history_idx].y = tp->y;
+    tp->history[tp->history_idx].time = now;
+    tp->history_idx = (tp->history_idx + 1) % TOUCH_HISTORY_LEN;
+    if (tp->history_cnt < TOUCH_HISTORY_LEN)
+        tp->history_cnt++;
+}
+
+/*** Publish a swipe if the point moved far and fast enough before the release ***/
+static void touch_detect_swipe(touch_pipeline_t *tp)
+{
+    if (tp->history_cnt < 2)
+        return;
+
+    int dist_x = tp->pub_x - tp->start_x;
+    int dist_y = tp->pub_y - tp->start_y;
+    if (LV_ABS(dist_x) < TOUCH_SWIPE_MIN_PX && LV_ABS(dist_y) < TOUCH_SWIPE_MIN_PX)
+        return;
+
+    const auto &oldest = tp->history[(tp->history_idx + TOUCH_HISTORY_LEN - tp->history_cnt) % TOUCH_HISTORY_LEN];
+    const auto &newest = tp->history[(tp->history_idx + TOUCH_HISTORY_LEN - 1) % TOUCH_HISTORY_LEN];
+    int32_t dt = newest.time - oldest.time;
+    if (dt <= 0)
+        return;
+
+    int32_t vx = (newest.x - oldest.x) * 1000 / dt;
+    int32_t vy = (newest.y - oldest.y) * 1000 / dt;
+    if (vx * vx + vy * vy < TOUCH_SWIPE_MIN_SPEED * TOUCH_SWIPE_MIN_SPEED)
+        return;
+
+    touch_publish(TOUCH_EV_SWIPE, tp->pub_x, tp->pub_y, LV_CLAMP(INT16_MIN, vx, INT16_MAX),
+                  LV_CLAMP(INT16_MIN, vy, INT16_MAX));
+}
+
+static void touch_pipeline_step(touch_pipeline_t *tp, const lgfx::touch_point_t *points, uint8_t count, uint32_t now)
+{
+    // Debounce: the state changes after TOUCH_DEBOUNCE_CNT equal reads
+    bool touched = count > 0;
+    if (touched != tp->pressed && ++tp->change_cnt < TOUCH_DEBOUNCE_CNT)
+        return;
+    tp->change_cnt = 0;
 
     if (!touched)
     {
-        data->state = LV_INDEV_STATE_REL;
+        if (tp->pressed)
+        {
+            tp->pressed = false;
+            touch_publish(TOUCH_EV_RELEASE, tp->pub_x, tp->pub_y, 0, 0);
+            if (!tp->two_points)
+                touch_detect_swipe(tp);
+        }
+        return;
     }
-    else
+
+    if (!tp->pressed)
+    {
+        tp->pressed = true;
+        tp->two_points = false;
+        tp->x = tp->pub_x = tp->start_x = points[0].x;
+        tp->y = tp->pub_y = tp->start_y = points[0].y;
+        touch_history_reset(tp);
+        touch_history_add(tp, now);
+        touch_publish(TOUCH_EV_PRESS, tp->x, tp->y, 0, 0);
+        return;
+    }
+
+    // Two points: pinch. LVGL's pointer stays where it is meanwhile.
+    if (count >= 2)
+    {
+        int32_t dx = points[1].x - points[0].x;
+        int32_t dy = points[1].y - points[0].y;
+        int32_t dist = LV_MAX((int32_t)sqrtf((float)(dx * dx + dy * dy)), 1);
+        if (!tp->two_points)
+        {
+            tp->two_points = true;
+            tp->pinch_dist = dist;
+            tp->pinch_ratio = 1000;
+            return;
+        }
+
+        int32_t ratio = LV_MIN(dist * 1000 / tp->pinch_dist, INT16_MAX);
+        if (LV_ABS(ratio - tp->pinch_ratio) >= TOUCH_PINCH_STEP)
+        {
+            tp->pinch_ratio = ratio;
+            touch_publish(TOUCH_EV_PINCH, (points[0].x + points[1].x) / 2, (points[0].y + points[1].y) / 2, ratio, 0);
+        }
+        return;
+    }
+
+    if (tp->two_points)
+    {
+        // One finger is lifted: continue from the other one without a jump or a swipe
+        tp->two_points = false;
+        tp->x = tp->start_x = tp->pub_x;
+        tp->y = tp->start_y = tp->pub_y;
+        touch_history_reset(tp);
+    }
+
+    // Jitter: smooth the point with a first order filter and ignore the small changes
+    tp->x += (points[0].x - tp->x) / 2;
+    tp->y += (points[0].y - tp->y) / 2;
+    touch_history_add(tp, now);
+    if (LV_ABS(tp->x - tp->pub_x) >= TOUCH_JITTER_PX || LV_ABS(tp->y - tp->pub_y) >= TOUCH_JITTER_PX)
     {
-        data->state = LV_INDEV_STATE_PR;
+        tp->pub_x = tp->x;
+        tp->pub_y = tp->y;
+        touch_publish(TOUCH_EV_MOVE, tp->x, tp->y, 0, 0);
+    }
+}
 
-        /*Set the coordinates*/
-        data->point.x = touchX;
-        data->point.y = touchY;
+/*** Touch task: reads the FT6336 and runs the touch pipeline ***/
+static void touch_task(void *arg)
+{
+    (void)arg;
+    static touch_pipeline_t pipeline;
+    lgfx::touch_point_t points[2];
 
-        sprintf(txt, "Touch:(%03d,%03d)", touchX, touchY);
-        lv_label_set_text(tlabel, txt); // set label text
+    while (1)
+    {
+        // A touch on the dark display only has to wake it up
+        vTaskDelay(pdMS_TO_TICKS(power_state >= POWER_BLANK ? TOUCH_POLL_MS * 5 : TOUCH_POLL_MS));
+
+        // Take I2C mutex before reading touch (uses I2C)
+        if (i2c_mutex == NULL || xSemaphoreTake(i2c_mutex, pdMS_TO_TICKS(50)) != pdTRUE)
+            continue; // If mutex not available, skip this read cycle
+
+        uint8_t count = lcd.getTouch(points, 2);
+        xSemaphoreGive(i2c_mutex);
+
+        touch_pipeline_step(&pipeline, points, count, esp_timer_get_time() / 1000);
     }
 }
+#endif
+
+#if TOUCH_DEBUG_OVERLAY
+/*** Show the last touch point. It's changed only if the point changed, so touching doesn't redraw it all the time. ***/
+static void touch_overlay_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    static lv_point_t shown = {-1, -1};
+    if (touch_point.x == shown.x && touch_point.y == shown.y)
+        return;
+
+    shown = touch_point;
+    lv_label_set_text_fmt(tlabel, "Touch:(%03d,%03d)", shown.x, shown.y);
+}
+#endif
+
+#if EVENT_BENCHMARK
+/*** Count the events of the rendered frames. Draw events are dispatched only to the objects which handle them. ***/
+static uint32_t event_benchmark_frames;
+
+static void event_benchmark_monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    (void)drv;
+    (void)time;
+    (void)px;
+    event_benchmark_frames++;
+}
+
+static void event_benchmark_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    if (event_benchmark_frames == 0)
+        return; // Nothing was rendered, keep counting until the next frame
+
+    lv_event_stat_t stat;
+    lv_event_get_stat(&stat);
+    lv_event_reset_stat();
+    ESP_LOGI(TAG, "Event benchmark %lu frames: %lu events/frame dispatched, %lu draw events/frame skipped",
+             (unsigned long)event_benchmark_frames, (unsigned long)(stat.sent / event_benchmark_frames),
+             (unsigned long)(stat.draw_skipped / event_benchmark_frames));
+    event_benchmark_frames = 0;
+}
+#endif
+
+#if GRAD_CACHE_REPORT
+/*** Report how well the computed gradients are reused ***/
+static void grad_cache_report_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    lv_grad_cache_stat_t stat;
+    lv_gradient_get_cache_stat(&stat);
+    lv_gradient_reset_cache_stat();
+
+    uint32_t lookups = stat.hit_cnt + stat.miss_cnt;
+    if (lookups == 0)
+        return; // No gradient was drawn
+
+    ESP_LOGI(TAG, "Gradient cache: %u/%u bytes, %lu items, %lu%% hit rate, %lu evicted, %lu too large",
+             (unsigned)stat.used_size, (unsigned)stat.cache_size, (unsigned long)stat.item_cnt,
+             (unsigned long)(stat.hit_cnt * 100 / lookups), (unsigned long)stat.evict_cnt,
+             (unsigned long)stat.not_cached_cnt);
+}
+#endif
+
+#if ARC_CACHE_REPORT && LV_ARC_CACHE_SIZE
+/*** Report how often the arcs are blended from their stored coverage ***/
+static void arc_cache_report_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    lv_draw_sw_arc_cache_stat_t stat;
+    lv_draw_sw_arc_get_cache_stat(&stat);
+    lv_draw_sw_arc_reset_cache_stat();
+
+    uint32_t lookups = stat.hit_cnt + stat.miss_cnt;
+    if (lookups == 0)
+        return; // No arc was drawn
+
+    ESP_LOGI(TAG, "Arc cache: %u/%u bytes, %lu items, %lu%% hit rate, %lu evicted, %lu not cached",
+             (unsigned)stat.used_size, (unsigned)stat.cache_size, (unsigned long)stat.item_cnt,
+             (unsigned long)(stat.hit_cnt * 100 / lookups), (unsigned long)stat.evict_cnt,
+             (unsigned long)stat.not_cached_cnt);
+}
+#endif
+
+#if OVERDRAW_REPORT && LV_REFR_OCCLUSION_CULL
+static void overdraw_report_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    lv_refr_occlusion_stat_t stat;
+    lv_refr_get_occlusion_stat(&stat);
+    lv_refr_reset_occlusion_stat();
+
+    if (stat.area_px == 0)
+        return; // Nothing was refreshed
+
+    // Drawn pixels per refreshed pixel in 1/100 (the transparent top and system layers count too)
+    uint32_t overdraw = (uint64_t)stat.drawn_px * 100 / stat.area_px;
+    ESP_LOGI(TAG, "Overdraw: %lu.%02lu, %lu px culled (%lu objects fully), %lu opaque objects",
+             (unsigned long)(overdraw / 100), (unsigned long)(overdraw % 100), (unsigned long)stat.culled_px,
+             (unsigned long)stat.culled_cnt, (unsigned long)stat.occluder_cnt);
+}
+#endif
 
 /* Counter button event handler */
 static void counter_event_handler(lv_event_t *e)
@@ -256,7 +867,7 @@ void lv_button_demo(void)
 
     // Button with counter
     lv_obj_t *btn1 = lv_btn_create(lv_scr_act());
-    lv_obj_add_event_cb(btn1, counter_event_handler, LV_EVENT_ALL, NULL);
+    lv_obj_add_event_cb(btn1, counter_event_handler, LV_EVENT_CLICKED, NULL);
 
     lv_obj_set_pos(btn1, 100, 100); /*Set its position*/
     lv_obj_set_size(btn1, 120, 50); /*Set its size*/
@@ -267,7 +878,7 @@ void lv_button_demo(void)
 
     // Toggle button
     lv_obj_t *btn2 = lv_btn_create(lv_scr_act());
-    lv_obj_add_event_cb(btn2, toggle_event_handler, LV_EVENT_ALL, NULL);
+    lv_obj_add_event_cb(btn2, toggle_event_handler, LV_EVENT_VALUE_CHANGED, NULL);
     lv_obj_add_flag(btn2, LV_OBJ_FLAG_CHECKABLE);
     lv_obj_set_pos(btn2, 250, 100); /*Set its position*/
     lv_obj_set_size(btn2, 120, 50); /*Set its size*/
@@ -289,6 +900,9 @@ void draw_thermometer_icon(lv_obj_t *parent, lv_coord_t x_offset, lv_coord_t y_o
     // Fill with transparent background
     lv_canvas_fill_bg(canvas, lv_color_hex(0x81ecec), LV_OPA_0);
 
+    // Draw all the parts with one drawing context
+    lv_canvas_draw_begin(canvas);
+
     lv_draw_rect_dsc_t rect_dsc;
     lv_draw_rect_dsc_init(&rect_dsc);
 
@@ -324,6 +938,8 @@ void draw_thermometer_icon(lv_obj_t *parent, lv_coord_t x_offset, lv_coord_t y_o
         line_points[1].y = 10 + (i * 5);
         lv_canvas_draw_line(canvas, line_points, 2, &line_dsc);
     }
+
+    lv_canvas_draw_end(canvas);
 }
 
 /* Draw custom pressure gauge icon using canvas */
@@ -338,6 +954,9 @@ void draw_pressure_gauge_icon(lv_obj_t *parent, lv_coord_t x_offset, lv_coord_t
     // Fill with transparent background
     lv_canvas_fill_bg(canvas, lv_color_hex(0xD1C4E9), LV_OPA_0);
 
+    // Draw all the parts with one drawing context
+    lv_canvas_draw_begin(canvas);
+
     lv_draw_arc_dsc_t arc_dsc;
     lv_draw_arc_dsc_init(&arc_dsc);
 
@@ -404,6 +1023,28 @@ void draw_pressure_gauge_icon(lv_obj_t *parent, lv_coord_t x_offset, lv_coord_t
 
         lv_canvas_draw_line(canvas, tick_points, 2, &tick_dsc);
     }
+
+    lv_canvas_draw_end(canvas);
+}
+
+/*** Show the sensor values. Formatted without printf and redrawn only if the shown digits change ***/
+static void update_temp_label(void)
+{
+    if (temp_value_label == NULL)
+        return;
+
+    if (temp_unit_fahrenheit)
+        lv_label_set_num(temp_value_label, sensor_temperature, 2, 1, LV_LABEL_NUM_CONV_C_TO_F, "°F");
+    else
+        lv_label_set_num(temp_value_label, sensor_temperature, 2, 1, LV_LABEL_NUM_CONV_NONE, "°C");
+}
+
+static void update_pressure_label(void)
+{
+    if (pressure_value_label == NULL)
+        return;
+
+    lv_label_set_num(pressure_value_label, sensor_pressure, 2, 0, LV_LABEL_NUM_CONV_NONE, " hPa");
 }
 
 /* Temperature unit button event handler */
@@ -424,16 +1065,7 @@ static void temp_unit_btn_event_handler(lv_event_t *e)
         }
 
         // Update temperature display with current sensor value
-        if (temp_value_label != NULL) {
-            char temp_str[16];
-            if (temp_unit_fahrenheit) {
-                float temp_f = (sensor_temperature * 9.0f / 5.0f) + 32.0f;
-                sprintf(temp_str, "%.1f°F", temp_f);
-            } else {
-                sprintf(temp_str, "%.1f°C", sensor_temperature);
-            }
-            lv_label_set_text(temp_value_label, temp_str);
-        }
+        update_temp_label();
 
         ESP_LOGI(TAG, "Temperature unit changed to %s", temp_unit_fahrenheit ? "Fahrenheit" : "Celsius");
     }
@@ -451,7 +1083,8 @@ static void brightness_btn_event_handler(lv_event_t *e)
         uint8_t new_brightness = brightness_levels[current_brightness_index];
 
         // Set LCD brightness
-        lcd.setBrightness(new_brightness);
+        backlight_level = new_brightness;
+        backlight_fade(new_brightness, BACKLIGHT_FADE_MS);
 
         // Calculate percentage
         uint8_t percentage = (new_brightness * 100) / 255;
@@ -473,6 +1106,9 @@ void lv_weather_dashboard(void)
     lv_obj_set_size(bg_container, 480, 320);
     lv_obj_center(bg_container);
     lv_obj_set_style_bg_color(bg_container, lv_color_hex(0xE3F2FD), 0); // Pastel blue background
+    lv_obj_set_style_bg_grad_color(bg_container, lv_color_hex(0x90CAF9), 0); // Sky blue at the bottom
+    lv_obj_set_style_bg_grad_dir(bg_container, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_bg_dither_mode(bg_container, LV_DITHER_ORDERED, 0); // No banding in RGB565
     lv_obj_set_style_border_width(bg_container, 0, 0);
     lv_obj_set_style_pad_all(bg_container, 20, 0);
 
@@ -508,6 +1144,7 @@ void lv_weather_dashboard(void)
     lv_obj_set_style_shadow_width(temp_card, 10, 0);
     lv_obj_set_style_shadow_color(temp_card, lv_color_hex(0x000000), 0);
     lv_obj_set_style_shadow_opa(temp_card, LV_OPA_20, 0);
+    lv_obj_add_flag(temp_card, LV_OBJ_FLAG_LAYER_CACHE); // Updated by the sensor: keep the shadowed card rendered, redraw only the value
 
     // Temperature icon (custom drawn thermometer)
     draw_thermometer_icon(temp_card, 0, 5, lv_color_hex(0xD32F2F));
@@ -521,7 +1158,7 @@ void lv_weather_dashboard(void)
 
     // Temperature value
     temp_value_label = lv_label_create(temp_card);
-    lv_label_set_text(temp_value_label, "25.5°C");
+    update_temp_label();
     lv_obj_set_style_text_font(temp_value_label, &lv_font_montserrat_28, 0);
     lv_obj_set_style_text_color(temp_value_label, lv_color_hex(0x00796B), 0); // Dark teal (matches theme)
     lv_obj_align(temp_value_label, LV_ALIGN_BOTTOM_MID, 0, -20);
@@ -570,6 +1207,7 @@ void lv_weather_dashboard(void)
     lv_obj_set_style_shadow_width(pressure_card, 10, 0);
     lv_obj_set_style_shadow_color(pressure_card, lv_color_hex(0x000000), 0);
     lv_obj_set_style_shadow_opa(pressure_card, LV_OPA_20, 0);
+    lv_obj_add_flag(pressure_card, LV_OBJ_FLAG_LAYER_CACHE); // Updated by the sensor: keep the shadowed card rendered, redraw only the value
 
     // Pressure icon (custom drawn gauge)
     draw_pressure_gauge_icon(pressure_card, 0, 5, lv_color_hex(0x5E35B1));
@@ -583,7 +1221,7 @@ void lv_weather_dashboard(void)
 
     // Pressure value
     pressure_value_label = lv_label_create(pressure_card);
-    lv_label_set_text(pressure_value_label, "1013 hPa");
+    update_pressure_label();
     lv_obj_set_style_text_font(pressure_value_label, &lv_font_montserrat_22, 0);
     lv_obj_set_style_text_color(pressure_value_label, lv_color_hex(0x4527A0), 0); // Darker purple
     lv_obj_align(pressure_value_label, LV_ALIGN_BOTTOM_MID, 0, -20);
@@ -632,12 +1270,336 @@ void lv_weather_dashboard(void)
     lv_obj_center(brightness_btn_label);
 }
 
+/*** Change the backlight with the LEDC hardware fade, it doesn't need the CPU while fading ***/
+static void backlight_fade(uint8_t level, uint32_t time_ms)
+{
+#if DISPLAY_BACKEND_BSP
+    bsp_display_brightness_fade((level * 100) / 255, time_ms);
+#else
+    lcd.setBrightnessFade(level, time_ms);
+#endif
+}
+
+/*** Put the panel to sleep mode or wake it up. It keeps the content of its frame memory while sleeping. ***/
+static void display_sleep(bool en)
+{
+#if DISPLAY_BACKEND_BSP
+    bsp_display_sleep(en); // Keeps the panel's sleep in/out timing
+#else
+    static int64_t toggle_time_us = 0; // Time of the last sleep in/out
+
+    // The panel ignores a sleep in/out sent within 120 ms after the previous one
+    int64_t elapsed_ms = (esp_timer_get_time() - toggle_time_us) / 1000;
+    if (elapsed_ms < 120)
+        vTaskDelay(pdMS_TO_TICKS(120 - elapsed_ms) + 1);
+
+    lcd.waitDMA(); // The queued DMA jobs are not synchronized with the commands
+    if (en)
+        lcd.sleep();
+    else
+        lcd.wakeup();
+    toggle_time_us = esp_timer_get_time();
+    vTaskDelay(pdMS_TO_TICKS(5)); // The panel needs 5 ms after sleep in/out before the next command
+#endif
+}
+
+/*** Change the power state. While the display is dark it isn't refreshed, only the invalidated areas are collected ***/
+static void power_set_state(power_state_t state)
+{
+    static const char *names[] = {"active", "dimmed", "blank", "sleeping"};
+
+    if (state == power_state)
+        return;
+
+    bool was_dark = power_state >= POWER_BLANK;
+    bool dark = state >= POWER_BLANK;
+
+    if (power_state == POWER_SLEEP)
+        display_sleep(false);
+
+    // While it's dark the invalidations don't restart the refreshing and the animations stand still.
+    // When it's lit again only the areas invalidated meanwhile are rendered and flushed.
+    if (was_dark != dark)
+        lv_disp_set_refr_paused(NULL, dark);
+
+    switch (state)
+    {
+    case POWER_ACTIVE:
+        // The panel still shows the last frame, so turn it on at once when waking up from dark
+        backlight_fade(backlight_level, was_dark ? 0 : BACKLIGHT_FADE_MS);
+        break;
+    case POWER_DIM:
+        backlight_fade(LV_MIN(BACKLIGHT_DIM_LEVEL, backlight_level), BACKLIGHT_FADE_MS);
+        break;
+    case POWER_BLANK:
+        backlight_fade(0, BACKLIGHT_FADE_MS);
+        break;
+    case POWER_SLEEP:
+        if (!was_dark)
+            backlight_fade(0, 0);
+        display_sleep(true);
+        break;
+    }
+
+    ESP_LOGI(TAG, "Display %s", names[state]);
+    power_state = state;
+}
+
+#if !DISPLAY_BACKEND_BSP
+/*** Step the power state after inactivity ***/
+static void power_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    uint32_t inactive_ms = lv_disp_get_inactive_time(NULL);
+    if (inactive_ms >= POWER_SLEEP_TIMEOUT_MS)
+        power_set_state(POWER_SLEEP);
+    else if (inactive_ms >= POWER_BLANK_TIMEOUT_MS)
+        power_set_state(POWER_BLANK);
+    else if (inactive_ms >= POWER_DIM_TIMEOUT_MS)
+        power_set_state(POWER_DIM);
+    else
+        power_set_state(POWER_ACTIVE);
+}
+#endif
+
+/*** Called on touch: wake up the display at once. Returns true if it was dark. ***/
+static bool power_wake(void)
+{
+    if (power_state == POWER_ACTIVE)
+        return false;
+
+    bool was_dark = power_state >= POWER_BLANK;
+    lv_disp_trig_activity(NULL);
+    power_set_state(POWER_ACTIVE);
+    return was_dark;
+}
+
 /* Setting up tick task for lvgl */
+#if LABEL_BENCHMARK
+/*** Measure lv_label_set_text() on labels like the dashboard's value and button labels ***/
+static void label_benchmark(void)
+{
+    typedef struct {
+        const char *name;
+        const lv_font_t *font;
+        const char *txt[2]; // Alternated to always change the text
+    } bench_label_t;
+
+    static const bench_label_t bench_labels[] = {
+        {"temp value", &lv_font_montserrat_28, {"25.5°C", "26.1°C"}},
+        {"humid value", &lv_font_montserrat_28, {"65%", "66%"}},
+        {"pressure value", &lv_font_montserrat_22, {"1013 hPa", "1014 hPa"}},
+        {"temp button", &lv_font_montserrat_12, {"Temp Mode: C", "Temp Mode: F"}},
+        {"brightness button", &lv_font_montserrat_14, {"Brightness: 10%", "Brightness: 95%"}},
+    };
+    const uint32_t iterations = 200;
+
+    lv_obj_t *scr_ori = lv_scr_act();
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_scr_load(scr);
+
+    for (uint32_t i = 0; i < sizeof(bench_labels) / sizeof(bench_labels[0]); i++)
+    {
+        lv_obj_t *label = lv_label_create(scr);
+        lv_obj_set_style_text_font(label, bench_labels[i].font, 0);
+        lv_obj_center(label);
+        lv_refr_now(NULL);
+
+        // Only the text change and the layout update
+        int64_t t_start = esp_timer_get_time();
+        for (uint32_t j = 0; j < iterations; j++)
+        {
+            lv_label_set_text(label, bench_labels[i].txt[j & 1]);
+            lv_obj_update_layout(label);
+        }
+        int64_t set_text_us = esp_timer_get_time() - t_start;
+
+        // Including the redraw of the label
+        t_start = esp_timer_get_time();
+        for (uint32_t j = 0; j < iterations; j++)
+        {
+            lv_label_set_text(label, bench_labels[i].txt[j & 1]);
+            lv_refr_now(NULL);
+        }
+        int64_t refr_us = esp_timer_get_time() - t_start;
+
+        ESP_LOGI(TAG, "Label benchmark %-18s set_text: %4lld us, set_text + refresh: %5lld us",
+                 bench_labels[i].name, set_text_us / iterations, refr_us / iterations);
+        lv_obj_del(label);
+    }
+
+    // Formatting a changing sensor value: float printf + lv_label_set_text() vs. lv_label_set_num()
+    lv_obj_t *label = lv_label_create(scr);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_28, 0);
+    lv_obj_center(label);
+    lv_refr_now(NULL);
+
+    int64_t t_start = esp_timer_get_time();
+    for (uint32_t j = 0; j < iterations; j++)
+    {
+        char txt[16];
+        sprintf(txt, "%.1f°C", (j & 1) ? 26.1f : 25.5f);
+        lv_label_set_text(label, txt);
+        lv_obj_update_layout(label);
+    }
+    int64_t printf_us = esp_timer_get_time() - t_start;
+
+    t_start = esp_timer_get_time();
+    for (uint32_t j = 0; j < iterations; j++)
+    {
+        lv_label_set_num(label, (j & 1) ? 2610 : 2550, 2, 1, LV_LABEL_NUM_CONV_NONE, "°C");
+        lv_obj_update_layout(label);
+    }
+    int64_t set_num_us = esp_timer_get_time() - t_start;
+
+    ESP_LOGI(TAG, "Label benchmark %-18s printf + set_text: %4lld us, set_num: %4lld us",
+             "temp value format", printf_us / iterations, set_num_us / iterations);
+    lv_obj_del(label);
+
+    lv_scr_load(scr_ori);
+    lv_obj_del(scr);
+}
+#endif
+
+#if OBJ_MEM_BENCHMARK && LV_OBJ_LIGHT_SLAB_CNT
+/*** Measure the heap used by unit and scale labels created as normal and as light objects ***/
+static void obj_mem_benchmark(void)
+{
+    const uint32_t label_cnt = LV_OBJ_LIGHT_SLAB_CNT * 4;
+    size_t used[2];
+
+    lv_obj_t *scr_ori = lv_scr_act();
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_scr_load(scr);
+
+    for (uint32_t light = 0; light < 2; light++)
+    {
+        lv_obj_enable_light_create(light);
+        size_t free_before = heap_caps_get_free_size(MALLOC_CAP_DEFAULT); // LVGL allocates from the system heap
+        for (uint32_t i = 0; i < label_cnt; i++)
+        {
+            lv_obj_t *label = lv_label_create(scr);
+            lv_label_set_text_static(label, "hPa");
+            lv_obj_set_style_text_font(label, &lv_font_montserrat_14, 0);
+            lv_obj_set_style_text_color(label, lv_color_hex(0x5A6F8C), 0);
+            lv_obj_set_pos(label, (i % 10) * 48, (i / 10) * 20);
+        }
+        used[light] = free_before - heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+        lv_obj_clean(scr);
+    }
+    lv_obj_enable_light_create(false);
+
+    // Objects per kB with one decimal
+    uint32_t normal_per_kb = label_cnt * 10240 / used[0];
+    uint32_t light_per_kb = label_cnt * 10240 / used[1];
+    ESP_LOGI(TAG, "Object memory benchmark %" PRIu32 " labels: normal %u B (%" PRIu32 ".%" PRIu32 " objects/kB), light %u B (%" PRIu32 ".%" PRIu32 " objects/kB)",
+             label_cnt, (unsigned)used[0], normal_per_kb / 10, normal_per_kb % 10,
+             (unsigned)used[1], light_per_kb / 10, light_per_kb % 10);
+
+    lv_scr_load(scr_ori);
+    lv_obj_del(scr);
+}
+#endif
+
+#if DISPLAY_BENCHMARK
+/*** Send full frames over the 8-bit parallel bus with the BSP's esp_lcd i80 backend and with LovyanGFX's Bus_Parallel8 ***/
+static void display_benchmark(void)
+{
+    bsp_display_benchmark_t bsp_result;
+    esp_err_t ret = bsp_display_benchmark(DISPLAY_BENCHMARK_FRAMES, &bsp_result);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Display benchmark: esp_lcd i80 failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    // The same pins, clock and band size as the BSP
+    lgfx::Bus_Parallel8 bus;
+    auto bus_cfg = bus.config();
+    bus_cfg.freq_write = LCD_PIXEL_CLK_HZ;
+    bus_cfg.pin_wr = LCD_WR_PIN;
+    bus_cfg.pin_rd = -1;
+    bus_cfg.pin_rs = LCD_DC_PIN;
+    bus_cfg.pin_d0 = LCD_D0_PIN;
+    bus_cfg.pin_d1 = LCD_D1_PIN;
+    bus_cfg.pin_d2 = LCD_D2_PIN;
+    bus_cfg.pin_d3 = LCD_D3_PIN;
+    bus_cfg.pin_d4 = LCD_D4_PIN;
+    bus_cfg.pin_d5 = LCD_D5_PIN;
+    bus_cfg.pin_d6 = LCD_D6_PIN;
+    bus_cfg.pin_d7 = LCD_D7_PIN;
+    bus.config(bus_cfg);
+
+    lgfx::Panel_ST7796 panel;
+    auto panel_cfg = panel.config();
+    panel_cfg.pin_cs = LCD_CS_PIN;
+    panel_cfg.pin_rst = LCD_RST_PIN;
+    panel_cfg.readable = false;
+    panel_cfg.bus_shared = false;
+    panel.config(panel_cfg);
+    panel.setBus(&bus);
+
+    lgfx::LGFX_Device dev;
+    dev.setPanel(&panel);
+    dev.init();
+    dev.setRotation(1);
+
+#if LV_COLOR_16_SWAP
+    typedef lgfx::swap565_t band_pixel_t;
+#else
+    typedef lgfx::rgb565_t band_pixel_t;
+#endif
+    const uint32_t lines = LCD_DRAW_BUF_LINES;
+    lv_color_t *bands[2];
+    bands[0] = (lv_color_t *)heap_caps_malloc(LCD_V_RES * lines * sizeof(lv_color_t), MALLOC_CAP_DMA);
+    bands[1] = (lv_color_t *)heap_caps_malloc(LCD_V_RES * lines * sizeof(lv_color_t), MALLOC_CAP_DMA);
+    if (bands[0] && bands[1])
+    {
+        lv_color_fill(bands[0], lv_color_make(0x00, 0x40, 0xC0), LCD_V_RES * lines);
+        lv_color_fill(bands[1], lv_color_make(0xC0, 0x40, 0x00), LCD_V_RES * lines);
+
+        uint32_t band_idx = 0;
+        int64_t start = esp_timer_get_time();
+        dev.startWrite();
+        for (uint32_t f = 0; f < DISPLAY_BENCHMARK_FRAMES; f++)
+        {
+            for (uint32_t y = 0; y < LCD_H_RES; y += lines)
+            {
+                uint32_t h = y + lines < LCD_H_RES ? lines : LCD_H_RES - y;
+                dev.pushImageDMA(0, y, LCD_V_RES, h, (const band_pixel_t *)bands[band_idx]);
+                band_idx ^= 1;
+            }
+        }
+        dev.endWrite(); // Waits for the last DMA transfer
+        uint32_t lgfx_us = (uint32_t)(esp_timer_get_time() - start);
+        uint32_t lgfx_bytes = DISPLAY_BENCHMARK_FRAMES * LCD_H_RES * LCD_V_RES * sizeof(lv_color_t);
+
+        // bytes/us = MB/s
+        ESP_LOGI(TAG, "Display benchmark %lu frames at %lu MHz", (unsigned long)DISPLAY_BENCHMARK_FRAMES,
+                 (unsigned long)(LCD_PIXEL_CLK_HZ / 1000000));
+        ESP_LOGI(TAG, "  esp_lcd i80 (BSP):        %6lu us, %5.2f MB/s, %5.1f fps", (unsigned long)bsp_result.time_us,
+                 (double)bsp_result.bytes / bsp_result.time_us, bsp_result.frames * 1e6 / bsp_result.time_us);
+        ESP_LOGI(TAG, "  LovyanGFX Bus_Parallel8:  %6lu us, %5.2f MB/s, %5.1f fps", (unsigned long)lgfx_us,
+                 (double)lgfx_bytes / lgfx_us, DISPLAY_BENCHMARK_FRAMES * 1e6 / lgfx_us);
+    }
+    else
+    {
+        ESP_LOGE(TAG, "Display benchmark: out of DMA memory");
+    }
+
+    heap_caps_free(bands[0]);
+    heap_caps_free(bands[1]);
+    bus.release();
+}
+#endif
+
+#if !DISPLAY_BACKEND_BSP
 static void lv_tick_task(void *arg)
 {
     (void)arg;
     lv_tick_inc(LV_TICK_PERIOD_MS);
 }
+#endif
 
 /* Initialize I2C master */
 static esp_err_t i2c_master_init(void)
@@ -706,28 +1668,14 @@ static void sensor_task(void *arg)
     while (1)
     {
         // Read temperature and pressure from BMP280
-        ret = bmp280_read_data(&bmp280_dev, &sensor_temperature, &sensor_pressure);
+        sensor_reading_t reading;
+        ret = bmp280_read_data_fixed(&bmp280_dev, &reading.temperature, &reading.pressure);
 
         if (ret == ESP_OK) {
-            ESP_LOGI(TAG, "Temperature: %.2f°C, Pressure: %.2f hPa", sensor_temperature, sensor_pressure);
-
-            // Update LVGL labels (thread-safe as LVGL runs in same context)
-            if (temp_value_label != NULL) {
-                char temp_str[16];
-                if (temp_unit_fahrenheit) {
-                    float temp_f = (sensor_temperature * 9.0f / 5.0f) + 32.0f;
-                    sprintf(temp_str, "%.1f°F", temp_f);
-                } else {
-                    sprintf(temp_str, "%.1f°C", sensor_temperature);
-                }
-                lv_label_set_text(temp_value_label, temp_str);
-            }
+            ESP_LOGI(TAG, "Temperature: %" PRId32 " x 0.01°C, Pressure: %" PRId32 " Pa", reading.temperature, reading.pressure);
 
-            if (pressure_value_label != NULL) {
-                char pressure_str[16];
-                sprintf(pressure_str, "%.0f hPa", sensor_pressure);
-                lv_label_set_text(pressure_value_label, pressure_str);
-            }
+            // Shown by sensor_timer_cb() in LVGL's task, an older reading not shown yet is replaced
+            xQueueOverwrite(sensor_queue, &reading);
         } else {
             ESP_LOGE(TAG, "Failed to read BMP280 sensor data");
         }
@@ -735,4 +1683,18 @@ static void sensor_task(void *arg)
         // Wait 2 seconds before next reading
         vTaskDelay(pdMS_TO_TICKS(2000));
     }
-}
\ No newline at end of file
+}
+
+/*** Show the latest reading of the sensor task. Runs in LVGL's task as LVGL can't be called from other tasks ***/
+static void sensor_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    sensor_reading_t reading;
+    if (xQueueReceive(sensor_queue, &reading, 0) != pdTRUE)
+        return;
+
+    sensor_temperature = reading.temperature;
+    sensor_pressure = reading.pressure;
+    update_temp_label();
+    update_pressure_label();
+}